@@ -0,0 +1,115 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cmath>
+
+#include <hnc/algo/find_range.hpp>
+#include <hnc/algo/replace_all.hpp>
+#include <hnc/algo/split.hpp>
+#include <hnc/algo/vector2D_parallel.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::algo::find_range, hnc::algo::replace_all and hnc::algo::split on texts of n characters
+// and of the parallel algorithms on n x n hnc::vector2D against the serial loops
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::algo",
+		{ 1000, 4000, 16000, 64000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			// Words of 1 to 8 characters separated by spaces, "needle" at the end
+			auto const text = std::make_shared<std::string>();
+			for (std::size_t i = 0; text->size() + 7 < n; ++i) { *text += std::string(1 + i % 8, char('a' + i % 26)) + " "; }
+			*text += "needle";
+			return
+			{
+				{ [=]() -> void { hnc::do_not_optimize(hnc::algo::find_range(*text, std::string("needle"))); }, "find_range" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::algo::replace_all_copy(*text, std::string(" "), std::string(", "))); }, "replace_all (larger)" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::algo::replace_all_copy(*text, std::string("bb "), std::string("_"))); }, "replace_all (smaller)" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::algo::split(*text, ' ')); }, "split" }
+			};
+		}
+	);
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::algo on hnc::vector2D",
+		{ 256, 1024, 2048 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const m = std::make_shared<hnc::vector2D<double>>(n, n, 0.5);
+			auto const dst = std::make_shared<hnc::vector2D<double>>(n, n);
+			return
+			{
+				{
+					[=]() -> void
+					{
+						for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { (*dst)(i, j) = std::sqrt((*m)(i, j)) + 1.; } }
+						hnc::do_not_optimize((*dst)(0, 0));
+					},
+					"transform (serial loop)"
+				},
+				{
+					[=]() -> void
+					{
+						hnc::algo::transform(*m, *dst, [](double const x) { return std::sqrt(x) + 1.; });
+						hnc::do_not_optimize((*dst)(0, 0));
+					},
+					"transform"
+				},
+				{
+					[=]() -> void
+					{
+						double sum = 0.;
+						for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { sum += (*m)(i, j); } }
+						hnc::do_not_optimize(sum);
+					},
+					"sum (serial loop)"
+				},
+				{ [=]() -> void { hnc::do_not_optimize(hnc::algo::reduce(*m, 0., std::plus<double>())); }, "reduce (fast)" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::algo::reduce(*m, 0., std::plus<double>(), hnc::algo::reduction_t::deterministic)); }, "reduce (deterministic)" },
+				{
+					[=]() -> void
+					{
+						hnc::algo::for_each_index(*dst, [](std::size_t const i, std::size_t const j, double & value) { value = double(i + j); });
+						hnc::do_not_optimize((*dst)(0, 0));
+					},
+					"for_each_index"
+				}
+			};
+		}
+	);
+
+	return benchmark_suite::save("algo", "hnc::algo", benchs);
+}
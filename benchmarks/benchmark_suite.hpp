@@ -0,0 +1,149 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#ifndef HNC_BENCHMARKS_BENCHMARK_SUITE_HPP
+#define HNC_BENCHMARKS_BENCHMARK_SUITE_HPP
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <functional>
+#include <utility>
+#include <tuple>
+#include <algorithm>
+
+#include <hnc/benchmark_functions.hpp>
+#include <hnc/benchmark_size_sweep.hpp>
+#include <hnc/benchmark_io.hpp>
+#include <hnc/benchmark_compare.hpp>
+#include <hnc/benchmark_memory.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/to_string.hpp>
+
+
+/**
+ * @brief Helpers of the benchmarks of hnc (the .cpp files of the benchmarks directory)
+ *
+ * Each benchmark runs hnc::benchmark_functions for each input size and saves the results in hnc_benchmark_<name>.json
+ * (with the metadata of the machine, see hnc::benchmark_machine_metadata) @n
+ * If hnc_benchmark_<name>.baseline.json exists (a copy of a previous hnc_benchmark_<name>.json),
+ * the results are compared with it (see hnc::benchmark_compare) and the benchmark returns 1 if there is a regression
+ */
+namespace benchmark_suite
+{
+	/// Versions with name for hnc::benchmark_functions
+	using versions_t = std::vector<std::pair<std::function<void()>, std::string>>;
+
+	/**
+	 * @brief Run hnc::benchmark_functions for each size
+	 *
+	 * The data of the versions must be captured by value (with a std::shared_ptr for example),
+	 * the versions are called after versions_of_size returns
+	 *
+	 * @param[in,out] benchs           The results: benchs[version][size] (the sizes are padded with spaces, see hnc::benchmark_size_key)
+	 * @param[in]     title            Title of the tabulars
+	 * @param[in]     sizes            Input sizes
+	 * @param[in]     versions_of_size Function which returns the versions for an input size
+	 * @param[in]     nb_run           Number of runs for each version
+	 */
+	inline void run
+	(
+		hnc::benchmark_name_opt & benchs,
+		std::string const & title,
+		std::vector<std::size_t> const & sizes,
+		std::function<versions_t(std::size_t)> const & versions_of_size,
+		std::size_t const nb_run = 7
+	)
+	{
+		std::size_t width = 0;
+		for (std::size_t const n : sizes) { width = std::max(width, hnc::to_string(n).size()); }
+
+		for (std::size_t const n : sizes)
+		{
+			auto benchmark_functions = hnc::benchmark_functions
+			(
+				hnc::benchmark_policy().set_shuffle().set_nb_warmup_run(1),
+				versions_of_size(n),
+				title + " (n = " + hnc::to_string(n) + ")",
+				"hnc_benchmark_suite_gnuplot",
+				nb_run,
+				"Versions",
+				"Time (in second)",
+				false,
+				0.01L
+			);
+			for (auto const & name_bench : std::get<0>(benchmark_functions))
+			{
+				benchs[name_bench.first][hnc::benchmark_size_key(n, width)] = name_bench.second;
+			}
+			std::cout << std::get<2>(benchmark_functions) << std::endl;
+			std::cout << std::endl;
+		}
+	}
+
+	/**
+	 * @brief Save the results and compare them with the baseline
+	 *
+	 * Write hnc_benchmark_<name>.json (with the metadata of the machine) and a Gnuplot of the median times by size,
+	 * then compare with hnc_benchmark_<name>.baseline.json if it exists
+	 *
+	 * @param[in] name   Name of the benchmark
+	 * @param[in] title  Title of the Gnuplot and of the tabular of the comparison
+	 * @param[in] benchs The results: benchs[version][size]
+	 *
+	 * @return 1 if a version is significantly slower than the baseline, 0 otherwise
+	 */
+	inline int save(std::string const & name, std::string const & title, hnc::benchmark_name_opt const & benchs)
+	{
+		// Gnuplot
+		hnc::gnuplot::output_terminal_pdf const output_terminal("hnc_benchmark_" + name + "_gnuplot");
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label("Size");
+		gp.set_y_label("Time (in second)");
+		for (auto const & name_benchs : benchs)
+		{
+			std::map<std::string, long double> data;
+			for (auto const & size_bench : name_benchs.second) { data[size_bench.first] = size_bench.second.median(); }
+			gp.add_line(data, name_benchs.first);
+		}
+		gp.write_script_in_file();
+		gp.write_data_in_file();
+
+		// Results
+		std::string const filename = "hnc_benchmark_" + name + ".json";
+		hnc::benchmark_save(filename, benchs, hnc::benchmark_machine_metadata());
+		std::cout << "Results saved in " << filename << std::endl;
+
+		// Baseline
+		std::string const baseline_filename = "hnc_benchmark_" + name + ".baseline.json";
+		if (hnc::filesystem::file_is_readable(baseline_filename) == false)
+		{
+			std::cout << "No baseline (copy " << filename << " to " << baseline_filename << " to compare the next results with it)" << std::endl;
+			return 0;
+		}
+		auto const comparisons = hnc::benchmark_compare(hnc::benchmark_name_opt_load(baseline_filename), benchs);
+		std::cout << std::endl;
+		std::cout << hnc::benchmark_comparison_tabular(comparisons, title + ": comparison with " + baseline_filename) << std::endl;
+		return hnc::benchmark_has_regression(comparisons) ? 1 : 0;
+	}
+}
+
+#endif
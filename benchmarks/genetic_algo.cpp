@@ -0,0 +1,155 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <string>
+
+#include <hnc/algo/genetic_algo.hpp>
+#include <hnc/random.hpp>
+#include <hnc/openmp.hpp>
+#include <hnc/unused.hpp>
+#include <hnc/int.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of 10 generations of hnc::algo::genetic_algo::genetic_algo with n solutions per island
+
+/// Search a word (see tests/algo_genetic_algo_find_a_word.cpp), the genetic algorithm never finds it
+class search_a_word
+{
+private:
+
+	/// Random char
+	hnc::random::uniform_t<char> m_random_char;
+
+	/// Random bool
+	hnc::random::uniform_t<bool> m_random_bool;
+
+	/// Random std::size_t
+	hnc::random::uniform_t<std::size_t> m_random_size_t;
+
+	/// Word
+	std::string const m_target;
+
+public:
+
+	/// @brief Constructor
+	/// @param[in] target The word we search
+	search_a_word(std::string const & target) :
+		m_random_char(32, 126),
+		m_random_bool(),
+		m_random_size_t(0, target.size() - 1),
+		m_target(target)
+	{ }
+
+	/// @brief Return a new solution
+	/// @return a new solution
+	std::string generate_solution()
+	{
+		std::string solution(m_target.size(), ' ');
+		for (auto & c : solution) { c = m_random_char(); }
+		return solution;
+	}
+
+	/// @brief Evaluate a solution
+	/// @param[in] solution A solution
+	/// @return grade of the solution
+	unsigned int evaluate_solution(std::string const & solution)
+	{
+		unsigned int grade = 0;
+		for (std::size_t i = 0; i < m_target.size(); ++i) { if (solution[i] == m_target[i]) { ++grade; } }
+		return hnc::uint_t(solution.size()) - grade;
+	}
+
+	/// @brief Crossover between two solutions
+	/// @param[in] solution_a First solution
+	/// @param[in] solution_b Second solution
+	/// @return the new solution
+	std::string crossover(std::string const & solution_a, std::string const & solution_b)
+	{
+		std::string new_solution(solution_a);
+		for (std::size_t i = 0; i < solution_a.size(); ++i) { if (m_random_bool()) { new_solution[i] = solution_b[i]; } }
+		return new_solution;
+	}
+
+	/// @brief Mutation of a solution
+	/// @param[in] solution Initial solution
+	/// @return the new solution
+	std::string mutation(std::string const & solution)
+	{
+		std::string new_solution(solution);
+		new_solution[m_random_size_t()] = m_random_char();
+		return new_solution;
+	}
+
+	/// @brief The genetic algorithm stops after the maximum number of generations
+	/// @param[in] best_solution The actual best solution
+	/// @param[in] grade         Best solution's grade
+	/// @return false
+	bool stop(std::string const & best_solution, unsigned int const & grade) const
+	{
+		hnc_unused(best_solution);
+		hnc_unused(grade);
+		return false;
+	}
+};
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::algo::genetic_algo",
+		{ 50, 100, 200, 400 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			return
+			{
+				{
+					[=]() -> void
+					{
+						hnc::algo::genetic_algo::genetic_algo<std::string, unsigned int, search_a_word> ga
+						(
+							search_a_word("A long sentence that the genetic algorithm never finds"),
+							1, // nb_archipelago
+							hnc::openmp::nb_thread_max(), // nb_island_per_archipelago
+							n, // nb_solution_per_island
+							0.7, // crossover_probability
+							0.2, // mutation_probability
+							3, // nb_migration_per_island
+							5, // nb_generation_between_island_migration
+							2, // nb_migration_per_archipelago
+							10, // nb_generation_between_archipelago_migration
+							0, // nb_same_solution_max
+							10 // nb_generation_max
+						);
+						hnc::do_not_optimize(ga.best_solution().grade);
+					},
+					"10 generations"
+				}
+			};
+		},
+		3
+	);
+
+	return benchmark_suite::save("genetic_algo", "hnc::algo::genetic_algo", benchs);
+}
@@ -0,0 +1,57 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <vector>
+#include <memory>
+#include <random>
+
+#include <hnc/math/median.hpp>
+#include <hnc/math/variance.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::math::median and hnc::math::variance on n random doubles
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::math",
+		{ 1000, 10000, 100000, 1000000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const v = std::make_shared<std::vector<double>>(n);
+			std::mt19937 random_engine(42);
+			std::normal_distribution<double> distribution(10., 2.);
+			for (auto & x : *v) { x = distribution(random_engine); }
+			return
+			{
+				{ [=]() -> void { hnc::do_not_optimize(hnc::math::median(*v)); }, "median" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::math::variance(*v)); }, "variance" }
+			};
+		}
+	);
+
+	return benchmark_suite::save("math", "hnc::math", benchs);
+}
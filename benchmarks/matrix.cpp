@@ -0,0 +1,100 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <memory>
+
+#include <hnc/vector2D.hpp>
+#include <hnc/math/transpose.hpp>
+#include <hnc/math/gemm.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::math::transpose and hnc::math::gemm against the naive loops on n x n matrices
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::math matrix kernels",
+		{ 64, 128, 256, 512 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const a = std::make_shared<hnc::vector2D<double>>(n, n, 1.);
+			auto const b = std::make_shared<hnc::vector2D<double>>(n, n, 2.);
+			auto const c = std::make_shared<hnc::vector2D<double>>(n, n, 0.);
+			auto const a_f = std::make_shared<hnc::vector2D<float>>(n, n, 1.f);
+			auto const b_f = std::make_shared<hnc::vector2D<float>>(n, n, 2.f);
+			auto const c_f = std::make_shared<hnc::vector2D<float>>(n, n, 0.f);
+			for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { (*a)(i, j) = double(i + j); } }
+			return
+			{
+				{
+					[=]() -> void
+					{
+						for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { (*c)(j, i) = (*a)(i, j); } }
+						hnc::do_not_optimize((*c)(0, 0));
+					},
+					"transpose naive"
+				},
+				{ [=]() -> void { hnc::math::transpose(a->view(), c->view()); hnc::do_not_optimize((*c)(0, 0)); }, "transpose blocked" },
+				{
+					[=]() -> void
+					{
+						for (std::size_t i = 0; i < n; ++i)
+						{
+							for (std::size_t j = 0; j < n; ++j)
+							{
+								double sum = 0;
+								for (std::size_t k = 0; k < n; ++k) { sum += (*a)(i, k) * (*b)(k, j); }
+								(*c)(i, j) = sum;
+							}
+						}
+						hnc::do_not_optimize((*c)(0, 0));
+					},
+					"gemm<double> naive"
+				},
+				{ [=]() -> void { hnc::math::gemm(1., a->view(), b->view(), 0., c->view()); hnc::do_not_optimize((*c)(0, 0)); }, "gemm<double> tiled" },
+				{
+					[=]() -> void
+					{
+						for (std::size_t i = 0; i < n; ++i)
+						{
+							for (std::size_t j = 0; j < n; ++j)
+							{
+								float sum = 0;
+								for (std::size_t k = 0; k < n; ++k) { sum += (*a_f)(i, k) * (*b_f)(k, j); }
+								(*c_f)(i, j) = sum;
+							}
+						}
+						hnc::do_not_optimize((*c_f)(0, 0));
+					},
+					"gemm<float> naive"
+				},
+				{ [=]() -> void { hnc::math::gemm(1.f, a_f->view(), b_f->view(), 0.f, c_f->view()); hnc::do_not_optimize((*c_f)(0, 0)); }, "gemm<float> tiled" }
+			};
+		}
+	);
+
+	return benchmark_suite::save("matrix", "hnc::math matrix kernels", benchs);
+}
@@ -0,0 +1,95 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <iostream>
+#include <string>
+#include <tuple>
+
+#include <hnc/benchmark_memory.hpp>
+#include <hnc/benchmark_io.hpp>
+#include <hnc/benchmark_scaling.hpp>
+
+
+// Memory probe suite: latency of each cache level, bandwidth and cache line ping-pong
+// The results are saved in hnc_benchmark_memory.json with the topology of the computer
+
+int main()
+{
+	hnc::computer::topology_t const topology = hnc::computer::topology();
+	std::string const machine = " (" + topology.to_string() + ")";
+
+	std::cout << "Topology: " << topology << std::endl;
+	std::cout << std::endl;
+
+	hnc::benchmark_name_opt benchs;
+
+	// Latency
+	{
+		auto benchmark_latency = hnc::benchmark_memory_latency
+		(
+			hnc::benchmark_memory_working_set_sizes(topology),
+			"Memory latency" + machine,
+			"hnc_benchmark_memory_latency_gnuplot",
+			3,
+			1 << 22,
+			topology.cache_line_size()
+		);
+		benchs.insert(std::get<0>(benchmark_latency).begin(), std::get<0>(benchmark_latency).end());
+		hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_latency);
+		gnuplot.write_script_in_file();
+		gnuplot.write_data_in_file();
+		std::cout << std::get<2>(benchmark_latency) << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Bandwidth (single-threaded and all cores)
+	{
+		std::size_t const buffer_size = hnc::benchmark_memory_working_set_sizes(topology).back();
+		auto benchmark_bandwidth = hnc::benchmark_memory_bandwidth
+		(
+			buffer_size,
+			hnc::benchmark_nb_threads(std::max(topology.nb_logical_core, std::size_t(1))),
+			"Memory bandwidth, " + hnc::to_string(buffer_size >> 20) + " MiB" + machine,
+			"hnc_benchmark_memory_bandwidth_gnuplot"
+		);
+		benchs.insert(std::get<0>(benchmark_bandwidth).begin(), std::get<0>(benchmark_bandwidth).end());
+		hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_bandwidth);
+		gnuplot.write_script_in_file();
+		gnuplot.write_data_in_file();
+		std::cout << std::get<2>(benchmark_bandwidth) << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Cache line ping-pong
+	{
+		auto benchmark_ping_pong = hnc::benchmark_cache_line_ping_pong
+		(
+			hnc::benchmark_cache_line_ping_pong_cpu_pairs(topology),
+			"Cache line ping-pong" + machine
+		);
+		benchs.insert(std::get<0>(benchmark_ping_pong).begin(), std::get<0>(benchmark_ping_pong).end());
+		std::cout << std::get<1>(benchmark_ping_pong) << std::endl;
+		std::cout << std::endl;
+	}
+
+	hnc::benchmark_save("hnc_benchmark_memory.json", benchs, hnc::benchmark_machine_metadata(topology));
+	std::cout << "Results saved in hnc_benchmark_memory.json" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdio>
+
+#include <hnc/serialization.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_mmap.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of serialization round-trips (save and load with Boost.Serialization text archives)
+// of n objects and of a n x 16 hnc::vector2D
+// and of the reopening of a n x 16 hnc::vector2D_mmap
+
+class human_t
+{
+private:
+
+	std::vector<std::string> m_first_names;
+
+	std::string m_name;
+
+	unsigned int m_age;
+
+public:
+
+	human_t() = default;
+
+	human_t(std::vector<std::string> const & first_names, std::string const & name, unsigned int const age) :
+		m_first_names(first_names),
+		m_name(name),
+		m_age(age)
+	{ }
+
+	hnc_generate_serialize_member_function(m_first_names, m_name, m_age)
+};
+
+#ifndef hnc_no_boost_serialization
+
+/// @brief Save and load a value
+/// @param[in] value A value
+/// @return the loaded value
+template <class T>
+T round_trip(T const & value)
+{
+	std::stringstream s;
+	{
+		boost::archive::text_oarchive oarchive(s);
+		oarchive << value;
+	}
+	T r;
+	{
+		boost::archive::text_iarchive iarchive(s);
+		iarchive >> r;
+	}
+	return r;
+}
+
+#endif
+
+int main()
+{
+	#ifdef hnc_no_boost_serialization
+
+		std::cout << "Boost.Serialization is not available, no benchmark" << std::endl;
+		return 0;
+
+	#else
+
+		hnc::benchmark_name_opt benchs;
+
+		benchmark_suite::run
+		(
+			benchs,
+			"hnc::serialization",
+			{ 100, 1000, 10000 },
+			[](std::size_t const n) -> benchmark_suite::versions_t
+			{
+				auto const humans = std::make_shared<std::vector<human_t>>();
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					humans->emplace_back(std::vector<std::string>({ "Saoirse", "Sigourney" }), "Rianne " + hnc::to_string(i), (unsigned int)(i % 100));
+				}
+				auto const v = std::make_shared<hnc::vector2D<double>>(n, 16, 0.5);
+				// File removed with the last copy of the filename
+				std::shared_ptr<std::string> const filename(new std::string(hnc::filesystem::tmp_filename()), [](std::string * const p) { std::remove(p->c_str()); delete p; });
+				{ hnc::vector2D_mmap<double> const m(*filename, v->view()); }
+				return
+				{
+					{ [=]() -> void { hnc::do_not_optimize(round_trip(*humans)); }, "std::vector<human_t>" },
+					{ [=]() -> void { hnc::do_not_optimize(round_trip(*v)); }, "hnc::vector2D<double>" },
+					{
+						[=]() -> void
+						{
+							hnc::vector2D_mmap<double> const m(*filename, hnc::vector2D_mmap<double>::mode_t::read_only);
+							hnc::do_not_optimize(m(n - 1, 15));
+						},
+						"hnc::vector2D_mmap<double> (reopen)"
+					}
+				};
+			}
+		);
+
+		return benchmark_suite::save("serialization", "hnc::serialization", benchs);
+
+	#endif
+}
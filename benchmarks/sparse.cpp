@@ -0,0 +1,79 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <memory>
+#include <vector>
+
+#include <hnc/sparse.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/math/gemm.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of the sparse matrix-vector and sparse matrix-dense matrix (n x 16) products
+// with n x n matrices with 1% of values, against the dense products with hnc::vector2D
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::sparse",
+		{ 500, 1000, 2000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			// Random matrix with 1% of values
+			hnc::sparse::coo<double> m_coo(n, n);
+			unsigned int seed = 42;
+			auto const random = [&seed]() -> std::size_t { seed = seed * 1103515245u + 12345u; return std::size_t((seed / 65536u) % 32768u); };
+			for (std::size_t k = 0; k < n * n / 100; ++k) { m_coo.add((random() * 32768 + random()) % n, (random() * 32768 + random()) % n, 1.); }
+
+			auto const dense = std::make_shared<hnc::vector2D<double>>(m_coo.to_vector2D());
+			auto const m_csr = std::make_shared<hnc::sparse::csr<double>>(m_coo);
+			auto const m_csc = std::make_shared<hnc::sparse::csc<double>>(m_coo);
+			auto const x = std::make_shared<std::vector<double>>(n, 1.);
+			auto const b = std::make_shared<hnc::vector2D<double>>(n, 16, 1.);
+
+			return
+			{
+				{
+					[=]() -> void
+					{
+						std::vector<double> y(n);
+						#pragma omp parallel for
+						for (long int i = 0; i < long(n); ++i) { y[std::size_t(i)] = (*dense)[std::size_t(i)].dot(*x); }
+						hnc::do_not_optimize(y[0]);
+					},
+					"dense matrix-vector"
+				},
+				{ [=]() -> void { hnc::do_not_optimize(m_csr->multiply(*x)[0]); }, "CSR matrix-vector" },
+				{ [=]() -> void { hnc::do_not_optimize(m_csc->multiply(*x)[0]); }, "CSC matrix-vector" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::math::multiply(*dense, *b)(0, 0)); }, "dense matrix-matrix (gemm)" },
+				{ [=]() -> void { hnc::do_not_optimize(m_csr->multiply(*b)(0, 0)); }, "CSR matrix-matrix" },
+				{ [=]() -> void { hnc::do_not_optimize(m_csc->multiply(*b)(0, 0)); }, "CSC matrix-matrix" }
+			};
+		}
+	);
+
+	return benchmark_suite::save("sparse", "hnc::sparse", benchs);
+}
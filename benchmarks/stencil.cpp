@@ -0,0 +1,147 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <memory>
+
+#include <hnc/vector3D.hpp>
+#include <hnc/vector3D_C_style_minimal.hpp>
+#include <hnc/math/stencil.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::math::stencil on n x n x n hnc::vector3D against the naive loops on hnc::vector3D_C_style_minimal and hnc::vector3D
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::math::stencil",
+		{ 32, 64, 128, 256 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const c_src = std::make_shared<hnc::vector3D_C_style_minimal<double>>(n, n, n, 1.);
+			auto const c_dst = std::make_shared<hnc::vector3D_C_style_minimal<double>>(n, n, n, 0.);
+			auto const src = std::make_shared<hnc::vector3D<double>>(n, n, n, 1.);
+			auto const dst = std::make_shared<hnc::vector3D<double>>(n, n, n, 0.);
+			auto const s7 = hnc::math::stencil_7_point_t<double>::laplacian();
+			auto const s27 = hnc::math::stencil_27_point_t<double>::laplacian();
+			return
+			{
+				{
+					[=]() -> void
+					{
+						hnc::vector3D_C_style_minimal<double> const & u = *c_src;
+						hnc::vector3D_C_style_minimal<double> & r = *c_dst;
+						for (std::size_t x = 1; x + 1 < n; ++x)
+						{
+							for (std::size_t y = 1; y + 1 < n; ++y)
+							{
+								for (std::size_t z = 1; z + 1 < n; ++z)
+								{
+									r[x][y][z] =
+										s7.center * u[x][y][z] +
+										s7.x_minus * u[x - 1][y][z] + s7.x_plus * u[x + 1][y][z] +
+										s7.y_minus * u[x][y - 1][z] + s7.y_plus * u[x][y + 1][z] +
+										s7.z_minus * u[x][y][z - 1] + s7.z_plus * u[x][y][z + 1];
+								}
+							}
+						}
+						hnc::do_not_optimize(r[1][1][1]);
+					},
+					"7-point (naive, vector3D_C_style_minimal)"
+				},
+				{
+					[=]() -> void
+					{
+						hnc::vector3D<double> const & u = *src;
+						hnc::vector3D<double> & r = *dst;
+						for (std::size_t x = 1; x + 1 < n; ++x)
+						{
+							for (std::size_t y = 1; y + 1 < n; ++y)
+							{
+								for (std::size_t z = 1; z + 1 < n; ++z)
+								{
+									r(x, y, z) =
+										s7.center * u(x, y, z) +
+										s7.x_minus * u(x - 1, y, z) + s7.x_plus * u(x + 1, y, z) +
+										s7.y_minus * u(x, y - 1, z) + s7.y_plus * u(x, y + 1, z) +
+										s7.z_minus * u(x, y, z - 1) + s7.z_plus * u(x, y, z + 1);
+								}
+							}
+						}
+						hnc::do_not_optimize(r(1, 1, 1));
+					},
+					"7-point (naive, vector3D)"
+				},
+				{
+					[=]() -> void
+					{
+						hnc::math::stencil(src->view(), dst->view(), s7);
+						hnc::do_not_optimize((*dst)(1, 1, 1));
+					},
+					"7-point (hnc::math::stencil)"
+				},
+				{
+					[=]() -> void
+					{
+						hnc::vector3D<double> const & u = *src;
+						hnc::vector3D<double> & r = *dst;
+						for (std::size_t x = 1; x + 1 < n; ++x)
+						{
+							for (std::size_t y = 1; y + 1 < n; ++y)
+							{
+								for (std::size_t z = 1; z + 1 < n; ++z)
+								{
+									double sum = 0.;
+									for (int dx = -1; dx <= 1; ++dx)
+									{
+										for (int dy = -1; dy <= 1; ++dy)
+										{
+											for (int dz = -1; dz <= 1; ++dz)
+											{
+												sum += s27(dx, dy, dz) * u(std::size_t(long(x) + dx), std::size_t(long(y) + dy), std::size_t(long(z) + dz));
+											}
+										}
+									}
+									r(x, y, z) = sum;
+								}
+							}
+						}
+						hnc::do_not_optimize(r(1, 1, 1));
+					},
+					"27-point (naive, vector3D)"
+				},
+				{
+					[=]() -> void
+					{
+						hnc::math::stencil(src->view(), dst->view(), s27);
+						hnc::do_not_optimize((*dst)(1, 1, 1));
+					},
+					"27-point (hnc::math::stencil)"
+				}
+			};
+		}
+	);
+
+	return benchmark_suite::save("stencil", "hnc::math::stencil", benchs);
+}
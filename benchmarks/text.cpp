@@ -0,0 +1,60 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <hnc/text.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::text::diff on texts of n words (1 word out of 10 is changed)
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::text",
+		{ 100, 200, 400, 800, 1600 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const text0 = std::make_shared<std::vector<std::string>>();
+			auto const text1 = std::make_shared<std::vector<std::string>>();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				text0->push_back("word" + hnc::to_string(i % 97));
+				if (i % 10 == 3) { text1->push_back("other" + hnc::to_string(i)); }
+				else if (i % 10 != 7) { text1->push_back(text0->back()); }
+			}
+			return
+			{
+				{ [=]() -> void { hnc::do_not_optimize(hnc::text::diff(*text0, *text1)); }, "diff" },
+				{ [=]() -> void { hnc::do_not_optimize(hnc::text::diff(*text0, *text0)); }, "diff (same texts)" }
+			};
+		}
+	);
+
+	return benchmark_suite::save("text", "hnc::text", benchs);
+}
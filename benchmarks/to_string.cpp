@@ -0,0 +1,66 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <hnc/to_string.hpp>
+#include <hnc/to_type.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::to_string and hnc::to_ on n values
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::to_string & hnc::to_",
+		{ 100, 1000, 10000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const ints = std::make_shared<std::vector<int>>(n);
+			auto const doubles = std::make_shared<std::vector<double>>(n);
+			auto const ints_str = std::make_shared<std::vector<std::string>>(n);
+			auto const doubles_str = std::make_shared<std::vector<std::string>>(n);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				(*ints)[i] = int(i * 7919 % 100003) - 50000;
+				(*doubles)[i] = double((*ints)[i]) / 7.;
+				(*ints_str)[i] = hnc::to_string((*ints)[i]);
+				(*doubles_str)[i] = hnc::to_string((*doubles)[i]);
+			}
+			return
+			{
+				{ [=]() -> void { for (int const x : *ints) { hnc::do_not_optimize(hnc::to_string(x)); } }, "to_string(int)" },
+				{ [=]() -> void { for (double const x : *doubles) { hnc::do_not_optimize(hnc::to_string(x)); } }, "to_string(double)" },
+				{ [=]() -> void { for (auto const & s : *ints_str) { hnc::do_not_optimize(hnc::to_<int>(s)); } }, "to_<int>" },
+				{ [=]() -> void { for (auto const & s : *doubles_str) { hnc::do_not_optimize(hnc::to_<double>(s)); } }, "to_<double>" }
+			};
+		}
+	);
+
+	return benchmark_suite::save("to_string", "hnc::to_string & hnc::to_", benchs);
+}
@@ -0,0 +1,147 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <memory>
+#include <algorithm>
+#include <vector>
+
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_storage.hpp>
+#include <hnc/algo/sum.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of the row and column operations and of the element-wise operations of hnc::vector2D on n x n matrices
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::vector2D",
+		{ 64, 128, 256, 512 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const v = std::make_shared<hnc::vector2D<double>>(n, n, 1.);
+			return
+			{
+				{ [=]() -> void { v->add_row_before(0, 2.); v->remove_line(0); hnc::do_not_optimize((*v)[0][0]); }, "add & remove first row" },
+				{ [=]() -> void { v->add_row_after(v->nb_row() - 1, 2.); v->remove_line(v->nb_row() - 1); hnc::do_not_optimize((*v)[0][0]); }, "add & remove last row" },
+				{ [=]() -> void { v->add_col_before(0, 2.); v->remove_column(0); hnc::do_not_optimize((*v)[0][0]); }, "add & remove first column" },
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (std::size_t i = 0; i < v->nb_row(); ++i) { for (std::size_t j = 0; j < v->nb_col(); ++j) { sum += (*v)[i][j]; } }
+						hnc::do_not_optimize(sum);
+					},
+					"row traversal"
+				},
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (std::size_t i = 0; i < n; i += 32) { for (std::size_t j = 0; j < n; j += 32) { sum += hnc::algo::sum(v->sub_view(i, j, 32, 32)); } }
+						hnc::do_not_optimize(sum);
+					},
+					"32 x 32 block traversal (views)"
+				},
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (std::size_t j = 0; j < n; ++j) { sum += hnc::algo::sum(v->col(j)); }
+						hnc::do_not_optimize(sum);
+					},
+					"column traversal (views)"
+				},
+				{
+					[=]() -> void
+					{
+						std::vector<double> const row(n, 3.);
+						hnc::vector2D<double> table;
+						for (std::size_t i = 0; i < n; ++i) { table.push_back_row(row); }
+						hnc::do_not_optimize(table[0][0]);
+					},
+					"append n rows"
+				},
+				{ [=]() -> void { hnc::vector2D<double> const copy(*v); hnc::do_not_optimize(copy[0][0]); }, "copy" },
+				{ [=]() -> void { hnc::vector2D<double> tmp(*v); hnc::vector2D<double> const moved(std::move(tmp)); hnc::do_not_optimize(moved[0][0]); }, "copy & move" }
+			};
+		}
+	);
+
+	benchmark_suite::run
+	(
+		benchs,
+		"hnc::vector2D element-wise",
+		{ 64, 128, 256, 512 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			using padded_t = hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>>;
+			auto const a = std::make_shared<hnc::vector2D<float>>(n, n, 1.f);
+			auto const b = std::make_shared<hnc::vector2D<float>>(n, n, 2.f);
+			auto const c = std::make_shared<hnc::vector2D<float>>(n, n);
+			auto const a_padded = std::make_shared<padded_t>(n, n, 1.f);
+			auto const b_padded = std::make_shared<padded_t>(n, n, 2.f);
+			auto const c_padded = std::make_shared<padded_t>(n, n);
+			return
+			{
+				{
+					[=]() -> void
+					{
+						for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { (*c)[i][j] = 2.f * (*a)[i][j] + (*b)[i][j] / 4.f; } }
+						hnc::do_not_optimize((*c)[0][0]);
+					},
+					"2 * a + b / 4 (loop)"
+				},
+				{ [=]() -> void { *c = 2.f * *a + *b / 4.f; hnc::do_not_optimize((*c)[0][0]); }, "2 * a + b / 4 (expression)" },
+				{ [=]() -> void { *c_padded = 2.f * *a_padded + *b_padded / 4.f; hnc::do_not_optimize((*c_padded)[0][0]); }, "2 * a + b / 4 (expression, aligned_padded)" },
+				{
+					[=]() -> void
+					{
+						float sum = 0;
+						for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { sum += (*a)[i][j] * (*b)[i][j]; } }
+						hnc::do_not_optimize(sum);
+					},
+					"dot (loop)"
+				},
+				{ [=]() -> void { hnc::do_not_optimize(a->dot(*b)); }, "dot" },
+				{ [=]() -> void { hnc::do_not_optimize(a_padded->dot(*b_padded)); }, "dot (aligned_padded)" },
+				{
+					[=]() -> void
+					{
+						float max = (*a)[0][0];
+						for (std::size_t i = 0; i < n; ++i) { for (std::size_t j = 0; j < n; ++j) { max = std::max(max, (*a)[i][j]); } }
+						hnc::do_not_optimize(max);
+					},
+					"max (loop)"
+				},
+				{ [=]() -> void { hnc::do_not_optimize(a->max()); }, "max" },
+				{ [=]() -> void { c->axpy(0.5f, *a); hnc::do_not_optimize((*c)[0][0]); }, "axpy" }
+			};
+		}
+	);
+
+	return benchmark_suite::save("vector2D", "hnc::vector2D", benchs);
+}
@@ -0,0 +1,133 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <memory>
+#include <vector>
+
+#include <hnc/vector2D_fixed.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/math/vector2D_fixed.hpp>
+#include <hnc/math/gemm.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of n 4 x 4 matrix products and inversions with hnc::vector2D_fixed against hnc::vector2D
+
+// Fill the 4 x 4 matrix m with invertible values
+template <class matrix_t>
+void fill_4x4(matrix_t & m, std::size_t const seed)
+{
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		for (std::size_t j = 0; j < 4; ++j) { m(i, j) = double((seed + i * 7 + j * 3) % 5) + ((i == j) ? 4. : 0.); }
+	}
+}
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	benchmark_suite::run
+	(
+		benchs,
+		"4 x 4 matrix multiply",
+		{ 1000, 10000, 100000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const dynamic = std::make_shared<std::vector<hnc::vector2D<double>>>(n, hnc::vector2D<double>(4, 4, 0.));
+			auto const fixed = std::make_shared<std::vector<hnc::vector2D_fixed<double, 4, 4>>>(n);
+			for (std::size_t i = 0; i < n; ++i) { fill_4x4((*dynamic)[i], i); fill_4x4((*fixed)[i], i); }
+			return
+			{
+				{
+					[=]() -> void
+					{
+						hnc::vector2D<double> r = (*dynamic)[0];
+						for (std::size_t i = 1; i < n; ++i) { r = hnc::math::multiply(r, (*dynamic)[i]); r /= 8.; }
+						hnc::do_not_optimize(r(0, 0));
+					},
+					"hnc::vector2D"
+				},
+				{
+					[=]() -> void
+					{
+						hnc::vector2D_fixed<double, 4, 4> r = (*fixed)[0];
+						for (std::size_t i = 1; i < n; ++i) { r = hnc::math::multiply(r, (*fixed)[i]); r /= 8.; }
+						hnc::do_not_optimize(r(0, 0));
+					},
+					"hnc::vector2D_fixed"
+				}
+			};
+		}
+	);
+
+	benchmark_suite::run
+	(
+		benchs,
+		"4 x 4 matrix inverse",
+		{ 1000, 10000, 100000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const fixed = std::make_shared<std::vector<hnc::vector2D_fixed<double, 4, 4>>>(n);
+			for (std::size_t i = 0; i < n; ++i) { fill_4x4((*fixed)[i], i); }
+			return
+			{
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (auto const & m : *fixed) { sum += hnc::math::determinant<double, 4>(m); }
+						hnc::do_not_optimize(sum);
+					},
+					"determinant (LU with pivoting)"
+				},
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (auto const & m : *fixed) { sum += hnc::math::determinant(m); }
+						hnc::do_not_optimize(sum);
+					},
+					"determinant (closed form)"
+				},
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (auto const & m : *fixed) { sum += hnc::math::inverse<double, 4>(m)(0, 0); }
+						hnc::do_not_optimize(sum);
+					},
+					"inverse (Gauss-Jordan with pivoting)"
+				},
+				{
+					[=]() -> void
+					{
+						double sum = 0;
+						for (auto const & m : *fixed) { sum += hnc::math::inverse(m)(0, 0); }
+						hnc::do_not_optimize(sum);
+					},
+					"inverse (closed form)"
+				}
+			};
+		}
+	);
+
+	return benchmark_suite::save("vector2D_fixed", "hnc::vector2D_fixed", benchs);
+}
@@ -0,0 +1,136 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <memory>
+#include <vector>
+#include <cmath>
+
+#include <hnc/vector3.hpp>
+#include <hnc/vector3_batch.hpp>
+#include <hnc/vector2D_fixed.hpp>
+#include <hnc/benchmark.hpp>
+
+#include "benchmark_suite.hpp"
+
+
+// Benchmark of hnc::vector3_batch (structure of arrays) against std::vector<hnc::vector3> (array of structures)
+
+// Return n points
+std::vector<hnc::vector3<float>> points(std::size_t const n)
+{
+	std::vector<hnc::vector3<float>> r;
+	r.reserve(n);
+	for (std::size_t i = 0; i < n; ++i) { r.emplace_back(float(i % 17) + 1.f, float(i % 5), -float(i % 11)); }
+	return r;
+}
+
+int main()
+{
+	hnc::benchmark_name_opt benchs;
+
+	hnc::vector2D_fixed<float, 3, 3> const rotation = { { 0.f, -1.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 0.f, 1.f } };
+
+	benchmark_suite::run
+	(
+		benchs,
+		"transform and normalize",
+		{ 1000, 100000, 1000000 },
+		[=](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const aos = std::make_shared<std::vector<hnc::vector3<float>>>(points(n));
+			auto const soa = std::make_shared<hnc::vector3_batch<float>>(points(n));
+			return
+			{
+				{
+					[=]() -> void
+					{
+						for (hnc::vector3<float> & p : *aos)
+						{
+							float const x = rotation(0, 0) * p.x + rotation(0, 1) * p.y + rotation(0, 2) * p.z;
+							float const y = rotation(1, 0) * p.x + rotation(1, 1) * p.y + rotation(1, 2) * p.z;
+							float const z = rotation(2, 0) * p.x + rotation(2, 1) * p.y + rotation(2, 2) * p.z;
+							float const norm = std::sqrt(x * x + y * y + z * z);
+							float const inv = (norm == 0.f) ? 0.f : 1.f / norm;
+							p = hnc::vector3<float>(x * inv, y * inv, z * inv);
+						}
+						hnc::do_not_optimize((*aos)[0].x);
+					},
+					"std::vector<hnc::vector3>"
+				},
+				{
+					[=]() -> void
+					{
+						soa->transform(rotation);
+						soa->normalize();
+						hnc::do_not_optimize(soa->x()[0]);
+					},
+					"hnc::vector3_batch"
+				}
+			};
+		}
+	);
+
+	benchmark_suite::run
+	(
+		benchs,
+		"dot and cross",
+		{ 1000, 100000, 1000000 },
+		[](std::size_t const n) -> benchmark_suite::versions_t
+		{
+			auto const aos_a = std::make_shared<std::vector<hnc::vector3<float>>>(points(n));
+			auto const aos_b = std::make_shared<std::vector<hnc::vector3<float>>>(points(n + 3));
+			auto const soa_a = std::make_shared<hnc::vector3_batch<float>>(points(n));
+			auto const soa_b = std::make_shared<hnc::vector3_batch<float>>(points(n + 3));
+			soa_b->resize(n);
+			return
+			{
+				{
+					[=]() -> void
+					{
+						std::vector<hnc::vector3<float>> const & a = *aos_a;
+						std::vector<hnc::vector3<float>> const & b = *aos_b;
+						std::vector<float> dot(n);
+						std::vector<hnc::vector3<float>> cross(n);
+						for (std::size_t i = 0; i < n; ++i)
+						{
+							hnc::vector3<float> const & p = a[i];
+							hnc::vector3<float> const & q = b[i];
+							dot[i] = p.x * q.x + p.y * q.y + p.z * q.z;
+							cross[i] = hnc::vector3<float>(p.y * q.z - p.z * q.y, p.z * q.x - p.x * q.z, p.x * q.y - p.y * q.x);
+						}
+						hnc::do_not_optimize(dot[0]);
+						hnc::do_not_optimize(cross[0].x);
+					},
+					"std::vector<hnc::vector3>"
+				},
+				{
+					[=]() -> void
+					{
+						auto const dot = soa_a->dot(*soa_b);
+						hnc::vector3_batch<float> const cross = soa_a->cross(*soa_b);
+						hnc::do_not_optimize(dot[0]);
+						hnc::do_not_optimize(cross.x()[0]);
+					},
+					"hnc::vector3_batch"
+				}
+			};
+		}
+	);
+
+	return benchmark_suite::save("vector3_batch", "hnc::vector3_batch", benchs);
+}
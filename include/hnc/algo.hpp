@@ -35,6 +35,8 @@
 
 #include "algo/sum.hpp"
 
+#include "algo/vector2D_parallel.hpp"
+
 
 namespace hnc
 {
@@ -33,6 +33,7 @@
 #include "../random.hpp"
 #include "../time.hpp"
 #include "../openmp.hpp"
+#include "../trace.hpp"
 
 namespace hnc
 {
@@ -396,6 +397,8 @@ namespace hnc
 				/// @brief Crossover & mutation
 				void crossover_and_mutation()
 				{
+					hnc_trace_scope("hnc::algo::genetic_algo::crossover_and_mutation");
+					
 					hnc::out(log_level, log_level_t::minimal_plus_log) << "  " << "+ Crossover & mutation" << std::endl;
 					
 					// Do crossover and mutation
@@ -406,6 +409,8 @@ namespace hnc
 						#pragma omp parallel for
 						for (std::size_t island = 0; island < m_solutions[archipelago].size(); ++island)
 						{
+							hnc_trace_scope("hnc::algo::genetic_algo::crossover_and_mutation island");
+							
 							auto const thread_id = hnc::openmp::thread_id();
 							
 							hnc::out(log_level, log_level_t::island_log) << "  " << "  " << "  " << "Island " << island << "/" << m_solutions[archipelago].size() << std::endl;
@@ -474,6 +479,8 @@ namespace hnc
 				/// @brief Migration between islands
 				void migration_between_islands()
 				{
+					hnc_trace_scope("hnc::algo::genetic_algo::migration_between_islands");
+					
 					hnc::out(log_level, log_level_t::minimal_plus_log) << "  " << "+ Migration between islands" << std::endl;
 					
 					for (auto & archipelago : m_solutions)
@@ -502,6 +509,8 @@ namespace hnc
 				/// @brief Migration between archipelagos
 				void migration_between_archipelagos()
 				{
+					hnc_trace_scope("hnc::algo::genetic_algo::migration_between_archipelagos");
+					
 					hnc::out(log_level, log_level_t::minimal_plus_log) << "  " << "+ Migration between archipelagos" << std::endl;
 					
 					for (std::size_t archipelago = 0; archipelago < m_solutions.size(); ++archipelago)
@@ -60,6 +60,21 @@ namespace hnc
 		template <class T, template <class, class Alloc = std::allocator<T>> class Container>
 		T sum(Container<T> const & c)
 		{ return hnc::algo::sum(c.begin(), c.end()); }
+
+		/**
+		 * @brief Sum of the values of a range (a hnc::vector2D_view, a row or a column of a matrix, ...)
+		 *
+		 * @code
+		   #include <hnc/algo.hpp>
+		   @endcode
+		 *
+		 * @param[in] r A range with begin() and end()
+		 *
+		 * @return the sum
+		 */
+		template <class range_t>
+		auto sum(range_t const & r) -> decltype(hnc::algo::sum(r.begin(), r.end()))
+		{ return hnc::algo::sum(r.begin(), r.end()); }
 	}
 }
 
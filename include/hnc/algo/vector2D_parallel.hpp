@@ -0,0 +1,302 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_ALGO_VECTOR2D_PARALLEL_HPP
+#define HNC_ALGO_VECTOR2D_PARALLEL_HPP
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <stdexcept>
+
+#include "../openmp.hpp"
+#include "../aligned_allocator.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+
+
+namespace hnc
+{
+	namespace algo
+	{
+		/// Reduction mode of hnc::algo::reduce
+		enum class reduction_t
+		{
+			/// One partial result by thread (the result depends on the number of threads for floating point numbers)
+			fast,
+			/// One partial result by tile, combined in order (the result does not depend on the number of threads)
+			deterministic
+		};
+
+		/**
+		 * @brief Tiles of a matrix used by the parallel algorithms on hnc::vector2D
+		 *
+		 * @code
+		   #include <hnc/algo/vector2D_parallel.hpp>
+		   @endcode
+		 *
+		 * A tile is a part of a row with at most max_tile_nb_col contiguous values (32 KiB of double, the size of a L1 cache): @n
+		 * the tiles are numbered row by row, the threads get contiguous ranges of tiles (contiguous memory) and
+		 * a matrix with few long rows is split between all threads
+		 */
+		class vector2D_tiling
+		{
+		private:
+
+			/// Number of columns
+			std::size_t m_nb_col;
+
+			/// Number of tiles by row
+			std::size_t m_nb_tile_by_row;
+
+			/// Number of tiles
+			std::size_t m_nb_tile;
+
+		public:
+
+			/// Maximum number of values of a tile
+			static constexpr std::size_t max_tile_nb_col = 4096;
+
+			/// @brief Constructor
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			vector2D_tiling(std::size_t const nb_row, std::size_t const nb_col) :
+				m_nb_col(nb_col),
+				m_nb_tile_by_row((nb_col + max_tile_nb_col - 1) / max_tile_nb_col),
+				m_nb_tile(nb_row * m_nb_tile_by_row)
+			{ }
+
+			/// @brief Return the number of tiles
+			/// @return the number of tiles
+			std::size_t size() const { return m_nb_tile; }
+
+			/// @brief Return the row of a tile
+			/// @param[in] tile Tile index
+			/// @return the row of the tile
+			std::size_t row(std::size_t const tile) const { return tile / m_nb_tile_by_row; }
+
+			/// @brief Return the first column of a tile
+			/// @param[in] tile Tile index
+			/// @return the first column of the tile
+			std::size_t first_col(std::size_t const tile) const { return (tile % m_nb_tile_by_row) * max_tile_nb_col; }
+
+			/// @brief Return the end column (not included) of a tile
+			/// @param[in] tile Tile index
+			/// @return the end column of the tile
+			std::size_t end_col(std::size_t const tile) const { return std::min(first_col(tile) + max_tile_nb_col, m_nb_col); }
+		};
+
+		/**
+		 * @brief Call f(i, j, value) for all values of a matrix, in parallel (OpenMP, tiles of rows)
+		 *
+		 * @code
+		   #include <hnc/algo/vector2D_parallel.hpp>
+		   @endcode
+		 *
+		 * @code
+		   hnc::vector2D<double> m(1000, 1000);
+		   hnc::algo::for_each_index(m, [](std::size_t const i, std::size_t const j, double & value) { value = double(i * j); });
+		   @endcode
+		 *
+		 * @param[in,out] m A matrix (hnc::vector2D, hnc::vector2D_mmap)
+		 * @param[in]     f A function (std::size_t i, std::size_t j, value_type & value), called concurrently
+		 *
+		 * @return f
+		 */
+		template <class matrix_t, class function_t>
+		function_t for_each_index(matrix_t & m, function_t f)
+		{
+			hnc::algo::vector2D_tiling const tiling(m.nb_row(), m.nb_col());
+			#pragma omp parallel for schedule(static)
+			for (long int t = 0; t < long(tiling.size()); ++t)
+			{
+				std::size_t const tile = std::size_t(t);
+				std::size_t const i = tiling.row(tile);
+				auto * const row = m[i].data();
+				for (std::size_t j = tiling.first_col(tile); j < tiling.end_col(tile); ++j) { f(i, j, row[j]); }
+			}
+			return f;
+		}
+
+		/**
+		 * @brief dst(i, j) = f(src(i, j)) for all values, in parallel (OpenMP, tiles of rows)
+		 *
+		 * @code
+		   #include <hnc/algo/vector2D_parallel.hpp>
+		   @endcode
+		 *
+		 * @param[in]  src A matrix (hnc::vector2D, hnc::vector2D_mmap)
+		 * @param[out] dst A matrix with the same size (it can be src)
+		 * @param[in]  f   A function (value) -> value, called concurrently
+		 *
+		 * @exception std::invalid_argument hnc::hassert the matrices have the same size if NDEBUG is not defined
+		 */
+		template <class matrix_src_t, class matrix_dst_t, class function_t>
+		void transform(matrix_src_t const & src, matrix_dst_t & dst, function_t f)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(src.nb_row() == dst.nb_row() && src.nb_col() == dst.nb_col(), std::invalid_argument("hnc::algo::transform, src is a " + hnc::to_string(src.nb_row()) + "x" + hnc::to_string(src.nb_col()) + " matrix, dst is a " + hnc::to_string(dst.nb_row()) + "x" + hnc::to_string(dst.nb_col()) + " matrix"));
+			#endif
+			hnc::algo::vector2D_tiling const tiling(src.nb_row(), src.nb_col());
+			#pragma omp parallel for schedule(static)
+			for (long int t = 0; t < long(tiling.size()); ++t)
+			{
+				std::size_t const tile = std::size_t(t);
+				std::size_t const i = tiling.row(tile);
+				auto const * const src_row = src[i].data();
+				auto * const dst_row = dst[i].data();
+				for (std::size_t j = tiling.first_col(tile); j < tiling.end_col(tile); ++j) { dst_row[j] = f(src_row[j]); }
+			}
+		}
+
+		/**
+		 * @brief dst(i, j) = f(a(i, j), b(i, j)) for all values, in parallel (OpenMP, tiles of rows)
+		 *
+		 * @code
+		   #include <hnc/algo/vector2D_parallel.hpp>
+		   @endcode
+		 *
+		 * @param[in]  a   A matrix (hnc::vector2D, hnc::vector2D_mmap)
+		 * @param[in]  b   A matrix with the same size
+		 * @param[out] dst A matrix with the same size (it can be a or b)
+		 * @param[in]  f   A function (value, value) -> value, called concurrently
+		 *
+		 * @exception std::invalid_argument hnc::hassert the matrices have the same size if NDEBUG is not defined
+		 */
+		template <class matrix_a_t, class matrix_b_t, class matrix_dst_t, class function_t>
+		void transform(matrix_a_t const & a, matrix_b_t const & b, matrix_dst_t & dst, function_t f)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(a.nb_row() == b.nb_row() && a.nb_col() == b.nb_col() && a.nb_row() == dst.nb_row() && a.nb_col() == dst.nb_col(), std::invalid_argument("hnc::algo::transform, a is a " + hnc::to_string(a.nb_row()) + "x" + hnc::to_string(a.nb_col()) + " matrix, b is a " + hnc::to_string(b.nb_row()) + "x" + hnc::to_string(b.nb_col()) + " matrix, dst is a " + hnc::to_string(dst.nb_row()) + "x" + hnc::to_string(dst.nb_col()) + " matrix"));
+			#endif
+			hnc::algo::vector2D_tiling const tiling(a.nb_row(), a.nb_col());
+			#pragma omp parallel for schedule(static)
+			for (long int t = 0; t < long(tiling.size()); ++t)
+			{
+				std::size_t const tile = std::size_t(t);
+				std::size_t const i = tiling.row(tile);
+				auto const * const a_row = a[i].data();
+				auto const * const b_row = b[i].data();
+				auto * const dst_row = dst[i].data();
+				for (std::size_t j = tiling.first_col(tile); j < tiling.end_col(tile); ++j) { dst_row[j] = f(a_row[j], b_row[j]); }
+			}
+		}
+
+		/**
+		 * @brief Reduce all values of a matrix with a monoid, in parallel (OpenMP, tiles of rows)
+		 *
+		 * @code
+		   #include <hnc/algo/vector2D_parallel.hpp>
+		   @endcode
+		 *
+		 * The values are combined in row-major order, so op has to be associative (not commutative) and identity its neutral element
+		 * (0 and +, 1 and *, +infinity and min, ...)
+		 *
+		 * With hnc::algo::reduction_t::deterministic, the partial results of the tiles (see hnc::algo::vector2D_tiling) are combined in order:
+		 * the result of a floating point sum does not depend on the number of threads (it is reproducible)
+		 *
+		 * @code
+		   hnc::vector2D<double> const m(1000, 1000, 0.1);
+		   double const sum = hnc::algo::reduce(m, 0., std::plus<double>(), hnc::algo::reduction_t::deterministic);
+		   @endcode
+		 *
+		 * @param[in] m         A matrix (hnc::vector2D, hnc::vector2D_mmap)
+		 * @param[in] identity  Neutral element of op
+		 * @param[in] op        Associative function (result, value) -> result, called concurrently
+		 * @param[in] reduction Reduction mode (hnc::algo::reduction_t::fast by default)
+		 *
+		 * @return the reduction of the values (identity if the matrix is empty)
+		 */
+		template <class matrix_t, class result_t, class function_t>
+		result_t reduce(matrix_t const & m, result_t const & identity, function_t op, hnc::algo::reduction_t const reduction = hnc::algo::reduction_t::fast)
+		{
+			hnc::algo::vector2D_tiling const tiling(m.nb_row(), m.nb_col());
+
+			// Partial result alone in its cache line (no false sharing, and no data race on the bits of a std::vector<bool>)
+			struct alignas(64) partial_t
+			{
+				result_t value;
+			};
+
+			// One partial result by tile or by thread
+			std::vector<partial_t, hnc::aligned_allocator<partial_t, 64>> partial;
+			if (reduction == hnc::algo::reduction_t::deterministic) { partial.assign(tiling.size(), partial_t{ identity }); }
+			#pragma omp parallel
+			{
+				std::size_t const thread_id = hnc::openmp::thread_id();
+				if (reduction == hnc::algo::reduction_t::fast)
+				{
+					#pragma omp single
+					partial.assign(std::max(std::size_t(1), hnc::openmp::nb_thread_actual()), partial_t{ identity });
+				}
+
+				result_t r = identity;
+				#pragma omp for schedule(static)
+				for (long int t = 0; t < long(tiling.size()); ++t)
+				{
+					std::size_t const tile = std::size_t(t);
+					auto const * const row = m[tiling.row(tile)].data();
+					if (reduction == hnc::algo::reduction_t::deterministic)
+					{
+						result_t r_tile = identity;
+						for (std::size_t j = tiling.first_col(tile); j < tiling.end_col(tile); ++j) { r_tile = op(r_tile, row[j]); }
+						partial[tile].value = r_tile;
+					}
+					else
+					{
+						for (std::size_t j = tiling.first_col(tile); j < tiling.end_col(tile); ++j) { r = op(r, row[j]); }
+					}
+				}
+				if (reduction == hnc::algo::reduction_t::fast) { partial[thread_id].value = r; }
+			}
+
+			// Combine in order
+			result_t r = identity;
+			for (partial_t const & p : partial) { r = op(r, p.value); }
+			return r;
+		}
+
+		/**
+		 * @brief Apply a function on each row of a matrix, in parallel (OpenMP)
+		 *
+		 * @code
+		   #include <hnc/algo/vector2D_parallel.hpp>
+		   @endcode
+		 *
+		 * @code
+		   hnc::vector2D<double> const m(1000, 1000, 0.5);
+		   std::vector<double> const row_max = hnc::algo::map_rows(m, [](hnc::vector2D<double>::line_const_ptr<double> const & row) { return row.max(); });
+		   @endcode
+		 *
+		 * @param[in] m A matrix (hnc::vector2D, hnc::vector2D_mmap)
+		 * @param[in] f A function (row) -> result (the row is a m[i]), called concurrently
+		 *
+		 * @return the results, f(m[i]) for each row i
+		 */
+		template <class matrix_t, class function_t>
+		auto map_rows(matrix_t const & m, function_t f) -> std::vector<typename std::decay<decltype(f(m[0]))>::type>
+		{
+			using result_t = typename std::decay<decltype(f(m[0]))>::type;
+			static_assert(std::is_same<result_t, bool>::value == false, "hnc::algo::map_rows, the values of a std::vector<bool> can not be written concurrently (return a char)");
+			std::vector<result_t> r(m.nb_row());
+			#pragma omp parallel for schedule(dynamic, 16)
+			for (long int i = 0; i < long(m.nb_row()); ++i) { r[std::size_t(i)] = f(m[std::size_t(i)]); }
+			return r;
+		}
+	}
+}
+
+#endif
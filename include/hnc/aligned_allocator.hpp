@@ -0,0 +1,134 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_ALIGNED_ALLOCATOR_HPP
+#define HNC_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <limits>
+
+
+namespace hnc
+{
+	/**
+	 * @brief Allocator with aligned memory (64 bytes by default, a cache line and an AVX-512 register)
+	 *
+	 * @code
+	   #include <hnc/aligned_allocator.hpp>
+	   @endcode
+	 *
+	 * The first value of the allocated memory is aligned, so the compiler (and the hardware) can use aligned vector loads and stores
+	 *
+	 * @code
+	   std::vector<float, hnc::aligned_allocator<float>> v(1000);
+	   // v.data() is a multiple of 64
+	   @endcode
+	 *
+	 * @tparam T         Type of the values
+	 * @tparam alignment Alignment in bytes (a power of 2, at least alignof(void *))
+	 */
+	template <class T, std::size_t alignment = 64>
+	class aligned_allocator
+	{
+		static_assert(alignment != 0 && (alignment & (alignment - 1)) == 0, "hnc::aligned_allocator, the alignment must be a power of 2");
+		static_assert(alignment >= alignof(void *), "hnc::aligned_allocator, the alignment must be at least alignof(void *)");
+
+	public:
+
+		/// Type of the values
+		using value_type = T;
+
+		/// Pointer
+		using pointer = T *;
+
+		/// Const pointer
+		using const_pointer = T const *;
+
+		/// Reference
+		using reference = T &;
+
+		/// Const reference
+		using const_reference = T const &;
+
+		/// Size type
+		using size_type = std::size_t;
+
+		/// Difference type
+		using difference_type = std::ptrdiff_t;
+
+		/// Allocator for an other type
+		template <class U>
+		struct rebind
+		{
+			/// Allocator for U
+			using other = hnc::aligned_allocator<U, alignment>;
+		};
+
+		/// @brief Default constructor
+		aligned_allocator() noexcept { }
+
+		/// @brief Constructor from an allocator of an other type
+		template <class U>
+		aligned_allocator(hnc::aligned_allocator<U, alignment> const &) noexcept { }
+
+		/**
+		 * @brief Allocate aligned memory for n values
+		 *
+		 * The memory is allocated with ::operator new, the original pointer is stored just before the aligned memory
+		 *
+		 * @param[in] n Number of values
+		 *
+		 * @exception std::bad_alloc if the allocation fails
+		 *
+		 * @return a pointer aligned on alignment bytes
+		 */
+		T * allocate(std::size_t const n)
+		{
+			if (n > (std::numeric_limits<std::size_t>::max() - alignment - sizeof(void *)) / sizeof(T)) { throw std::bad_alloc(); }
+			void * const p = ::operator new(n * sizeof(T) + alignment + sizeof(void *));
+			std::uintptr_t const aligned = (std::uintptr_t(p) + sizeof(void *) + alignment - 1) & ~std::uintptr_t(alignment - 1);
+			reinterpret_cast<void **>(aligned)[-1] = p;
+			return reinterpret_cast<T *>(aligned);
+		}
+
+		/// @brief Free the memory allocated by allocate
+		/// @param[in] p Pointer returned by allocate
+		void deallocate(T * const p, std::size_t const) noexcept
+		{
+			if (p != nullptr) { ::operator delete(reinterpret_cast<void **>(p)[-1]); }
+		}
+
+		/// @brief Return the maximum number of values which can be allocated
+		/// @return the maximum number of values which can be allocated
+		std::size_t max_size() const noexcept
+		{
+			return (std::numeric_limits<std::size_t>::max() - alignment - sizeof(void *)) / sizeof(T);
+		}
+	};
+
+	/// @brief Equality operator (all hnc::aligned_allocator are equal)
+	/// @return true
+	template <class T, class U, std::size_t alignment>
+	bool operator ==(hnc::aligned_allocator<T, alignment> const &, hnc::aligned_allocator<U, alignment> const &) noexcept { return true; }
+
+	/// @brief Inequality operator (all hnc::aligned_allocator are equal)
+	/// @return false
+	template <class T, class U, std::size_t alignment>
+	bool operator !=(hnc::aligned_allocator<T, alignment> const &, hnc::aligned_allocator<U, alignment> const &) noexcept { return false; }
+}
+
+#endif
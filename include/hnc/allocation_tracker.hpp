@@ -0,0 +1,221 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_ALLOCATION_TRACKER_HPP
+#define HNC_ALLOCATION_TRACKER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+
+namespace hnc
+{
+	/**
+	 * @brief Count the heap allocations (global operator new and operator delete)
+	 *
+	 * @code
+	   #include <hnc/allocation_tracker.hpp>
+	   @endcode
+	 *
+	 * The global operator new and operator delete are replaced by hnc_allocation_tracker_define_global_operators(),
+	 * in exactly one source file of the program, at global scope:
+	 * @code
+	   #include <hnc/allocation_tracker.hpp>
+
+	   hnc_allocation_tracker_define_global_operators();
+	   @endcode
+	 *
+	 * Between start and stop, hnc::allocation_tracker records (for all threads):
+	 * - the number of allocations
+	 * - the number of allocated bytes
+	 * - the peak of live bytes (bytes allocated and not deallocated since start)
+	 *
+	 * @code
+	   hnc::allocation_tracker::start();
+	   std::vector<int> v(1000);
+	   hnc::allocation_tracker::values_t const values = hnc::allocation_tracker::stop();
+	   std::cout << values.nb_allocation << " allocation(s), " << values.nb_byte << " bytes" << std::endl; // 1 allocation(s), 4000 bytes
+	   @endcode
+	 *
+	 * If the operators are not replaced, hnc::allocation_tracker::installed() returns false and nothing is recorded
+	 * (see hnc::benchmark_base_t::set_allocation_tracker)
+	 *
+	 * @warning Only one start/stop at the same time
+	 */
+	class allocation_tracker
+	{
+	public:
+
+		/// Values recorded between start and stop
+		class values_t
+		{
+		public:
+
+			/// Number of allocations
+			std::uint64_t nb_allocation;
+
+			/// Number of allocated bytes
+			std::uint64_t nb_byte;
+
+			/// Peak of live bytes
+			std::uint64_t peak_live_byte;
+		};
+
+	private:
+
+		/// Global state
+		class state_t
+		{
+		public:
+
+			/// Operators replaced
+			std::atomic<bool> installed;
+
+			/// Recording
+			std::atomic<bool> recording;
+
+			/// Number of allocations
+			std::atomic<std::uint64_t> nb_allocation;
+
+			/// Number of allocated bytes
+			std::atomic<std::uint64_t> nb_byte;
+
+			/// Live bytes
+			std::atomic<std::int64_t> live_byte;
+
+			/// Live bytes at start
+			std::atomic<std::int64_t> live_byte_at_start;
+
+			/// Peak of live bytes (since start)
+			std::atomic<std::int64_t> peak_live_byte;
+		};
+
+		/// @brief Return the global state
+		/// @return the global state
+		static state_t & state()
+		{
+			// Zero initialized before any dynamic initialization
+			static state_t s;
+			return s;
+		}
+
+		/// @brief Size of the header before each allocation (to save the size)
+		/// @return the size of the header
+		static std::size_t header_size() { return alignof(std::max_align_t); }
+
+	public:
+
+		/// @brief Mark the operators as replaced (called by hnc_allocation_tracker_define_global_operators())
+		/// @return true
+		static bool install() { state().installed = true; return true; }
+
+		/// @brief Return true if the global operators are replaced
+		/// @return true if the global operators are replaced, false otherwise
+		static bool installed() { return state().installed; }
+
+		/// @brief Reset the values and start recording
+		static void start()
+		{
+			state_t & s = state();
+			s.nb_allocation = 0;
+			s.nb_byte = 0;
+			s.live_byte_at_start = s.live_byte.load();
+			s.peak_live_byte = 0;
+			s.recording = true;
+		}
+
+		/// @brief Stop recording and return the values
+		/// @return the values recorded since start
+		static values_t stop()
+		{
+			state_t & s = state();
+			s.recording = false;
+			values_t r;
+			r.nb_allocation = s.nb_allocation;
+			r.nb_byte = s.nb_byte;
+			r.peak_live_byte = std::uint64_t(s.peak_live_byte.load());
+			return r;
+		}
+
+		/// @brief Allocate memory (used by the replaced operator new)
+		/// @param[in] size Size in bytes
+		/// @exception std::bad_alloc if the allocation fails
+		/// @return a pointer to the memory
+		static void * allocate(std::size_t const size)
+		{
+			void * p = nullptr;
+			while ((p = std::malloc(size + header_size())) == nullptr)
+			{
+				std::new_handler const handler = std::get_new_handler();
+				if (handler == nullptr) { throw std::bad_alloc(); }
+				handler();
+			}
+			*static_cast<std::size_t *>(p) = size;
+
+			state_t & s = state();
+			std::int64_t const live = (s.live_byte += std::int64_t(size));
+			if (s.recording)
+			{
+				++s.nb_allocation;
+				s.nb_byte += size;
+				std::int64_t const peak = live - s.live_byte_at_start;
+				std::int64_t previous_peak = s.peak_live_byte;
+				while (peak > previous_peak && s.peak_live_byte.compare_exchange_weak(previous_peak, peak) == false) { }
+			}
+
+			return static_cast<char *>(p) + header_size();
+		}
+
+		/// @brief Deallocate memory (used by the replaced operator delete)
+		/// @param[in] ptr Pointer returned by allocate (or nullptr)
+		static void deallocate(void * const ptr)
+		{
+			if (ptr == nullptr) { return; }
+			void * const p = static_cast<char *>(ptr) - header_size();
+			state().live_byte -= std::int64_t(*static_cast<std::size_t *>(p));
+			std::free(p);
+		}
+	};
+}
+
+/**
+ * @brief Replace the global operator new and operator delete to count the allocations (see hnc::allocation_tracker)
+ *
+ * @code
+   #include <hnc/allocation_tracker.hpp>
+   @endcode
+ *
+ * Use it in exactly one source file, at global scope
+ */
+#define hnc_allocation_tracker_define_global_operators() \
+	void * operator new(std::size_t size) { return hnc::allocation_tracker::allocate(size); } \
+	void * operator new[](std::size_t size) { return hnc::allocation_tracker::allocate(size); } \
+	void * operator new(std::size_t size, std::nothrow_t const &) noexcept \
+	{ try { return hnc::allocation_tracker::allocate(size); } catch (...) { return nullptr; } } \
+	void * operator new[](std::size_t size, std::nothrow_t const &) noexcept \
+	{ try { return hnc::allocation_tracker::allocate(size); } catch (...) { return nullptr; } } \
+	void operator delete(void * ptr) noexcept { hnc::allocation_tracker::deallocate(ptr); } \
+	void operator delete[](void * ptr) noexcept { hnc::allocation_tracker::deallocate(ptr); } \
+	void operator delete(void * ptr, std::nothrow_t const &) noexcept { hnc::allocation_tracker::deallocate(ptr); } \
+	void operator delete[](void * ptr, std::nothrow_t const &) noexcept { hnc::allocation_tracker::deallocate(ptr); } \
+	static bool const hnc_allocation_tracker_installed = hnc::allocation_tracker::install()
+
+#endif
@@ -25,16 +25,82 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <memory>
+#include <array>
+#include <cstdint>
+#include <atomic>
+#include <stdexcept>
 
+#include "assert.hpp"
 #include "time.hpp"
+#include "benchmark_clock.hpp"
 #include "math/median.hpp"
 #include "math/geometric_mean.hpp"
 #include "math/mean.hpp"
+#include "math/variance.hpp"
+#include "math/running_statistics.hpp"
+#include "math/hdr_histogram.hpp"
+#include "perf_counters.hpp"
+#include "allocation_tracker.hpp"
 #include "ostreamable.hpp"
 
 
 namespace hnc
 {
+	/**
+	 * @brief Prevent the compiler from optimizing away the computation of a value
+	 *
+	 * @code
+	   #include <hnc/benchmark.hpp>
+	   @endcode
+	 *
+	 * The value is considered as read (and the memory as modified) by the compiler,
+	 * so the computation of the value can not be removed
+	 *
+	 * @code
+	   b["Test"].start();
+	   hnc::do_not_optimize(std::sqrt(x));
+	   b["Test"].stop();
+	   @endcode
+	 *
+	 * @param[in] value A value
+	 */
+	template <class T>
+	inline void do_not_optimize(T const & value)
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			__asm__ __volatile__("" : : "r,m"(value) : "memory");
+		#else
+			static char volatile sink;
+			sink = *reinterpret_cast<char const volatile *>(&value);
+		#endif
+	}
+
+	/**
+	 * @brief Force the compiler to write all pending values in memory (the memory is considered as read and modified)
+	 *
+	 * @code
+	   #include <hnc/benchmark.hpp>
+	   @endcode
+	 *
+	 * @code
+	   std::vector<int> v;
+	   v.reserve(1);
+	   b["push_back"].start();
+	   v.push_back(42);
+	   hnc::clobber_memory(); // The write in v is not removed
+	   b["push_back"].stop();
+	   @endcode
+	 */
+	inline void clobber_memory()
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			__asm__ __volatile__("" : : : "memory");
+		#else
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+		#endif
+	}
+
 	/**
 	 * @brief Vector of elapsed times
 	 *
@@ -42,57 +108,437 @@ namespace hnc
 	   #include <hnc/benchmark.hpp>
 	   @endcode
 	 * 
-	 * @warning hnc::benchmark_base is just a class to stock benchmark data @n
+	 * @warning hnc::benchmark_base_t is just a class to stock benchmark data @n
 	 * Please consider hnc::benchmark and hnc::benchmark_name_opt
 	 *
-	 * hnc::benchmark_base is a vector (std::vector) of elapsed times between start and stop
+	 * hnc::benchmark_base_t is a vector (std::vector) of elapsed times between start and stop
 	 * You can access to the min, max, median, geometric mean, mean and all elapsed times
+	 *
+	 * The elapsed times are measured with a clock policy (see hnc::benchmark_clock),
+	 * hnc::benchmark_base is a hnc::benchmark_base_t with hnc::benchmark_clock::steady @n
+	 * For nanosecond-scale code, use hnc::benchmark_clock::tsc: the overhead of start/stop is subtracted and the raw tick counts are in .all_ticks
+	 * @code
+	   hnc::benchmark_t<hnc::benchmark_clock::tsc> b;
+	   b["Small kernel"].start();
+	   // Some computation
+	   b["Small kernel"].stop();
+	   std::cout << b["Small kernel"].all.back() << " s = " << b["Small kernel"].all_ticks.back() << " ticks" << std::endl;
+	   std::cout << b["Small kernel"].ticks_per_second() << " ticks per second" << std::endl;
+	   @endcode
+	 *
+	 * The hardware performance counters (see hnc::perf_counters) can be recorded for each start/stop in .all_perf_counters @n
+	 * If the counters are not available (not Linux, container, perf_event_paranoid), only the time is recorded
+	 * @code
+	   hnc::benchmark b;
+	   b["Test"].set_perf_counters();
+	   b["Test"].start();
+	   // Some computation
+	   b["Test"].stop();
+	   if (b["Test"].has_perf_counter(hnc::perf_counters::event_t::instructions))
+	   {
+	   	std::cout << b["Test"].perf_counter_mean(hnc::perf_counters::event_t::instructions) << " instructions" << std::endl;
+	   }
+	   @endcode
+	 *
+	 * The heap allocations (see hnc::allocation_tracker) can be recorded for each start/stop in .all_allocations @n
+	 * The global operator new and operator delete must be replaced with hnc_allocation_tracker_define_global_operators()
+	 * @code
+	   hnc_allocation_tracker_define_global_operators();
+
+	   hnc::benchmark b;
+	   b["Test"].set_allocation_tracker();
+	   b["Test"].start();
+	   // Some computation
+	   b["Test"].stop();
+	   std::cout << b["Test"].all_allocations.back().nb_allocation << " allocations" << std::endl;
+	   @endcode
+	 *
+	 * For long benchmarks (a lot of elapsed times), use the streaming mode: elapsed times are not saved in .all,
+	 * the statistics are updated in O(1) with a constant memory (see hnc::math::running_statistics) @n
+	 * In streaming mode, the median and the quantiles are approximate (relative error <= 1%)
+	 * @code
+	   hnc::benchmark b;
+	   b["Soak test"].set_streaming();
+	   for (std::size_t i = 0; i < 100000000; ++i)
+	   {
+	   	b["Soak test"].start();
+	   	// Some computation
+	   	b["Soak test"].stop();
+	   }
+	   std::cout << b["Soak test"].median() << std::endl;
+	   std::cout << b["Soak test"].quantile(0.99) << std::endl;
+	   @endcode
+	 *
+	 * For latencies (p99, p99.9, max), use the histogram mode: the streaming mode with the elapsed times recorded in nanoseconds
+	 * in a hnc::math::hdr_histogram (O(1), without allocation, bounded memory, mergeable) @n
+	 * The median and the quantiles come from the histogram (relative error <= 10^-significant digits)
+	 * @code
+	   hnc::benchmark b;
+	   b["Request"].set_histogram(); // 1 ns to 1 hour, 3 significant digits
+	   for (std::size_t i = 0; i < 1000000; ++i)
+	   {
+	   	b["Request"].start();
+	   	// Some computation
+	   	b["Request"].stop();
+	   }
+	   std::cout << b["Request"].quantile(0.999) << std::endl;
+	   std::cout << b["Request"].histogram().value_at_percentile(99.999) << " ns" << std::endl;
+	   @endcode
 	 */
-	class benchmark_base
+	template <class clock_t = hnc::benchmark_clock::steady>
+	class benchmark_base_t
 	{
 	public:
 
-		/// Vector of all elapsed times
+		/// Tick count type of the clock policy
+		using tick_t = typename clock_t::tick_t;
+
+		/// Vector of all elapsed times (empty in streaming mode)
 		std::vector<long double> all;
+
+		/// Vector of all elapsed times in raw ticks of the clock, overhead subtracted (only for start/stop, empty in streaming mode)
+		std::vector<tick_t> all_ticks;
+
+		/// Vector of the hardware performance counters of all start/stop (empty in streaming mode or without hardware performance counters)
+		std::vector<hnc::perf_counters::values_t> all_perf_counters;
+
+		/// Vector of the allocations of all start/stop (empty in streaming mode or without allocation tracker)
+		std::vector<hnc::allocation_tracker::values_t> all_allocations;
 		
 	private:
 
-		/// Last start time
-		long double m_start;
+		/// Last start tick count
+		tick_t m_start;
+
+		/// Streaming mode
+		bool m_streaming;
+
+		/// Statistics (updated at each elapsed time)
+		hnc::math::running_statistics m_statistics;
+
+		/// Histogram of the elapsed times in nanoseconds (without count if the histogram mode is disabled)
+		hnc::math::hdr_histogram m_histogram;
+
+		/// Hardware performance counters (nullptr if they are not used or not available)
+		std::shared_ptr<hnc::perf_counters> m_perf_counters;
+
+		/// Sum of the hardware performance counters
+		hnc::perf_counters::values_t m_perf_counters_sum;
+
+		/// Number of hardware performance counters values
+		std::size_t m_perf_counters_size;
+
+		/// Number of iterations of the last batch
+		std::size_t m_nb_iteration;
+
+		/// Allocation tracker used
+		bool m_allocation_tracker;
+
+		/// Sum of the allocations
+		hnc::allocation_tracker::values_t m_allocations_sum;
+
+		/// Number of allocations values
+		std::size_t m_allocations_size;
 
 	public:
 
+		/// @brief Default constructor
+		///
+		/// The clock is calibrated here (overhead and ticks per second, once per program), not in the first stop()
+		benchmark_base_t() :
+			all(),
+			all_ticks(),
+			all_perf_counters(),
+			all_allocations(),
+			m_start(0),
+			m_streaming(false),
+			m_statistics(),
+			m_histogram(),
+			m_perf_counters(),
+			m_perf_counters_sum(),
+			m_perf_counters_size(0),
+			m_nb_iteration(1),
+			m_allocation_tracker(false),
+			m_allocations_sum(),
+			m_allocations_size(0)
+		{
+			m_perf_counters_sum.fill(0);
+			m_allocations_sum.nb_allocation = 0;
+			m_allocations_sum.nb_byte = 0;
+			m_allocations_sum.peak_live_byte = 0;
+			clock_t::overhead();
+			clock_t::ticks_per_second();
+		}
+
 		/// @brief Start timer for benchmark
 		void start()
 		{
-			m_start = hnc::time::s();
+			if (m_allocation_tracker) { hnc::allocation_tracker::start(); }
+			if (m_perf_counters) { m_perf_counters->start(); }
+			m_start = clock_t::start();
 		}
 
 		/// @brief Stop timer and save the duration (elapsed time during last .start()) (in seconds)
-		void stop()
+		void stop() { stop(1); }
+
+		/**
+		 * @brief Stop timer and save the duration of one iteration of a batch (elapsed time during last .start() divided by nb_iteration)
+		 *
+		 * For code shorter than the clock resolution, run it nb_iteration times between start and stop
+		 * (see hnc::benchmark_calibrate to choose nb_iteration) @n
+		 * The elapsed time, the ticks, the hardware performance counters, the number of allocations and of allocated bytes are saved per iteration
+		 *
+		 * @code
+		   hnc::benchmark b;
+		   b["Small kernel"].start();
+		   for (std::size_t i = 0; i < 1000; ++i) { hnc::do_not_optimize(small_kernel()); }
+		   b["Small kernel"].stop(1000);
+		   @endcode
+		 *
+		 * @param[in] nb_iteration Number of iterations between start and stop (>= 1)
+		 * @exception std::invalid_argument hnc::hassert nb_iteration >= 1 if NDEBUG is not defined
+		 */
+		void stop(std::size_t const nb_iteration)
 		{
-			all.push_back(hnc::time::s() - m_start);
+			tick_t const end = clock_t::stop();
+			#ifndef NDEBUG
+				hnc::hassert(nb_iteration >= 1, std::invalid_argument("hnc::benchmark_base_t::stop, number of iterations must be >= 1"));
+			#endif
+			if (m_perf_counters)
+			{
+				hnc::perf_counters::values_t values = m_perf_counters->stop();
+				for (auto & value : values) { value /= nb_iteration; }
+				save_perf_counters(values);
+			}
+			if (m_allocation_tracker)
+			{
+				hnc::allocation_tracker::values_t values = hnc::allocation_tracker::stop();
+				values.nb_allocation /= nb_iteration;
+				values.nb_byte /= nb_iteration;
+				save_allocations(values);
+			}
+			// The counters are stopped before any other work (the clock is calibrated in the constructor)
+			tick_t const overhead = clock_t::overhead();
+			tick_t const ticks = (end - m_start > overhead) ? (end - m_start - overhead) : tick_t(0);
+			if (m_streaming == false) { all_ticks.push_back(tick_t(ticks / nb_iteration)); }
+			m_nb_iteration = nb_iteration;
+			save((long double)(ticks) / clock_t::ticks_per_second() / (long double)(nb_iteration));
 		}
 
+		/// @brief Return the number of iterations of the last batch (see stop(nb_iteration), 1 by default)
+		/// @return the number of iterations of the last batch
+		std::size_t nb_iteration() const { return m_nb_iteration; }
+
 		/// @brief Add (push back) a user elapsed time value
-		/// @param[in] value value of one elapsed time
-		void push_back(double const value) { all.push_back(value); }
+		/// @param[in] value value of one elapsed time (saved without conversion in .all)
+		void push_back(long double const value) { save(value); }
+
+		/**
+		 * @brief Enable (or disable) the streaming mode
+		 *
+		 * In streaming mode, the elapsed times are not saved in .all and .all_ticks (they are cleared) @n
+		 * Choose the mode before the first elapsed time @n
+		 * Disabling the streaming mode also disables the histogram mode
+		 *
+		 * @param[in] streaming true to enable the streaming mode (by default), false to disable it
+		 * @return the hnc::benchmark_base_t
+		 */
+		benchmark_base_t & set_streaming(bool const streaming = true)
+		{
+			m_streaming = streaming;
+			if (m_streaming == false) { m_histogram = hnc::math::hdr_histogram(); }
+			if (m_streaming)
+			{
+				std::vector<long double>().swap(all);
+				std::vector<tick_t>().swap(all_ticks);
+				std::vector<hnc::perf_counters::values_t>().swap(all_perf_counters);
+				std::vector<hnc::allocation_tracker::values_t>().swap(all_allocations);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Enable (or disable) the histogram mode
+		 *
+		 * The histogram mode is the streaming mode (see set_streaming) with the elapsed times recorded in nanoseconds
+		 * in a hnc::math::hdr_histogram, used for the median and the quantiles @n
+		 * The histogram is allocated here (nb_count() * 8 bytes, ~300 KB with the default parameters), then the record is O(1) without allocation @n
+		 * Choose the mode before the first elapsed time
+		 *
+		 * @param[in] enable                 true to enable the histogram mode (by default), false to disable it (the streaming mode stays enabled)
+		 * @param[in] highest_trackable_time Highest trackable elapsed time in seconds (3600 by default), longer times are counted as this one
+		 * @param[in] significant_digits     Number of significant digits in [1, 5] (3 by default, 0.1%)
+		 * @return the hnc::benchmark_base_t
+		 */
+		benchmark_base_t & set_histogram
+		(
+			bool const enable = true,
+			long double const highest_trackable_time = 3600,
+			int const significant_digits = 3
+		)
+		{
+			if (enable)
+			{
+				set_streaming(true);
+				m_histogram = hnc::math::hdr_histogram(std::uint64_t(highest_trackable_time / histogram_unit()), significant_digits);
+			}
+			else { m_histogram = hnc::math::hdr_histogram(); }
+			return *this;
+		}
+
+		/// @brief Return true if the histogram mode is enabled
+		/// @return true if the histogram mode is enabled, false otherwise
+		bool has_histogram() const { return m_histogram.nb_count() != 0; }
+
+		/// @brief Return the histogram of the elapsed times in nanoseconds (without count if the histogram mode is disabled)
+		/// @return the histogram of the elapsed times in nanoseconds
+		hnc::math::hdr_histogram const & histogram() const { return m_histogram; }
+
+		/// @brief Return the unit of the values of the histogram in seconds (1 ns)
+		/// @return the unit of the values of the histogram in seconds
+		static long double histogram_unit() { return 1e-9L; }
+
+		/**
+		 * @brief Record (or not) the hardware performance counters for each start/stop
+		 *
+		 * If the counters can not be opened, nothing is recorded (only the time)
+		 *
+		 * @param[in] enable true to record the hardware performance counters (by default), false otherwise
+		 * @return the hnc::benchmark_base_t
+		 */
+		benchmark_base_t & set_perf_counters(bool const enable = true)
+		{
+			m_perf_counters.reset();
+			if (enable)
+			{
+				m_perf_counters = std::make_shared<hnc::perf_counters>();
+				if (m_perf_counters->available() == false) { m_perf_counters.reset(); }
+			}
+			return *this;
+		}
+
+		/// @brief Return true if hardware performance counters are recorded
+		/// @return true if hardware performance counters are recorded, false otherwise
+		bool has_perf_counters() const { return bool(m_perf_counters); }
+
+		/// @brief Return true if this hardware performance counter is recorded
+		/// @param[in] event An event
+		/// @return true if this hardware performance counter is recorded, false otherwise
+		bool has_perf_counter(hnc::perf_counters::event_t const event) const
+		{
+			return m_perf_counters && m_perf_counters->available(event);
+		}
+
+		/// @brief Return the mean of a hardware performance counter (for all start/stop)
+		/// @param[in] event An event
+		/// @return the mean of a hardware performance counter
+		long double perf_counter_mean(hnc::perf_counters::event_t const event) const
+		{
+			if (m_perf_counters_size == 0) { return 0; }
+			return (long double)(m_perf_counters_sum[std::size_t(event)]) / (long double)(m_perf_counters_size);
+		}
+
+		/**
+		 * @brief Record (or not) the heap allocations for each start/stop (see hnc::allocation_tracker)
+		 *
+		 * If the global operators are not replaced (see hnc_allocation_tracker_define_global_operators()), nothing is recorded
+		 *
+		 * @param[in] enable true to record the allocations (by default), false otherwise
+		 * @return the hnc::benchmark_base_t
+		 */
+		benchmark_base_t & set_allocation_tracker(bool const enable = true)
+		{
+			m_allocation_tracker = enable && hnc::allocation_tracker::installed();
+			return *this;
+		}
+
+		/// @brief Return true if the heap allocations are recorded
+		/// @return true if the heap allocations are recorded, false otherwise
+		bool has_allocation_tracker() const { return m_allocation_tracker; }
+
+		/// @brief Return the mean of the allocations (for all start/stop)
+		/// @return the mean of the number of allocations, of the allocated bytes and of the peak of live bytes
+		std::array<long double, 3> allocations_mean() const
+		{
+			std::array<long double, 3> r;
+			r.fill(0);
+			if (m_allocations_size == 0) { return r; }
+			long double const size = (long double)(m_allocations_size);
+			r[0] = (long double)(m_allocations_sum.nb_allocation) / size;
+			r[1] = (long double)(m_allocations_sum.nb_byte) / size;
+			r[2] = (long double)(m_allocations_sum.peak_live_byte) / size;
+			return r;
+		}
+
+		/// @brief Return true if the streaming mode is enabled
+		/// @return true if the streaming mode is enabled, false otherwise
+		bool is_streaming() const { return m_streaming; }
+
+		/// @brief Return the number of ticks in one second of the clock policy
+		/// @return the number of ticks in one second of the clock policy
+		long double ticks_per_second() const { return clock_t::ticks_per_second(); }
+
+		/// @brief Return the overhead of start/stop (in ticks) subtracted from each elapsed time
+		/// @return the overhead of start/stop (in ticks)
+		tick_t overhead_ticks() const { return clock_t::overhead(); }
+
+		/// @brief Return the statistics updated at each elapsed time in streaming mode (see set_streaming)
+		/// @return the statistics updated at each elapsed time in streaming mode (empty otherwise)
+		hnc::math::running_statistics const & statistics() const { return m_statistics; }
+
+		/// @brief Return the number of elapsed times
+		/// @return the number of elapsed times
+		std::size_t size() const { return (m_streaming) ? m_statistics.size() : all.size(); }
 
 		/// @brief Return the minimum of elapsed time
 		/// @return the minimum of elapsed time
-		long double min() const { return *std::min_element(all.begin(), all.end()); }
+		long double min() const
+		{
+			if (m_streaming) { return m_statistics.min(); }
+			return *std::min_element(all.begin(), all.end());
+		}
 
 		/// @brief Return the maximum of elapsed time
 		/// @return the maximum of elapsed time
-		long double max() const { return *std::max_element(all.begin(), all.end()); }
+		long double max() const
+		{
+			if (m_streaming) { return m_statistics.max(); }
+			return *std::max_element(all.begin(), all.end());
+		}
 
-		/// @brief Return the median of all elapsed times
+		/// @brief Return the median of all elapsed times (approximate in streaming mode)
 		/// @return the median of all elapsed times
-		long double median() const { return hnc::math::median(all); }
+		long double median() const
+		{
+			if (has_histogram()) { return quantile(0.5); }
+			if (m_streaming) { return m_statistics.median(); }
+			return hnc::math::median(all);
+		}
+
+		/// @brief Return a quantile of all elapsed times (approximate in streaming mode)
+		/// @param[in] q Quantile in [0, 1] (0.5 for the median, 0.99 for the 99th percentile)
+		/// @exception std::length_error: hnc::hassert there is at least one elapsed time if NDEBUG is not defined
+		/// @return a quantile of all elapsed times
+		long double quantile(double const q) const
+		{
+			if (has_histogram()) { return (long double)(m_histogram.value_at_percentile(100. * q)) * histogram_unit(); }
+			if (m_streaming) { return m_statistics.quantile(q); }
+			#ifndef NDEBUG
+				hnc::hassert(all.empty() == false, std::length_error("hnc::benchmark_base_t::quantile, Can not compute a quantile without elapsed time"));
+			#endif
+			std::vector<long double> copy(all);
+			auto const nth = copy.begin() + long(std::min(std::max(q, 0.), 1.) * double(copy.size() - 1) + 0.5);
+			std::nth_element(copy.begin(), nth, copy.end());
+			return *nth;
+		}
 
 		/// @brief Return the geometric mean of all elapsed times
 		/// @return the geometric mean of all elapsed times
-		long double geometric_mean() const { return hnc::math::geometric_mean(all); }
+		long double geometric_mean() const
+		{
+			if (m_streaming) { return m_statistics.geometric_mean(); }
+			return hnc::math::geometric_mean(all);
+		}
 
 		/**
 		 * @brief Return the mean of all elapsed times
@@ -101,8 +547,54 @@ namespace hnc
 		 * 
 		 * @return the mean of all elapsed times
 		 */
-		long double mean() const { return hnc::math::mean(all); }
+		long double mean() const
+		{
+			if (m_streaming) { return m_statistics.mean(); }
+			return hnc::math::mean(all);
+		}
+
+		/// @brief Return the variance of all elapsed times
+		/// @return the variance of all elapsed times
+		long double variance() const
+		{
+			if (m_streaming) { return m_statistics.variance(); }
+			return hnc::math::variance(all);
+		}
+
+	private:
+
+		/// @brief Save an elapsed time
+		/// @param[in] elapsed_time Elapsed time
+		void save(long double const elapsed_time)
+		{
+			if (m_streaming == false) { all.push_back(elapsed_time); return; }
+			m_statistics.push_back(elapsed_time);
+			if (has_histogram()) { m_histogram.record(std::uint64_t(std::max(elapsed_time, 0.L) / histogram_unit() + 0.5L)); }
+		}
+
+		/// @brief Save the values of the hardware performance counters
+		/// @param[in] values Values of the hardware performance counters
+		void save_perf_counters(hnc::perf_counters::values_t const & values)
+		{
+			if (m_streaming == false) { all_perf_counters.push_back(values); }
+			for (std::size_t i = 0; i < values.size(); ++i) { m_perf_counters_sum[i] += values[i]; }
+			++m_perf_counters_size;
+		}
+
+		/// @brief Save the allocations
+		/// @param[in] values Allocations
+		void save_allocations(hnc::allocation_tracker::values_t const & values)
+		{
+			if (m_streaming == false) { all_allocations.push_back(values); }
+			m_allocations_sum.nb_allocation += values.nb_allocation;
+			m_allocations_sum.nb_byte += values.nb_byte;
+			m_allocations_sum.peak_live_byte += values.peak_live_byte;
+			++m_allocations_size;
+		}
 	};
+
+	/// @brief hnc::benchmark_base_t with std::chrono::steady_clock
+	typedef hnc::benchmark_base_t<> benchmark_base;
 	
 	/**
 	 * @brief Save benchmarks by name
@@ -123,7 +615,7 @@ namespace hnc
 	 * - median
 	 * - geometric mean
 	 * - mean (benchmark is a long tail distribution, mean (may) have no sense; use media or geometric mean instead)
-	 * - all elapsed times
+	 * - all elapsed times (not saved in streaming mode, see hnc::benchmark_base::set_streaming)
 	 *
 	 * @code
 	   hnc::benchmark b;
@@ -147,25 +639,46 @@ namespace hnc
 	   @endcode
 	 */
 	typedef std::map<std::string, hnc::benchmark_base> benchmark;
+
+	/// @brief hnc::benchmark with an other clock policy (see hnc::benchmark_clock)
+	template <class clock_t>
+	using benchmark_t = std::map<std::string, hnc::benchmark_base_t<clock_t>>;
 	
 	/// @brief Operator << between a std::ostream and a hnc::benchmark
 	/// @param[in,out] o Output stream
 	/// @param[in]     b A hnc::benchmark
 	/// @return the output stream
-	inline std::ostream & operator <<(std::ostream & o, hnc::benchmark const & b)
+	template <class clock_t>
+	std::ostream & operator <<(std::ostream & o, hnc::benchmark_t<clock_t> const & b)
 	{
 		for (auto const & t : b)
 		{
 			auto const & key = t.first;
 			auto const & value = t.second;
-			std::cout << key << ":" << "\n";
-			std::cout << "- all:            " << hnc::ostreamable(value.all) << "\n";
-			std::cout << "- min:            " << value.min() << "\n";
-			std::cout << "- max:            " << value.max() << "\n";
-			std::cout << "- median:         " << value.median() << "\n";
-			std::cout << "- geometric mean: " << value.geometric_mean() << "\n";
-			std::cout << "- mean:           " << value.mean();
-			if (t.first != b.rbegin()->first) { std::cout << "\n"; }
+			o << key << ":" << "\n";
+			if (value.is_streaming()) { o << "- size:           " << value.size() << "\n"; }
+			else { o << "- all:            " << hnc::ostreamable(value.all) << "\n"; }
+			o << "- min:            " << value.min() << "\n";
+			o << "- max:            " << value.max() << "\n";
+			o << "- median:         " << value.median() << "\n";
+			o << "- geometric mean: " << value.geometric_mean() << "\n";
+			o << "- mean:           " << value.mean();
+			for (auto const event : hnc::perf_counters::events())
+			{
+				if (value.has_perf_counter(event))
+				{
+					std::string const name = hnc::perf_counters::name(event) + ":";
+					o << "\n" << "- " << name << std::string((name.size() < 16) ? 16 - name.size() : 1, ' ') << value.perf_counter_mean(event);
+				}
+			}
+			if (value.has_allocation_tracker())
+			{
+				auto const allocations = value.allocations_mean();
+				o << "\n" << "- allocations:    " << allocations[0];
+				o << "\n" << "- allocated bytes: " << allocations[1];
+				o << "\n" << "- peak live bytes: " << allocations[2];
+			}
+			if (t.first != b.rbegin()->first) { o << "\n"; }
 		}
 		return o;
 	}
@@ -181,7 +694,8 @@ namespace hnc
 	 * 
 	 * @return a std::map of double, key is the name of the benchmark, value is the mean
 	 */
-	std::map<std::string, long double> benchmark_extract_mean(hnc::benchmark const & b)
+	template <class clock_t>
+	std::map<std::string, long double> benchmark_extract_mean(hnc::benchmark_t<clock_t> const & b)
 	{
 		std::map<std::string, long double> r;
 		
@@ -239,12 +753,17 @@ namespace hnc
 	   @endcode
 	 */
 	typedef std::map<std::string, std::map<std::string, hnc::benchmark_base>> benchmark_name_opt;
+
+	/// @brief hnc::benchmark_name_opt with an other clock policy (see hnc::benchmark_clock)
+	template <class clock_t>
+	using benchmark_name_opt_t = std::map<std::string, std::map<std::string, hnc::benchmark_base_t<clock_t>>>;
 	
 	/// @brief Operator << between a std::ostream and a hnc::benchmark_name_opt
 	/// @param[in,out] o Output stream
 	/// @param[in]     b A hnc::benchmark_name_opt
 	/// @return the output stream
-	inline std::ostream & operator <<(std::ostream & o, hnc::benchmark_name_opt const & b)
+	template <class clock_t>
+	std::ostream & operator <<(std::ostream & o, hnc::benchmark_name_opt_t<clock_t> const & b)
 	{
 		for (auto const & t : b)
 		{
@@ -258,12 +777,28 @@ namespace hnc
 				auto const & value = t.second;
 				o << "\n";
 				o << "- " << key << ":" << "\n";
-				o << "  " << "- all:            " << hnc::ostreamable(value.all) << "\n";
+				if (value.is_streaming()) { o << "  " << "- size:           " << value.size() << "\n"; }
+				else { o << "  " << "- all:            " << hnc::ostreamable(value.all) << "\n"; }
 				o << "  " << "- min:            " << value.min() << "\n";
 				o << "  " << "- max:            " << value.max() << "\n";
 				o << "  " << "- median:         " << value.median() << "\n";
 				o << "  " << "- geometric mean: " << value.geometric_mean() << "\n";
 				o << "  " << "- mean:           " << value.mean();
+				for (auto const event : hnc::perf_counters::events())
+				{
+					if (value.has_perf_counter(event))
+					{
+						std::string const name = hnc::perf_counters::name(event) + ":";
+						o << "\n" << "  " << "- " << name << std::string((name.size() < 16) ? 16 - name.size() : 1, ' ') << value.perf_counter_mean(event);
+					}
+				}
+				if (value.has_allocation_tracker())
+				{
+					auto const allocations = value.allocations_mean();
+					o << "\n" << "  " << "- allocations:    " << allocations[0];
+					o << "\n" << "  " << "- allocated bytes: " << allocations[1];
+					o << "\n" << "  " << "- peak live bytes: " << allocations[2];
+				}
 			}
 			if (t.first != b.rbegin()->first) { o << "\n"; }
 		}
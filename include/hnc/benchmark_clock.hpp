@@ -0,0 +1,192 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_CLOCK_HPP
+#define HNC_BENCHMARK_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+	#define hnc_benchmark_clock_tsc
+#endif
+
+
+namespace hnc
+{
+	/**
+	 * @brief Clock policies for hnc::benchmark_base_t
+	 *
+	 * @code
+	   #include <hnc/benchmark.hpp>
+	   @endcode
+	 *
+	 * A clock policy is a class with:
+	 * - tick_t:                 the type of a tick count
+	 * - tick_t start():         the tick count before the measured code
+	 * - tick_t stop():          the tick count after the measured code
+	 * - long double ticks_per_second(): the number of ticks in one second
+	 * - tick_t overhead():      the number of ticks measured for an empty code (subtracted from each elapsed time)
+	 *
+	 * Available clock policies:
+	 * - hnc::benchmark_clock::steady: std::chrono::steady_clock (default, no overhead subtracted)
+	 * - hnc::benchmark_clock::tsc:    serialized time stamp counter (x86), calibrated against std::chrono::steady_clock
+	 */
+	namespace benchmark_clock
+	{
+		/**
+		 * @brief std::chrono::steady_clock policy
+		 *
+		 * @code
+		   #include <hnc/benchmark.hpp>
+		   @endcode
+		 *
+		 * A tick is a period of std::chrono::steady_clock (one nanosecond with GCC)
+		 */
+		class steady
+		{
+		public:
+
+			/// Tick count type
+			using tick_t = std::uint64_t;
+
+			/// @brief Return the tick count before the measured code
+			/// @return the tick count before the measured code
+			static tick_t start() { return tick_t(std::chrono::steady_clock::now().time_since_epoch().count()); }
+
+			/// @brief Return the tick count after the measured code
+			/// @return the tick count after the measured code
+			static tick_t stop() { return tick_t(std::chrono::steady_clock::now().time_since_epoch().count()); }
+
+			/// @brief Return the number of ticks in one second
+			/// @return the number of ticks in one second
+			static long double ticks_per_second()
+			{
+				return (long double)(std::chrono::steady_clock::period::den) / (long double)(std::chrono::steady_clock::period::num);
+			}
+
+			/// @brief Return the overhead (0, nothing is subtracted)
+			/// @return the overhead
+			static tick_t overhead() { return 0; }
+		};
+
+		/**
+		 * @brief Time stamp counter policy (cycle-accurate, low overhead)
+		 *
+		 * @code
+		   #include <hnc/benchmark.hpp>
+		   @endcode
+		 *
+		 * start() is lfence + rdtsc, stop() is rdtscp + lfence, so the measured code can not be reordered outside the measure @n
+		 * The frequency of the counter is calibrated against std::chrono::steady_clock at the first use,
+		 * the overhead (minimum of empty measures) is measured at the first use too
+		 *
+		 * @warning The time stamp counter must be invariant (constant_tsc and nonstop_tsc in /proc/cpuinfo), this is the case for recent x86 processors @n
+		 * On non-x86 processors, hnc::benchmark_clock::tsc uses std::chrono::steady_clock
+		 */
+		class tsc
+		{
+		public:
+
+			/// Tick count type
+			using tick_t = std::uint64_t;
+
+			/// @brief Return the tick count before the measured code
+			/// @return the tick count before the measured code
+			static tick_t start()
+			{
+				#ifdef hnc_benchmark_clock_tsc
+					_mm_lfence();
+					tick_t const r = __rdtsc();
+					_mm_lfence();
+					return r;
+				#else
+					return hnc::benchmark_clock::steady::start();
+				#endif
+			}
+
+			/// @brief Return the tick count after the measured code
+			/// @return the tick count after the measured code
+			static tick_t stop()
+			{
+				#ifdef hnc_benchmark_clock_tsc
+					unsigned int aux;
+					tick_t const r = __rdtscp(&aux);
+					_mm_lfence();
+					return r;
+				#else
+					return hnc::benchmark_clock::steady::stop();
+				#endif
+			}
+
+			/// @brief Return the number of ticks in one second (calibrated at the first call)
+			/// @return the number of ticks in one second
+			static long double ticks_per_second()
+			{
+				static long double const r = calibrate();
+				return r;
+			}
+
+			/// @brief Return the overhead of a start/stop (measured at the first call)
+			/// @return the overhead of a start/stop
+			static tick_t overhead()
+			{
+				static tick_t const r = measure_overhead();
+				return r;
+			}
+
+		private:
+
+			/// @brief Calibrate the counter against std::chrono::steady_clock (during 20 ms)
+			/// @return the number of ticks in one second
+			static long double calibrate()
+			{
+				#ifdef hnc_benchmark_clock_tsc
+					auto const t0 = std::chrono::steady_clock::now();
+					tick_t const tick0 = start();
+					auto t1 = t0;
+					while (t1 - t0 < std::chrono::milliseconds(20)) { t1 = std::chrono::steady_clock::now(); }
+					tick_t const tick1 = stop();
+					long double const s = std::chrono::duration_cast<std::chrono::duration<long double>>(t1 - t0).count();
+					return (long double)(tick1 - tick0) / s;
+				#else
+					return hnc::benchmark_clock::steady::ticks_per_second();
+				#endif
+			}
+
+			/// @brief Measure the overhead of a start/stop (minimum of 1000 empty measures)
+			/// @return the overhead of a start/stop
+			static tick_t measure_overhead()
+			{
+				tick_t r = std::numeric_limits<tick_t>::max();
+				for (std::size_t i = 0; i < 1000; ++i)
+				{
+					tick_t const tick0 = start();
+					tick_t const tick1 = stop();
+					r = std::min(r, tick1 - tick0);
+				}
+				return r;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,250 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_COMPARE_HPP
+#define HNC_BENCHMARK_COMPARE_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "benchmark.hpp"
+#include "benchmark_io.hpp"
+#include "math/mann_whitney_u.hpp"
+#include "tabular.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Comparison of a benchmark with its baseline
+	 *
+	 * @code
+	   #include <hnc/benchmark_compare.hpp>
+	   @endcode
+	 */
+	class benchmark_comparison
+	{
+	public:
+
+		/// Median of the baseline
+		long double baseline_median;
+
+		/// Median
+		long double median;
+
+		/// Relative change of the median ((median - baseline median) / baseline median, > 0 is slower)
+		long double relative_change;
+
+		/// Two-sided p-value of the Mann-Whitney U test on the elapsed times (1 if the comparison is not testable)
+		long double p_value;
+
+		/// The difference is statistically significant (p-value < alpha, always false if the comparison is not testable)
+		bool significant;
+
+		/// The Mann-Whitney U test was done: the baseline and the benchmark have at least 2 elapsed times in .all @n
+		/// (false if one of them is in streaming mode, or was reloaded from a streaming benchmark with only its median)
+		bool testable;
+
+		/// @brief Return true if the benchmark is significantly slower than its baseline by more than a threshold
+		/// @param[in] threshold Minimal relative change (0.05 by default, 5%)
+		/// @return true if the benchmark is significantly slower than its baseline by more than the threshold
+		bool is_regression(long double const threshold = 0.05L) const { return significant && relative_change > threshold; }
+
+		/// @brief Return true if the benchmark is significantly faster than its baseline by more than a threshold
+		/// @param[in] threshold Minimal relative change (0.05 by default, 5%)
+		/// @return true if the benchmark is significantly faster than its baseline by more than the threshold
+		bool is_improvement(long double const threshold = 0.05L) const { return significant && relative_change < -threshold; }
+	};
+
+	/**
+	 * @brief Compare a benchmark_base with its baseline
+	 *
+	 * The Mann-Whitney U test needs the elapsed times: if the baseline or the benchmark is in streaming mode (.all is empty),
+	 * only the medians are compared, the comparison is not testable (testable is false) and it is never a regression or an improvement
+	 *
+	 * @param[in] baseline A hnc::benchmark_base_t (the baseline)
+	 * @param[in] bench    A hnc::benchmark_base_t
+	 * @param[in] alpha    Significance level (0.05 by default)
+	 *
+	 * @return the comparison
+	 */
+	template <class clock_0_t, class clock_1_t>
+	hnc::benchmark_comparison benchmark_compare
+	(
+		hnc::benchmark_base_t<clock_0_t> const & baseline,
+		hnc::benchmark_base_t<clock_1_t> const & bench,
+		long double const alpha = 0.05L
+	)
+	{
+		hnc::benchmark_comparison r;
+		r.baseline_median = baseline.median();
+		r.median = bench.median();
+		r.relative_change = (r.baseline_median > 0) ? (r.median - r.baseline_median) / r.baseline_median : 0;
+		r.testable = baseline.all.size() >= 2 && bench.all.size() >= 2;
+		r.p_value = (r.testable) ? hnc::math::mann_whitney_u(baseline.all, bench.all).p_value : 1;
+		r.significant = r.testable && r.p_value < alpha;
+		return r;
+	}
+
+	/**
+	 * @brief Compare a hnc::benchmark with its baseline
+	 *
+	 * @code
+	   #include <hnc/benchmark_compare.hpp>
+	   @endcode
+	 *
+	 * For each test in the baseline and in the benchmark, the relative change of the median is computed and
+	 * the Mann-Whitney U test (see hnc::math::mann_whitney_u) says if the difference is significant or just noise @n
+	 * The tests in streaming mode are not testable (see hnc::benchmark_comparison::testable), use hnc::benchmark_has_not_testable to detect them
+	 *
+	 * @code
+	   hnc::benchmark const baseline = hnc::benchmark_load("baseline.json");
+	   auto const comparisons = hnc::benchmark_compare(baseline, b);
+	   std::cout << hnc::benchmark_comparison_tabular(comparisons, "Comparison with the baseline") << std::endl;
+	   if (hnc::benchmark_has_regression(comparisons)) { return 1; }
+	   @endcode
+	 *
+	 * @param[in] baseline A hnc::benchmark (the baseline)
+	 * @param[in] b        A hnc::benchmark
+	 * @param[in] alpha    Significance level (0.05 by default)
+	 *
+	 * @return the comparisons by test
+	 */
+	template <class clock_0_t, class clock_1_t>
+	std::map<std::string, hnc::benchmark_comparison> benchmark_compare
+	(
+		hnc::benchmark_t<clock_0_t> const & baseline,
+		hnc::benchmark_t<clock_1_t> const & b,
+		long double const alpha = 0.05L
+	)
+	{
+		std::map<std::string, hnc::benchmark_comparison> r;
+		for (auto const & name_bench : b)
+		{
+			auto const it = baseline.find(name_bench.first);
+			if (it == baseline.end() || it->second.size() == 0 || name_bench.second.size() == 0) { continue; }
+			r[name_bench.first] = hnc::benchmark_compare(it->second, name_bench.second, alpha);
+		}
+		return r;
+	}
+
+	/// @brief Compare a hnc::benchmark_name_opt with its baseline (the keys of the result are "name[option]")
+	/// @param[in] baseline A hnc::benchmark_name_opt (the baseline)
+	/// @param[in] b        A hnc::benchmark_name_opt
+	/// @param[in] alpha    Significance level (0.05 by default)
+	/// @return the comparisons by test
+	template <class clock_0_t, class clock_1_t>
+	std::map<std::string, hnc::benchmark_comparison> benchmark_compare
+	(
+		hnc::benchmark_name_opt_t<clock_0_t> const & baseline,
+		hnc::benchmark_name_opt_t<clock_1_t> const & b,
+		long double const alpha = 0.05L
+	)
+	{
+		std::map<std::string, hnc::benchmark_comparison> r;
+		for (auto const & name_opts : b)
+		{
+			auto const it = baseline.find(name_opts.first);
+			if (it == baseline.end()) { continue; }
+			for (auto const & comparison : hnc::benchmark_compare(it->second, name_opts.second, alpha))
+			{
+				r[name_opts.first + "[" + comparison.first + "]"] = comparison.second;
+			}
+		}
+		return r;
+	}
+
+	/// @brief Compare a hnc::benchmark with a baseline file (JSON or CSV, see hnc::benchmark_load)
+	/// @param[in] baseline_filename Filename of the baseline
+	/// @param[in] b                 A hnc::benchmark
+	/// @param[in] alpha             Significance level (0.05 by default)
+	/// @return the comparisons by test
+	template <class clock_t>
+	std::map<std::string, hnc::benchmark_comparison> benchmark_compare
+	(
+		std::string const & baseline_filename,
+		hnc::benchmark_t<clock_t> const & b,
+		long double const alpha = 0.05L
+	)
+	{
+		return hnc::benchmark_compare(hnc::benchmark_load(baseline_filename), b, alpha);
+	}
+
+	/// @brief Return true if a test is significantly slower than its baseline by more than a threshold
+	/// @param[in] comparisons Comparisons by test
+	/// @param[in] threshold   Minimal relative change (0.05 by default, 5%)
+	/// @return true if a test is significantly slower than its baseline by more than the threshold
+	inline bool benchmark_has_regression(std::map<std::string, hnc::benchmark_comparison> const & comparisons, long double const threshold = 0.05L)
+	{
+		for (auto const & comparison : comparisons) { if (comparison.second.is_regression(threshold)) { return true; } }
+		return false;
+	}
+
+	/// @brief Return true if a comparison is not testable (see hnc::benchmark_comparison::testable)
+	/// @param[in] comparisons Comparisons by test
+	/// @return true if a comparison is not testable, false otherwise
+	inline bool benchmark_has_not_testable(std::map<std::string, hnc::benchmark_comparison> const & comparisons)
+	{
+		for (auto const & comparison : comparisons) { if (comparison.second.testable == false) { return true; } }
+		return false;
+	}
+
+	/**
+	 * @brief Return a tabular with the comparisons
+	 *
+	 * @code
+	   #include <hnc/benchmark_compare.hpp>
+	   @endcode
+	 *
+	 * One row by test: baseline median, median, relative change (in %), p-value and verdict ("slower", "faster", "same" or "not testable")
+	 *
+	 * @param[in] comparisons Comparisons by test
+	 * @param[in] title       Title of the tabular
+	 * @param[in] threshold   Minimal relative change for "slower" and "faster" (0.05 by default, 5%)
+	 *
+	 * @return a tabular with the comparisons
+	 */
+	inline hnc::tabular benchmark_comparison_tabular
+	(
+		std::map<std::string, hnc::benchmark_comparison> const & comparisons,
+		std::string const & title,
+		long double const threshold = 0.05L
+	)
+	{
+		std::vector<std::string> const header = { "", "baseline median", "median", "change (%)", "p-value", "verdict" };
+		std::vector<std::vector<std::string>> data;
+		for (auto const & comparison : comparisons)
+		{
+			auto const & c = comparison.second;
+			data.push_back
+			({
+				comparison.first,
+				hnc::to_string(c.baseline_median),
+				hnc::to_string(c.median),
+				hnc::to_string(100 * c.relative_change),
+				(c.testable) ? hnc::to_string(c.p_value) : "-",
+				(c.testable == false) ? "not testable" : (c.is_regression(threshold) ? "slower" : (c.is_improvement(threshold) ? "faster" : "same"))
+			});
+		}
+		return hnc::tabular(data, title, header);
+	}
+}
+
+#endif
@@ -0,0 +1,216 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_COMPLEXITY_HPP
+#define HNC_BENCHMARK_COMPLEXITY_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+
+
+namespace hnc
+{
+	/**
+	 * @brief Complexity models
+	 *
+	 * @code
+	   #include <hnc/benchmark_complexity.hpp>
+	   @endcode
+	 */
+	enum class complexity_t
+	{
+		/// O(1)
+		o_1,
+		/// O(log n)
+		o_log_n,
+		/// O(n)
+		o_n,
+		/// O(n log n)
+		o_n_log_n,
+		/// O(n²)
+		o_n2
+	};
+
+	/// @brief Return all complexity models
+	/// @return all complexity models (from the lowest to the highest)
+	inline std::vector<hnc::complexity_t> complexities()
+	{
+		return
+		{
+			hnc::complexity_t::o_1,
+			hnc::complexity_t::o_log_n,
+			hnc::complexity_t::o_n,
+			hnc::complexity_t::o_n_log_n,
+			hnc::complexity_t::o_n2
+		};
+	}
+
+	/// @brief Return the name of a complexity model
+	/// @param[in] complexity A complexity model
+	/// @return the name of a complexity model ("O(1)", "O(log n)", "O(n)", "O(n log n)", "O(n^2)")
+	inline std::string to_string(hnc::complexity_t const complexity)
+	{
+		switch (complexity)
+		{
+			case hnc::complexity_t::o_1:       return "O(1)";
+			case hnc::complexity_t::o_log_n:   return "O(log n)";
+			case hnc::complexity_t::o_n:       return "O(n)";
+			case hnc::complexity_t::o_n_log_n: return "O(n log n)";
+			case hnc::complexity_t::o_n2:      return "O(n^2)";
+		}
+		return "";
+	}
+
+	/// @brief Operator << between a std::ostream and a hnc::complexity_t
+	/// @param[in,out] o          Output stream
+	/// @param[in]     complexity A complexity model
+	/// @return the output stream
+	inline std::ostream & operator <<(std::ostream & o, hnc::complexity_t const complexity)
+	{
+		return o << hnc::to_string(complexity);
+	}
+
+	/// @brief Return the value of the function of a complexity model
+	/// @param[in] complexity A complexity model
+	/// @param[in] n          Size
+	/// @return the value of the function of a complexity model (1, log2(n), n, n log2(n), n²)
+	inline long double complexity_function(hnc::complexity_t const complexity, long double const n)
+	{
+		switch (complexity)
+		{
+			case hnc::complexity_t::o_1:       return 1;
+			case hnc::complexity_t::o_log_n:   return std::log2(n);
+			case hnc::complexity_t::o_n:       return n;
+			case hnc::complexity_t::o_n_log_n: return n * std::log2(n);
+			case hnc::complexity_t::o_n2:      return n * n;
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief Fit of times to a complexity model
+	 *
+	 * @code
+	   #include <hnc/benchmark_complexity.hpp>
+	   @endcode
+	 *
+	 * The model is @f$ t(n) = c \times f(n) @f$ @n
+	 * The sizes are often a geometric range, so the coefficient @f$ c @f$ minimizes the sum of squares of the relative errors
+	 * (each size has the same weight) @n
+	 * The goodness of fit is the relative root mean square error (lower is better):
+	 * @f$ \text{rms} = \sqrt{\frac{1}{k} \sum \left(\frac{t_i - c \times f(n_i)}{t_i}\right)^2} @f$
+	 */
+	class complexity_fit
+	{
+	public:
+
+		/// Complexity model
+		hnc::complexity_t complexity;
+
+		/// Coefficient
+		long double coefficient;
+
+		/// Relative root mean square error
+		long double rms;
+
+		/// @brief Return the time predicted by the model
+		/// @param[in] n Size
+		/// @return the time predicted by the model
+		long double operator ()(long double const n) const
+		{
+			return coefficient * hnc::complexity_function(complexity, n);
+		}
+	};
+
+	/**
+	 * @brief Fit times (by size) to all complexity models
+	 *
+	 * @code
+	   #include <hnc/benchmark_complexity.hpp>
+	   @endcode
+	 *
+	 * @code
+	   std::map<std::size_t, long double> times;
+	   for (std::size_t n = 2; n <= 1024; n *= 2) { times[n] = 1e-9 * n * n; }
+	   std::vector<hnc::complexity_fit> fits = hnc::benchmark_complexity_fits(times);
+	   std::cout << hnc::benchmark_complexity_best_fit(times).complexity << std::endl; // O(n^2)
+	   @endcode
+	 *
+	 * @param[in] times Times by size (at least two sizes for a meaningful fit, times <= 0 are ignored)
+	 *
+	 * @return the fits in the order of hnc::complexities()
+	 */
+	inline std::vector<hnc::complexity_fit> benchmark_complexity_fits(std::map<std::size_t, long double> const & times)
+	{
+		std::vector<hnc::complexity_fit> r;
+
+		for (auto const complexity : hnc::complexities())
+		{
+			// Least squares of the relative errors
+			long double sum_x = 0;
+			long double sum_xx = 0;
+			std::size_t nb = 0;
+			for (auto const & n_time : times)
+			{
+				if (n_time.second <= 0) { continue; }
+				long double const x = hnc::complexity_function(complexity, (long double)(n_time.first)) / n_time.second;
+				sum_x += x;
+				sum_xx += x * x;
+				++nb;
+			}
+
+			hnc::complexity_fit fit;
+			fit.complexity = complexity;
+			fit.coefficient = (sum_xx > 0) ? sum_x / sum_xx : 0;
+
+			// Relative root mean square error
+			long double sum_error = 0;
+			for (auto const & n_time : times)
+			{
+				if (n_time.second <= 0) { continue; }
+				long double const error = (n_time.second - fit((long double)(n_time.first))) / n_time.second;
+				sum_error += error * error;
+			}
+			fit.rms = (nb == 0) ? std::numeric_limits<long double>::max() : std::sqrt(sum_error / (long double)(nb));
+
+			r.push_back(fit);
+		}
+
+		return r;
+	}
+
+	/// @brief Return the complexity model which fits the best times (by size)
+	/// @param[in] times Times by size
+	/// @return the fit with the lowest relative root mean square error
+	inline hnc::complexity_fit benchmark_complexity_best_fit(std::map<std::size_t, long double> const & times)
+	{
+		std::vector<hnc::complexity_fit> const fits = hnc::benchmark_complexity_fits(times);
+		return *std::min_element
+		(
+			fits.begin(), fits.end(),
+			[](hnc::complexity_fit const & a, hnc::complexity_fit const & b) -> bool { return a.rms < b.rms; }
+		);
+	}
+}
+
+#endif
@@ -22,14 +22,237 @@
 #include <vector>
 #include <functional>
 #include <algorithm>
+#include <map>
+#include <random>
+#include <tuple>
 
 #include "benchmark.hpp"
+#include "benchmark_policy.hpp"
 #include "gnuplot.hpp"
 #include "tabular.hpp"
+#include "to_string.hpp"
 
 
 namespace hnc
 {
+	/**
+	 * @brief Return the number of iterations of a function such that a batch takes at least min_sample_time seconds
+	 *
+	 * @code
+	   #include <hnc/benchmark_functions.hpp>
+	   @endcode
+	 *
+	 * The number of iterations starts at 1 and grows (by a factor estimated from the last batch, at most 10)
+	 * until the batch takes at least min_sample_time seconds
+	 *
+	 * @code
+	   std::size_t const nb_iteration = hnc::benchmark_calibrate([&]() -> void { hnc::do_not_optimize(std::sqrt(x)); }, 0.01);
+	   b["sqrt"].start();
+	   for (std::size_t i = 0; i < nb_iteration; ++i) { hnc::do_not_optimize(std::sqrt(x)); }
+	   b["sqrt"].stop(nb_iteration);
+	   @endcode
+	 *
+	 * @param[in] function        A function
+	 * @param[in] min_sample_time Minimal duration of a batch (in seconds)
+	 * @param[in] max_nb_iteration Maximal number of iterations (1e9 by default)
+	 *
+	 * @return the number of iterations
+	 */
+	inline std::size_t benchmark_calibrate
+	(
+		std::function<void()> const & function,
+		long double const min_sample_time,
+		std::size_t const max_nb_iteration = 1000000000
+	)
+	{
+		std::size_t nb_iteration = 1;
+		while (true)
+		{
+			hnc::benchmark_base b;
+			b.start();
+			for (std::size_t i = 0; i < nb_iteration; ++i) { function(); }
+			b.stop();
+			long double const time = b.all.back();
+
+			if (time >= min_sample_time || nb_iteration >= max_nb_iteration) { return nb_iteration; }
+
+			// Growth factor estimated from the last batch (10% margin), between 2 and 10
+			long double const factor = (time > 0) ? std::min(std::max(min_sample_time / time * 1.1L, 2.L), 10.L) : 10.L;
+			nb_iteration = std::min(std::size_t((long double)(nb_iteration) * factor), max_nb_iteration);
+		}
+	}
+
+	/**
+	 * @brief Performs a benchmark with some functions, with an execution policy
+	 *
+	 * @code
+	   #include <hnc/benchmark_functions.hpp>
+	   @endcode
+	 *
+	 * Same as hnc::benchmark_functions without policy, the versions are run with the execution policy:
+	 * shuffled order at each run (warmup runs included), warmup runs, CPU pinning (see hnc::benchmark_policy)
+	 *
+	 * @code
+	   auto benchmark_functions = hnc::benchmark_functions
+	   (
+	   	hnc::benchmark_policy().set_shuffle().set_nb_warmup_run(2).set_cpu(0),
+	   	versions, "Title", "hnc_benchmark_functions_gnuplot", 10
+	   );
+	   // Policy used (with the seed of the shuffle)
+	   std::cout << std::get<3>(benchmark_functions) << std::endl;
+	   @endcode
+	 *
+	 * @param[in] policy                  Execution policy
+	 * @param[in] versions_with_name      A std::vector of { function, name }
+	 * @param[in] title                   Title for Gnuplot and tabular
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 * @param[in] nb_run                  Number of runs for each version
+	 * @param[in] x_label                 Gnuplot x label ("Versions" by default)
+	 * @param[in] y_label                 Gnuplot y label ("Time (in second)" by default)
+	 * @param[in] perf_counters           Record the hardware performance counters (false by default, ignored if they are not available)
+	 * @param[in] min_sample_time         If > 0, each sample is a batch of iterations which takes at least min_sample_time seconds
+	 *                                    (see hnc::benchmark_calibrate) and the time of one iteration is saved (0 by default, one call per sample)
+	 *
+	 * @return the benchmark with all times, the gnuplot and the tabular with the median times,
+	 * and the policy used (seed chosen, CPU is -1 if the pinning failed)
+	 */
+	inline std::tuple
+	<
+		hnc::benchmark,
+		hnc::gnuplot::gnuplot_boxes,
+		hnc::tabular,
+		hnc::benchmark_policy
+	>
+	benchmark_functions
+	(
+		hnc::benchmark_policy const & policy,
+		std::vector<std::pair<std::function<void()>, std::string>> const & versions_with_name,
+		std::string const & title,
+		std::string const & gnuplot_output_filename,
+		std::size_t const nb_run = 1,
+		std::string const & x_label = "Versions",
+		std::string const & y_label = "Time (in second)",
+		bool const perf_counters = false,
+		long double const min_sample_time = 0
+	)
+	{
+		// Benchmark
+		hnc::benchmark benchs;
+		
+		// Policy used
+		hnc::benchmark_policy policy_used = policy.with_seed();
+		
+		// CPU pinning
+		hnc::benchmark_cpu_pinning const pinning(policy.cpu());
+		if (pinning.pinned() == false) { policy_used.set_cpu(-1); }
+		
+		// Hardware performance counters
+		if (perf_counters)
+		{
+			for (auto const & version_with_name : versions_with_name)
+			{
+				benchs[version_with_name.second].set_perf_counters();
+			}
+		}
+		
+		// Number of iterations of each version
+		std::map<std::string, std::size_t> nb_iterations;
+		for (auto const & version_with_name : versions_with_name)
+		{
+			nb_iterations[version_with_name.second] =
+				(min_sample_time > 0) ? hnc::benchmark_calibrate(version_with_name.first, min_sample_time) : 1;
+		}
+		
+		// Order of the versions
+		std::vector<std::size_t> order(versions_with_name.size());
+		for (std::size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+		std::default_random_engine random_engine(policy_used.seed());
+		
+		// Warmup runs (shuffled like the runs, so each version is warmed up in the same conditions)
+		for (std::size_t run = 0; run < policy.nb_warmup_run(); ++run)
+		{
+			if (policy.shuffle()) { std::shuffle(order.begin(), order.end(), random_engine); }
+			for (std::size_t const v : order)
+			{
+				auto const & version_with_name = versions_with_name[v];
+				std::size_t const nb_iteration = nb_iterations[version_with_name.second];
+				for (std::size_t i = 0; i < nb_iteration; ++i) { version_with_name.first(); }
+			}
+		}
+		
+		// Runs
+		for (std::size_t run = 0; run < nb_run; ++run)
+		{
+			if (policy.shuffle()) { std::shuffle(order.begin(), order.end(), random_engine); }
+			
+			// Versions
+			for (std::size_t const v : order)
+			{
+				auto const & version_with_name = versions_with_name[v];
+				auto const & version = version_with_name.first;
+				auto const & name = version_with_name.second;
+				// Get benchmark
+				auto & bench = benchs[name];
+				// Run
+				std::size_t const nb_iteration = nb_iterations[name];
+				bench.start();
+				for (std::size_t i = 0; i < nb_iteration; ++i) { version(); }
+				bench.stop(nb_iteration);
+			}
+		}
+
+		// Extract mean
+		std::map<std::string, long double> benchs_mean = benchmark_extract_mean(benchs);
+
+		// Create the GNUPlot script
+		hnc::gnuplot::gnuplot_boxes gp
+		(
+			hnc::gnuplot::output_terminal_pdf(gnuplot_output_filename),
+			benchs_mean
+		);
+		gp.set_title(title);
+		gp.set_x_label(x_label);
+		gp.set_y_label(y_label);
+		gp.plot().no_title();
+
+		// Hardware performance counters recorded
+		std::vector<hnc::perf_counters::event_t> events;
+		for (auto const event : hnc::perf_counters::events())
+		{
+			if (benchs.empty() == false && benchs.begin()->second.has_perf_counter(event)) { events.push_back(event); }
+		}
+		
+		// Create data for tabular
+		std::vector<std::vector<std::string>> tabular_data(1);
+		std::vector<std::string> tabular_header;
+		if (events.empty() == false)
+		{
+			tabular_header.push_back("");
+			tabular_data[0].push_back("time");
+		}
+		for (auto const & bench_mean : benchs_mean)
+		{
+			tabular_header.push_back(bench_mean.first);
+			tabular_data[0].push_back(hnc::to_string(bench_mean.second));
+		}
+		
+		// Add hardware performance counters in tabular
+		for (auto const event : events)
+		{
+			tabular_data.emplace_back(1, hnc::perf_counters::name(event));
+			for (auto const & bench : benchs)
+			{
+				tabular_data.back().push_back(hnc::to_string(bench.second.perf_counter_mean(event)));
+			}
+		}
+		
+		// Create the tabular LaTeX
+		hnc::tabular tabular(tabular_data, title, tabular_header);
+
+		// Return
+		return std::make_tuple(benchs, gp, tabular, policy_used);
+	}
+
 	/**
 	 * @brief Performs a benchmark with some functions
 	 * 
@@ -41,6 +264,7 @@ namespace hnc
 	 * - raw times in a hnc::benchmark
 	 * - a Gnuplot image with the median of times for each versions in a hnc::gnuplot::gnuplot_boxes
 	 * - a tabular with the median of times for each versions in a hnc::tabular
+	 *   (and the mean of the hardware performance counters if perf_counters is true, see hnc::perf_counters)
 	 *
 	 * @param[in] versions_with_name      A std::vector of { function, name }
 	 * @param[in] title                   Title for Gnuplot and tabular
@@ -48,6 +272,14 @@ namespace hnc
 	 * @param[in] nb_run                  Number of runs for each version
 	 * @param[in] x_label                 Gnuplot x label ("Versions" by default)
 	 * @param[in] y_label                 Gnuplot y label ("Time (in second)" by default)
+	 * @param[in] perf_counters           Record the hardware performance counters (false by default, ignored if they are not available)
+	 * @param[in] min_sample_time         If > 0, each sample is a batch of iterations which takes at least min_sample_time seconds
+	 *                                    (see hnc::benchmark_calibrate) and the time of one iteration is saved (0 by default, one call per sample)
+	 *
+	 * For functions shorter than the clock resolution, use min_sample_time and hnc::do_not_optimize/hnc::clobber_memory in the functions
+	 *
+	 * The versions are run in the given order at each run, which favours the versions run after
+	 * (frequency scaling, cache, allocator); prefer a shuffled order with some warmup runs (see the overload with a hnc::benchmark_policy)
 	 *
 	 * Example:
 	 * @code
@@ -105,9 +337,9 @@ namespace hnc
 	   // ---------------------------------------------------------------------------------------------------
 	   @endcode
 	 * 
-	 * @return the benchmark with all times, the gnuplot and the tabular with the median times 
+	 * @return the benchmark with all times, the gnuplot and the tabular with the median times
 	 */
-	std::tuple
+	inline std::tuple
 	<
 		hnc::benchmark,
 		hnc::gnuplot::gnuplot_boxes,
@@ -120,57 +352,17 @@ namespace hnc
 		std::string const & gnuplot_output_filename,
 		std::size_t const nb_run = 1,
 		std::string const & x_label = "Versions",
-		std::string const & y_label = "Time (in second)"
+		std::string const & y_label = "Time (in second)",
+		bool const perf_counters = false,
+		long double const min_sample_time = 0
 	)
 	{
-		// Benchmark
-		hnc::benchmark benchs;
-		
-		// Runs
-		for (std::size_t run = 0; run < nb_run; ++run)
-		{
-			// Versions
-			for (auto const & version_with_name : versions_with_name)
-			{
-				auto const & version = version_with_name.first;
-				auto const & name = version_with_name.second;
-				// Get benchmark
-				auto & bench = benchs[name];
-				// Run
-				bench.start();
-				version();
-				bench.stop();
-			}
-		}
-
-		// Extract mean
-		std::map<std::string, long double> benchs_mean = benchmark_extract_mean(benchs);
-
-		// Create the GNUPlot script
-		hnc::gnuplot::gnuplot_boxes gp
+		auto r = hnc::benchmark_functions
 		(
-			hnc::gnuplot::output_terminal_pdf(gnuplot_output_filename),
-			benchs_mean
+			hnc::benchmark_policy(),
+			versions_with_name, title, gnuplot_output_filename, nb_run, x_label, y_label, perf_counters, min_sample_time
 		);
-		gp.set_title(title);
-		gp.set_x_label(x_label);
-		gp.set_y_label(y_label);
-		gp.plot().no_title();
-
-		// Create data for tabular
-		std::vector<std::vector<long double>> tabular_data(1);
-		std::vector<std::string> tabular_header;
-		for (auto const & bench_mean : benchs_mean)
-		{
-			tabular_header.push_back(bench_mean.first);
-			tabular_data[0].push_back(bench_mean.second);
-		}
-		
-		// Create the tabular LaTeX
-		hnc::tabular tabular(tabular_data, title, tabular_header);
-
-		// Return
-		return std::make_tuple(benchs, gp, tabular);
+		return std::make_tuple(std::move(std::get<0>(r)), std::move(std::get<1>(r)), std::move(std::get<2>(r)));
 	}
 }
 
@@ -0,0 +1,267 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_HISTOGRAM_HPP
+#define HNC_BENCHMARK_HISTOGRAM_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <sstream>
+#include <iomanip>
+
+#include "benchmark.hpp"
+#include "math/hdr_histogram.hpp"
+#include "gnuplot.hpp"
+#include "tabular.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/// @brief Return the percentiles of the percentile tabulars: 50, 90, 99, 99.9, 99.99 and 100
+	/// @return the percentiles of the percentile tabulars
+	inline std::vector<double> benchmark_percentiles()
+	{
+		return { 50., 90., 99., 99.9, 99.99, 100. };
+	}
+
+	/// @brief Return the percentiles of the percentile distribution plots: 0, 10, ..., 90, 99, 99.9, 99.99, 99.999 and 100
+	/// @return the percentiles of the percentile distribution plots
+	inline std::vector<double> benchmark_cdf_percentiles()
+	{
+		return { 0., 10., 20., 30., 40., 50., 60., 70., 80., 90., 99., 99.9, 99.99, 99.999, 100. };
+	}
+
+	/// @brief Return a percentile as a key of a std::map (padded with spaces to keep the std::map sorted)
+	/// @param[in] percentile Percentile in [0, 100]
+	/// @return the percentile as a key
+	inline std::string benchmark_percentile_key(double const percentile)
+	{
+		std::ostringstream o;
+		o << std::fixed << std::setprecision(3) << std::setw(7) << percentile;
+		return o.str();
+	}
+
+	/// @brief Return the name of a percentile ("p50", "p99.9", ...)
+	/// @param[in] percentile Percentile in [0, 100]
+	/// @return the name of the percentile
+	inline std::string benchmark_percentile_name(double const percentile)
+	{
+		std::ostringstream o;
+		o << "p" << percentile;
+		return o.str();
+	}
+
+	/**
+	 * @brief Return a tabular with the percentiles of histograms
+	 *
+	 * @code
+	   #include <hnc/benchmark_histogram.hpp>
+	   @endcode
+	 *
+	 * One row by histogram, one column by percentile ("p50", "p99.9", ...) plus "max" and "count"
+	 *
+	 * @param[in] histograms  Histograms by name
+	 * @param[in] title       Title of the tabular
+	 * @param[in] percentiles Percentiles in [0, 100] (see hnc::benchmark_percentiles)
+	 * @param[in] unit        The values of the histograms are multiplied by the unit (1 by default, 1e-9 for nanoseconds to seconds)
+	 *
+	 * @return a tabular with the percentiles
+	 */
+	inline hnc::tabular hdr_histogram_tabular
+	(
+		std::map<std::string, hnc::math::hdr_histogram> const & histograms,
+		std::string const & title,
+		std::vector<double> const & percentiles = hnc::benchmark_percentiles(),
+		long double const unit = 1
+	)
+	{
+		std::vector<std::string> header(1, "");
+		for (double const p : percentiles) { header.push_back(hnc::benchmark_percentile_name(p)); }
+		header.push_back("max");
+		header.push_back("count");
+		std::vector<std::vector<std::string>> data;
+		for (auto const & name_histogram : histograms)
+		{
+			auto const & h = name_histogram.second;
+			data.emplace_back(1, name_histogram.first);
+			for (double const p : percentiles)
+			{
+				data.back().push_back((h.empty()) ? "" : hnc::to_string((long double)(h.value_at_percentile(p)) * unit));
+			}
+			data.back().push_back((h.empty()) ? "" : hnc::to_string((long double)(h.max()) * unit));
+			data.back().push_back(hnc::to_string(h.size()));
+		}
+		return hnc::tabular(data, title, header);
+	}
+
+	/**
+	 * @brief Return a Gnuplot with the percentile distribution (inverse cumulative distribution function) of histograms
+	 *
+	 * @code
+	   #include <hnc/benchmark_histogram.hpp>
+	   @endcode
+	 *
+	 * The x tics are the percentiles of hnc::benchmark_cdf_percentiles (the tail, 99 to 100, is spread like in HdrHistogram plots),
+	 * one line by histogram
+	 *
+	 * @param[in] histograms              Histograms by name
+	 * @param[in] title                   Title of the Gnuplot
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 * @param[in] unit                    The values of the histograms are multiplied by the unit (1 by default, 1e-9 for nanoseconds to seconds)
+	 * @param[in] y_label                 Label of the y axis ("Value" by default)
+	 *
+	 * @return the Gnuplot
+	 */
+	inline hnc::gnuplot::gnuplot_lines hdr_histogram_gnuplot
+	(
+		std::map<std::string, hnc::math::hdr_histogram> const & histograms,
+		std::string const & title,
+		std::string const & gnuplot_output_filename,
+		long double const unit = 1,
+		std::string const & y_label = "Value"
+	)
+	{
+		hnc::gnuplot::output_terminal_pdf const output_terminal(gnuplot_output_filename);
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label("Percentile");
+		gp.set_y_label(y_label);
+		for (auto const & name_histogram : histograms)
+		{
+			auto const & h = name_histogram.second;
+			if (h.empty()) { continue; }
+			std::map<std::string, long double> data;
+			for (double const p : hnc::benchmark_cdf_percentiles())
+			{
+				data[hnc::benchmark_percentile_key(p)] = (long double)(h.value_at_percentile(p)) * unit;
+			}
+			gp.add_line(data, name_histogram.first);
+		}
+		return gp;
+	}
+
+	/// @brief Return the histograms of the tests in histogram mode (see hnc::benchmark_base_t::set_histogram)
+	/// @param[in] b A hnc::benchmark
+	/// @return the histograms (in nanoseconds) by test
+	template <class clock_t>
+	std::map<std::string, hnc::math::hdr_histogram> benchmark_histograms(hnc::benchmark_t<clock_t> const & b)
+	{
+		std::map<std::string, hnc::math::hdr_histogram> r;
+		for (auto const & name_bench : b)
+		{
+			if (name_bench.second.has_histogram()) { r[name_bench.first] = name_bench.second.histogram(); }
+		}
+		return r;
+	}
+
+	/**
+	 * @brief Return a tabular with the percentiles of the elapsed times (in seconds) of a benchmark
+	 *
+	 * @code
+	   #include <hnc/benchmark_histogram.hpp>
+	   @endcode
+	 *
+	 * The percentiles come from hnc::benchmark_base_t::quantile, so all modes are supported
+	 * (exact, streaming or histogram, see hnc::benchmark_base_t::set_histogram)
+	 *
+	 * @code
+	   hnc::benchmark b;
+	   b["Request"].set_histogram();
+	   // start/stop
+	   std::cout << hnc::benchmark_percentile_tabular(b, "Latencies (s)") << std::endl;
+	   @endcode
+	 *
+	 * @param[in] b           A hnc::benchmark
+	 * @param[in] title       Title of the tabular
+	 * @param[in] percentiles Percentiles in [0, 100] (see hnc::benchmark_percentiles)
+	 *
+	 * @return a tabular with the percentiles
+	 */
+	template <class clock_t>
+	hnc::tabular benchmark_percentile_tabular
+	(
+		hnc::benchmark_t<clock_t> const & b,
+		std::string const & title,
+		std::vector<double> const & percentiles = hnc::benchmark_percentiles()
+	)
+	{
+		std::vector<std::string> header(1, "");
+		for (double const p : percentiles) { header.push_back(hnc::benchmark_percentile_name(p)); }
+		header.push_back("max");
+		header.push_back("count");
+		std::vector<std::vector<std::string>> data;
+		for (auto const & name_bench : b)
+		{
+			auto const & bench = name_bench.second;
+			data.emplace_back(1, name_bench.first);
+			for (double const p : percentiles)
+			{
+				data.back().push_back((bench.size() == 0) ? "" : hnc::to_string(bench.quantile(p / 100.)));
+			}
+			data.back().push_back((bench.size() == 0) ? "" : hnc::to_string(bench.max()));
+			data.back().push_back(hnc::to_string(bench.size()));
+		}
+		return hnc::tabular(data, title, header);
+	}
+
+	/**
+	 * @brief Return a Gnuplot with the percentile distribution of the elapsed times (in seconds) of a benchmark
+	 *
+	 * @code
+	   #include <hnc/benchmark_histogram.hpp>
+	   @endcode
+	 *
+	 * Same plot as hnc::hdr_histogram_gnuplot, with the percentiles from hnc::benchmark_base_t::quantile (all modes are supported)
+	 *
+	 * @param[in] b                       A hnc::benchmark
+	 * @param[in] title                   Title of the Gnuplot
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 *
+	 * @return the Gnuplot
+	 */
+	template <class clock_t>
+	hnc::gnuplot::gnuplot_lines benchmark_cdf_gnuplot
+	(
+		hnc::benchmark_t<clock_t> const & b,
+		std::string const & title,
+		std::string const & gnuplot_output_filename
+	)
+	{
+		hnc::gnuplot::output_terminal_pdf const output_terminal(gnuplot_output_filename);
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label("Percentile");
+		gp.set_y_label("Time (s)");
+		for (auto const & name_bench : b)
+		{
+			auto const & bench = name_bench.second;
+			if (bench.size() == 0) { continue; }
+			std::map<std::string, long double> data;
+			for (double const p : hnc::benchmark_cdf_percentiles())
+			{
+				data[hnc::benchmark_percentile_key(p)] = bench.quantile(p / 100.);
+			}
+			gp.add_line(data, name_bench.first);
+		}
+		return gp;
+	}
+}
+
+#endif
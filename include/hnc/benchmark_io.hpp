@@ -0,0 +1,727 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_IO_HPP
+#define HNC_BENCHMARK_IO_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "benchmark.hpp"
+#include "filesystem.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Internal functions of hnc/benchmark_io.hpp
+	 *
+	 * @code
+	   #include <hnc/benchmark_io.hpp>
+	   @endcode
+	 */
+	namespace benchmark_io
+	{
+		/// @brief Return a number with enough digits to be read back exactly (with the classic locale, the global locale is ignored)
+		/// @param[in] x A number
+		/// @return the number in a std::string
+		inline std::string number_string(long double const x)
+		{
+			std::ostringstream o;
+			o.imbue(std::locale::classic());
+			o << std::setprecision(std::numeric_limits<long double>::max_digits10) << x;
+			return o.str();
+		}
+
+		/// @brief Read a number written by hnc::benchmark_io::number_string (with the classic locale, the global and the C locales are ignored)
+		/// @param[in]  text   Text beginning with the number
+		/// @param[out] length Number of characters of the number (0 if the text does not begin with a number)
+		/// @return the number (0 if the text does not begin with a number)
+		inline long double string_number(char const * const text, std::size_t & length)
+		{
+			length = 0;
+			for (char c = text[0]; (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '+' || c == '-' || c == '.'; c = text[length])
+			{
+				++length;
+			}
+			std::string const token(text, length);
+			if (token == "inf" || token == "+inf") { return std::numeric_limits<long double>::infinity(); }
+			if (token == "-inf") { return -std::numeric_limits<long double>::infinity(); }
+			if (token == "nan" || token == "-nan") { return std::numeric_limits<long double>::quiet_NaN(); }
+			std::istringstream i(token);
+			i.imbue(std::locale::classic());
+			long double r = 0;
+			i >> r;
+			if (i.fail() || i.peek() != std::char_traits<char>::eof()) { length = 0; return 0; }
+			return r;
+		}
+
+		// JSON
+
+		/// @brief Return a JSON string (with quotes)
+		/// @param[in] s A std::string
+		/// @return the JSON string
+		inline std::string json_string(std::string const & s)
+		{
+			std::string r = "\"";
+			for (char const c : s)
+			{
+				if (c == '"') { r += "\\\""; }
+				else if (c == '\\') { r += "\\\\"; }
+				else if (c == '\n') { r += "\\n"; }
+				else if (c == '\t') { r += "\\t"; }
+				else if (c == '\r') { r += "\\r"; }
+				else if ((unsigned char)(c) < 0x20)
+				{
+					char const * const hex = "0123456789abcdef";
+					r += "\\u00";
+					r += hex[(unsigned char)(c) >> 4];
+					r += hex[(unsigned char)(c) & 0xf];
+				}
+				else { r += c; }
+			}
+			return r + "\"";
+		}
+
+		/// @brief Return a benchmark_base in JSON
+		/// @param[in] bench  A hnc::benchmark_base_t
+		/// @param[in] indent Indentation
+		/// @return the benchmark_base in JSON
+		template <class clock_t>
+		std::string json_benchmark_base(hnc::benchmark_base_t<clock_t> const & bench, std::string const & indent)
+		{
+			std::string r = "{\n";
+			r += indent + "\t\"size\": " + hnc::to_string(bench.size());
+			if (bench.size() != 0)
+			{
+				r += ",\n" + indent + "\t\"min\": " + hnc::benchmark_io::number_string(bench.min());
+				r += ",\n" + indent + "\t\"max\": " + hnc::benchmark_io::number_string(bench.max());
+				r += ",\n" + indent + "\t\"median\": " + hnc::benchmark_io::number_string(bench.median());
+				r += ",\n" + indent + "\t\"geometric_mean\": " + hnc::benchmark_io::number_string(bench.geometric_mean());
+				r += ",\n" + indent + "\t\"mean\": " + hnc::benchmark_io::number_string(bench.mean());
+				r += ",\n" + indent + "\t\"variance\": " + hnc::benchmark_io::number_string(bench.variance());
+			}
+			if (bench.is_streaming() == false)
+			{
+				r += ",\n" + indent + "\t\"all\": [";
+				for (std::size_t i = 0; i < bench.all.size(); ++i)
+				{
+					if (i != 0) { r += ", "; }
+					r += hnc::benchmark_io::number_string(bench.all[i]);
+				}
+				r += "]";
+			}
+			return r + "\n" + indent + "}";
+		}
+
+		/**
+		 * @brief Minimal JSON reader (objects, arrays, strings, numbers, true, false, null)
+		 *
+		 * @code
+		   #include <hnc/benchmark_io.hpp>
+		   @endcode
+		 */
+		class json_reader
+		{
+		private:
+
+			/// JSON text
+			std::string const & m_text;
+
+			/// Position
+			std::size_t m_i;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] text JSON text (must live longer than the reader)
+			explicit json_reader(std::string const & text) : m_text(text), m_i(0) { }
+
+			/// @brief Return the next character (after the white spaces) without consuming it
+			/// @return the next character ('\0' at the end)
+			char peek()
+			{
+				while (m_i < m_text.size() && (m_text[m_i] == ' ' || m_text[m_i] == '\t' || m_text[m_i] == '\n' || m_text[m_i] == '\r')) { ++m_i; }
+				return (m_i < m_text.size()) ? m_text[m_i] : '\0';
+			}
+
+			/// @brief Consume a character
+			/// @param[in] c Expected character
+			/// @exception std::invalid_argument if the next character is not c
+			void expect(char const c)
+			{
+				if (peek() != c) { error(std::string("'") + c + "' expected"); }
+				++m_i;
+			}
+
+			/// @brief Consume a character if it is the next one
+			/// @param[in] c A character
+			/// @return true if the character is consumed, false otherwise
+			bool consume(char const c)
+			{
+				if (peek() != c) { return false; }
+				++m_i;
+				return true;
+			}
+
+			/// @brief Read a string
+			/// @return the string
+			std::string read_string()
+			{
+				expect('"');
+				std::string r;
+				while (m_i < m_text.size() && m_text[m_i] != '"')
+				{
+					char c = m_text[m_i++];
+					if (c == '\\' && m_i < m_text.size())
+					{
+						c = m_text[m_i++];
+						if (c == 'n') { c = '\n'; }
+						else if (c == 't') { c = '\t'; }
+						else if (c == 'r') { c = '\r'; }
+						else if (c == 'b') { c = '\b'; }
+						else if (c == 'f') { c = '\f'; }
+						else if (c == 'u')
+						{
+							if (m_i + 4 > m_text.size()) { error("bad \\u escape"); }
+							unsigned long const code = std::strtoul(m_text.substr(m_i, 4).c_str(), nullptr, 16);
+							m_i += 4;
+							// Only ASCII is escaped by hnc
+							c = (code < 0x80) ? char(code) : '?';
+						}
+					}
+					r += c;
+				}
+				expect('"');
+				return r;
+			}
+
+			/// @brief Read a number
+			/// @return the number
+			long double read_number()
+			{
+				peek();
+				std::size_t length = 0;
+				long double const r = hnc::benchmark_io::string_number(m_text.c_str() + m_i, length);
+				if (length == 0) { error("number expected"); }
+				m_i += length;
+				return r;
+			}
+
+			/// @brief Skip a value
+			void skip_value()
+			{
+				char const c = peek();
+				if (c == '"') { read_string(); }
+				else if (c == '{')
+				{
+					expect('{');
+					if (consume('}')) { return; }
+					do { read_string(); expect(':'); skip_value(); } while (consume(','));
+					expect('}');
+				}
+				else if (c == '[')
+				{
+					expect('[');
+					if (consume(']')) { return; }
+					do { skip_value(); } while (consume(','));
+					expect(']');
+				}
+				else if (m_text.compare(m_i, 4, "true") == 0 || m_text.compare(m_i, 4, "null") == 0) { m_i += 4; }
+				else if (m_text.compare(m_i, 5, "false") == 0) { m_i += 5; }
+				else { read_number(); }
+			}
+
+			/// @brief Throw an exception
+			/// @param[in] message Message
+			/// @exception std::invalid_argument always
+			void error(std::string const & message) const
+			{
+				throw std::invalid_argument("hnc::benchmark_io::json_reader, " + message + " at position " + hnc::to_string(m_i));
+			}
+		};
+
+		/// @brief Read a benchmark_base in JSON (the benchmarks without "all" get their median as only elapsed time)
+		/// @param[in,out] reader A hnc::benchmark_io::json_reader
+		/// @param[out]    bench  A hnc::benchmark_base_t
+		template <class clock_t>
+		void json_read_benchmark_base(hnc::benchmark_io::json_reader & reader, hnc::benchmark_base_t<clock_t> & bench)
+		{
+			bool has_all = false;
+			bool has_median = false;
+			long double median = 0;
+			reader.expect('{');
+			if (reader.consume('}') == false)
+			{
+				do
+				{
+					std::string const key = reader.read_string();
+					reader.expect(':');
+					if (key == "all")
+					{
+						has_all = true;
+						reader.expect('[');
+						if (reader.consume(']') == false)
+						{
+							do { bench.push_back(reader.read_number()); } while (reader.consume(','));
+							reader.expect(']');
+						}
+					}
+					else if (key == "median") { has_median = true; median = reader.read_number(); }
+					else { reader.skip_value(); }
+				}
+				while (reader.consume(','));
+				reader.expect('}');
+			}
+			if (has_all == false && has_median) { bench.push_back(median); }
+		}
+
+		/**
+		 * @brief Enter in the benchmark of a JSON document with metadata (see hnc::benchmark_to_json with metadata)
+		 *
+		 * If the document is { "metadata": {...}, "benchmark": {...} }, the reader is moved before the benchmark object
+		 * and the closing '}' of the document must be consumed after the benchmark
+		 *
+		 * @param[in,out] reader A hnc::benchmark_io::json_reader at the beginning of the document
+		 * @return true if the document has metadata, false otherwise (the reader is not moved)
+		 */
+		inline bool json_enter_benchmark_with_metadata(hnc::benchmark_io::json_reader & reader)
+		{
+			hnc::benchmark_io::json_reader lookahead = reader;
+			if (lookahead.consume('{') == false || lookahead.peek() != '"' || lookahead.read_string() != "metadata") { return false; }
+			reader.expect('{');
+			reader.read_string();
+			reader.expect(':');
+			reader.skip_value();
+			reader.expect(',');
+			if (reader.read_string() != "benchmark") { reader.error("\"benchmark\" expected"); }
+			reader.expect(':');
+			return true;
+		}
+
+		// CSV
+
+		/// @brief Return a CSV field (quoted if needed)
+		/// @param[in] s A std::string
+		/// @return the CSV field
+		inline std::string csv_field(std::string const & s)
+		{
+			if (s.find_first_of(",\"\n\r") == std::string::npos) { return s; }
+			std::string r = "\"";
+			for (char const c : s) { if (c == '"') { r += "\"\""; } else { r += c; } }
+			return r + "\"";
+		}
+
+		/// @brief Return the CSV rows (with the fields)
+		/// @param[in] text CSV text
+		/// @return the CSV rows
+		inline std::vector<std::vector<std::string>> csv_rows(std::string const & text)
+		{
+			std::vector<std::vector<std::string>> r;
+			std::vector<std::string> row;
+			std::string field;
+			bool in_quotes = false;
+			bool row_not_empty = false;
+			for (std::size_t i = 0; i < text.size(); ++i)
+			{
+				char const c = text[i];
+				if (in_quotes)
+				{
+					if (c == '"' && i + 1 < text.size() && text[i + 1] == '"') { field += '"'; ++i; }
+					else if (c == '"') { in_quotes = false; }
+					else { field += c; }
+				}
+				else if (c == '"') { in_quotes = true; row_not_empty = true; }
+				else if (c == ',') { row.push_back(field); field.clear(); row_not_empty = true; }
+				else if (c == '\n' || c == '\r')
+				{
+					if (row_not_empty || field.empty() == false) { row.push_back(field); r.push_back(row); }
+					row.clear(); field.clear(); row_not_empty = false;
+				}
+				else { field += c; row_not_empty = true; }
+			}
+			if (row_not_empty || field.empty() == false) { row.push_back(field); r.push_back(row); }
+			return r;
+		}
+	}
+
+	/**
+	 * @brief Return a hnc::benchmark in JSON
+	 *
+	 * @code
+	   #include <hnc/benchmark_io.hpp>
+	   @endcode
+	 *
+	 * @code
+	   // {
+	   // 	"Test": {
+	   // 		"size": 3,
+	   // 		"min": 0.1,
+	   // 		"max": 0.3,
+	   // 		"median": 0.2,
+	   // 		"geometric_mean": 0.18,
+	   // 		"mean": 0.2,
+	   // 		"variance": 0.0066,
+	   // 		"all": [0.1, 0.2, 0.3]
+	   // 	}
+	   // }
+	   @endcode
+	 *
+	 * "all" (the elapsed times) is not written in streaming mode
+	 *
+	 * @param[in] b A hnc::benchmark
+	 *
+	 * @return the hnc::benchmark in JSON
+	 */
+	template <class clock_t>
+	std::string benchmark_to_json(hnc::benchmark_t<clock_t> const & b)
+	{
+		std::string r = "{";
+		for (auto const & name_bench : b)
+		{
+			if (name_bench.first != b.begin()->first) { r += ","; }
+			r += "\n\t" + hnc::benchmark_io::json_string(name_bench.first) + ": " + hnc::benchmark_io::json_benchmark_base(name_bench.second, "\t");
+		}
+		return r + "\n}\n";
+	}
+
+	/// @brief Return a hnc::benchmark_name_opt in JSON (same format as hnc::benchmark_to_json with one more level for the options)
+	/// @param[in] b A hnc::benchmark_name_opt
+	/// @return the hnc::benchmark_name_opt in JSON
+	template <class clock_t>
+	std::string benchmark_to_json(hnc::benchmark_name_opt_t<clock_t> const & b)
+	{
+		std::string r = "{";
+		for (auto const & name_opts : b)
+		{
+			if (name_opts.first != b.begin()->first) { r += ","; }
+			r += "\n\t" + hnc::benchmark_io::json_string(name_opts.first) + ": {";
+			for (auto const & opt_bench : name_opts.second)
+			{
+				if (opt_bench.first != name_opts.second.begin()->first) { r += ","; }
+				r += "\n\t\t" + hnc::benchmark_io::json_string(opt_bench.first) + ": " + hnc::benchmark_io::json_benchmark_base(opt_bench.second, "\t\t");
+			}
+			r += "\n\t}";
+		}
+		return r + "\n}\n";
+	}
+
+	/**
+	 * @brief Return a hnc::benchmark or a hnc::benchmark_name_opt in JSON with metadata (the machine, the compiler, ...)
+	 *
+	 * @code
+	   #include <hnc/benchmark_io.hpp>
+	   @endcode
+	 *
+	 * @code
+	   // {
+	   // 	"metadata": {
+	   // 		"processor": "Intel(R) Xeon(R)"
+	   // 	},
+	   // 	"benchmark": {
+	   // 		...
+	   // 	}
+	   // }
+	   @endcode
+	 *
+	 * hnc::benchmark_from_json and hnc::benchmark_name_opt_from_json read this format too
+	 * (so "metadata" can not be the name of the first test), see hnc::benchmark_metadata_from_json
+	 *
+	 * @param[in] b        A hnc::benchmark or a hnc::benchmark_name_opt
+	 * @param[in] metadata Metadata
+	 *
+	 * @return the benchmark with metadata in JSON
+	 */
+	template <class benchmark_t>
+	std::string benchmark_to_json(benchmark_t const & b, std::map<std::string, std::string> const & metadata)
+	{
+		std::string r = "{\n\t\"metadata\": {";
+		for (auto const & key_value : metadata)
+		{
+			if (key_value.first != metadata.begin()->first) { r += ","; }
+			r += "\n\t\t" + hnc::benchmark_io::json_string(key_value.first) + ": " + hnc::benchmark_io::json_string(key_value.second);
+		}
+		r += "\n\t},\n\t\"benchmark\": ";
+		std::string const json = hnc::benchmark_to_json(b);
+		// Indentation
+		for (std::size_t i = 0; i + 1 < json.size(); ++i) { r += json[i]; if (json[i] == '\n') { r += '\t'; } }
+		return r + "\n}\n";
+	}
+
+	/// @brief Return the metadata of a JSON benchmark (see hnc::benchmark_to_json with metadata)
+	/// @param[in] json JSON text
+	/// @exception std::invalid_argument if the JSON is not valid
+	/// @return the metadata (empty if there is no metadata)
+	inline std::map<std::string, std::string> benchmark_metadata_from_json(std::string const & json)
+	{
+		std::map<std::string, std::string> r;
+		hnc::benchmark_io::json_reader reader(json);
+		hnc::benchmark_io::json_reader lookahead = reader;
+		if (lookahead.consume('{') == false || lookahead.peek() != '"' || lookahead.read_string() != "metadata") { return r; }
+		reader.expect('{');
+		reader.read_string();
+		reader.expect(':');
+		reader.expect('{');
+		if (reader.consume('}')) { return r; }
+		do
+		{
+			std::string const key = reader.read_string();
+			reader.expect(':');
+			r[key] = reader.read_string();
+		}
+		while (reader.consume(','));
+		reader.expect('}');
+		return r;
+	}
+
+	/**
+	 * @brief Return a hnc::benchmark from JSON (see hnc::benchmark_to_json)
+	 *
+	 * @code
+	   #include <hnc/benchmark_io.hpp>
+	   @endcode
+	 *
+	 * The elapsed times are read from "all"; without "all" (streaming mode), the median is the only elapsed time
+	 *
+	 * @param[in] json JSON text
+	 *
+	 * @exception std::invalid_argument if the JSON is not valid
+	 *
+	 * @return the hnc::benchmark
+	 */
+	inline hnc::benchmark benchmark_from_json(std::string const & json)
+	{
+		hnc::benchmark r;
+		hnc::benchmark_io::json_reader reader(json);
+		bool const with_metadata = hnc::benchmark_io::json_enter_benchmark_with_metadata(reader);
+		reader.expect('{');
+		if (reader.consume('}') == false)
+		{
+			do
+			{
+				std::string const name = reader.read_string();
+				reader.expect(':');
+				hnc::benchmark_io::json_read_benchmark_base(reader, r[name]);
+			}
+			while (reader.consume(','));
+			reader.expect('}');
+		}
+		if (with_metadata) { reader.expect('}'); }
+		return r;
+	}
+
+	/// @brief Return a hnc::benchmark_name_opt from JSON (see hnc::benchmark_from_json)
+	/// @param[in] json JSON text
+	/// @exception std::invalid_argument if the JSON is not valid
+	/// @return the hnc::benchmark_name_opt
+	inline hnc::benchmark_name_opt benchmark_name_opt_from_json(std::string const & json)
+	{
+		hnc::benchmark_name_opt r;
+		hnc::benchmark_io::json_reader reader(json);
+		bool const with_metadata = hnc::benchmark_io::json_enter_benchmark_with_metadata(reader);
+		reader.expect('{');
+		if (reader.consume('}') == false)
+		{
+			do
+			{
+				std::string const name = reader.read_string();
+				reader.expect(':');
+				reader.expect('{');
+				auto & opts = r[name];
+				if (reader.consume('}')) { continue; }
+				do
+				{
+					std::string const opt = reader.read_string();
+					reader.expect(':');
+					hnc::benchmark_io::json_read_benchmark_base(reader, opts[opt]);
+				}
+				while (reader.consume(','));
+				reader.expect('}');
+			}
+			while (reader.consume(','));
+			reader.expect('}');
+		}
+		if (with_metadata) { reader.expect('}'); }
+		return r;
+	}
+
+	/**
+	 * @brief Return a hnc::benchmark in CSV, one row by elapsed time
+	 *
+	 * @code
+	   #include <hnc/benchmark_io.hpp>
+	   @endcode
+	 *
+	 * @code
+	   // name,time
+	   // Test,0.1
+	   // Test,0.2
+	   // Test,0.3
+	   @endcode
+	 *
+	 * In streaming mode, the median is written (the elapsed times are not saved)
+	 *
+	 * @param[in] b A hnc::benchmark
+	 *
+	 * @return the hnc::benchmark in CSV
+	 */
+	template <class clock_t>
+	std::string benchmark_to_csv(hnc::benchmark_t<clock_t> const & b)
+	{
+		std::string r = "name,time\n";
+		for (auto const & name_bench : b)
+		{
+			std::string const name = hnc::benchmark_io::csv_field(name_bench.first);
+			auto const & bench = name_bench.second;
+			if (bench.is_streaming()) { if (bench.size() != 0) { r += name + "," + hnc::benchmark_io::number_string(bench.median()) + "\n"; } }
+			else { for (auto const time : bench.all) { r += name + "," + hnc::benchmark_io::number_string(time) + "\n"; } }
+		}
+		return r;
+	}
+
+	/// @brief Return a hnc::benchmark_name_opt in CSV, one row by elapsed time (name,option,time)
+	/// @param[in] b A hnc::benchmark_name_opt
+	/// @return the hnc::benchmark_name_opt in CSV
+	template <class clock_t>
+	std::string benchmark_to_csv(hnc::benchmark_name_opt_t<clock_t> const & b)
+	{
+		std::string r = "name,option,time\n";
+		for (auto const & name_opts : b)
+		{
+			for (auto const & opt_bench : name_opts.second)
+			{
+				std::string const name_opt = hnc::benchmark_io::csv_field(name_opts.first) + "," + hnc::benchmark_io::csv_field(opt_bench.first);
+				auto const & bench = opt_bench.second;
+				if (bench.is_streaming()) { if (bench.size() != 0) { r += name_opt + "," + hnc::benchmark_io::number_string(bench.median()) + "\n"; } }
+				else { for (auto const time : bench.all) { r += name_opt + "," + hnc::benchmark_io::number_string(time) + "\n"; } }
+			}
+		}
+		return r;
+	}
+
+	/// @brief Return a hnc::benchmark from CSV (see hnc::benchmark_to_csv)
+	/// @param[in] csv CSV text
+	/// @exception std::invalid_argument if a row has not 2 fields or if the time is not a number
+	/// @return the hnc::benchmark
+	inline hnc::benchmark benchmark_from_csv(std::string const & csv)
+	{
+		hnc::benchmark r;
+		std::vector<std::vector<std::string>> const rows = hnc::benchmark_io::csv_rows(csv);
+		for (std::size_t i = 1; i < rows.size(); ++i)
+		{
+			if (rows[i].size() != 2) { throw std::invalid_argument("hnc::benchmark_from_csv, row " + hnc::to_string(i) + " has not 2 fields"); }
+			std::size_t length = 0;
+			long double const time = hnc::benchmark_io::string_number(rows[i][1].c_str(), length);
+			if (length == 0 || length != rows[i][1].size()) { throw std::invalid_argument("hnc::benchmark_from_csv, row " + hnc::to_string(i) + " has not a number as time"); }
+			r[rows[i][0]].push_back(time);
+		}
+		return r;
+	}
+
+	/// @brief Return a hnc::benchmark_name_opt from CSV (see hnc::benchmark_to_csv)
+	/// @param[in] csv CSV text
+	/// @exception std::invalid_argument if a row has not 3 fields or if the time is not a number
+	/// @return the hnc::benchmark_name_opt
+	inline hnc::benchmark_name_opt benchmark_name_opt_from_csv(std::string const & csv)
+	{
+		hnc::benchmark_name_opt r;
+		std::vector<std::vector<std::string>> const rows = hnc::benchmark_io::csv_rows(csv);
+		for (std::size_t i = 1; i < rows.size(); ++i)
+		{
+			if (rows[i].size() != 3) { throw std::invalid_argument("hnc::benchmark_name_opt_from_csv, row " + hnc::to_string(i) + " has not 3 fields"); }
+			std::size_t length = 0;
+			long double const time = hnc::benchmark_io::string_number(rows[i][2].c_str(), length);
+			if (length == 0 || length != rows[i][2].size()) { throw std::invalid_argument("hnc::benchmark_name_opt_from_csv, row " + hnc::to_string(i) + " has not a number as time"); }
+			r[rows[i][0]][rows[i][1]].push_back(time);
+		}
+		return r;
+	}
+
+	/**
+	 * @brief Save a hnc::benchmark or a hnc::benchmark_name_opt in a file, in JSON or in CSV (from the extension, JSON by default)
+	 *
+	 * @code
+	   #include <hnc/benchmark_io.hpp>
+	   @endcode
+	 *
+	 * @code
+	   hnc::benchmark_save("benchmark.json", b);
+	   hnc::benchmark_save("benchmark.csv", b);
+	   @endcode
+	 *
+	 * @param[in] filename Filename (.json or .csv)
+	 * @param[in] b        A hnc::benchmark or a hnc::benchmark_name_opt
+	 *
+	 * @exception std::runtime_error if the file can not be written
+	 */
+	template <class benchmark_t>
+	void benchmark_save(std::string const & filename, benchmark_t const & b)
+	{
+		std::ofstream f(filename);
+		if (f.good() == false) { throw std::runtime_error("hnc::benchmark_save, can not write \"" + filename + "\""); }
+		f << ((hnc::filesystem::extension(filename) == "csv") ? hnc::benchmark_to_csv(b) : hnc::benchmark_to_json(b));
+	}
+
+	/// @brief Save a hnc::benchmark or a hnc::benchmark_name_opt in a file with metadata (the metadata are written in JSON only, not in CSV)
+	/// @param[in] filename Filename (.json or .csv)
+	/// @param[in] b        A hnc::benchmark or a hnc::benchmark_name_opt
+	/// @param[in] metadata Metadata (see hnc::benchmark_to_json with metadata)
+	/// @exception std::runtime_error if the file can not be written
+	template <class benchmark_t>
+	void benchmark_save(std::string const & filename, benchmark_t const & b, std::map<std::string, std::string> const & metadata)
+	{
+		std::ofstream f(filename);
+		if (f.good() == false) { throw std::runtime_error("hnc::benchmark_save, can not write \"" + filename + "\""); }
+		f << ((hnc::filesystem::extension(filename) == "csv") ? hnc::benchmark_to_csv(b) : hnc::benchmark_to_json(b, metadata));
+	}
+
+	/// @brief Load a hnc::benchmark from a JSON or CSV file (from the extension, JSON by default)
+	/// @param[in] filename Filename (.json or .csv)
+	/// @exception std::runtime_error if the file can not be read
+	/// @exception std::invalid_argument if the file is not valid
+	/// @return the hnc::benchmark
+	inline hnc::benchmark benchmark_load(std::string const & filename)
+	{
+		if (hnc::filesystem::file_is_readable(filename) == false) { throw std::runtime_error("hnc::benchmark_load, can not read \"" + filename + "\""); }
+		std::string const text = hnc::filesystem::read_file(filename);
+		return (hnc::filesystem::extension(filename) == "csv") ? hnc::benchmark_from_csv(text) : hnc::benchmark_from_json(text);
+	}
+
+	/// @brief Load a hnc::benchmark_name_opt from a JSON or CSV file (from the extension, JSON by default)
+	/// @param[in] filename Filename (.json or .csv)
+	/// @exception std::runtime_error if the file can not be read
+	/// @exception std::invalid_argument if the file is not valid
+	/// @return the hnc::benchmark_name_opt
+	inline hnc::benchmark_name_opt benchmark_name_opt_load(std::string const & filename)
+	{
+		if (hnc::filesystem::file_is_readable(filename) == false) { throw std::runtime_error("hnc::benchmark_name_opt_load, can not read \"" + filename + "\""); }
+		std::string const text = hnc::filesystem::read_file(filename);
+		return (hnc::filesystem::extension(filename) == "csv") ? hnc::benchmark_name_opt_from_csv(text) : hnc::benchmark_name_opt_from_json(text);
+	}
+}
+
+#endif
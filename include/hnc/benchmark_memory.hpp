@@ -0,0 +1,528 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#ifndef HNC_BENCHMARK_MEMORY_HPP
+#define HNC_BENCHMARK_MEMORY_HPP
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "assert.hpp"
+#include "benchmark.hpp"
+#include "benchmark_policy.hpp"
+#include "benchmark_size_sweep.hpp"
+#include "computer.hpp"
+#include "gnuplot.hpp"
+#include "tabular.hpp"
+#include "openmp.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Return the metadata of the machine to tag benchmark results (see hnc::benchmark_to_json with metadata)
+	 *
+	 * @code
+	   #include <hnc/benchmark_memory.hpp>
+	   @endcode
+	 *
+	 * Keys: "system", "system version", "processor", "topology", "logical cores", "physical cores", "packages",
+	 * "NUMA nodes", "cache line" and "L1", "L2", ... (sizes in bytes of the data or unified caches)
+	 *
+	 * @param[in] topology Topology of the computer (see hnc::computer::topology)
+	 *
+	 * @return the metadata of the machine
+	 */
+	inline std::map<std::string, std::string> benchmark_machine_metadata(hnc::computer::topology_t const & topology = hnc::computer::topology())
+	{
+		std::map<std::string, std::string> r;
+		r["system"] = hnc::computer::system_name();
+		r["system version"] = hnc::computer::system_version();
+		r["processor"] = hnc::computer::processor_name();
+		r["topology"] = topology.to_string();
+		r["logical cores"] = hnc::to_string(topology.nb_logical_core);
+		r["physical cores"] = hnc::to_string(topology.nb_physical_core);
+		r["packages"] = hnc::to_string(topology.nb_package);
+		r["NUMA nodes"] = hnc::to_string(topology.nb_numa_node());
+		r["cache line"] = hnc::to_string(topology.cache_line_size());
+		for (auto const & cache : topology.caches)
+		{
+			if (cache.type != "Instruction") { r["L" + hnc::to_string(cache.level)] = hnc::to_string(cache.size); }
+		}
+		return r;
+	}
+
+	/// @brief Return the key of a size in bytes in KiB (padded with spaces to keep the std::map sorted by size)
+	/// @param[in] size Size in bytes
+	/// @return the key of the size
+	inline std::string benchmark_memory_size_key(std::size_t const size)
+	{
+		return hnc::benchmark_size_key(size / 1024, 7) + " KiB";
+	}
+
+	/**
+	 * @brief Return the working set sizes of a memory latency probe (see hnc::benchmark_memory_latency)
+	 *
+	 * @code
+	   #include <hnc/benchmark_memory.hpp>
+	   @endcode
+	 *
+	 * Powers of two from 4 KiB to 4 times the largest cache (at least 8 MiB, at most 256 MiB),
+	 * so each cache level and the main memory have some points
+	 *
+	 * @param[in] topology Topology of the computer (see hnc::computer::topology)
+	 *
+	 * @return the working set sizes in bytes
+	 */
+	inline std::vector<std::size_t> benchmark_memory_working_set_sizes(hnc::computer::topology_t const & topology = hnc::computer::topology())
+	{
+		std::size_t largest_cache = 0;
+		for (auto const & cache : topology.caches) { largest_cache = std::max(largest_cache, cache.size); }
+		std::size_t const max = std::min(std::max(4 * largest_cache, std::size_t(8) << 20), std::size_t(256) << 20);
+		std::vector<std::size_t> r;
+		for (std::size_t size = 4096; size <= max; size *= 2) { r.push_back(size); }
+		return r;
+	}
+
+	/**
+	 * @brief Performs a memory latency probe: a pointer chasing on working sets of several sizes
+	 *
+	 * @code
+	   #include <hnc/benchmark_memory.hpp>
+	   @endcode
+	 *
+	 * The working set is divided in cache lines, each cache line contains the index of the next one
+	 * in a random cyclic permutation (Sattolo's algorithm), so each load depends on the previous one
+	 * and the hardware prefetchers can not guess the next address @n
+	 * The time of one load is the latency of the cache level (or of the main memory) that holds the working set
+	 *
+	 * Output:
+	 * - raw times (seconds by load) in a hnc::benchmark_name_opt: ["pointer chasing"][size] (see hnc::benchmark_memory_size_key)
+	 * - a Gnuplot with the latency (ns) by working set size
+	 * - a tabular with the latency (ns) by working set size
+	 *
+	 * @param[in] sizes                   Working set sizes in bytes (see hnc::benchmark_memory_working_set_sizes)
+	 * @param[in] title                   Title for Gnuplot and tabular
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 * @param[in] nb_run                  Number of runs for each size
+	 * @param[in] nb_load                 Number of loads by run
+	 * @param[in] line_size               Cache line size in bytes (see hnc::computer::topology_t::cache_line_size)
+	 *
+	 * Example:
+	 * @code
+	   auto const topology = hnc::computer::topology();
+	   auto benchmark_latency = hnc::benchmark_memory_latency
+	   (
+	   	hnc::benchmark_memory_working_set_sizes(topology),
+	   	"Memory latency (" + topology.to_string() + ")",
+	   	"hnc_benchmark_memory_latency_gnuplot"
+	   );
+	   hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_latency);
+	   hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_latency);
+	   hnc::tabular const & tabular = std::get<2>(benchmark_latency);
+	   @endcode
+	 *
+	 * @return the benchmark with all times, the gnuplot and the tabular
+	 */
+	inline std::tuple
+	<
+		hnc::benchmark_name_opt,
+		hnc::gnuplot::gnuplot_lines,
+		hnc::tabular
+	>
+	benchmark_memory_latency
+	(
+		std::vector<std::size_t> const & sizes,
+		std::string const & title,
+		std::string const & gnuplot_output_filename,
+		std::size_t const nb_run = 3,
+		std::size_t const nb_load = 1 << 22,
+		std::size_t const line_size = 64
+	)
+	{
+		#ifndef NDEBUG
+			hnc::hassert(nb_load >= 1 && line_size >= sizeof(std::size_t), std::invalid_argument("hnc::benchmark_memory_latency, number of loads must be >= 1 and line size must be >= sizeof(std::size_t)"));
+		#endif
+
+		hnc::benchmark_name_opt benchs;
+		auto & benchs_size = benchs["pointer chasing"];
+
+		std::size_t const stride = line_size / sizeof(std::size_t);
+		std::mt19937 random_engine(42);
+
+		for (std::size_t const size : sizes)
+		{
+			// Random cyclic permutation of the cache lines
+			std::size_t const nb_line = std::max(size / line_size, std::size_t(2));
+			std::vector<std::size_t> lines(nb_line);
+			for (std::size_t i = 0; i < nb_line; ++i) { lines[i] = i; }
+			for (std::size_t i = nb_line - 1; i > 0; --i)
+			{
+				std::swap(lines[i], lines[std::uniform_int_distribution<std::size_t>(0, i - 1)(random_engine)]);
+			}
+			std::vector<std::size_t> chain(nb_line * stride, 0);
+			for (std::size_t i = 0; i < nb_line; ++i) { chain[lines[i] * stride] = lines[(i + 1) % nb_line] * stride; }
+
+			// Warmup
+			std::size_t p = 0;
+			for (std::size_t i = 0; i < nb_line; ++i) { p = chain[p]; }
+
+			auto & bench = benchs_size[hnc::benchmark_memory_size_key(size)];
+			for (std::size_t run = 0; run < nb_run; ++run)
+			{
+				bench.start();
+				for (std::size_t i = 0; i < nb_load; ++i) { p = chain[p]; }
+				bench.stop(nb_load);
+				hnc::do_not_optimize(p);
+			}
+		}
+
+		// Gnuplot
+		hnc::gnuplot::output_terminal_pdf const output_terminal(gnuplot_output_filename);
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label("Working set size");
+		gp.set_y_label("Latency (ns)");
+		std::map<std::string, long double> data;
+		for (auto const & size_bench : benchs_size) { data[size_bench.first] = size_bench.second.median() * 1e9L; }
+		gp.add_line(data, "pointer chasing");
+
+		// Tabular
+		std::vector<std::vector<std::string>> tabular_data;
+		for (auto const & size_latency : data) { tabular_data.push_back({ size_latency.first, hnc::to_string(size_latency.second) }); }
+
+		return std::make_tuple(benchs, gp, hnc::tabular(tabular_data, title, { "Working set size", "Latency (ns)" }));
+	}
+
+	/**
+	 * @brief Performs a memory bandwidth probe: sequential read, write and copy on a buffer with several numbers of threads
+	 *
+	 * @code
+	   #include <hnc/benchmark_memory.hpp>
+	   @endcode
+	 *
+	 * For each number of threads p, the OpenMP threads read (sum), write (fill) and copy the buffer,
+	 * a copy moves twice the size of the buffer (read the source, write the destination) @n
+	 * The number of OpenMP threads is set with omp_set_num_threads (the previous maximum number of OpenMP threads is restored at the end) @n
+	 * Use a buffer larger than the last level cache to measure the bandwidth of the main memory
+	 *
+	 * Output:
+	 * - raw times in a hnc::benchmark_name_opt: ["read", "write" or "copy"][number of threads] (see hnc::benchmark_size_key)
+	 * - a Gnuplot with the bandwidth (GB/s) by number of threads
+	 * - a tabular with the bandwidth (GB/s) by number of threads
+	 *
+	 * @param[in] buffer_size             Size of the buffer in bytes
+	 * @param[in] nb_threads              Numbers of threads (see hnc::benchmark_nb_threads, 1 and all cores in general)
+	 * @param[in] title                   Title for Gnuplot and tabular
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 * @param[in] nb_run                  Number of runs for each number of threads
+	 *
+	 * Example:
+	 * @code
+	   auto const topology = hnc::computer::topology();
+	   auto benchmark_bandwidth = hnc::benchmark_memory_bandwidth
+	   (
+	   	std::size_t(256) << 20,
+	   	{ 1, topology.nb_logical_core },
+	   	"Memory bandwidth (" + topology.to_string() + ")",
+	   	"hnc_benchmark_memory_bandwidth_gnuplot"
+	   );
+	   hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_bandwidth);
+	   hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_bandwidth);
+	   hnc::tabular const & tabular = std::get<2>(benchmark_bandwidth);
+	   @endcode
+	 *
+	 * @return the benchmark with all times, the gnuplot and the tabular
+	 */
+	inline std::tuple
+	<
+		hnc::benchmark_name_opt,
+		hnc::gnuplot::gnuplot_lines,
+		hnc::tabular
+	>
+	benchmark_memory_bandwidth
+	(
+		std::size_t const buffer_size,
+		std::vector<std::size_t> const & nb_threads,
+		std::string const & title,
+		std::string const & gnuplot_output_filename,
+		std::size_t const nb_run = 5
+	)
+	{
+		hnc::benchmark_name_opt benchs;
+
+		std::size_t const n = std::max(buffer_size / sizeof(std::uint64_t), std::size_t(1));
+		long int const size = long(n);
+		// Not initialized by the allocation: the pages are first touched by the threads (NUMA), with the schedule of the timed loops
+		std::unique_ptr<std::uint64_t[]> const src(new std::uint64_t[n]);
+		std::unique_ptr<std::uint64_t[]> const dst(new std::uint64_t[n]);
+		std::uint64_t * const src_data = src.get();
+		std::uint64_t * const dst_data = dst.get();
+		#pragma omp parallel for schedule(static)
+		for (long int i = 0; i < size; ++i) { src_data[i] = 1; dst_data[i] = 0; }
+		long double const nb_byte = (long double)(n * sizeof(std::uint64_t));
+
+		// Width of the keys
+		std::size_t width = 0;
+		for (std::size_t const p : nb_threads) { width = std::max(width, hnc::to_string(p).size()); }
+
+		// Numbers of threads
+		#if defined(_OPENMP)
+			int const previous_nb_thread_max = omp_get_max_threads();
+		#endif
+		for (std::size_t const p : nb_threads)
+		{
+			#if defined(_OPENMP)
+				omp_set_num_threads(int(p));
+			#endif
+			std::string const key = hnc::benchmark_size_key(p, width);
+			for (std::size_t run = 0; run < nb_run; ++run)
+			{
+				// Read
+				{
+					auto & bench = benchs["read"][key];
+					std::uint64_t sum = 0;
+					bench.start();
+					#pragma omp parallel for schedule(static) reduction(+:sum)
+					for (long int i = 0; i < size; ++i) { sum += src_data[i]; }
+					bench.stop();
+					hnc::do_not_optimize(sum);
+				}
+				// Write
+				{
+					auto & bench = benchs["write"][key];
+					std::uint64_t const value = std::uint64_t(run);
+					bench.start();
+					#pragma omp parallel for schedule(static)
+					for (long int i = 0; i < size; ++i) { dst_data[i] = value; }
+					bench.stop();
+					hnc::do_not_optimize(dst_data[n / 2]);
+				}
+				// Copy
+				{
+					auto & bench = benchs["copy"][key];
+					bench.start();
+					#pragma omp parallel for schedule(static)
+					for (long int i = 0; i < size; ++i) { dst_data[i] = src_data[i]; }
+					bench.stop();
+					hnc::do_not_optimize(dst_data[n / 2]);
+				}
+			}
+		}
+		#if defined(_OPENMP)
+			omp_set_num_threads(previous_nb_thread_max);
+		#endif
+
+		// Bandwidths
+		std::map<std::string, std::map<std::string, long double>> bandwidths;
+		for (auto const & name_benchs : benchs)
+		{
+			long double const factor = (name_benchs.first == "copy") ? 2 : 1;
+			for (auto const & p_bench : name_benchs.second)
+			{
+				long double const median = p_bench.second.median();
+				bandwidths[name_benchs.first][p_bench.first] = (median > 0) ? factor * nb_byte / median / 1e9L : 0;
+			}
+		}
+
+		// Gnuplot
+		hnc::gnuplot::output_terminal_pdf const output_terminal(gnuplot_output_filename);
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label("Number of threads");
+		gp.set_y_label("Bandwidth (GB/s)");
+		for (auto const & name_bandwidths : bandwidths) { gp.add_line(name_bandwidths.second, name_bandwidths.first); }
+
+		// Tabular
+		std::vector<std::vector<std::string>> tabular_data;
+		for (std::size_t const p : nb_threads)
+		{
+			std::string const key = hnc::benchmark_size_key(p, width);
+			tabular_data.push_back({ hnc::to_string(p) });
+			for (auto const & name_bandwidths : bandwidths) { tabular_data.back().push_back(hnc::to_string(name_bandwidths.second.at(key))); }
+		}
+		std::vector<std::string> header = { "Number of threads" };
+		for (auto const & name_bandwidths : bandwidths) { header.push_back(name_bandwidths.first + " (GB/s)"); }
+
+		return std::make_tuple(benchs, gp, hnc::tabular(tabular_data, title, header));
+	}
+
+	/**
+	 * @brief Return the pairs of logical cores of a cache line ping-pong probe (see hnc::benchmark_cache_line_ping_pong)
+	 *
+	 * @code
+	   #include <hnc/benchmark_memory.hpp>
+	   @endcode
+	 *
+	 * The first logical core with its SMT siblings (shared L1) and with the first logical core of each other physical core
+	 * (shared last level cache or other package, see hnc::computer::topology_t::physical_cores) @n
+	 * (0, 0) if the computer has only one logical core
+	 *
+	 * @param[in] topology Topology of the computer (see hnc::computer::topology)
+	 *
+	 * @return the pairs of logical cores
+	 */
+	inline std::vector<std::pair<int, int>> benchmark_cache_line_ping_pong_cpu_pairs(hnc::computer::topology_t const & topology = hnc::computer::topology())
+	{
+		std::vector<std::pair<int, int>> r;
+		for (auto const & siblings : topology.physical_cores)
+		{
+			for (std::size_t const cpu : siblings)
+			{
+				if (cpu != 0 && (cpu == siblings.front() || siblings == topology.physical_cores.front()))
+				{
+					r.emplace_back(0, int(cpu));
+				}
+			}
+		}
+		if (r.empty()) { r.emplace_back(0, (topology.nb_logical_core > 1) ? 1 : 0); }
+		return r;
+	}
+
+	/**
+	 * @brief Performs a cache line ping-pong probe: the latency of a round trip of a cache line between two logical cores
+	 *
+	 * @code
+	   #include <hnc/benchmark_memory.hpp>
+	   @endcode
+	 *
+	 * Two threads, pinned on two logical cores (see hnc::benchmark_cpu_pinning), increment in turn an atomic counter
+	 * alone in its cache line, so the cache line moves from a core to the other at each increment @n
+	 * The threads spin and yield after some spins (so the probe terminates if both threads share one logical core)
+	 *
+	 * Output:
+	 * - raw times (seconds by round trip) in a hnc::benchmark_name_opt: ["ping-pong"]["cpu a <-> cpu b"]
+	 * - a tabular with the round trip latency (ns) by pair of logical cores
+	 *
+	 * @param[in] cpu_pairs     Pairs of logical cores (see hnc::benchmark_cache_line_ping_pong_cpu_pairs)
+	 * @param[in] title         Title of the tabular
+	 * @param[in] nb_run        Number of runs for each pair
+	 * @param[in] nb_round_trip Number of round trips by run
+	 *
+	 * Example:
+	 * @code
+	   auto const topology = hnc::computer::topology();
+	   auto benchmark_ping_pong = hnc::benchmark_cache_line_ping_pong
+	   (
+	   	hnc::benchmark_cache_line_ping_pong_cpu_pairs(topology),
+	   	"Cache line ping-pong (" + topology.to_string() + ")"
+	   );
+	   hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_ping_pong);
+	   hnc::tabular const & tabular = std::get<1>(benchmark_ping_pong);
+	   @endcode
+	 *
+	 * @return the benchmark with all times and the tabular
+	 */
+	inline std::tuple
+	<
+		hnc::benchmark_name_opt,
+		hnc::tabular
+	>
+	benchmark_cache_line_ping_pong
+	(
+		std::vector<std::pair<int, int>> const & cpu_pairs,
+		std::string const & title,
+		std::size_t const nb_run = 5,
+		std::size_t const nb_round_trip = 100000
+	)
+	{
+		#ifndef NDEBUG
+			hnc::hassert(nb_round_trip >= 1, std::invalid_argument("hnc::benchmark_cache_line_ping_pong, number of round trips must be >= 1"));
+		#endif
+
+		// Atomic counter alone in its cache line
+		struct alignas(64) cache_line_t
+		{
+			std::atomic<std::size_t> counter;
+			char padding[64 - sizeof(std::atomic<std::size_t>)];
+		};
+
+		// Wait until the counter is equal to the value
+		auto const wait = [](std::atomic<std::size_t> const & counter, std::size_t const value) -> void
+		{
+			for (std::size_t spin = 0; counter.load(std::memory_order_acquire) != value; ++spin)
+			{
+				if (spin >= 1024) { std::this_thread::yield(); }
+			}
+		};
+
+		hnc::benchmark_name_opt benchs;
+		auto & benchs_pair = benchs["ping-pong"];
+
+		for (auto const & cpu_pair : cpu_pairs)
+		{
+			auto & bench = benchs_pair["cpu " + hnc::to_string(cpu_pair.first) + " <-> cpu " + hnc::to_string(cpu_pair.second)];
+			for (std::size_t run = 0; run < nb_run; ++run)
+			{
+				cache_line_t line;
+				line.counter.store(0);
+
+				std::thread pong
+				(
+					[&]() -> void
+					{
+						hnc::benchmark_cpu_pinning const pinning(cpu_pair.second);
+						for (std::size_t i = 0; i < nb_round_trip; ++i)
+						{
+							wait(line.counter, 2 * i + 1);
+							line.counter.store(2 * i + 2, std::memory_order_release);
+						}
+					}
+				);
+
+				{
+					hnc::benchmark_cpu_pinning const pinning(cpu_pair.first);
+					bench.start();
+					for (std::size_t i = 0; i < nb_round_trip; ++i)
+					{
+						line.counter.store(2 * i + 1, std::memory_order_release);
+						wait(line.counter, 2 * i + 2);
+					}
+					bench.stop(nb_round_trip);
+				}
+
+				pong.join();
+			}
+		}
+
+		// Tabular
+		std::vector<std::vector<std::string>> tabular_data;
+		for (auto const & pair_bench : benchs_pair)
+		{
+			tabular_data.push_back({ pair_bench.first, hnc::to_string(pair_bench.second.median() * 1e9L) });
+		}
+
+		return std::make_tuple(benchs, hnc::tabular(tabular_data, title, { "Logical cores", "Round trip (ns)" }));
+	}
+}
+
+#endif
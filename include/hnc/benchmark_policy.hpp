@@ -0,0 +1,220 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_POLICY_HPP
+#define HNC_BENCHMARK_POLICY_HPP
+
+#include <iostream>
+#include <string>
+
+#ifdef hnc_linux
+	#include <sched.h>
+#endif
+
+#include "time.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Execution policy of hnc::benchmark_functions
+	 *
+	 * @code
+	   #include <hnc/benchmark_policy.hpp>
+	   @endcode
+	 *
+	 * The execution policy chooses:
+	 * - if the order of the versions is shuffled at each run (false by default, the versions are run in the given order)
+	 * - the number of warmup runs (their times are discarded, 0 by default)
+	 * - the CPU where the benchmark is pinned with sched_setaffinity (-1 by default, not pinned; Linux only)
+	 * - the seed of the shuffle (0 by default, a seed is chosen with hnc::time::ns())
+	 *
+	 * hnc::benchmark_functions returns the policy used: the seed chosen is saved and the CPU is -1 if the pinning failed,
+	 * so a benchmark can be run again with the same order
+	 *
+	 * @code
+	   hnc::benchmark_policy policy;
+	   policy.set_shuffle().set_nb_warmup_run(2).set_cpu(0);
+	   std::cout << policy << std::endl; // shuffle: 1, warmup runs: 2, cpu: 0, seed: 0
+	   @endcode
+	 */
+	class benchmark_policy
+	{
+	private:
+
+		/// Shuffle the order of the versions at each run
+		bool m_shuffle;
+
+		/// Number of warmup runs
+		std::size_t m_nb_warmup_run;
+
+		/// CPU (-1 if the benchmark is not pinned)
+		int m_cpu;
+
+		/// Seed of the shuffle (0 to choose a seed)
+		unsigned int m_seed;
+
+	public:
+
+		/// @brief Default constructor (versions in the given order, no warmup, not pinned)
+		benchmark_policy() :
+			m_shuffle(false),
+			m_nb_warmup_run(0),
+			m_cpu(-1),
+			m_seed(0)
+		{ }
+
+		/// @brief Shuffle (or not) the order of the versions at each run
+		/// @param[in] shuffle true to shuffle the order of the versions (by default), false otherwise
+		/// @return the hnc::benchmark_policy
+		benchmark_policy & set_shuffle(bool const shuffle = true) { m_shuffle = shuffle; return *this; }
+
+		/// @brief Set the number of warmup runs (their times are discarded)
+		/// @param[in] nb_warmup_run Number of warmup runs
+		/// @return the hnc::benchmark_policy
+		benchmark_policy & set_nb_warmup_run(std::size_t const nb_warmup_run) { m_nb_warmup_run = nb_warmup_run; return *this; }
+
+		/// @brief Set the CPU where the benchmark is pinned
+		/// @param[in] cpu CPU (-1 to not pin the benchmark)
+		/// @return the hnc::benchmark_policy
+		benchmark_policy & set_cpu(int const cpu) { m_cpu = cpu; return *this; }
+
+		/// @brief Set the seed of the shuffle
+		/// @param[in] seed Seed (0 to choose a seed with hnc::time::ns())
+		/// @return the hnc::benchmark_policy
+		benchmark_policy & set_seed(unsigned int const seed) { m_seed = seed; return *this; }
+
+		/// @brief Return true if the order of the versions is shuffled at each run
+		/// @return true if the order of the versions is shuffled at each run, false otherwise
+		bool shuffle() const { return m_shuffle; }
+
+		/// @brief Return the number of warmup runs
+		/// @return the number of warmup runs
+		std::size_t nb_warmup_run() const { return m_nb_warmup_run; }
+
+		/// @brief Return the CPU where the benchmark is pinned
+		/// @return the CPU where the benchmark is pinned (-1 if the benchmark is not pinned)
+		int cpu() const { return m_cpu; }
+
+		/// @brief Return the seed of the shuffle
+		/// @return the seed of the shuffle (0 if the seed is not chosen yet)
+		unsigned int seed() const { return m_seed; }
+
+		/// @brief Return the policy with a seed chosen (if the seed is 0)
+		/// @return the policy with a seed chosen
+		benchmark_policy with_seed() const
+		{
+			benchmark_policy r = *this;
+			if (r.m_seed == 0) { r.m_seed = (unsigned int)(hnc::time::ns()) | 1u; }
+			return r;
+		}
+
+		/// @brief Return the policy in a std::string
+		/// @return the policy in a std::string
+		std::string to_string() const
+		{
+			return
+				"shuffle: " + hnc::to_string(m_shuffle) +
+				", warmup runs: " + hnc::to_string(m_nb_warmup_run) +
+				", cpu: " + hnc::to_string(m_cpu) +
+				", seed: " + hnc::to_string(m_seed);
+		}
+	};
+
+	/// @brief Operator << between a std::ostream and a hnc::benchmark_policy
+	/// @param[in,out] o      Output stream
+	/// @param[in]     policy A hnc::benchmark_policy
+	/// @return the output stream
+	inline std::ostream & operator <<(std::ostream & o, hnc::benchmark_policy const & policy)
+	{
+		return o << policy.to_string();
+	}
+
+	/**
+	 * @brief Pin the calling thread on one CPU (sched_setaffinity) during the life of the object
+	 *
+	 * @code
+	   #include <hnc/benchmark_policy.hpp>
+	   @endcode
+	 *
+	 * The previous affinity is restored by the destructor @n
+	 * On non-Linux platforms (or if the CPU is not available), the thread is not pinned
+	 *
+	 * @code
+	   {
+	   	hnc::benchmark_cpu_pinning pinning(0);
+	   	std::cout << pinning.pinned() << std::endl;
+	   	// Benchmark on CPU 0
+	   }
+	   @endcode
+	 *
+	 * @note hnc::benchmark_cpu_pinning is not copyable
+	 */
+	class benchmark_cpu_pinning
+	{
+	private:
+
+		/// Pinned
+		bool m_pinned;
+
+		#ifdef hnc_linux
+			/// Previous affinity
+			cpu_set_t m_previous;
+		#endif
+
+	public:
+
+		/// @brief Constructor, pin the calling thread
+		/// @param[in] cpu CPU (-1 to not pin the thread)
+		explicit benchmark_cpu_pinning(int const cpu) :
+			m_pinned(false)
+		{
+			#ifdef hnc_linux
+				if (cpu < 0 || cpu >= CPU_SETSIZE) { return; }
+				if (sched_getaffinity(0, sizeof(cpu_set_t), &m_previous) != 0) { return; }
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(std::size_t(cpu), &set);
+				m_pinned = (sched_setaffinity(0, sizeof(cpu_set_t), &set) == 0);
+			#else
+				(void)cpu;
+			#endif
+		}
+
+		/// @brief Copy constructor (deleted)
+		benchmark_cpu_pinning(benchmark_cpu_pinning const &) = delete;
+
+		/// @brief Copy assignment operator (deleted)
+		benchmark_cpu_pinning & operator =(benchmark_cpu_pinning const &) = delete;
+
+		/// @brief Destructor, restore the previous affinity
+		~benchmark_cpu_pinning()
+		{
+			#ifdef hnc_linux
+				if (m_pinned) { sched_setaffinity(0, sizeof(cpu_set_t), &m_previous); }
+			#endif
+		}
+
+		/// @brief Return true if the calling thread is pinned
+		/// @return true if the calling thread is pinned, false otherwise
+		bool pinned() const { return m_pinned; }
+	};
+}
+
+#endif
@@ -0,0 +1,252 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_SCALING_HPP
+#define HNC_BENCHMARK_SCALING_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <functional>
+#include <tuple>
+#include <algorithm>
+
+#include "benchmark.hpp"
+#include "benchmark_size_sweep.hpp"
+#include "gnuplot.hpp"
+#include "tabular.hpp"
+#include "openmp.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Return the numbers of threads 1, 2, 4, ..., max (max is always in the range)
+	 *
+	 * @code
+	   #include <hnc/benchmark_scaling.hpp>
+	   @endcode
+	 *
+	 * @param[in] max Maximum number of threads (hnc::openmp::nb_thread_max() by default)
+	 *
+	 * @return the numbers of threads
+	 */
+	inline std::vector<std::size_t> benchmark_nb_threads(std::size_t const max = std::max(hnc::openmp::nb_thread_max(), std::size_t(1)))
+	{
+		return hnc::benchmark_sizes(1, std::max(max, std::size_t(1)));
+	}
+
+	/**
+	 * @brief Return the serial fraction of the Amdahl's law which fits the speedups
+	 *
+	 * @code
+	   #include <hnc/benchmark_scaling.hpp>
+	   @endcode
+	 *
+	 * The Amdahl's law is @f$ S(p) = \frac{1}{f + \frac{1 - f}{p}} @f$ with @f$ f @f$ the serial fraction @n
+	 * so @f$ \frac{1}{S(p)} - \frac{1}{p} = f \left(1 - \frac{1}{p}\right) @f$ and @f$ f @f$ is fitted with least squares
+	 *
+	 * http://en.wikipedia.org/wiki/Amdahl%27s_law
+	 *
+	 * @param[in] speedups Speedups by number of threads
+	 *
+	 * @return the serial fraction in [0, 1] (0 if there is no speedup with more than one thread)
+	 */
+	inline long double benchmark_amdahl_serial_fraction(std::map<std::size_t, long double> const & speedups)
+	{
+		long double sum_xy = 0;
+		long double sum_xx = 0;
+		for (auto const & p_speedup : speedups)
+		{
+			if (p_speedup.first <= 1 || p_speedup.second <= 0) { continue; }
+			long double const p = (long double)(p_speedup.first);
+			long double const x = 1 - 1 / p;
+			long double const y = 1 / p_speedup.second - 1 / p;
+			sum_xy += x * y;
+			sum_xx += x * x;
+		}
+		if (sum_xx == 0) { return 0; }
+		return std::min(std::max(sum_xy / sum_xx, 0.L), 1.L);
+	}
+
+	/// @brief Return the speedup of the Amdahl's law
+	/// @param[in] serial_fraction Serial fraction
+	/// @param[in] nb_thread       Number of threads
+	/// @return the speedup of the Amdahl's law
+	inline long double benchmark_amdahl_speedup(long double const serial_fraction, std::size_t const nb_thread)
+	{
+		return 1 / (serial_fraction + (1 - serial_fraction) / (long double)(nb_thread));
+	}
+
+	/**
+	 * @brief Performs a benchmark of a workload with 1 to N threads
+	 *
+	 * @code
+	   #include <hnc/benchmark_scaling.hpp>
+	   @endcode
+	 *
+	 * For each number of threads p, the workload is run nb_run times @n
+	 * The number of threads is given to the workload and, if set_openmp is true, set for OpenMP with omp_set_num_threads
+	 * (the previous maximum number of OpenMP threads is restored at the end)
+	 *
+	 * From the medians @f$ T(p) @f$, with @f$ p_0 @f$ the lowest number of threads (1 in general):
+	 * - speedup @f$ S(p) = p_0 \frac{T(p_0)}{T(p)} @f$
+	 * - parallel efficiency @f$ E(p) = \frac{S(p)}{p} @f$
+	 * - serial fraction of the Amdahl's law (see hnc::benchmark_amdahl_serial_fraction)
+	 *
+	 * Output:
+	 * - raw times in a hnc::benchmark: the keys are the numbers of threads (padded with spaces, see hnc::benchmark_size_key)
+	 * - a Gnuplot with the speedup, the ideal speedup and the speedup of the Amdahl's law in a hnc::gnuplot::gnuplot_lines
+	 * - a tabular with the median time, the speedup and the efficiency for each number of threads
+	 * - the serial fraction
+	 *
+	 * @param[in] workload                A function of the number of threads
+	 * @param[in] nb_threads              Numbers of threads (see hnc::benchmark_nb_threads)
+	 * @param[in] title                   Title for Gnuplot and tabular
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 * @param[in] nb_run                  Number of runs for each number of threads
+	 * @param[in] set_openmp              Set the number of OpenMP threads (true by default)
+	 *
+	 * Example:
+	 * @code
+	   std::vector<double> v(10000000, 1.);
+	   auto benchmark_scaling = hnc::benchmark_scaling
+	   (
+	   	[&](std::size_t const) -> void
+	   	{
+	   		#pragma omp parallel for
+	   		for (std::size_t i = 0; i < v.size(); ++i) { v[i] = std::sqrt(v[i]); }
+	   	},
+	   	hnc::benchmark_nb_threads(),
+	   	"Title",
+	   	"hnc_benchmark_scaling_gnuplot",
+	   	5
+	   );
+	   hnc::benchmark const & benchmark = std::get<0>(benchmark_scaling);
+	   hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_scaling);
+	   hnc::tabular const & tabular = std::get<2>(benchmark_scaling);
+	   long double const serial_fraction = std::get<3>(benchmark_scaling);
+	   @endcode
+	 *
+	 * @return the benchmark with all times, the gnuplot with the speedups, the tabular and the serial fraction
+	 */
+	inline std::tuple
+	<
+		hnc::benchmark,
+		hnc::gnuplot::gnuplot_lines,
+		hnc::tabular,
+		long double
+	>
+	benchmark_scaling
+	(
+		std::function<void(std::size_t)> const & workload,
+		std::vector<std::size_t> const & nb_threads,
+		std::string const & title,
+		std::string const & gnuplot_output_filename,
+		std::size_t const nb_run = 1,
+		bool const set_openmp = true
+	)
+	{
+		// Benchmark
+		hnc::benchmark benchs;
+
+		// Width of the keys
+		std::size_t width = 0;
+		for (std::size_t const p : nb_threads) { width = std::max(width, hnc::to_string(p).size()); }
+
+		// Numbers of threads
+		#if defined(_OPENMP)
+			int const previous_nb_thread_max = omp_get_max_threads();
+		#endif
+		for (std::size_t const p : nb_threads)
+		{
+			#if defined(_OPENMP)
+				if (set_openmp) { omp_set_num_threads(int(p)); }
+			#else
+				(void)set_openmp;
+			#endif
+			auto & bench = benchs[hnc::benchmark_size_key(p, width)];
+			for (std::size_t run = 0; run < nb_run; ++run)
+			{
+				bench.start();
+				workload(p);
+				bench.stop();
+			}
+		}
+		#if defined(_OPENMP)
+			if (set_openmp) { omp_set_num_threads(previous_nb_thread_max); }
+		#endif
+
+		// Speedups and efficiencies
+		std::map<std::size_t, long double> const medians = hnc::benchmark_extract_median_by_size(benchs);
+		std::map<std::size_t, long double> speedups;
+		if (medians.empty() == false)
+		{
+			long double const p0 = (long double)(medians.begin()->first);
+			long double const t0 = medians.begin()->second;
+			for (auto const & p_median : medians)
+			{
+				speedups[p_median.first] = (p_median.second > 0) ? p0 * t0 / p_median.second : 0;
+			}
+		}
+		long double const serial_fraction = hnc::benchmark_amdahl_serial_fraction(speedups);
+
+		// Gnuplot
+		hnc::gnuplot::output_terminal_pdf const output_terminal(gnuplot_output_filename);
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label("Number of threads");
+		gp.set_y_label("Speedup");
+		std::map<std::string, long double> data_speedup;
+		std::map<std::string, long double> data_ideal;
+		std::map<std::string, long double> data_amdahl;
+		for (auto const & p_speedup : speedups)
+		{
+			std::string const key = hnc::benchmark_size_key(p_speedup.first, width);
+			data_speedup[key] = p_speedup.second;
+			data_ideal[key] = (long double)(p_speedup.first);
+			data_amdahl[key] = hnc::benchmark_amdahl_speedup(serial_fraction, p_speedup.first);
+		}
+		gp.add_line(data_speedup, "speedup");
+		gp.add_line(data_ideal, "ideal speedup");
+		gp.add_line(data_amdahl, "Amdahl speedup (serial fraction " + hnc::to_string(serial_fraction) + ")");
+
+		// Tabular
+		std::vector<std::string> tabular_header(1, "Number of threads");
+		std::vector<std::vector<std::string>> tabular_data
+		{
+			std::vector<std::string>(1, "time"),
+			std::vector<std::string>(1, "speedup"),
+			std::vector<std::string>(1, "efficiency")
+		};
+		for (auto const & p_speedup : speedups)
+		{
+			tabular_header.push_back(hnc::to_string(p_speedup.first));
+			tabular_data[0].push_back(hnc::to_string(medians.at(p_speedup.first)));
+			tabular_data[1].push_back(hnc::to_string(p_speedup.second));
+			tabular_data[2].push_back(hnc::to_string(p_speedup.second / (long double)(p_speedup.first)));
+		}
+		hnc::tabular tabular(tabular_data, title, tabular_header);
+
+		// Return
+		return std::make_tuple(benchs, gp, tabular, serial_fraction);
+	}
+}
+
+#endif
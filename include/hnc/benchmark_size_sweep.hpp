@@ -0,0 +1,248 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_BENCHMARK_SIZE_SWEEP_HPP
+#define HNC_BENCHMARK_SIZE_SWEEP_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <functional>
+#include <tuple>
+#include <stdexcept>
+
+#include "assert.hpp"
+#include "benchmark.hpp"
+#include "benchmark_functions.hpp"
+#include "benchmark_complexity.hpp"
+#include "gnuplot.hpp"
+#include "tabular.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Return a geometric range of sizes
+	 *
+	 * @code
+	   #include <hnc/benchmark_size_sweep.hpp>
+	   @endcode
+	 *
+	 * @code
+	   std::vector<std::size_t> sizes = hnc::benchmark_sizes(8, 1000); // { 8, 16, 32, 64, 128, 256, 512, 1000 }
+	   @endcode
+	 *
+	 * @param[in] min    Minimum size (>= 1)
+	 * @param[in] max    Maximum size (always in the range)
+	 * @param[in] factor Factor between two sizes (> 1, 2 by default)
+	 *
+	 * @exception std::invalid_argument hnc::hassert min >= 1 and factor > 1 if NDEBUG is not defined
+	 *
+	 * @return a geometric range of sizes
+	 */
+	inline std::vector<std::size_t> benchmark_sizes(std::size_t const min, std::size_t const max, double const factor = 2.)
+	{
+		#ifndef NDEBUG
+			hnc::hassert(min >= 1 && factor > 1., std::invalid_argument("hnc::benchmark_sizes, minimum size must be >= 1 and factor must be > 1"));
+		#endif
+
+		std::vector<std::size_t> r;
+		for (double n = double(min); n < double(max); n *= factor)
+		{
+			std::size_t const size = std::size_t(n + 0.5);
+			if (r.empty() || size > r.back()) { r.push_back(size); }
+		}
+		if (r.empty() || max > r.back()) { r.push_back(max); }
+		return r;
+	}
+
+	/// @brief Return the option key of a size in a size sweep (padded with spaces to keep the std::map sorted by size)
+	/// @param[in] n     Size
+	/// @param[in] width Number of characters (the number of digits of the maximum size)
+	/// @return the option key of a size
+	inline std::string benchmark_size_key(std::size_t const n, std::size_t const width)
+	{
+		std::string const r = hnc::to_string(n);
+		return (r.size() < width) ? std::string(width - r.size(), ' ') + r : r;
+	}
+
+	/**
+	 * @brief Return the medians by size of a size sweep (see hnc::benchmark_size_sweep)
+	 *
+	 * @code
+	   #include <hnc/benchmark_size_sweep.hpp>
+	   @endcode
+	 *
+	 * @param[in] benchs Benchmarks of one version (the options are the sizes)
+	 *
+	 * @return the medians by size
+	 */
+	template <class clock_t>
+	std::map<std::size_t, long double> benchmark_extract_median_by_size(std::map<std::string, hnc::benchmark_base_t<clock_t>> const & benchs)
+	{
+		std::map<std::size_t, long double> r;
+		for (auto const & size_bench : benchs)
+		{
+			r[std::size_t(std::stoull(size_bench.first))] = size_bench.second.median();
+		}
+		return r;
+	}
+
+	/**
+	 * @brief Performs a benchmark of some functions of a size on a range of sizes and fits the complexity
+	 *
+	 * @code
+	   #include <hnc/benchmark_size_sweep.hpp>
+	   @endcode
+	 *
+	 * For each version and each size, the function is run nb_run times @n
+	 * The medians by size are fitted to O(1), O(log n), O(n), O(n log n) and O(n²) (see hnc::benchmark_complexity_fits)
+	 *
+	 * Output:
+	 * - raw times in a hnc::benchmark_name_opt: [name][size] (the sizes are padded with spaces, see hnc::benchmark_size_key)
+	 * - a Gnuplot with the median by size of each version and the best complexity model in a hnc::gnuplot::gnuplot_lines
+	 * - a tabular with the goodness of fit (relative root mean square error, lower is better) of each model for each version and the best model
+	 *
+	 * @param[in] versions_with_name      A std::vector of { function of the size, name }
+	 * @param[in] sizes                   Sizes (see hnc::benchmark_sizes)
+	 * @param[in] title                   Title for Gnuplot and tabular
+	 * @param[in] gnuplot_output_filename Gnuplot output file
+	 * @param[in] nb_run                  Number of runs for each version and each size
+	 * @param[in] x_label                 Gnuplot x label ("Size" by default)
+	 * @param[in] y_label                 Gnuplot y label ("Time (in second)" by default)
+	 * @param[in] min_sample_time         If > 0, each sample is a batch of iterations which takes at least min_sample_time seconds (see hnc::benchmark_calibrate)
+	 *
+	 * Example:
+	 * @code
+	   std::vector<int> v;
+	   auto benchmark_size_sweep = hnc::benchmark_size_sweep
+	   (
+	   	{
+	   		{ [&](std::size_t const n) -> void { v.assign(n, 1); std::sort(v.begin(), v.end()); }, "sort" },
+	   		{ [&](std::size_t const n) -> void { v.assign(n, 1); hnc::do_not_optimize(std::find(v.begin(), v.end(), 0)); }, "find" }
+	   	},
+	   	hnc::benchmark_sizes(1024, 1024 * 1024),
+	   	"Title",
+	   	"hnc_benchmark_size_sweep_gnuplot",
+	   	3
+	   );
+	   hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_size_sweep);
+	   hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_size_sweep);
+	   hnc::tabular const & tabular = std::get<2>(benchmark_size_sweep);
+
+	   // Complexity of a version
+	   std::cout << hnc::benchmark_complexity_best_fit(hnc::benchmark_extract_median_by_size(benchmark.at("find"))).complexity << std::endl;
+	   @endcode
+	 *
+	 * @return the benchmark with all times, the gnuplot with the medians and the tabular with the goodness of fit
+	 */
+	inline std::tuple
+	<
+		hnc::benchmark_name_opt,
+		hnc::gnuplot::gnuplot_lines,
+		hnc::tabular
+	>
+	benchmark_size_sweep
+	(
+		std::vector<std::pair<std::function<void(std::size_t)>, std::string>> const & versions_with_name,
+		std::vector<std::size_t> const & sizes,
+		std::string const & title,
+		std::string const & gnuplot_output_filename,
+		std::size_t const nb_run = 1,
+		std::string const & x_label = "Size",
+		std::string const & y_label = "Time (in second)",
+		long double const min_sample_time = 0
+	)
+	{
+		// Benchmark
+		hnc::benchmark_name_opt benchs;
+
+		// Width of the size keys
+		std::size_t width = 0;
+		for (std::size_t const n : sizes) { width = std::max(width, hnc::to_string(n).size()); }
+
+		// Versions
+		for (auto const & version_with_name : versions_with_name)
+		{
+			auto const & version = version_with_name.first;
+			auto const & name = version_with_name.second;
+
+			// Sizes
+			for (std::size_t const n : sizes)
+			{
+				auto & bench = benchs[name][hnc::benchmark_size_key(n, width)];
+				std::function<void()> const version_n = [&]() -> void { version(n); };
+				std::size_t const nb_iteration = (min_sample_time > 0) ? hnc::benchmark_calibrate(version_n, min_sample_time) : 1;
+				// Runs
+				for (std::size_t run = 0; run < nb_run; ++run)
+				{
+					bench.start();
+					for (std::size_t i = 0; i < nb_iteration; ++i) { version(n); }
+					bench.stop(nb_iteration);
+				}
+			}
+		}
+
+		// Gnuplot
+		hnc::gnuplot::output_terminal_pdf const output_terminal(gnuplot_output_filename);
+		hnc::gnuplot::gnuplot_lines gp(output_terminal);
+		gp.set_title(title);
+		gp.set_x_label(x_label);
+		gp.set_y_label(y_label);
+
+		// Tabular header
+		std::vector<std::string> tabular_header(1, "");
+		for (auto const complexity : hnc::complexities()) { tabular_header.push_back(hnc::to_string(complexity)); }
+		tabular_header.push_back("best");
+
+		// Fit
+		std::vector<std::vector<std::string>> tabular_data;
+		for (auto const & name_benchs : benchs)
+		{
+			auto const & name = name_benchs.first;
+			std::map<std::size_t, long double> const medians = hnc::benchmark_extract_median_by_size(name_benchs.second);
+			std::vector<hnc::complexity_fit> const fits = hnc::benchmark_complexity_fits(medians);
+			hnc::complexity_fit const best = hnc::benchmark_complexity_best_fit(medians);
+
+			// Tabular
+			tabular_data.emplace_back(1, name);
+			for (auto const & fit : fits) { tabular_data.back().push_back(hnc::to_string(fit.rms)); }
+			tabular_data.back().push_back(hnc::to_string(best.complexity));
+
+			// Gnuplot
+			std::map<std::string, long double> data;
+			std::map<std::string, long double> data_fit;
+			for (auto const & n_median : medians)
+			{
+				data[hnc::benchmark_size_key(n_median.first, width)] = n_median.second;
+				data_fit[hnc::benchmark_size_key(n_median.first, width)] = best((long double)(n_median.first));
+			}
+			gp.add_line(data, name);
+			gp.add_line(data_fit, name + " " + hnc::to_string(best.complexity));
+		}
+
+		// Tabular
+		hnc::tabular tabular(tabular_data, title, tabular_header);
+
+		// Return
+		return std::make_tuple(benchs, gp, tabular);
+	}
+}
+
+#endif
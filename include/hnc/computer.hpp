@@ -19,11 +19,20 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <vector>
+#include <set>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <thread>
 
 #ifdef hnc_unix
 	#include <sys/utsname.h>
 	#include <sys/types.h>
-	#include <sys/sysctl.h>
+	#ifndef hnc_linux
+		#include <sys/sysctl.h>
+	#endif
 #endif
 
 #ifdef hnc_windows
@@ -256,6 +265,291 @@ namespace hnc
 				
 			#endif
 		}
+		
+		/**
+		 * @brief Cache of a processor
+		 *
+		 * @code
+		   #include <hnc/computer.hpp>
+		   @endcode
+		 */
+		class cache_t
+		{
+		public:
+			
+			/// Level (1 for L1, 2 for L2, ...)
+			std::size_t level;
+			
+			/// Type ("Data", "Instruction" or "Unified")
+			std::string type;
+			
+			/// Size in bytes
+			std::size_t size;
+			
+			/// Line size in bytes
+			std::size_t line_size;
+			
+			/// Number of ways of associativity (0 if unknown)
+			std::size_t associativity;
+			
+			/// Logical cores sharing this cache
+			std::vector<std::size_t> shared_logical_cores;
+		};
+		
+		/**
+		 * @brief Topology of the computer: cores, caches and NUMA nodes
+		 *
+		 * @code
+		   #include <hnc/computer.hpp>
+		   @endcode
+		 *
+		 * See hnc::computer::topology
+		 */
+		class topology_t
+		{
+		public:
+			
+			/// Number of logical cores (hardware threads)
+			std::size_t nb_logical_core;
+			
+			/// Number of physical cores
+			std::size_t nb_physical_core;
+			
+			/// Number of packages (sockets)
+			std::size_t nb_package;
+			
+			/// Logical cores of each physical core (SMT siblings)
+			std::vector<std::vector<std::size_t>> physical_cores;
+			
+			/// Caches of the first logical core (sorted by level)
+			std::vector<hnc::computer::cache_t> caches;
+			
+			/// Logical cores of each NUMA node (empty if unknown)
+			std::vector<std::vector<std::size_t>> numa_nodes;
+			
+			/// @brief Return the maximum number of logical cores per physical core (SMT, 1 without SMT)
+			/// @return the maximum number of logical cores per physical core
+			std::size_t nb_smt() const
+			{
+				std::size_t r = 1;
+				for (auto const & siblings : physical_cores) { r = std::max(r, siblings.size()); }
+				return r;
+			}
+			
+			/// @brief Return the number of NUMA nodes (1 if unknown)
+			/// @return the number of NUMA nodes
+			std::size_t nb_numa_node() const { return std::max(numa_nodes.size(), std::size_t(1)); }
+			
+			/// @brief Return the size of the data (or unified) cache of a level
+			/// @param[in] level Level (1 for L1, 2 for L2, ...)
+			/// @return the size in bytes of the data (or unified) cache of the level, 0 if unknown
+			std::size_t cache_size(std::size_t const level) const
+			{
+				for (auto const & cache : caches)
+				{
+					if (cache.level == level && cache.type != "Instruction") { return cache.size; }
+				}
+				return 0;
+			}
+			
+			/// @brief Return the cache line size
+			/// @return the line size in bytes of the first data (or unified) cache, 64 if unknown
+			std::size_t cache_line_size() const
+			{
+				for (auto const & cache : caches)
+				{
+					if (cache.type != "Instruction" && cache.line_size != 0) { return cache.line_size; }
+				}
+				return 64;
+			}
+			
+			/// @brief Return the topology in a std::string
+			/// @return the topology in a std::string
+			std::string to_string() const
+			{
+				std::string r;
+				r += "logical cores: " + hnc::to_string(nb_logical_core);
+				r += ", physical cores: " + hnc::to_string(nb_physical_core);
+				r += ", packages: " + hnc::to_string(nb_package);
+				r += ", SMT: " + hnc::to_string(nb_smt());
+				for (auto const & cache : caches)
+				{
+					r += ", L" + hnc::to_string(cache.level);
+					if (cache.type == "Data") { r += "d"; }
+					else if (cache.type == "Instruction") { r += "i"; }
+					r += ": " + hnc::to_string(cache.size / 1024) + " KiB";
+				}
+				r += ", line: " + hnc::to_string(cache_line_size()) + " B";
+				r += ", NUMA nodes: " + hnc::to_string(nb_numa_node());
+				return r;
+			}
+		};
+		
+		/// @brief Display a hnc::computer::topology_t
+		/// @param[in,out] o        Output stream
+		/// @param[in]     topology A hnc::computer::topology_t
+		/// @return the output stream
+		inline std::ostream & operator <<(std::ostream & o, hnc::computer::topology_t const & topology)
+		{
+			return o << topology.to_string();
+		}
+		
+		/**
+		 * @brief Internal functions to read the topology from sysfs
+		 *
+		 * @code
+		   #include <hnc/computer.hpp>
+		   @endcode
+		 */
+		namespace sysfs
+		{
+			/// @brief Return the first line of a file (without the trailing whitespaces)
+			/// @param[in] filename Filename
+			/// @return the first line of the file, an empty string if the file can not be read
+			inline std::string read_line(std::string const & filename)
+			{
+				std::ifstream f(filename);
+				std::string r;
+				std::getline(f, r);
+				while (r.empty() == false && (r.back() == ' ' || r.back() == '\n' || r.back() == '\r' || r.back() == '\t')) { r.pop_back(); }
+				return r;
+			}
+			
+			/// @brief Return a number read in a file
+			/// @param[in] filename Filename
+			/// @param[in] fallback Value if the file can not be read
+			/// @return the number read in the file
+			inline std::size_t read_number(std::string const & filename, std::size_t const fallback)
+			{
+				std::istringstream line(hnc::computer::sysfs::read_line(filename));
+				std::size_t r = 0;
+				if (line >> r) { return r; }
+				return fallback;
+			}
+			
+			/// @brief Return a size ("32K", "8192K", "1M") in bytes
+			/// @param[in] s A size
+			/// @return the size in bytes, 0 if it can not be read
+			inline std::size_t read_size(std::string const & s)
+			{
+				std::istringstream in(s);
+				std::size_t r = 0;
+				if (!(in >> r)) { return 0; }
+				char unit = '\0';
+				if (in >> unit)
+				{
+					if (unit == 'K' || unit == 'k') { r *= 1024; }
+					else if (unit == 'M' || unit == 'm') { r *= 1024 * 1024; }
+					else if (unit == 'G' || unit == 'g') { r *= 1024 * 1024 * 1024; }
+				}
+				return r;
+			}
+			
+			/// @brief Return the numbers of a list ("0-3,8,10-11")
+			/// @param[in] s A list
+			/// @return the numbers of the list
+			inline std::vector<std::size_t> read_list(std::string const & s)
+			{
+				std::vector<std::size_t> r;
+				std::istringstream in(s);
+				std::string range;
+				while (std::getline(in, range, ','))
+				{
+					std::istringstream in_range(range);
+					std::size_t first = 0;
+					if (!(in_range >> first)) { continue; }
+					std::size_t last = first;
+					char dash = '\0';
+					if (in_range >> dash && dash == '-') { in_range >> last; }
+					for (std::size_t i = first; i <= last; ++i) { r.push_back(i); }
+				}
+				return r;
+			}
+		}
+		
+		/**
+		 * @brief Get the topology of the computer: logical and physical cores, SMT siblings, caches and NUMA nodes
+		 *
+		 * @code
+		   #include <hnc/computer.hpp>
+		   @endcode
+		 *
+		 * The topology is read from /sys/devices/system/cpu and /sys/devices/system/node (Linux) @n
+		 * If these files are not available, the number of logical cores is std::thread::hardware_concurrency(),
+		 * each logical core is a physical core and the caches are unknown
+		 *
+		 * @code
+		   hnc::computer::topology_t const topology = hnc::computer::topology();
+		   std::cout << topology << std::endl;
+		   std::size_t const l2 = topology.cache_size(2);           // Size of the L2 cache in bytes (0 if unknown)
+		   std::size_t const line_size = topology.cache_line_size(); // 64 if unknown
+		   @endcode
+		 *
+		 * @param[in] sys_path Path of the sysfs system directory ("/sys/devices/system" by default)
+		 *
+		 * @return the topology of the computer
+		 */
+		inline hnc::computer::topology_t topology(std::string const & sys_path = "/sys/devices/system")
+		{
+			hnc::computer::topology_t r;
+			
+			// Logical cores
+			std::string const cpu_path = sys_path + "/cpu";
+			std::vector<std::size_t> logical_cores = hnc::computer::sysfs::read_list(hnc::computer::sysfs::read_line(cpu_path + "/online"));
+			if (logical_cores.empty())
+			{
+				std::size_t const nb = std::max(std::size_t(std::thread::hardware_concurrency()), std::size_t(1));
+				for (std::size_t i = 0; i < nb; ++i) { logical_cores.push_back(i); }
+			}
+			r.nb_logical_core = logical_cores.size();
+			
+			// Physical cores (package id, core id) and packages
+			std::map<std::pair<std::size_t, std::size_t>, std::vector<std::size_t>> physical_cores;
+			std::set<std::size_t> packages;
+			for (std::size_t const logical_core : logical_cores)
+			{
+				std::string const topology_path = cpu_path + "/cpu" + hnc::to_string(logical_core) + "/topology";
+				std::size_t const package_id = hnc::computer::sysfs::read_number(topology_path + "/physical_package_id", 0);
+				// Without core id, each logical core is a physical core
+				std::size_t const core_id = hnc::computer::sysfs::read_number(topology_path + "/core_id", logical_core);
+				physical_cores[std::make_pair(package_id, core_id)].push_back(logical_core);
+				packages.insert(package_id);
+			}
+			for (auto const & physical_core : physical_cores) { r.physical_cores.push_back(physical_core.second); }
+			r.nb_physical_core = r.physical_cores.size();
+			r.nb_package = packages.size();
+			
+			// Caches of the first logical core
+			std::string const cache_path = cpu_path + "/cpu" + hnc::to_string(logical_cores.front()) + "/cache/index";
+			for (std::size_t index = 0; ; ++index)
+			{
+				std::string const index_path = cache_path + hnc::to_string(index);
+				std::size_t const level = hnc::computer::sysfs::read_number(index_path + "/level", 0);
+				if (level == 0) { break; }
+				hnc::computer::cache_t cache;
+				cache.level = level;
+				cache.type = hnc::computer::sysfs::read_line(index_path + "/type");
+				cache.size = hnc::computer::sysfs::read_size(hnc::computer::sysfs::read_line(index_path + "/size"));
+				cache.line_size = hnc::computer::sysfs::read_number(index_path + "/coherency_line_size", 0);
+				cache.associativity = hnc::computer::sysfs::read_number(index_path + "/ways_of_associativity", 0);
+				cache.shared_logical_cores = hnc::computer::sysfs::read_list(hnc::computer::sysfs::read_line(index_path + "/shared_cpu_list"));
+				r.caches.push_back(cache);
+			}
+			std::stable_sort
+			(
+				r.caches.begin(), r.caches.end(),
+				[](hnc::computer::cache_t const & c0, hnc::computer::cache_t const & c1) -> bool { return c0.level < c1.level; }
+			);
+			
+			// NUMA nodes
+			std::string const node_path = sys_path + "/node";
+			for (std::size_t const node : hnc::computer::sysfs::read_list(hnc::computer::sysfs::read_line(node_path + "/online")))
+			{
+				r.numa_nodes.push_back(hnc::computer::sysfs::read_list(hnc::computer::sysfs::read_line(node_path + "/node" + hnc::to_string(node) + "/cpulist")));
+			}
+			
+			return r;
+		}
 	}
 }
 
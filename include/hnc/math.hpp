@@ -26,11 +26,15 @@
 #include "math/combination.hpp"
 
 #include "math/gcd.hpp"
+#include "math/gemm.hpp"
 
 #include "math/geometric_mean.hpp"
 
+#include "math/hdr_histogram.hpp"
+
 #include "math/linear_equation.hpp"
 
+#include "math/mann_whitney_u.hpp"
 #include "math/mean.hpp"
 #include "math/median.hpp"
 
@@ -38,11 +42,19 @@
 
 #include "math/pi.hpp"
 
+#include "math/quantile_sketch.hpp"
+
 #include "math/relational_operator.hpp"
+#include "math/running_statistics.hpp"
 
 #include "math/standard_deviation.hpp"
+#include "math/stencil.hpp"
 #include "math/variance.hpp"
 
+#include "math/transpose.hpp"
+
+#include "math/vector2D_fixed.hpp"
+
 
 namespace hnc
 {
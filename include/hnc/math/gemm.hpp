@@ -0,0 +1,368 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#ifndef HNC_MATH_GEMM_HPP
+#define HNC_MATH_GEMM_HPP
+
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include "../vector2D.hpp"
+#include "../vector2D_view.hpp"
+#include "../computer.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief Block sizes of hnc::math::gemm
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * C += A * B is computed by blocks: a kc x nc block of B (packed, in the L3 cache),
+		 * a mc x kc block of A (packed, in the L2 cache) and micro-panels of kc values (in the L1 cache)
+		 */
+		class gemm_blocking_t
+		{
+		public:
+
+			/// Number of rows of the blocks of A (multiple of hnc::math::gemm_kernel::mr)
+			std::size_t mc;
+
+			/// Number of columns of the blocks of A, number of rows of the blocks of B
+			std::size_t kc;
+
+			/// Number of columns of the blocks of B (multiple of hnc::math::gemm_kernel::nr<T>())
+			std::size_t nc;
+		};
+
+		/// @brief Packing and micro-kernel of hnc::math::gemm
+		namespace gemm_kernel
+		{
+			/// Size of a vector register in bytes (instruction set known at compile time)
+			#if defined(__AVX512F__)
+				constexpr std::size_t vector_size = 64;
+			#elif defined(__AVX__)
+				constexpr std::size_t vector_size = 32;
+			#else
+				constexpr std::size_t vector_size = 16;
+			#endif
+
+			/// Number of rows of the micro-kernel
+			constexpr std::size_t mr = 4;
+
+			/// @brief Return the number of columns of the micro-kernel (2 vector registers by row, the mr x nr accumulator is 8 vector registers and does not spill)
+			/// @return the number of columns of the micro-kernel
+			template <class T>
+			constexpr std::size_t nr() { return (2 * vector_size > sizeof(T)) ? 2 * vector_size / sizeof(T) : 1; }
+
+			/// @brief Round up a value to a multiple
+			/// @param[in] n        A value
+			/// @param[in] multiple A multiple
+			/// @return the smallest multiple of multiple >= n
+			inline std::size_t round_up(std::size_t const n, std::size_t const multiple)
+			{
+				return (n + multiple - 1) / multiple * multiple;
+			}
+
+			/**
+			 * @brief Pack a block of A in micro-panels of mr rows (column-major in the micro-panel, padded with 0)
+			 *
+			 * @param[in]  a      A view on the block of A
+			 * @param[out] packed ceil(rows / mr) * mr * columns values
+			 */
+			template <class T_a, class T>
+			void pack_a(hnc::vector2D_view<T_a> const & a, T * packed)
+			{
+				std::size_t const m = a.nb_row();
+				std::size_t const k = a.nb_col();
+				for (std::size_t i_panel = 0; i_panel < m; i_panel += mr)
+				{
+					std::size_t const rows = std::min(mr, m - i_panel);
+					for (std::size_t p = 0; p < k; ++p)
+					{
+						T_a const * const a_col = a.data() + i_panel * a.row_stride() + p * a.col_stride();
+						for (std::size_t i = 0; i < rows; ++i) { packed[i] = a_col[i * a.row_stride()]; }
+						for (std::size_t i = rows; i < mr; ++i) { packed[i] = T(0); }
+						packed += mr;
+					}
+				}
+			}
+
+			/**
+			 * @brief Pack nr columns of a block of B (row-major in the micro-panel, padded with 0)
+			 *
+			 * @param[in]  b      A view on the block of B
+			 * @param[in]  j      First column of the micro-panel
+			 * @param[out] packed nr * rows values
+			 */
+			template <class T_b, class T>
+			void pack_b_panel(hnc::vector2D_view<T_b> const & b, std::size_t const j, T * packed)
+			{
+				std::size_t const cols = std::min(nr<T>(), b.nb_col() - j);
+				for (std::size_t p = 0; p < b.nb_row(); ++p)
+				{
+					T_b const * const b_row = b.data() + p * b.row_stride() + j * b.col_stride();
+					for (std::size_t jj = 0; jj < cols; ++jj) { packed[jj] = b_row[jj * b.col_stride()]; }
+					for (std::size_t jj = cols; jj < nr<T>(); ++jj) { packed[jj] = T(0); }
+					packed += nr<T>();
+				}
+			}
+
+			/**
+			 * @brief Micro-kernel: acc = a * b with a packed micro-panel of A (mr x kc) and a packed micro-panel of B (kc x nr)
+			 *
+			 * The accumulator is mr x nr values (in registers), the inner loop on nr contiguous values is vectorized by the compiler
+			 *
+			 * @param[in]  kc  Number of columns of a, number of rows of b
+			 * @param[in]  a   Packed micro-panel of A
+			 * @param[in]  b   Packed micro-panel of B
+			 * @param[out] acc Accumulator
+			 */
+			template <class T>
+			void micro_kernel(std::size_t const kc, T const * a, T const * b, T (&acc)[mr][nr<T>()])
+			{
+				// Local accumulator (acc could alias a and b, it would be loaded and stored at each iteration)
+				T r[mr][nr<T>()];
+				for (std::size_t i = 0; i < mr; ++i) { for (std::size_t j = 0; j < nr<T>(); ++j) { r[i][j] = T(0); } }
+				for (std::size_t p = 0; p < kc; ++p, a += mr, b += nr<T>())
+				{
+					for (std::size_t i = 0; i < mr; ++i)
+					{
+						T const a_i = a[i];
+						#pragma omp simd
+						for (std::size_t j = 0; j < nr<T>(); ++j) { r[i][j] = T(r[i][j] + a_i * b[j]); }
+					}
+				}
+				for (std::size_t i = 0; i < mr; ++i) { for (std::size_t j = 0; j < nr<T>(); ++j) { acc[i][j] = r[i][j]; } }
+			}
+
+			/**
+			 * @brief c += alpha * acc on a rows x cols tile of C
+			 *
+			 * @param[in]     alpha Scalar
+			 * @param[in]     acc   Accumulator of the micro-kernel
+			 * @param[in,out] c     A view on C
+			 * @param[in]     i     First row of the tile
+			 * @param[in]     j     First column of the tile
+			 */
+			template <class T>
+			void update_c(T const alpha, T const (&acc)[mr][nr<T>()], hnc::vector2D_view<T> const & c, std::size_t const i, std::size_t const j)
+			{
+				std::size_t const rows = std::min(mr, c.nb_row() - i);
+				std::size_t const cols = std::min(nr<T>(), c.nb_col() - j);
+				for (std::size_t ii = 0; ii < rows; ++ii)
+				{
+					T * const c_row = c.data() + (i + ii) * c.row_stride() + j * c.col_stride();
+					if (c.col_stride() == 1)
+					{
+						for (std::size_t jj = 0; jj < cols; ++jj) { c_row[jj] = T(c_row[jj] + alpha * acc[ii][jj]); }
+					}
+					else
+					{
+						for (std::size_t jj = 0; jj < cols; ++jj) { c_row[jj * c.col_stride()] = T(c_row[jj * c.col_stride()] + alpha * acc[ii][jj]); }
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Return the block sizes of hnc::math::gemm for a topology
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * - kc: a micro-panel of A and a micro-panel of B stay in the half of the L1 data cache (32 KiB if unknown)
+		 * - mc: a block of A stays in the half of the L2 cache (256 KiB if unknown)
+		 * - nc: a block of B stays in the half of the L3 cache (4 x L2 if unknown)
+		 *
+		 * @param[in] topology Topology of the computer (see hnc::computer::topology)
+		 *
+		 * @return the block sizes
+		 */
+		template <class T>
+		hnc::math::gemm_blocking_t gemm_blocking(hnc::computer::topology_t const & topology)
+		{
+			using namespace hnc::math::gemm_kernel;
+			std::size_t const l1 = (topology.cache_size(1) == 0) ? 32 * 1024 : topology.cache_size(1);
+			std::size_t const l2 = (topology.cache_size(2) == 0) ? 256 * 1024 : topology.cache_size(2);
+			std::size_t const l3 = (topology.cache_size(3) == 0) ? 4 * l2 : topology.cache_size(3);
+			hnc::math::gemm_blocking_t r;
+			r.kc = std::min(std::max(l1 / 2 / ((mr + nr<T>()) * sizeof(T)), std::size_t(16)), std::size_t(1024));
+			r.mc = std::min(std::max(l2 / 2 / (r.kc * sizeof(T)) / mr * mr, mr), std::size_t(1024));
+			r.nc = std::min(std::max(l3 / 2 / (r.kc * sizeof(T)) / nr<T>() * nr<T>(), nr<T>()), std::size_t(8192));
+			return r;
+		}
+
+		/// @brief Return the block sizes of hnc::math::gemm for this computer (the topology is detected once)
+		/// @return the block sizes
+		template <class T>
+		hnc::math::gemm_blocking_t gemm_blocking()
+		{
+			static hnc::math::gemm_blocking_t const blocking = hnc::math::gemm_blocking<T>(hnc::computer::topology());
+			return blocking;
+		}
+
+		/**
+		 * @brief General matrix multiplication: C = alpha * A * B + beta * C
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * Tiled (see hnc::math::gemm_blocking) and parallel (OpenMP) implementation: @n
+		 * the blocks of A and B are packed in contiguous micro-panels, a micro-kernel computes
+		 * hnc::math::gemm_kernel::mr x hnc::math::gemm_kernel::nr<T>() values of C in registers (the inner loop is vectorized by the compiler)
+		 *
+		 * For float, double and integer types (no overflow check)
+		 *
+		 * @code
+		   hnc::vector2D<double> a(1000, 500, 1.);
+		   hnc::vector2D<double> b(500, 2000, 2.);
+		   hnc::vector2D<double> c(1000, 2000);
+		   hnc::math::gemm(1., a.view(), b.view(), 0., c.view());
+		   // C += A * transpose(B) without copy
+		   hnc::math::gemm(1., a.view(), b2.transposed_view(), 1., c.view());
+		   @endcode
+		 *
+		 * @param[in]     alpha    Scalar
+		 * @param[in]     a        A hnc::vector2D_view (m x k)
+		 * @param[in]     b        A hnc::vector2D_view (k x n)
+		 * @param[in]     beta     Scalar (if beta is 0, C is not read)
+		 * @param[in,out] c        A hnc::vector2D_view (m x n, must not overlap a and b)
+		 * @param[in]     blocking Block sizes (hnc::math::gemm_blocking<T>() by default)
+		 *
+		 * @exception std::invalid_argument hnc::hassert the sizes are compatible if NDEBUG is not defined
+		 */
+		template <class T_a, class T_b, class T>
+		void gemm
+		(
+			T const alpha,
+			hnc::vector2D_view<T_a> const & a,
+			hnc::vector2D_view<T_b> const & b,
+			T const beta,
+			hnc::vector2D_view<T> const & c,
+			hnc::math::gemm_blocking_t const & blocking = hnc::math::gemm_blocking<T>()
+		)
+		{
+			static_assert(std::is_arithmetic<T>::value, "hnc::math::gemm is for float, double and integer types");
+			using namespace hnc::math::gemm_kernel;
+
+			#ifndef NDEBUG
+				hnc::hassert(a.nb_col() == b.nb_row() && c.nb_row() == a.nb_row() && c.nb_col() == b.nb_col(), std::invalid_argument("hnc::math::gemm, incompatible sizes: A is " + hnc::to_string(a.nb_row()) + " x " + hnc::to_string(a.nb_col()) + ", B is " + hnc::to_string(b.nb_row()) + " x " + hnc::to_string(b.nb_col()) + ", C is " + hnc::to_string(c.nb_row()) + " x " + hnc::to_string(c.nb_col())));
+			#endif
+
+			std::size_t const m = c.nb_row();
+			std::size_t const n = c.nb_col();
+			std::size_t const k = a.nb_col();
+
+			// C = beta * C
+			if (beta != T(1))
+			{
+				#pragma omp parallel for
+				for (long int i = 0; i < long(m); ++i)
+				{
+					auto const row = c.row(std::size_t(i));
+					if (beta == T(0)) { row.fill(T(0)); }
+					else { for (std::size_t j = 0; j < n; ++j) { row[j] = T(beta * row[j]); } }
+				}
+			}
+			if (m == 0 || n == 0 || k == 0 || alpha == T(0)) { return; }
+
+			// Block sizes (not larger than the matrices)
+			std::size_t const mc = std::min(round_up(std::max(blocking.mc, std::size_t(1)), mr), round_up(m, mr));
+			std::size_t const kc = std::min(std::max(blocking.kc, std::size_t(1)), k);
+			std::size_t const nc = std::min(round_up(std::max(blocking.nc, std::size_t(1)), nr<T>()), round_up(n, nr<T>()));
+
+			// Packed block of B (shared)
+			std::vector<T> b_packed(kc * nc);
+
+			#pragma omp parallel
+			{
+				// Packed block of A (one by thread)
+				std::vector<T> a_packed(mc * kc);
+				T acc[mr][nr<T>()];
+
+				for (std::size_t jc = 0; jc < n; jc += nc)
+				{
+					std::size_t const nc_cur = std::min(nc, n - jc);
+					for (std::size_t pc = 0; pc < k; pc += kc)
+					{
+						std::size_t const kc_cur = std::min(kc, k - pc);
+
+						// Pack the block of B
+						auto const b_block = b.sub_view(pc, jc, kc_cur, nc_cur);
+						long int const nb_b_panel = long((nc_cur + nr<T>() - 1) / nr<T>());
+						#pragma omp for
+						for (long int jr = 0; jr < nb_b_panel; ++jr)
+						{
+							pack_b_panel(b_block, std::size_t(jr) * nr<T>(), b_packed.data() + std::size_t(jr) * nr<T>() * kc_cur);
+						}
+
+						// Blocks of A
+						long int const nb_a_block = long((m + mc - 1) / mc);
+						#pragma omp for schedule(dynamic)
+						for (long int ic_block = 0; ic_block < nb_a_block; ++ic_block)
+						{
+							std::size_t const ic = std::size_t(ic_block) * mc;
+							std::size_t const mc_cur = std::min(mc, m - ic);
+							pack_a(a.sub_view(ic, pc, mc_cur, kc_cur), a_packed.data());
+							auto const c_block = c.sub_view(ic, jc, mc_cur, nc_cur);
+							// Micro-panels
+							for (std::size_t jr = 0; jr < nc_cur; jr += nr<T>())
+							{
+								T const * const b_panel = b_packed.data() + jr * kc_cur;
+								for (std::size_t ir = 0; ir < mc_cur; ir += mr)
+								{
+									micro_kernel(kc_cur, a_packed.data() + ir * kc_cur, b_panel, acc);
+									update_c(alpha, acc, c_block, ir, jr);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+
+		/// @brief Return the product of two matrices (tiled and parallel, see hnc::math::gemm)
+		/// @param[in] a A hnc::vector2D (m x k)
+		/// @param[in] b A hnc::vector2D (k x n)
+		/// @exception std::invalid_argument hnc::hassert a.nb_col() == b.nb_row() if NDEBUG is not defined
+		/// @return a * b (m x n)
+		template <class T, class storage_t>
+		hnc::vector2D<T, storage_t> multiply(hnc::vector2D<T, storage_t> const & a, hnc::vector2D<T, storage_t> const & b)
+		{
+			hnc::vector2D<T, storage_t> c(a.nb_row(), b.nb_col());
+			hnc::math::gemm(T(1), a.view(), b.view(), T(0), c.view());
+			return c;
+		}
+	}
+}
+
+#endif
@@ -89,6 +89,21 @@ namespace hnc
 		{
 			return hnc::math::geometric_mean(c.begin(), c.end());
 		}
+
+		/**
+		 * @brief Geometric mean of the values of a range (a hnc::vector2D_view, a row or a column of a matrix, ...)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * @param[in] r A range with begin() and end() (with a size >= 1)
+		 *
+		 * @return the geometric mean
+		 */
+		template <class range_t>
+		auto geometric_mean(range_t const & r) -> decltype(hnc::math::geometric_mean(r.begin(), r.end()))
+		{ return hnc::math::geometric_mean(r.begin(), r.end()); }
 	}
 }
 
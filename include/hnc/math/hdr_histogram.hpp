@@ -0,0 +1,434 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_MATH_HDR_HISTOGRAM_HPP
+#define HNC_MATH_HDR_HISTOGRAM_HPP
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../assert.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief High Dynamic Range histogram: log-linear buckets of integer values (latencies in nanoseconds for example)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The range [lowest discernible value, highest trackable value] is split in buckets of powers of two,
+		 * each bucket is split in linear sub-buckets, so each value is counted with a relative error
+		 * @f$ \leq 10^{-\text{significant digits}} @f$ (HdrHistogram semantics) @n
+		 * All the counts are allocated in the constructor:
+		 * record is O(1) and never allocates, the memory is bounded
+		 *
+		 * http://hdrhistogram.org
+		 *
+		 * Two histograms with the same parameters can be merged (for example, one per thread)
+		 *
+		 * @code
+		   hnc::math::hdr_histogram h(3600000000000, 3); // 1 ns to 1 hour, 3 significant digits
+		   h.record(1500);
+		   h.record(2000);
+		   h.record(1000000);
+		   std::cout << h.value_at_percentile(50) << std::endl;   // 2000 (+/- 0.1%)
+		   std::cout << h.value_at_percentile(99.9) << std::endl; // 1000000 (+/- 0.1%)
+		   @endcode
+		 *
+		 * Values greater than the highest trackable value are counted as the highest trackable value (see nb_saturated)
+		 */
+		class hdr_histogram
+		{
+		private:
+
+			/// Lowest discernible value
+			std::uint64_t m_lowest_discernible_value;
+
+			/// Highest trackable value
+			std::uint64_t m_highest_trackable_value;
+
+			/// Number of significant digits
+			int m_significant_digits;
+
+			/// log2 of the lowest discernible value (rounded down)
+			int m_unit_magnitude;
+
+			/// Number of sub-buckets in a bucket
+			std::uint64_t m_sub_bucket_count;
+
+			/// Half of the number of sub-buckets
+			std::uint64_t m_sub_bucket_half_count;
+
+			/// log2 of the half of the number of sub-buckets
+			int m_sub_bucket_half_count_magnitude;
+
+			/// Mask of the values in the first bucket
+			std::uint64_t m_sub_bucket_mask;
+
+			/// Number of buckets
+			int m_bucket_count;
+
+			/// Counts
+			std::vector<std::uint64_t> m_counts;
+
+			/// Number of values
+			std::uint64_t m_total_count;
+
+			/// Number of values greater than the highest trackable value
+			std::uint64_t m_nb_saturated;
+
+			/// Minimum value
+			std::uint64_t m_min;
+
+			/// Maximum value
+			std::uint64_t m_max;
+
+		public:
+
+			/// @brief Default constructor, histogram without any count (use the other constructor to record values)
+			hdr_histogram() :
+				m_lowest_discernible_value(1),
+				m_highest_trackable_value(0),
+				m_significant_digits(0),
+				m_unit_magnitude(0),
+				m_sub_bucket_count(0),
+				m_sub_bucket_half_count(0),
+				m_sub_bucket_half_count_magnitude(0),
+				m_sub_bucket_mask(0),
+				m_bucket_count(0),
+				m_counts(),
+				m_total_count(0),
+				m_nb_saturated(0),
+				m_min(std::numeric_limits<std::uint64_t>::max()),
+				m_max(0)
+			{ }
+
+			/**
+			 * @brief Constructor
+			 * @param[in] highest_trackable_value  Highest trackable value (>= 2 * lowest_discernible_value)
+			 * @param[in] significant_digits       Number of significant digits in [1, 5] (3 by default, 0.1%)
+			 * @param[in] lowest_discernible_value Lowest discernible value (>= 1, 1 by default)
+			 * @exception std::invalid_argument hnc::hassert the parameters are valid if NDEBUG is not defined
+			 */
+			explicit hdr_histogram
+			(
+				std::uint64_t const highest_trackable_value,
+				int const significant_digits = 3,
+				std::uint64_t const lowest_discernible_value = 1
+			) :
+				hdr_histogram()
+			{
+				#ifndef NDEBUG
+					hnc::hassert(lowest_discernible_value >= 1, std::invalid_argument("hnc::math::hdr_histogram, lowest discernible value must be >= 1"));
+					hnc::hassert(highest_trackable_value / 2 >= lowest_discernible_value, std::invalid_argument("hnc::math::hdr_histogram, highest trackable value must be >= 2 * lowest discernible value"));
+					hnc::hassert(significant_digits >= 1 && significant_digits <= 5, std::invalid_argument("hnc::math::hdr_histogram, number of significant digits must be in [1, 5]"));
+				#endif
+
+				m_lowest_discernible_value = lowest_discernible_value;
+				m_highest_trackable_value = highest_trackable_value;
+				m_significant_digits = significant_digits;
+
+				// Sub-buckets: enough to have 1 unit of resolution for 2 * 10^significant_digits
+				std::uint64_t largest_value_with_single_unit_resolution = 2;
+				for (int i = 0; i < significant_digits; ++i) { largest_value_with_single_unit_resolution *= 10; }
+				int sub_bucket_count_magnitude = 0;
+				while ((std::uint64_t(1) << sub_bucket_count_magnitude) < largest_value_with_single_unit_resolution) { ++sub_bucket_count_magnitude; }
+				m_sub_bucket_half_count_magnitude = std::max(sub_bucket_count_magnitude, 1) - 1;
+				m_sub_bucket_count = std::uint64_t(1) << (m_sub_bucket_half_count_magnitude + 1);
+				m_sub_bucket_half_count = m_sub_bucket_count / 2;
+
+				while ((std::uint64_t(2) << m_unit_magnitude) <= lowest_discernible_value) { ++m_unit_magnitude; }
+				m_sub_bucket_mask = (m_sub_bucket_count - 1) << m_unit_magnitude;
+
+				// Buckets
+				std::uint64_t smallest_untrackable_value = m_sub_bucket_count << m_unit_magnitude;
+				m_bucket_count = 1;
+				while (smallest_untrackable_value <= highest_trackable_value)
+				{
+					if (smallest_untrackable_value > std::numeric_limits<std::uint64_t>::max() / 2) { ++m_bucket_count; break; }
+					smallest_untrackable_value <<= 1;
+					++m_bucket_count;
+				}
+
+				m_counts.assign(std::size_t(m_bucket_count + 1) * std::size_t(m_sub_bucket_half_count), 0);
+			}
+
+			/// @brief Return the lowest discernible value
+			/// @return the lowest discernible value
+			std::uint64_t lowest_discernible_value() const { return m_lowest_discernible_value; }
+
+			/// @brief Return the highest trackable value
+			/// @return the highest trackable value
+			std::uint64_t highest_trackable_value() const { return m_highest_trackable_value; }
+
+			/// @brief Return the number of significant digits
+			/// @return the number of significant digits
+			int significant_digits() const { return m_significant_digits; }
+
+			/// @brief Return the number of counts (memory used is nb_count() * 8 bytes)
+			/// @return the number of counts
+			std::size_t nb_count() const { return m_counts.size(); }
+
+			/// @brief Return the number of values
+			/// @return the number of values
+			std::uint64_t size() const { return m_total_count; }
+
+			/// @brief Return true if there is no value
+			/// @return true if there is no value, false otherwise
+			bool empty() const { return m_total_count == 0; }
+
+			/// @brief Return the number of values greater than the highest trackable value
+			/// @return the number of values greater than the highest trackable value
+			std::uint64_t nb_saturated() const { return m_nb_saturated; }
+
+			/// @brief Return the minimum value (exact)
+			/// @return the minimum value
+			std::uint64_t min() const { check_not_empty(); return m_min; }
+
+			/// @brief Return the maximum value (exact)
+			/// @return the maximum value
+			std::uint64_t max() const { check_not_empty(); return m_max; }
+
+			/**
+			 * @brief Record a value, in O(1) and without allocation
+			 * @param[in] value A value (counted as the highest trackable value if it is greater)
+			 * @param[in] count Number of times the value is recorded (1 by default)
+			 * @exception std::length_error hnc::hassert the histogram has counts (not default constructed) if NDEBUG is not defined
+			 */
+			void record(std::uint64_t value, std::uint64_t const count = 1)
+			{
+				#ifndef NDEBUG
+					hnc::hassert(m_counts.empty() == false, std::length_error("hnc::math::hdr_histogram::record, can not record in a default constructed histogram"));
+				#endif
+				if (value > m_highest_trackable_value) { value = m_highest_trackable_value; m_nb_saturated += count; }
+				m_counts[counts_index_of(value)] += count;
+				m_total_count += count;
+				m_min = std::min(m_min, value);
+				m_max = std::max(m_max, value);
+			}
+
+			/// @brief Merge with an other histogram
+			/// @param[in] h A hnc::math::hdr_histogram with the same parameters
+			/// @exception std::invalid_argument if the parameters are different
+			void merge(hnc::math::hdr_histogram const & h)
+			{
+				if
+				(
+					h.m_lowest_discernible_value != m_lowest_discernible_value ||
+					h.m_highest_trackable_value != m_highest_trackable_value ||
+					h.m_significant_digits != m_significant_digits
+				)
+				{
+					throw std::invalid_argument("hnc::math::hdr_histogram::merge, can not merge histograms with different parameters");
+				}
+				for (std::size_t i = 0; i < m_counts.size(); ++i) { m_counts[i] += h.m_counts[i]; }
+				m_total_count += h.m_total_count;
+				m_nb_saturated += h.m_nb_saturated;
+				m_min = std::min(m_min, h.m_min);
+				m_max = std::max(m_max, h.m_max);
+			}
+
+			/// @brief Remove all values (the counts are kept allocated)
+			void clear()
+			{
+				std::fill(m_counts.begin(), m_counts.end(), 0);
+				m_total_count = 0;
+				m_nb_saturated = 0;
+				m_min = std::numeric_limits<std::uint64_t>::max();
+				m_max = 0;
+			}
+
+			/// @brief Return the number of values equivalent to a value (in the same sub-bucket)
+			/// @param[in] value A value
+			/// @return the number of values equivalent to the value
+			std::uint64_t count_at_value(std::uint64_t const value) const
+			{
+				return m_counts[counts_index_of(std::min(value, m_highest_trackable_value))];
+			}
+
+			/// @brief Return the lowest value equivalent to a value (in the same sub-bucket)
+			/// @param[in] value A value
+			/// @return the lowest value equivalent to the value
+			std::uint64_t lowest_equivalent_value(std::uint64_t const value) const
+			{
+				int const bucket_index = get_bucket_index(value);
+				std::uint64_t const sub_bucket_index = get_sub_bucket_index(value, bucket_index);
+				return value_from_index(bucket_index, sub_bucket_index);
+			}
+
+			/// @brief Return the highest value equivalent to a value (in the same sub-bucket)
+			/// @param[in] value A value
+			/// @return the highest value equivalent to the value
+			std::uint64_t highest_equivalent_value(std::uint64_t const value) const
+			{
+				return lowest_equivalent_value(value) + size_of_equivalent_value_range(value) - 1;
+			}
+
+			/**
+			 * @brief Return the value at a percentile
+			 *
+			 * The value is the highest value equivalent to the value at the percentile, bounded by the exact maximum
+			 *
+			 * @param[in] percentile Percentile in [0, 100] (50 for the median, 99.9 for the 99.9th percentile)
+			 * @pre The histogram is not empty
+			 * @exception std::length_error hnc::hassert histogram is not empty if NDEBUG is not defined
+			 * @return the value at the percentile
+			 */
+			std::uint64_t value_at_percentile(double const percentile) const
+			{
+				check_not_empty();
+				double const p = std::min(std::max(percentile, 0.), 100.);
+				std::uint64_t const count_at_percentile = std::max
+				(
+					std::uint64_t(p / 100. * double(m_total_count) + 0.5),
+					std::uint64_t(1)
+				);
+				std::uint64_t total = 0;
+				for (std::size_t i = 0; i < m_counts.size(); ++i)
+				{
+					total += m_counts[i];
+					if (total >= count_at_percentile)
+					{
+						std::uint64_t const value = value_from_counts_index(i);
+						return std::max(std::min(highest_equivalent_value(value), m_max), m_min);
+					}
+				}
+				return m_max;
+			}
+
+			/// @brief Return the percentile of the values <= a value (cumulative distribution function)
+			/// @param[in] value A value
+			/// @return the percentile (in [0, 100]) of the values <= the value
+			double percentile_at_value(std::uint64_t const value) const
+			{
+				if (m_total_count == 0) { return 0; }
+				std::size_t const last = counts_index_of(std::min(value, m_highest_trackable_value));
+				std::uint64_t total = 0;
+				for (std::size_t i = 0; i <= last; ++i) { total += m_counts[i]; }
+				return 100. * double(total) / double(m_total_count);
+			}
+
+			/// @brief Return the approximate mean (with the middle of the sub-buckets)
+			/// @return the approximate mean
+			long double mean() const
+			{
+				check_not_empty();
+				long double sum = 0;
+				for (std::size_t i = 0; i < m_counts.size(); ++i)
+				{
+					if (m_counts[i] == 0) { continue; }
+					std::uint64_t const value = value_from_counts_index(i);
+					long double const median_equivalent_value = (long double)(value) + (long double)(size_of_equivalent_value_range(value)) / 2;
+					sum += median_equivalent_value * (long double)(m_counts[i]);
+				}
+				return sum / (long double)(m_total_count);
+			}
+
+		private:
+
+			/// @brief Check that the histogram is not empty
+			/// @exception std::length_error hnc::hassert histogram is not empty if NDEBUG is not defined
+			void check_not_empty() const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(m_total_count > 0, std::length_error("hnc::math::hdr_histogram, no value"));
+				#endif
+			}
+
+			/// @brief Return the bucket index of a value
+			/// @param[in] value A value
+			/// @return the bucket index of the value
+			int get_bucket_index(std::uint64_t const value) const
+			{
+				// Smallest power of two containing the value
+				std::uint64_t const v = value | m_sub_bucket_mask;
+				int pow2_ceiling = 0;
+				#if defined(__GNUC__) || defined(__clang__)
+					pow2_ceiling = 64 - __builtin_clzll((unsigned long long)(v));
+				#else
+					while (pow2_ceiling < 64 && (v >> pow2_ceiling) != 0) { ++pow2_ceiling; }
+				#endif
+				return pow2_ceiling - m_unit_magnitude - (m_sub_bucket_half_count_magnitude + 1);
+			}
+
+			/// @brief Return the sub-bucket index of a value
+			/// @param[in] value        A value
+			/// @param[in] bucket_index Bucket index of the value
+			/// @return the sub-bucket index of the value
+			std::uint64_t get_sub_bucket_index(std::uint64_t const value, int const bucket_index) const
+			{
+				return value >> (bucket_index + m_unit_magnitude);
+			}
+
+			/// @brief Return the index in the counts of a value
+			/// @param[in] value A value (<= highest trackable value)
+			/// @return the index in the counts of the value
+			std::size_t counts_index_of(std::uint64_t const value) const
+			{
+				int const bucket_index = get_bucket_index(value);
+				std::uint64_t const sub_bucket_index = get_sub_bucket_index(value, bucket_index);
+				return std::size_t((std::uint64_t(bucket_index + 1) << m_sub_bucket_half_count_magnitude) + (sub_bucket_index - m_sub_bucket_half_count));
+			}
+
+			/// @brief Return the lowest value of a sub-bucket
+			/// @param[in] bucket_index     Bucket index
+			/// @param[in] sub_bucket_index Sub-bucket index
+			/// @return the lowest value of the sub-bucket
+			std::uint64_t value_from_index(int const bucket_index, std::uint64_t const sub_bucket_index) const
+			{
+				return sub_bucket_index << (bucket_index + m_unit_magnitude);
+			}
+
+			/// @brief Return the lowest value of the sub-bucket at an index in the counts
+			/// @param[in] index Index in the counts
+			/// @return the lowest value of the sub-bucket
+			std::uint64_t value_from_counts_index(std::size_t const index) const
+			{
+				int bucket_index = int(index >> m_sub_bucket_half_count_magnitude) - 1;
+				std::uint64_t sub_bucket_index = (std::uint64_t(index) & (m_sub_bucket_half_count - 1)) + m_sub_bucket_half_count;
+				if (bucket_index < 0)
+				{
+					sub_bucket_index -= m_sub_bucket_half_count;
+					bucket_index = 0;
+				}
+				return value_from_index(bucket_index, sub_bucket_index);
+			}
+
+			/// @brief Return the number of values equivalent to a value (size of its sub-bucket)
+			/// @param[in] value A value
+			/// @return the number of values equivalent to the value
+			std::uint64_t size_of_equivalent_value_range(std::uint64_t const value) const
+			{
+				int const bucket_index = get_bucket_index(value);
+				std::uint64_t const sub_bucket_index = get_sub_bucket_index(value, bucket_index);
+				int const adjusted_bucket = (sub_bucket_index >= m_sub_bucket_count) ? bucket_index + 1 : bucket_index;
+				return std::uint64_t(1) << (m_unit_magnitude + adjusted_bucket);
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,128 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_MATH_MANN_WHITNEY_U_HPP
+#define HNC_MATH_MANN_WHITNEY_U_HPP
+
+#include <vector>
+#include <utility>
+#include <cmath>
+#include <algorithm>
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief Result of the Mann-Whitney U test
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 */
+		class mann_whitney_u_result
+		{
+		public:
+
+			/// U statistic of the first sample
+			long double u;
+
+			/// z score (normal approximation, with tie and continuity corrections)
+			long double z;
+
+			/// Two-sided p-value
+			long double p_value;
+		};
+
+		/**
+		 * @brief Mann-Whitney U test (Wilcoxon rank-sum test), two-sided
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * Test if the values of two samples come from the same distribution, without hypothesis on the distribution
+		 * (benchmark times are long tail distributions) @n
+		 * The p-value is computed with the normal approximation (with tie and continuity corrections),
+		 * reliable for samples with more than ~8 values
+		 *
+		 * http://en.wikipedia.org/wiki/Mann%E2%80%93Whitney_U_test
+		 *
+		 * @code
+		   std::vector<double> a = { 1.0, 1.1, 0.9, 1.0, 1.2, 1.1, 0.9, 1.0 };
+		   std::vector<double> b = { 2.0, 2.1, 1.9, 2.0, 2.2, 2.1, 1.9, 2.0 };
+		   std::cout << hnc::math::mann_whitney_u(a, b).p_value << std::endl; // < 0.001
+		   @endcode
+		 *
+		 * @param[in] sample_0 First sample
+		 * @param[in] sample_1 Second sample
+		 *
+		 * @return the U statistic of the first sample, the z score and the two-sided p-value (1 if a sample is empty)
+		 */
+		template <class container_0_t, class container_1_t>
+		hnc::math::mann_whitney_u_result mann_whitney_u(container_0_t const & sample_0, container_1_t const & sample_1)
+		{
+			hnc::math::mann_whitney_u_result r;
+			r.u = 0;
+			r.z = 0;
+			r.p_value = 1;
+
+			long double const n0 = (long double)(sample_0.size());
+			long double const n1 = (long double)(sample_1.size());
+			if (sample_0.size() == 0 || sample_1.size() == 0) { return r; }
+
+			// All values with their sample
+			std::vector<std::pair<long double, bool>> values;
+			values.reserve(sample_0.size() + sample_1.size());
+			for (auto const & x : sample_0) { values.emplace_back((long double)(x), false); }
+			for (auto const & x : sample_1) { values.emplace_back((long double)(x), true); }
+			std::sort(values.begin(), values.end());
+
+			// Sum of the ranks of the first sample (mean rank for ties) and tie correction
+			long double rank_sum_0 = 0;
+			long double tie_sum = 0;
+			for (std::size_t i = 0; i < values.size(); )
+			{
+				std::size_t j = i;
+				while (j < values.size() && values[j].first == values[i].first) { ++j; }
+				long double const mean_rank = (long double)(i + 1 + j) / 2;
+				for (std::size_t k = i; k < j; ++k) { if (values[k].second == false) { rank_sum_0 += mean_rank; } }
+				long double const t = (long double)(j - i);
+				tie_sum += t * t * t - t;
+				i = j;
+			}
+
+			r.u = rank_sum_0 - n0 * (n0 + 1) / 2;
+
+			// Normal approximation
+			long double const n = n0 + n1;
+			long double const mean_u = n0 * n1 / 2;
+			long double const variance_u = n0 * n1 / 12 * ((n + 1) - tie_sum / (n * (n - 1)));
+			if (variance_u <= 0) { return r; }
+			long double const difference = std::abs(r.u - mean_u);
+			r.z = (difference > 0.5L) ? (difference - 0.5L) / std::sqrt(variance_u) : 0;
+			if (r.u < mean_u) { r.z = -r.z; }
+			r.p_value = std::min(1.L, (long double)(std::erfc(double(std::abs(r.z)) / std::sqrt(2.))));
+
+			return r;
+		}
+	}
+}
+
+#endif
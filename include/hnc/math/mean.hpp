@@ -94,6 +94,21 @@ namespace hnc
 			#endif
 			return hnc::math::mean(c.begin(), c.end());
 		}
+
+		/**
+		 * @brief Arithmetic mean of the values of a range (a hnc::vector2D_view, a row or a column of a matrix, ...)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * @param[in] r A range with begin() and end() (with a size >= 1)
+		 *
+		 * @return the arithmetic mean
+		 */
+		template <class range_t>
+		auto mean(range_t const & r) -> decltype(hnc::math::mean(r.begin(), r.end()))
+		{ return hnc::math::mean(r.begin(), r.end()); }
 	}
 }
 
@@ -105,6 +105,21 @@ namespace hnc
 		{
 			return hnc::math::median(c.begin(), c.end());
 		}
+
+		/**
+		 * @brief Median of the values of a range (a hnc::vector2D_view, a row or a column of a matrix, ...)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * @param[in] r A range with begin() and end() (with a size >= 1)
+		 *
+		 * @return the median
+		 */
+		template <class range_t>
+		auto median(range_t const & r) -> decltype(hnc::math::median(r.begin(), r.end()))
+		{ return hnc::math::median(r.begin(), r.end()); }
 	}
 }
 
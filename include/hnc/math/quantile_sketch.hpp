@@ -0,0 +1,251 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_MATH_QUANTILE_SKETCH_HPP
+#define HNC_MATH_QUANTILE_SKETCH_HPP
+
+#include <vector>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../assert.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief Mergeable approximate quantiles with a bounded memory
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * Values are counted in logarithmic bins (DDSketch): a value @f$ x @f$ goes in the bin
+		 * @f$ k = \lceil \log_\gamma(x) \rceil @f$ with @f$ \gamma = \frac{1 + \alpha}{1 - \alpha} @f$,
+		 * so each quantile is returned with a relative error @f$ \leq \alpha @f$ @n
+		 * The number of bins is bounded; when it is reached, the lowest bins are collapsed (only the lowest quantiles lose accuracy)
+		 *
+		 * http://arxiv.org/abs/1908.10693
+		 *
+		 * push_back is O(1) (amortized), two sketches with the same accuracy can be merged
+		 *
+		 * @code
+		   hnc::math::quantile_sketch sketch;
+		   for (long double x = 1; x <= 1000; ++x) { sketch.push_back(x); }
+		   std::cout << sketch.quantile(0.5) << std::endl;  // 500 +/- 1%
+		   std::cout << sketch.quantile(0.99) << std::endl; // 990 +/- 1%
+		   @endcode
+		 *
+		 * @warning Values must be >= 0 (values <= hnc::math::quantile_sketch::min_indexable_value() are counted as 0)
+		 */
+		class quantile_sketch
+		{
+		private:
+
+			/// Relative accuracy
+			double m_relative_accuracy;
+
+			/// ln(gamma)
+			double m_ln_gamma;
+
+			/// Maximum number of bins
+			std::size_t m_max_nb_bin;
+
+			/// Number of values in each bin
+			std::vector<std::size_t> m_bins;
+
+			/// Index of the first bin
+			long int m_offset;
+
+			/// Number of values counted as 0
+			std::size_t m_nb_zero;
+
+			/// Number of values
+			std::size_t m_size;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] relative_accuracy Relative accuracy of the quantiles (0.01 by default)
+			/// @param[in] max_nb_bin        Maximum number of bins (2048 by default, enough to cover 1 ns to 10^9 s at 1%)
+			/// @exception std::invalid_argument hnc::hassert 0 < relative_accuracy < 1 and max_nb_bin >= 1 if NDEBUG is not defined
+			quantile_sketch(double const relative_accuracy = 0.01, std::size_t const max_nb_bin = 2048) :
+				m_relative_accuracy(relative_accuracy),
+				m_ln_gamma(std::log((1. + relative_accuracy) / (1. - relative_accuracy))),
+				m_max_nb_bin(max_nb_bin),
+				m_bins(),
+				m_offset(0),
+				m_nb_zero(0),
+				m_size(0)
+			{
+				#ifndef NDEBUG
+					hnc::hassert(relative_accuracy > 0. && relative_accuracy < 1., std::invalid_argument("hnc::math::quantile_sketch, relative accuracy must be in ]0, 1["));
+					hnc::hassert(max_nb_bin >= 1, std::invalid_argument("hnc::math::quantile_sketch, maximum number of bins must be >= 1"));
+				#endif
+			}
+
+			/// @brief Return the smallest value which is not counted as 0
+			/// @return the smallest value which is not counted as 0
+			static long double min_indexable_value() { return 1e-30L; }
+
+			/// @brief Return the relative accuracy
+			/// @return the relative accuracy
+			double relative_accuracy() const { return m_relative_accuracy; }
+
+			/// @brief Return the number of values
+			/// @return the number of values
+			std::size_t size() const { return m_size; }
+
+			/// @brief Return true if there is no value
+			/// @return true if there is no value, false otherwise
+			bool empty() const { return m_size == 0; }
+
+			/// @brief Return the number of bins used
+			/// @return the number of bins used
+			std::size_t nb_bin() const { return m_bins.size(); }
+
+			/// @brief Add a value
+			/// @param[in] x Value (>= 0)
+			void push_back(long double const x)
+			{
+				if (x <= min_indexable_value()) { ++m_nb_zero; }
+				else { add_in_bin(bin_index(x), 1); }
+				++m_size;
+			}
+
+			/// @brief Merge with an other quantile sketch
+			/// @param[in] sketch A hnc::math::quantile_sketch with the same relative accuracy
+			/// @exception std::invalid_argument if relative accuracies are different
+			void merge(hnc::math::quantile_sketch const & sketch)
+			{
+				if (sketch.m_relative_accuracy != m_relative_accuracy)
+				{
+					throw std::invalid_argument("hnc::math::quantile_sketch::merge, can not merge sketches with different relative accuracies");
+				}
+				for (std::size_t i = 0; i < sketch.m_bins.size(); ++i)
+				{
+					if (sketch.m_bins[i] != 0) { add_in_bin(sketch.m_offset + long(i), sketch.m_bins[i]); }
+				}
+				m_nb_zero += sketch.m_nb_zero;
+				m_size += sketch.m_size;
+			}
+
+			/// @brief Return the approximate quantile
+			/// @param[in] q Quantile in [0, 1] (0.5 for the median)
+			/// @pre The sketch is not empty
+			/// @exception std::length_error hnc::hassert sketch is not empty if NDEBUG is not defined
+			/// @return the approximate quantile
+			long double quantile(double const q) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(m_size > 0, std::length_error("hnc::math::quantile_sketch::quantile, Can not compute the quantile of an empty sketch"));
+				#endif
+
+				long double const rank = (long double)(std::min(std::max(q, 0.), 1.)) * (long double)(m_size - 1);
+
+				std::size_t nb = m_nb_zero;
+				if ((long double)(nb) > rank) { return 0; }
+				for (std::size_t i = 0; i < m_bins.size(); ++i)
+				{
+					nb += m_bins[i];
+					if ((long double)(nb) > rank) { return bin_value(m_offset + long(i)); }
+				}
+				return bin_value(m_offset + long(m_bins.size()) - 1);
+			}
+
+			/// @brief Remove all values
+			void clear()
+			{
+				m_bins.clear();
+				m_offset = 0;
+				m_nb_zero = 0;
+				m_size = 0;
+			}
+
+		private:
+
+			/// @brief Return the bin index of a value
+			/// @param[in] x Value (> min_indexable_value())
+			/// @return the bin index of a value
+			long int bin_index(long double const x) const
+			{
+				return long(std::ceil(std::log(double(x)) / m_ln_gamma));
+			}
+
+			/// @brief Return the representative value of a bin (relative error <= relative accuracy for all values of the bin)
+			/// @param[in] k Bin index
+			/// @return the representative value of a bin
+			long double bin_value(long int const k) const
+			{
+				return (long double)(std::exp(m_ln_gamma * double(k)) * (1. - m_relative_accuracy));
+			}
+
+			/// @brief Add nb values in the bin k (the lowest bins are collapsed if there are too many bins)
+			/// @param[in] k  Bin index
+			/// @param[in] nb Number of values
+			void add_in_bin(long int k, std::size_t const nb)
+			{
+				long int const max_nb_bin = long(m_max_nb_bin);
+
+				// First bin
+				if (m_bins.empty())
+				{
+					m_bins.assign(1, 0);
+					m_offset = k;
+				}
+				// Before the first bin
+				else if (k < m_offset)
+				{
+					long int const last = m_offset + long(m_bins.size()) - 1;
+					long int const new_offset = std::max(k, last - max_nb_bin + 1);
+					if (new_offset < m_offset)
+					{
+						m_bins.insert(m_bins.begin(), std::size_t(m_offset - new_offset), 0);
+						m_offset = new_offset;
+					}
+					// Collapsed in the first bin
+					k = std::max(k, m_offset);
+				}
+				// After the last bin
+				else if (k >= m_offset + long(m_bins.size()))
+				{
+					long int const new_offset = std::max(m_offset, k - max_nb_bin + 1);
+					// Collapse the lowest bins
+					if (new_offset > m_offset)
+					{
+						std::size_t const nb_collapsed = std::min(std::size_t(new_offset - m_offset), m_bins.size());
+						std::size_t const nb_in_collapsed = std::accumulate(m_bins.begin(), m_bins.begin() + long(nb_collapsed), std::size_t(0));
+						m_bins.erase(m_bins.begin(), m_bins.begin() + long(nb_collapsed));
+						if (m_bins.empty()) { m_bins.assign(1, 0); }
+						m_bins.front() += nb_in_collapsed;
+						m_offset = new_offset;
+					}
+					m_bins.resize(std::size_t(k - m_offset + 1), 0);
+				}
+
+				m_bins[std::size_t(k - m_offset)] += nb;
+			}
+		};
+	}
+}
+
+#endif
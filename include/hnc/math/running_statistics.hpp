@@ -0,0 +1,213 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_MATH_RUNNING_STATISTICS_HPP
+#define HNC_MATH_RUNNING_STATISTICS_HPP
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../assert.hpp"
+#include "quantile_sketch.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief Statistics updated in O(1) for each value, with a constant memory
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The values are not saved, hnc::math::running_statistics keeps:
+		 * - the number of values, the minimum and the maximum
+		 * - the mean and the variance (Welford algorithm) http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Online_algorithm
+		 * - the sum of the logarithms for the geometric mean (values must be >= 0)
+		 * - a hnc::math::quantile_sketch for the median and the approximate quantiles
+		 *
+		 * Two hnc::math::running_statistics can be merged (for example, one per thread)
+		 *
+		 * @code
+		   hnc::math::running_statistics s;
+		   s.push_back(2); s.push_back(4); s.push_back(6); s.push_back(8);
+		   std::cout << s.mean() << std::endl;     // 5
+		   std::cout << s.variance() << std::endl; // 5
+		   std::cout << s.median() << std::endl;   // close to 4
+		   @endcode
+		 */
+		class running_statistics
+		{
+		private:
+
+			/// Number of values
+			std::size_t m_size;
+
+			/// Minimum
+			long double m_min;
+
+			/// Maximum
+			long double m_max;
+
+			/// Mean
+			long double m_mean;
+
+			/// Sum of squares of differences from the mean
+			long double m_m2;
+
+			/// Sum of logarithms (of the values > 0)
+			long double m_sum_log;
+
+			/// Number of values <= 0 (the geometric mean is 0)
+			std::size_t m_nb_not_positive;
+
+			/// Quantile sketch
+			hnc::math::quantile_sketch m_sketch;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] relative_accuracy Relative accuracy of the quantiles (0.01 by default)
+			running_statistics(double const relative_accuracy = 0.01) :
+				m_size(0),
+				m_min(std::numeric_limits<long double>::max()),
+				m_max(std::numeric_limits<long double>::lowest()),
+				m_mean(0),
+				m_m2(0),
+				m_sum_log(0),
+				m_nb_not_positive(0),
+				m_sketch(relative_accuracy)
+			{ }
+
+			/// @brief Add a value
+			/// @param[in] x Value
+			void push_back(long double const x)
+			{
+				++m_size;
+				m_min = std::min(m_min, x);
+				m_max = std::max(m_max, x);
+				long double const delta = x - m_mean;
+				m_mean += delta / (long double)(m_size);
+				m_m2 += delta * (x - m_mean);
+				if (x > 0) { m_sum_log += std::log(x); }
+				else { ++m_nb_not_positive; }
+				m_sketch.push_back(x);
+			}
+
+			/// @brief Merge with other statistics
+			/// @param[in] s A hnc::math::running_statistics
+			void merge(hnc::math::running_statistics const & s)
+			{
+				if (s.m_size == 0) { return; }
+				if (m_size == 0) { *this = s; return; }
+
+				long double const n0 = (long double)(m_size);
+				long double const n1 = (long double)(s.m_size);
+				long double const delta = s.m_mean - m_mean;
+
+				m_size += s.m_size;
+				m_min = std::min(m_min, s.m_min);
+				m_max = std::max(m_max, s.m_max);
+				m_mean += delta * n1 / (n0 + n1);
+				m_m2 += s.m_m2 + delta * delta * n0 * n1 / (n0 + n1);
+				m_sum_log += s.m_sum_log;
+				m_nb_not_positive += s.m_nb_not_positive;
+				m_sketch.merge(s.m_sketch);
+			}
+
+			/// @brief Remove all values
+			void clear()
+			{
+				*this = hnc::math::running_statistics(m_sketch.relative_accuracy());
+			}
+
+			/// @brief Return the number of values
+			/// @return the number of values
+			std::size_t size() const { return m_size; }
+
+			/// @brief Return true if there is no value
+			/// @return true if there is no value, false otherwise
+			bool empty() const { return m_size == 0; }
+
+			/// @brief Return the minimum
+			/// @return the minimum
+			long double min() const { check_not_empty(); return m_min; }
+
+			/// @brief Return the maximum
+			/// @return the maximum
+			long double max() const { check_not_empty(); return m_max; }
+
+			/// @brief Return the arithmetic mean
+			/// @return the arithmetic mean
+			long double mean() const { check_not_empty(); return m_mean; }
+
+			/// @brief Return the variance (same definition as hnc::math::variance)
+			/// @return the variance
+			long double variance() const { check_not_empty(); return m_m2 / (long double)(m_size); }
+
+			/// @brief Return the standard deviation
+			/// @return the standard deviation
+			long double standard_deviation() const { return std::sqrt(variance()); }
+
+			/// @brief Return the geometric mean (computed with the sum of logarithms, 0 if a value is 0)
+			/// @return the geometric mean
+			long double geometric_mean() const
+			{
+				check_not_empty();
+				if (m_nb_not_positive != 0) { return 0; }
+				return std::exp(m_sum_log / (long double)(m_size));
+			}
+
+			/// @brief Return the approximate quantile (exact for 0 and 1)
+			/// @param[in] q Quantile in [0, 1]
+			/// @return the approximate quantile
+			long double quantile(double const q) const
+			{
+				check_not_empty();
+				if (q <= 0.) { return m_min; }
+				if (q >= 1.) { return m_max; }
+				return std::min(std::max(m_sketch.quantile(q), m_min), m_max);
+			}
+
+			/// @brief Return the approximate median
+			/// @return the approximate median
+			long double median() const { return quantile(0.5); }
+
+			/// @brief Return the quantile sketch
+			/// @return the quantile sketch
+			hnc::math::quantile_sketch const & sketch() const { return m_sketch; }
+
+		private:
+
+			/// @brief Check if there is at least one value
+			/// @exception std::length_error hnc::hassert there is at least one value if NDEBUG is not defined
+			void check_not_empty() const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(m_size > 0, std::length_error("hnc::math::running_statistics, no value"));
+				#endif
+			}
+		};
+	}
+}
+
+#endif
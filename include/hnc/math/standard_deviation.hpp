@@ -80,6 +80,21 @@ namespace hnc
 		template <class T, template <class, class Alloc = std::allocator<T>> class Container>
 		auto standard_deviation(Container<T> const & c) -> decltype(std::sqrt(c.front()))
 		{ return hnc::math::standard_deviation(c.begin(), c.end()); }
+
+		/**
+		 * @brief Standard deviation of the values of a range (a hnc::vector2D_view, a row or a column of a matrix, ...)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * @param[in] r A range with begin() and end() (with a size >= 1)
+		 *
+		 * @return the standard deviation
+		 */
+		template <class range_t>
+		auto standard_deviation(range_t const & r) -> decltype(hnc::math::standard_deviation(r.begin(), r.end()))
+		{ return hnc::math::standard_deviation(r.begin(), r.end()); }
 	}
 }
 
@@ -0,0 +1,588 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+#ifndef HNC_MATH_STENCIL_HPP
+#define HNC_MATH_STENCIL_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include "../vector3D.hpp"
+#include "../vector3D_view.hpp"
+#include "../computer.hpp"
+#include "../openmp.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief Weights of a 7-point stencil (the value and its 6 neighbors along the axes)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The result at (x, y, z) is center * v(x, y, z) + x_minus * v(x - 1, y, z) + x_plus * v(x + 1, y, z) + ... + z_plus * v(x, y, z + 1)
+		 */
+		template <class T>
+		class stencil_7_point_t
+		{
+		public:
+
+			/// Weight of (x, y, z)
+			T center;
+
+			/// Weight of (x - 1, y, z)
+			T x_minus;
+
+			/// Weight of (x + 1, y, z)
+			T x_plus;
+
+			/// Weight of (x, y - 1, z)
+			T y_minus;
+
+			/// Weight of (x, y + 1, z)
+			T y_plus;
+
+			/// Weight of (x, y, z - 1)
+			T z_minus;
+
+			/// Weight of (x, y, z + 1)
+			T z_plus;
+
+			/// @brief Constructor of a symmetric stencil
+			/// @param[in] center   Weight of (x, y, z) (T() by default)
+			/// @param[in] neighbor Weight of the 6 neighbors (T() by default)
+			stencil_7_point_t(T const & center = T(), T const & neighbor = T()) :
+				center(center),
+				x_minus(neighbor), x_plus(neighbor),
+				y_minus(neighbor), y_plus(neighbor),
+				z_minus(neighbor), z_plus(neighbor)
+			{ }
+
+			/// @brief Return the 7-point Laplacian (second order finite differences)
+			/// @param[in] h Grid spacing (1 by default)
+			/// @return the stencil (-6 / h² for the center, 1 / h² for the neighbors)
+			static stencil_7_point_t<T> laplacian(T const & h = T(1))
+			{
+				return stencil_7_point_t<T>(T(-6) / (h * h), T(1) / (h * h));
+			}
+		};
+
+		/**
+		 * @brief Weights of a 27-point stencil (the value and its 26 neighbors in the 3 x 3 x 3 cube)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The result at (x, y, z) is the sum of w(dx, dy, dz) * v(x + dx, y + dy, z + dz) for dx, dy, dz in { -1, 0, 1 }
+		 */
+		template <class T>
+		class stencil_27_point_t
+		{
+		private:
+
+			/// Weights, w(dx, dy, dz) is m_weights[(dx + 1) * 9 + (dy + 1) * 3 + (dz + 1)]
+			T m_weights[27];
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] weight Weight of the 27 points (T() by default)
+			stencil_27_point_t(T const & weight = T())
+			{
+				std::fill(m_weights, m_weights + 27, weight);
+			}
+
+			/// @brief Constructor from a 7-point stencil (the weights of the other points are T())
+			/// @param[in] s A hnc::math::stencil_7_point_t
+			stencil_27_point_t(hnc::math::stencil_7_point_t<T> const & s) :
+				stencil_27_point_t()
+			{
+				(*this)(0, 0, 0) = s.center;
+				(*this)(-1, 0, 0) = s.x_minus; (*this)(1, 0, 0) = s.x_plus;
+				(*this)(0, -1, 0) = s.y_minus; (*this)(0, 1, 0) = s.y_plus;
+				(*this)(0, 0, -1) = s.z_minus; (*this)(0, 0, 1) = s.z_plus;
+			}
+
+			/// @brief Const access to a weight
+			/// @param[in] dx Offset in the dimension x (-1, 0 or 1)
+			/// @param[in] dy Offset in the dimension y (-1, 0 or 1)
+			/// @param[in] dz Offset in the dimension z (-1, 0 or 1)
+			/// @exception std::out_of_range hnc::hassert the offsets are in { -1, 0, 1 } if NDEBUG is not defined
+			/// @return the weight of (x + dx, y + dy, z + dz)
+			T const & operator ()(int const dx, int const dy, int const dz) const { return m_weights[index(dx, dy, dz)]; }
+
+			/// @brief Access to a weight
+			/// @param[in] dx Offset in the dimension x (-1, 0 or 1)
+			/// @param[in] dy Offset in the dimension y (-1, 0 or 1)
+			/// @param[in] dz Offset in the dimension z (-1, 0 or 1)
+			/// @exception std::out_of_range hnc::hassert the offsets are in { -1, 0, 1 } if NDEBUG is not defined
+			/// @return the weight of (x + dx, y + dy, z + dz)
+			T & operator ()(int const dx, int const dy, int const dz) { return m_weights[index(dx, dy, dz)]; }
+
+			/// @brief Return the 27-point Laplacian (second order, isotropic error)
+			/// @param[in] h Grid spacing (1 by default)
+			/// @return the stencil (-128 / 30h² for the center, 14 / 30h² for the faces, 3 / 30h² for the edges, 1 / 30h² for the corners)
+			static stencil_27_point_t<T> laplacian(T const & h = T(1))
+			{
+				stencil_27_point_t<T> r;
+				for (int dx = -1; dx <= 1; ++dx)
+				{
+					for (int dy = -1; dy <= 1; ++dy)
+					{
+						for (int dz = -1; dz <= 1; ++dz)
+						{
+							int const nb_offset = (dx != 0) + (dy != 0) + (dz != 0);
+							T const weight = (nb_offset == 0) ? T(-128) : ((nb_offset == 1) ? T(14) : ((nb_offset == 2) ? T(3) : T(1)));
+							r(dx, dy, dz) = weight / (T(30) * h * h);
+						}
+					}
+				}
+				return r;
+			}
+
+			/// @brief Return the mean of the 27 points (a box filter)
+			/// @return the stencil (1 / 27 for all points)
+			static stencil_27_point_t<T> mean()
+			{
+				return stencil_27_point_t<T>(T(1) / T(27));
+			}
+
+		private:
+
+			/// @brief Return the index of a weight
+			/// @param[in] dx Offset in the dimension x (-1, 0 or 1)
+			/// @param[in] dy Offset in the dimension y (-1, 0 or 1)
+			/// @param[in] dz Offset in the dimension z (-1, 0 or 1)
+			/// @exception std::out_of_range hnc::hassert the offsets are in { -1, 0, 1 } if NDEBUG is not defined
+			/// @return the index of the weight of (x + dx, y + dy, z + dz)
+			static std::size_t index(int const dx, int const dy, int const dz)
+			{
+				#ifndef NDEBUG
+					hnc::hassert(dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1 && dz >= -1 && dz <= 1, std::out_of_range("hnc::math::stencil_27_point_t, offset (" + hnc::to_string(dx) + ", " + hnc::to_string(dy) + ", " + hnc::to_string(dz) + ") is not in the 3 x 3 x 3 cube"));
+				#endif
+				return std::size_t((dx + 1) * 9 + (dy + 1) * 3 + (dz + 1));
+			}
+		};
+
+		/**
+		 * @brief Tile sizes of hnc::math::stencil
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The dimension with the largest stride is streamed, the tiles cut the two other dimensions: @n
+		 * a tile is nb_line lines of line_size values of the dimension with the smallest stride (the contiguous dimension of a hnc::vector3D)
+		 */
+		class stencil_tile_t
+		{
+		public:
+
+			/// Number of lines of a tile
+			std::size_t nb_line;
+
+			/// Number of values in a line of a tile
+			std::size_t line_size;
+		};
+
+		/**
+		 * @brief Return the tile sizes of hnc::math::stencil for a topology
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * While a tile is streamed, the 3 source planes and the destination plane of the tile stay in the half of the L2 cache (256 KiB if unknown) @n
+		 * The line size is a multiple of the number of values in a cache line
+		 *
+		 * @param[in] topology Topology of the computer (see hnc::computer::topology)
+		 *
+		 * @return the tile sizes
+		 */
+		template <class T>
+		hnc::math::stencil_tile_t stencil_tile(hnc::computer::topology_t const & topology)
+		{
+			std::size_t const l2 = (topology.cache_size(2) == 0) ? 256 * 1024 : topology.cache_size(2);
+			std::size_t const line = std::max(std::size_t(1), topology.cache_line_size() / sizeof(T));
+			std::size_t const nb_value = std::max(line, l2 / 2 / (4 * sizeof(T)));
+			hnc::math::stencil_tile_t r;
+			r.line_size = std::min(std::max(nb_value / 16 / line * line, line), std::size_t(1024));
+			r.nb_line = std::max(nb_value / r.line_size, std::size_t(1));
+			return r;
+		}
+
+		/// @brief Return the tile sizes of hnc::math::stencil for this computer (the topology is detected once)
+		/// @return the tile sizes
+		template <class T>
+		hnc::math::stencil_tile_t stencil_tile()
+		{
+			static hnc::math::stencil_tile_t const tile = hnc::math::stencil_tile<T>(hnc::computer::topology());
+			return tile;
+		}
+
+		/// @brief Kernels and loop nest of hnc::math::stencil
+		namespace stencil_kernel
+		{
+			/**
+			 * @brief Geometry of a stencil: sizes and strides of the source and of the destination
+			 *
+			 * The dimensions are sorted by decreasing source stride, so the dimension 2 is the contiguous one
+			 */
+			class geometry_t
+			{
+			public:
+
+				/// Original dimension (0 for x, 1 for y, 2 for z) of the dimensions
+				std::size_t dim[3];
+
+				/// Sizes of the dimensions
+				std::size_t size[3];
+
+				/// Source strides of the dimensions
+				std::ptrdiff_t src_stride[3];
+
+				/// Destination strides of the dimensions
+				std::ptrdiff_t dst_stride[3];
+
+				/// @brief Constructor
+				/// @param[in] src A hnc::vector3D_view
+				/// @param[in] dst A hnc::vector3D_view with the same sizes
+				template <class T_src, class T>
+				geometry_t(hnc::vector3D_view<T_src> const & src, hnc::vector3D_view<T> const & dst)
+				{
+					std::size_t const sizes[3] = { src.size_x(), src.size_y(), src.size_z() };
+					std::size_t const src_strides[3] = { src.stride_x(), src.stride_y(), src.stride_z() };
+					std::size_t const dst_strides[3] = { dst.stride_x(), dst.stride_y(), dst.stride_z() };
+					dim[0] = 0; dim[1] = 1; dim[2] = 2;
+					std::stable_sort(dim, dim + 3, [&](std::size_t const a, std::size_t const b) { return src_strides[a] > src_strides[b]; });
+					for (std::size_t k = 0; k < 3; ++k)
+					{
+						size[k] = sizes[dim[k]];
+						src_stride[k] = std::ptrdiff_t(src_strides[dim[k]]);
+						dst_stride[k] = std::ptrdiff_t(dst_strides[dim[k]]);
+					}
+				}
+			};
+
+			/// @brief 7-point kernel in the dimensions of a hnc::math::stencil_kernel::geometry_t
+			template <class T>
+			class kernel_7_point_t
+			{
+			private:
+
+				/// Weight of the center
+				T m_center;
+
+				/// Weights of the neighbors before in the dimensions 0, 1, 2
+				T m_minus[3];
+
+				/// Weights of the neighbors after in the dimensions 0, 1, 2
+				T m_plus[3];
+
+				/// Source stride of the dimension 0
+				std::ptrdiff_t m_stride_0;
+
+				/// Source stride of the dimension 1
+				std::ptrdiff_t m_stride_1;
+
+			public:
+
+				/// @brief Constructor
+				/// @param[in] s        A hnc::math::stencil_7_point_t
+				/// @param[in] geometry A hnc::math::stencil_kernel::geometry_t
+				kernel_7_point_t(hnc::math::stencil_7_point_t<T> const & s, geometry_t const & geometry) :
+					m_center(s.center), m_stride_0(geometry.src_stride[0]), m_stride_1(geometry.src_stride[1])
+				{
+					T const minus[3] = { s.x_minus, s.y_minus, s.z_minus };
+					T const plus[3] = { s.x_plus, s.y_plus, s.z_plus };
+					for (std::size_t k = 0; k < 3; ++k)
+					{
+						m_minus[k] = minus[geometry.dim[k]];
+						m_plus[k] = plus[geometry.dim[k]];
+					}
+				}
+
+				/// @brief Compute the stencil
+				/// @param[in] p        Source value
+				/// @param[in] stride_2 Source stride of the dimension 2
+				/// @return the result of the stencil at p
+				template <class T_src>
+				T operator ()(T_src const * const p, std::ptrdiff_t const stride_2) const
+				{
+					return
+						m_center * p[0] +
+						m_minus[0] * p[-m_stride_0] + m_plus[0] * p[m_stride_0] +
+						m_minus[1] * p[-m_stride_1] + m_plus[1] * p[m_stride_1] +
+						m_minus[2] * p[-stride_2] + m_plus[2] * p[stride_2];
+				}
+			};
+
+			/// @brief 27-point kernel in the dimensions of a hnc::math::stencil_kernel::geometry_t
+			template <class T>
+			class kernel_27_point_t
+			{
+			private:
+
+				/// Weights, the weight of the offsets (d0, d1, d2) is m_weights[(d0 + 1) * 9 + (d1 + 1) * 3 + (d2 + 1)]
+				T m_weights[27];
+
+				/// Source stride of the dimension 0
+				std::ptrdiff_t m_stride_0;
+
+				/// Source stride of the dimension 1
+				std::ptrdiff_t m_stride_1;
+
+			public:
+
+				/// @brief Constructor
+				/// @param[in] s        A hnc::math::stencil_27_point_t
+				/// @param[in] geometry A hnc::math::stencil_kernel::geometry_t
+				kernel_27_point_t(hnc::math::stencil_27_point_t<T> const & s, geometry_t const & geometry) :
+					m_stride_0(geometry.src_stride[0]), m_stride_1(geometry.src_stride[1])
+				{
+					for (int d0 = -1; d0 <= 1; ++d0)
+					{
+						for (int d1 = -1; d1 <= 1; ++d1)
+						{
+							for (int d2 = -1; d2 <= 1; ++d2)
+							{
+								int d[3];
+								d[geometry.dim[0]] = d0;
+								d[geometry.dim[1]] = d1;
+								d[geometry.dim[2]] = d2;
+								m_weights[(d0 + 1) * 9 + (d1 + 1) * 3 + (d2 + 1)] = s(d[0], d[1], d[2]);
+							}
+						}
+					}
+				}
+
+				/// @brief Compute the stencil
+				/// @param[in] p        Source value
+				/// @param[in] stride_2 Source stride of the dimension 2
+				/// @return the result of the stencil at p
+				template <class T_src>
+				T operator ()(T_src const * const p, std::ptrdiff_t const stride_2) const
+				{
+					T r = T();
+					for (int d0 = -1; d0 <= 1; ++d0)
+					{
+						for (int d1 = -1; d1 <= 1; ++d1)
+						{
+							T_src const * const line = p + d0 * m_stride_0 + d1 * m_stride_1;
+							T const * const w = m_weights + (d0 + 1) * 9 + (d1 + 1) * 3;
+							r += w[0] * line[-stride_2] + w[1] * line[0] + w[2] * line[stride_2];
+						}
+					}
+					return r;
+				}
+			};
+
+			/// @brief Compute the stencil on a contiguous line
+			/// @param[in]  kernel A kernel
+			/// @param[in]  src    First source value
+			/// @param[out] dst    First destination value
+			/// @param[in]  n      Number of values
+			template <class kernel_t, class T_src, class T>
+			void line(kernel_t const & kernel, T_src const * const src, T * const dst, std::size_t const n)
+			{
+				for (std::size_t k = 0; k < n; ++k) { dst[k] = kernel(src + k, 1); }
+			}
+
+			/// @brief Compute the stencil on a strided line
+			/// @param[in]  kernel     A kernel
+			/// @param[in]  src        First source value
+			/// @param[out] dst        First destination value
+			/// @param[in]  n          Number of values
+			/// @param[in]  src_stride Distance between two source values
+			/// @param[in]  dst_stride Distance between two destination values
+			template <class kernel_t, class T_src, class T>
+			void line(kernel_t const & kernel, T_src const * const src, T * const dst, std::size_t const n, std::ptrdiff_t const src_stride, std::ptrdiff_t const dst_stride)
+			{
+				for (std::size_t k = 0; k < n; ++k) { dst[std::ptrdiff_t(k) * dst_stride] = kernel(src + std::ptrdiff_t(k) * src_stride, src_stride); }
+			}
+
+			/**
+			 * @brief Compute the stencil on the interior values, tile by tile, in parallel
+			 *
+			 * The tasks are (a range of the dimension 0) x (a tile of the dimensions 1 and 2),
+			 * the range of the dimension 0 is cut when there are less tiles than 4 tasks per thread
+			 *
+			 * @param[in]  kernel   A kernel
+			 * @param[in]  geometry Geometry of the source and of the destination
+			 * @param[in]  src      Source value (0, 0, 0)
+			 * @param[out] dst      Destination value (0, 0, 0)
+			 * @param[in]  tile     Tile sizes
+			 */
+			template <class kernel_t, class T_src, class T>
+			void run(kernel_t const & kernel, geometry_t const & geometry, T_src const * const src, T * const dst, hnc::math::stencil_tile_t const & tile)
+			{
+				if (geometry.size[0] < 3 || geometry.size[1] < 3 || geometry.size[2] < 3) { return; }
+
+				std::size_t const n0 = geometry.size[0] - 2;
+				std::size_t const n1 = geometry.size[1] - 2;
+				std::size_t const n2 = geometry.size[2] - 2;
+				std::size_t const tile_1 = std::min(std::max(tile.nb_line, std::size_t(1)), n1);
+				std::size_t const tile_2 = std::min(std::max(tile.line_size, std::size_t(1)), n2);
+				std::size_t const nb_tile_1 = (n1 + tile_1 - 1) / tile_1;
+				std::size_t const nb_tile_2 = (n2 + tile_2 - 1) / tile_2;
+				std::size_t const nb_tile = nb_tile_1 * nb_tile_2;
+				std::size_t const nb_task_wanted = 4 * std::max(std::size_t(1), hnc::openmp::nb_thread_max());
+				std::size_t const nb_chunk_0_wanted = std::min(n0, (nb_task_wanted + nb_tile - 1) / nb_tile);
+				std::size_t const chunk_0 = (n0 + nb_chunk_0_wanted - 1) / nb_chunk_0_wanted;
+				std::size_t const nb_chunk_0 = (n0 + chunk_0 - 1) / chunk_0;
+
+				std::ptrdiff_t const src_stride_0 = geometry.src_stride[0];
+				std::ptrdiff_t const src_stride_1 = geometry.src_stride[1];
+				std::ptrdiff_t const src_stride_2 = geometry.src_stride[2];
+				std::ptrdiff_t const dst_stride_0 = geometry.dst_stride[0];
+				std::ptrdiff_t const dst_stride_1 = geometry.dst_stride[1];
+				std::ptrdiff_t const dst_stride_2 = geometry.dst_stride[2];
+				bool const contiguous = (src_stride_2 == 1 && dst_stride_2 == 1);
+
+				long int const nb_task = long(nb_chunk_0 * nb_tile);
+				#pragma omp parallel for
+				for (long int task = 0; task < nb_task; ++task)
+				{
+					std::size_t const chunk = std::size_t(task) / nb_tile;
+					std::size_t const tile_id = std::size_t(task) % nb_tile;
+					std::size_t const i0_begin = 1 + chunk * chunk_0;
+					std::size_t const i0_end = 1 + std::min((chunk + 1) * chunk_0, n0);
+					std::size_t const i1_begin = 1 + (tile_id / nb_tile_2) * tile_1;
+					std::size_t const i1_end = 1 + std::min((tile_id / nb_tile_2 + 1) * tile_1, n1);
+					std::size_t const i2_begin = 1 + (tile_id % nb_tile_2) * tile_2;
+					std::size_t const i2_end = 1 + std::min((tile_id % nb_tile_2 + 1) * tile_2, n2);
+					for (std::size_t i0 = i0_begin; i0 < i0_end; ++i0)
+					{
+						for (std::size_t i1 = i1_begin; i1 < i1_end; ++i1)
+						{
+							T_src const * const src_line = src + std::ptrdiff_t(i0) * src_stride_0 + std::ptrdiff_t(i1) * src_stride_1 + std::ptrdiff_t(i2_begin) * src_stride_2;
+							T * const dst_line = dst + std::ptrdiff_t(i0) * dst_stride_0 + std::ptrdiff_t(i1) * dst_stride_1 + std::ptrdiff_t(i2_begin) * dst_stride_2;
+							if (contiguous) { stencil_kernel::line(kernel, src_line, dst_line, i2_end - i2_begin); }
+							else { stencil_kernel::line(kernel, src_line, dst_line, i2_end - i2_begin, src_stride_2, dst_stride_2); }
+						}
+					}
+				}
+			}
+
+			/// @brief Check the sizes of the source and of the destination
+			/// @param[in] src A hnc::vector3D_view
+			/// @param[in] dst A hnc::vector3D_view
+			/// @exception std::invalid_argument hnc::hassert src and dst have the same sizes
+			template <class T_src, class T>
+			void check_size(hnc::vector3D_view<T_src> const & src, hnc::vector3D_view<T> const & dst)
+			{
+				hnc::hassert(src.size_x() == dst.size_x() && src.size_y() == dst.size_y() && src.size_z() == dst.size_z(), std::invalid_argument("hnc::math::stencil, destination of size " + hnc::to_string(dst.size_x()) + " x " + hnc::to_string(dst.size_y()) + " x " + hnc::to_string(dst.size_z()) + " for a source of size " + hnc::to_string(src.size_x()) + " x " + hnc::to_string(src.size_y()) + " x " + hnc::to_string(src.size_z())));
+			}
+		}
+
+		/**
+		 * @brief 7-point stencil on the interior values: dst(x, y, z) = center * src(x, y, z) + x_minus * src(x - 1, y, z) + ... + z_plus * src(x, y, z + 1)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The interior values are [1, size - 1) in the 3 dimensions, the boundary values of dst are not modified @n
+		 * The dimension with the largest source stride is streamed, the two other dimensions are cut in tiles (see hnc::math::stencil_tile) @n
+		 * The tiles are computed in parallel with OpenMP and the loop on the contiguous dimension is vectorized @n
+		 * The views can have any layout (and different layouts)
+		 *
+		 * @code
+		   hnc::vector3D<double> u(256, 256, 256, 0.);
+		   hnc::vector3D<double> laplacian_u(256, 256, 256, 0.);
+		   hnc::math::stencil(u.view(), laplacian_u.view(), hnc::math::stencil_7_point_t<double>::laplacian(0.01));
+		   @endcode
+		 *
+		 * @param[in]  src  A hnc::vector3D_view
+		 * @param[out] dst  A hnc::vector3D_view with the sizes of src (must not overlap src)
+		 * @param[in]  s    Weights of the stencil
+		 * @param[in]  tile Tile sizes (hnc::math::stencil_tile<T>() by default)
+		 *
+		 * @exception std::invalid_argument hnc::hassert dst has the sizes of src if NDEBUG is not defined
+		 */
+		template <class T_src, class T>
+		void stencil
+		(
+			hnc::vector3D_view<T_src> const & src, hnc::vector3D_view<T> const & dst,
+			hnc::math::stencil_7_point_t<T> const & s,
+			hnc::math::stencil_tile_t const & tile = hnc::math::stencil_tile<T>()
+		)
+		{
+			static_assert(std::is_same<typename std::remove_const<T_src>::type, T>::value, "hnc::math::stencil, the source and the destination must have the same type of values");
+			#ifndef NDEBUG
+				hnc::math::stencil_kernel::check_size(src, dst);
+			#endif
+			hnc::math::stencil_kernel::geometry_t const geometry(src, dst);
+			hnc::math::stencil_kernel::run(hnc::math::stencil_kernel::kernel_7_point_t<T>(s, geometry), geometry, src.data(), dst.data(), tile);
+		}
+
+		/**
+		 * @brief 27-point stencil on the interior values: dst(x, y, z) = sum of w(dx, dy, dz) * src(x + dx, y + dy, z + dz)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * Same loop nest as the 7-point stencil (see hnc::math::stencil), the boundary values of dst are not modified
+		 *
+		 * @param[in]  src  A hnc::vector3D_view
+		 * @param[out] dst  A hnc::vector3D_view with the sizes of src (must not overlap src)
+		 * @param[in]  s    Weights of the stencil
+		 * @param[in]  tile Tile sizes (hnc::math::stencil_tile<T>() by default)
+		 *
+		 * @exception std::invalid_argument hnc::hassert dst has the sizes of src if NDEBUG is not defined
+		 */
+		template <class T_src, class T>
+		void stencil
+		(
+			hnc::vector3D_view<T_src> const & src, hnc::vector3D_view<T> const & dst,
+			hnc::math::stencil_27_point_t<T> const & s,
+			hnc::math::stencil_tile_t const & tile = hnc::math::stencil_tile<T>()
+		)
+		{
+			static_assert(std::is_same<typename std::remove_const<T_src>::type, T>::value, "hnc::math::stencil, the source and the destination must have the same type of values");
+			#ifndef NDEBUG
+				hnc::math::stencil_kernel::check_size(src, dst);
+			#endif
+			hnc::math::stencil_kernel::geometry_t const geometry(src, dst);
+			hnc::math::stencil_kernel::run(hnc::math::stencil_kernel::kernel_27_point_t<T>(s, geometry), geometry, src.data(), dst.data(), tile);
+		}
+
+		/// @brief Return the result of a stencil on a hnc::vector3D (the boundary values are copied, see hnc::math::stencil)
+		/// @param[in] v A hnc::vector3D
+		/// @param[in] s Weights of the stencil (hnc::math::stencil_7_point_t or hnc::math::stencil_27_point_t)
+		/// @return a hnc::vector3D with the layout of v
+		template <class T, class storage_t, class stencil_t>
+		hnc::vector3D<T, storage_t> stencil(hnc::vector3D<T, storage_t> const & v, stencil_t const & s)
+		{
+			hnc::vector3D<T, storage_t> r(v);
+			hnc::math::stencil(v.view(), r.view(), s);
+			return r;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,147 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#ifndef HNC_MATH_TRANSPOSE_HPP
+#define HNC_MATH_TRANSPOSE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../vector2D.hpp"
+#include "../vector2D_view.hpp"
+#include "../computer.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/**
+		 * @brief Return the tile size of hnc::math::transpose for a topology
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The source tile and the destination tile stay in the half of the L1 data cache (32 KiB if unknown) @n
+		 * The tile size is a power of 2 times the number of values in a cache line
+		 *
+		 * @param[in] topology Topology of the computer (see hnc::computer::topology)
+		 *
+		 * @return the tile size (number of rows and columns of a tile)
+		 */
+		template <class T>
+		std::size_t transpose_tile_size(hnc::computer::topology_t const & topology)
+		{
+			std::size_t const l1 = (topology.cache_size(1) == 0) ? 32 * 1024 : topology.cache_size(1);
+			std::size_t tile = std::max(std::size_t(1), topology.cache_line_size() / sizeof(T));
+			while (2 * (2 * tile) * (2 * tile) * sizeof(T) <= l1 / 2) { tile *= 2; }
+			return tile;
+		}
+
+		/// @brief Return the tile size of hnc::math::transpose for this computer (the topology is detected once)
+		/// @return the tile size (number of rows and columns of a tile)
+		template <class T>
+		std::size_t transpose_tile_size()
+		{
+			static std::size_t const tile = hnc::math::transpose_tile_size<T>(hnc::computer::topology());
+			return tile;
+		}
+
+		/**
+		 * @brief Cache-blocked transpose: dst(j, i) = src(i, j)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The matrix is transposed tile by tile (see hnc::math::transpose_tile_size), so the reads and the writes stay in the cache
+		 * (the naive loop misses the cache for every write on large matrices) @n
+		 * The rows of tiles are transposed in parallel with OpenMP
+		 *
+		 * @code
+		   hnc::vector2D<double> a(1000, 2000);
+		   hnc::vector2D<double> t(2000, 1000);
+		   hnc::math::transpose(a.view(), t.view());
+		   // Transpose a block in another block
+		   hnc::math::transpose(a.sub_view(0, 0, 64, 32), t.sub_view(100, 100, 32, 64));
+		   @endcode
+		 *
+		 * @param[in]  src  A hnc::vector2D_view
+		 * @param[out] dst  A hnc::vector2D_view with src.nb_col() rows and src.nb_row() columns (must not overlap src)
+		 * @param[in]  tile Tile size (0 by default, hnc::math::transpose_tile_size<T>())
+		 *
+		 * @exception std::invalid_argument hnc::hassert dst has the transposed size of src if NDEBUG is not defined
+		 */
+		template <class T_src, class T>
+		void transpose(hnc::vector2D_view<T_src> const & src, hnc::vector2D_view<T> const & dst, std::size_t tile = 0)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(dst.nb_row() == src.nb_col() && dst.nb_col() == src.nb_row(), std::invalid_argument("hnc::math::transpose, destination of size " + hnc::to_string(dst.nb_row()) + " x " + hnc::to_string(dst.nb_col()) + " for a source of size " + hnc::to_string(src.nb_row()) + " x " + hnc::to_string(src.nb_col())));
+			#endif
+			if (tile == 0) { tile = hnc::math::transpose_tile_size<T>(); }
+
+			std::size_t const nb_row = src.nb_row();
+			std::size_t const nb_col = src.nb_col();
+			T_src const * const src_data = src.data();
+			T * const dst_data = dst.data();
+			std::size_t const src_row_stride = src.row_stride();
+			std::size_t const src_col_stride = src.col_stride();
+			std::size_t const dst_row_stride = dst.row_stride();
+			std::size_t const dst_col_stride = dst.col_stride();
+
+			long int const nb_tile_row = long((nb_row + tile - 1) / tile);
+			#pragma omp parallel for
+			for (long int tile_row = 0; tile_row < nb_tile_row; ++tile_row)
+			{
+				std::size_t const i_begin = std::size_t(tile_row) * tile;
+				std::size_t const i_end = std::min(i_begin + tile, nb_row);
+				for (std::size_t j_begin = 0; j_begin < nb_col; j_begin += tile)
+				{
+					std::size_t const j_end = std::min(j_begin + tile, nb_col);
+					for (std::size_t i = i_begin; i < i_end; ++i)
+					{
+						T_src const * const src_row = src_data + i * src_row_stride;
+						T * const dst_col = dst_data + i * dst_col_stride;
+						for (std::size_t j = j_begin; j < j_end; ++j)
+						{
+							dst_col[j * dst_row_stride] = src_row[j * src_col_stride];
+						}
+					}
+				}
+			}
+		}
+
+		/// @brief Return the transposed matrix (cache-blocked, see hnc::math::transpose)
+		/// @param[in] m A hnc::vector2D
+		/// @return the transposed matrix
+		template <class T, class storage_t>
+		hnc::vector2D<T, storage_t> transpose(hnc::vector2D<T, storage_t> const & m)
+		{
+			hnc::vector2D<T, storage_t> r(m.nb_col(), m.nb_row());
+			hnc::math::transpose(m.view(), r.view());
+			return r;
+		}
+	}
+}
+
+#endif
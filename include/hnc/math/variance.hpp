@@ -89,6 +89,21 @@ namespace hnc
 		template <class T, template <class, class Alloc = std::allocator<T>> class Container>
 		T variance(Container<T> const & c)
 		{ return hnc::math::variance(c.begin(), c.end()); }
+
+		/**
+		 * @brief Variance of the values of a range (a hnc::vector2D_view, a row or a column of a matrix, ...)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * @param[in] r A range with begin() and end() (with a size >= 1)
+		 *
+		 * @return the variance
+		 */
+		template <class range_t>
+		auto variance(range_t const & r) -> decltype(hnc::math::variance(r.begin(), r.end()))
+		{ return hnc::math::variance(r.begin(), r.end()); }
 	}
 }
 
@@ -0,0 +1,367 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+#ifndef HNC_MATH_VECTOR2D_FIXED_HPP
+#define HNC_MATH_VECTOR2D_FIXED_HPP
+
+#include <cstddef>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "../vector2D_fixed.hpp"
+
+
+namespace hnc
+{
+	namespace math
+	{
+		/// @brief Unrolled loops of the operations on hnc::vector2D_fixed
+		namespace vector2D_fixed_kernel
+		{
+			/**
+			 * @brief Call f(0), f(1), ..., f(n - 1) without loop
+			 *
+			 * The calls are generated at compile time, so the compiler inlines them with constant indexes
+			 *
+			 * @tparam n Number of calls
+			 */
+			template <std::size_t n>
+			class unroll
+			{
+			public:
+
+				/// @brief Call f(0), f(1), ..., f(n - 1)
+				/// @param[in] f A function with a std::size_t parameter
+				template <class function_t>
+				static void apply(function_t const & f)
+				{
+					unroll<n - 1>::apply(f);
+					f(n - 1);
+				}
+			};
+
+			/// @brief End of the unrolled calls
+			template <>
+			class unroll<0>
+			{
+			public:
+
+				/// @brief Call nothing
+				template <class function_t>
+				static void apply(function_t const &) { }
+			};
+
+			/// @brief Throw std::domain_error if the determinant is 0
+			/// @param[in] determinant Determinant of a square matrix
+			/// @exception std::domain_error if the determinant is 0
+			template <class T>
+			void check_invertible(T const & determinant)
+			{
+				if (determinant == T(0)) { throw std::domain_error("hnc::math::inverse, the matrix is singular (the determinant is 0)"); }
+			}
+		}
+
+		/**
+		 * @brief Return the product of two hnc::vector2D_fixed (unrolled)
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The three loops are unrolled at compile time (see hnc::math::vector2D_fixed_kernel::unroll): it is for small matrices
+		 *
+		 * @param[in] a A hnc::vector2D_fixed (m x k)
+		 * @param[in] b A hnc::vector2D_fixed (k x n)
+		 *
+		 * @return a * b (m x n)
+		 */
+		template <class T, std::size_t m, std::size_t k, std::size_t n>
+		hnc::vector2D_fixed<T, m, n> multiply(hnc::vector2D_fixed<T, m, k> const & a, hnc::vector2D_fixed<T, k, n> const & b)
+		{
+			using hnc::math::vector2D_fixed_kernel::unroll;
+			hnc::vector2D_fixed<T, m, n> c;
+			T const * const pa = a.data();
+			T const * const pb = b.data();
+			T * const pc = c.data();
+			unroll<m>::apply([&](std::size_t const i)
+			{
+				unroll<n>::apply([&](std::size_t const j)
+				{
+					T r = T();
+					unroll<k>::apply([&](std::size_t const l) { r += pa[i * k + l] * pb[l * n + j]; });
+					pc[i * n + j] = r;
+				});
+			});
+			return c;
+		}
+
+		/// @brief Return the transposed hnc::vector2D_fixed (unrolled)
+		/// @param[in] a A hnc::vector2D_fixed (m x n)
+		/// @return the transposed matrix (n x m)
+		template <class T, std::size_t m, std::size_t n>
+		hnc::vector2D_fixed<T, n, m> transpose(hnc::vector2D_fixed<T, m, n> const & a)
+		{
+			using hnc::math::vector2D_fixed_kernel::unroll;
+			hnc::vector2D_fixed<T, n, m> r;
+			T const * const pa = a.data();
+			T * const pr = r.data();
+			unroll<m>::apply([&](std::size_t const i)
+			{
+				unroll<n>::apply([&](std::size_t const j) { pr[j * m + i] = pa[i * n + j]; });
+			});
+			return r;
+		}
+
+		/**
+		 * @brief Return the determinant of a square hnc::vector2D_fixed
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The 1 x 1, 2 x 2, 3 x 3 and 4 x 4 matrices use the explicit formulas (constexpr for 1 x 1, 2 x 2 and 3 x 3), @n
+		 * the other sizes use a Gaussian elimination with partial pivoting (for floating-point values)
+		 *
+		 * @param[in] a A square hnc::vector2D_fixed
+		 *
+		 * @return the determinant of a
+		 */
+		template <class T, std::size_t n>
+		T determinant(hnc::vector2D_fixed<T, n, n> const & a)
+		{
+			using std::abs;
+			hnc::vector2D_fixed<T, n, n> lu = a;
+			T r = T(1);
+			for (std::size_t col = 0; col < n; ++col)
+			{
+				std::size_t pivot = col;
+				for (std::size_t row = col + 1; row < n; ++row) { if (abs(lu(row, col)) > abs(lu(pivot, col))) { pivot = row; } }
+				if (lu(pivot, col) == T(0)) { return T(0); }
+				if (pivot != col)
+				{
+					for (std::size_t j = col; j < n; ++j) { std::swap(lu(pivot, j), lu(col, j)); }
+					r = -r;
+				}
+				r *= lu(col, col);
+				for (std::size_t row = col + 1; row < n; ++row)
+				{
+					T const factor = lu(row, col) / lu(col, col);
+					for (std::size_t j = col + 1; j < n; ++j) { lu(row, j) -= factor * lu(col, j); }
+				}
+			}
+			return r;
+		}
+
+		/// @brief Return the determinant of a 1 x 1 hnc::vector2D_fixed (constexpr)
+		/// @param[in] a A 1 x 1 hnc::vector2D_fixed
+		/// @return the determinant of a
+		template <class T>
+		constexpr T determinant(hnc::vector2D_fixed<T, 1, 1> const & a)
+		{
+			return a(0, 0);
+		}
+
+		/// @brief Return the determinant of a 2 x 2 hnc::vector2D_fixed (constexpr)
+		/// @param[in] a A 2 x 2 hnc::vector2D_fixed
+		/// @return the determinant of a
+		template <class T>
+		constexpr T determinant(hnc::vector2D_fixed<T, 2, 2> const & a)
+		{
+			return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+		}
+
+		/// @brief Return the determinant of a 3 x 3 hnc::vector2D_fixed (constexpr)
+		/// @param[in] a A 3 x 3 hnc::vector2D_fixed
+		/// @return the determinant of a
+		template <class T>
+		constexpr T determinant(hnc::vector2D_fixed<T, 3, 3> const & a)
+		{
+			return
+				a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1)) +
+				a(0, 1) * (a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2)) +
+				a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+		}
+
+		/// @brief Return the determinant of a 4 x 4 hnc::vector2D_fixed (with the 2 x 2 minors of the first two rows and of the last two rows)
+		/// @param[in] a A 4 x 4 hnc::vector2D_fixed
+		/// @return the determinant of a
+		template <class T>
+		T determinant(hnc::vector2D_fixed<T, 4, 4> const & a)
+		{
+			T const s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+			T const s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+			T const s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+			T const s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+			T const s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+			T const s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+			T const c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+			T const c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+			T const c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+			T const c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+			T const c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+			T const c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+			return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		}
+
+		/**
+		 * @brief Return the inverse of a square hnc::vector2D_fixed
+		 *
+		 * @code
+		   #include <hnc/math.hpp>
+		   @endcode
+		 *
+		 * The 1 x 1, 2 x 2, 3 x 3 and 4 x 4 matrices use the adjugate matrix (explicit formulas), @n
+		 * the other sizes use a Gauss-Jordan elimination with partial pivoting
+		 *
+		 * @param[in] a A square hnc::vector2D_fixed (floating-point values)
+		 *
+		 * @exception std::domain_error if the matrix is singular
+		 *
+		 * @return the inverse of a
+		 */
+		template <class T, std::size_t n>
+		hnc::vector2D_fixed<T, n, n> inverse(hnc::vector2D_fixed<T, n, n> const & a)
+		{
+			using std::abs;
+			hnc::vector2D_fixed<T, n, n> lu = a;
+			hnc::vector2D_fixed<T, n, n> r;
+			for (std::size_t i = 0; i < n; ++i) { r(i, i) = T(1); }
+			for (std::size_t col = 0; col < n; ++col)
+			{
+				std::size_t pivot = col;
+				for (std::size_t row = col + 1; row < n; ++row) { if (abs(lu(row, col)) > abs(lu(pivot, col))) { pivot = row; } }
+				hnc::math::vector2D_fixed_kernel::check_invertible(lu(pivot, col));
+				if (pivot != col)
+				{
+					for (std::size_t j = 0; j < n; ++j) { std::swap(lu(pivot, j), lu(col, j)); std::swap(r(pivot, j), r(col, j)); }
+				}
+				T const inv_pivot = T(1) / lu(col, col);
+				for (std::size_t j = 0; j < n; ++j) { lu(col, j) *= inv_pivot; r(col, j) *= inv_pivot; }
+				for (std::size_t row = 0; row < n; ++row)
+				{
+					if (row == col) { continue; }
+					T const factor = lu(row, col);
+					for (std::size_t j = 0; j < n; ++j) { lu(row, j) -= factor * lu(col, j); r(row, j) -= factor * r(col, j); }
+				}
+			}
+			return r;
+		}
+
+		/// @brief Return the inverse of a 1 x 1 hnc::vector2D_fixed
+		/// @param[in] a A 1 x 1 hnc::vector2D_fixed
+		/// @exception std::domain_error if the matrix is singular
+		/// @return the inverse of a
+		template <class T>
+		hnc::vector2D_fixed<T, 1, 1> inverse(hnc::vector2D_fixed<T, 1, 1> const & a)
+		{
+			hnc::math::vector2D_fixed_kernel::check_invertible(a(0, 0));
+			hnc::vector2D_fixed<T, 1, 1> r;
+			r(0, 0) = T(1) / a(0, 0);
+			return r;
+		}
+
+		/// @brief Return the inverse of a 2 x 2 hnc::vector2D_fixed
+		/// @param[in] a A 2 x 2 hnc::vector2D_fixed
+		/// @exception std::domain_error if the matrix is singular
+		/// @return the inverse of a
+		template <class T>
+		hnc::vector2D_fixed<T, 2, 2> inverse(hnc::vector2D_fixed<T, 2, 2> const & a)
+		{
+			T const det = hnc::math::determinant(a);
+			hnc::math::vector2D_fixed_kernel::check_invertible(det);
+			T const inv_det = T(1) / det;
+			return hnc::vector2D_fixed<T, 2, 2>
+			(
+				hnc::row_major_values,
+				a(1, 1) * inv_det, -a(0, 1) * inv_det,
+				-a(1, 0) * inv_det, a(0, 0) * inv_det
+			);
+		}
+
+		/// @brief Return the inverse of a 3 x 3 hnc::vector2D_fixed
+		/// @param[in] a A 3 x 3 hnc::vector2D_fixed
+		/// @exception std::domain_error if the matrix is singular
+		/// @return the inverse of a
+		template <class T>
+		hnc::vector2D_fixed<T, 3, 3> inverse(hnc::vector2D_fixed<T, 3, 3> const & a)
+		{
+			T const c00 = a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1);
+			T const c01 = a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2);
+			T const c02 = a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0);
+			T const det = a(0, 0) * c00 + a(0, 1) * c01 + a(0, 2) * c02;
+			hnc::math::vector2D_fixed_kernel::check_invertible(det);
+			T const inv_det = T(1) / det;
+			return hnc::vector2D_fixed<T, 3, 3>
+			(
+				hnc::row_major_values,
+				c00 * inv_det, (a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2)) * inv_det, (a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1)) * inv_det,
+				c01 * inv_det, (a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0)) * inv_det, (a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2)) * inv_det,
+				c02 * inv_det, (a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1)) * inv_det, (a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)) * inv_det
+			);
+		}
+
+		/// @brief Return the inverse of a 4 x 4 hnc::vector2D_fixed (with the 2 x 2 minors of the first two rows and of the last two rows)
+		/// @param[in] a A 4 x 4 hnc::vector2D_fixed
+		/// @exception std::domain_error if the matrix is singular
+		/// @return the inverse of a
+		template <class T>
+		hnc::vector2D_fixed<T, 4, 4> inverse(hnc::vector2D_fixed<T, 4, 4> const & a)
+		{
+			T const s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+			T const s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+			T const s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+			T const s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+			T const s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+			T const s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+			T const c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+			T const c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+			T const c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+			T const c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+			T const c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+			T const c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+			T const det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			hnc::math::vector2D_fixed_kernel::check_invertible(det);
+			T const inv_det = T(1) / det;
+			return hnc::vector2D_fixed<T, 4, 4>
+			(
+				hnc::row_major_values,
+				( a(1, 1) * c5 - a(1, 2) * c4 + a(1, 3) * c3) * inv_det,
+				(-a(0, 1) * c5 + a(0, 2) * c4 - a(0, 3) * c3) * inv_det,
+				( a(3, 1) * s5 - a(3, 2) * s4 + a(3, 3) * s3) * inv_det,
+				(-a(2, 1) * s5 + a(2, 2) * s4 - a(2, 3) * s3) * inv_det,
+
+				(-a(1, 0) * c5 + a(1, 2) * c2 - a(1, 3) * c1) * inv_det,
+				( a(0, 0) * c5 - a(0, 2) * c2 + a(0, 3) * c1) * inv_det,
+				(-a(3, 0) * s5 + a(3, 2) * s2 - a(3, 3) * s1) * inv_det,
+				( a(2, 0) * s5 - a(2, 2) * s2 + a(2, 3) * s1) * inv_det,
+
+				( a(1, 0) * c4 - a(1, 1) * c2 + a(1, 3) * c0) * inv_det,
+				(-a(0, 0) * c4 + a(0, 1) * c2 - a(0, 3) * c0) * inv_det,
+				( a(3, 0) * s4 - a(3, 1) * s2 + a(3, 3) * s0) * inv_det,
+				(-a(2, 0) * s4 + a(2, 1) * s2 - a(2, 3) * s0) * inv_det,
+
+				(-a(1, 0) * c3 + a(1, 1) * c1 - a(1, 2) * c0) * inv_det,
+				( a(0, 0) * c3 - a(0, 1) * c1 + a(0, 2) * c0) * inv_det,
+				(-a(3, 0) * s3 + a(3, 1) * s1 - a(3, 2) * s0) * inv_det,
+				( a(2, 0) * s3 - a(2, 1) * s1 + a(2, 2) * s0) * inv_det
+			);
+		}
+	}
+}
+
+#endif
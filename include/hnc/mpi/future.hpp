@@ -29,6 +29,7 @@
 
 #include "../boost_serialization_std.hpp"
 #include "../unused.hpp"
+#include "../trace.hpp"
 
 
 namespace hnc
@@ -661,6 +662,7 @@ namespace hnc
 		template <class result_t>
 		result_t future<result_t>::get()
 		{
+			hnc_trace_scope("hnc::mpi::future::get");
 			result_t r{};
 			// Get result
 			if (!m_done)
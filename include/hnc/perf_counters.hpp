@@ -0,0 +1,224 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#ifndef HNC_PERF_COUNTERS_HPP
+#define HNC_PERF_COUNTERS_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#ifdef hnc_linux
+	#include <unistd.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+
+
+namespace hnc
+{
+	/**
+	 * @brief Hardware performance counters of the calling thread (Linux perf_event_open)
+	 *
+	 * @code
+	   #include <hnc/perf_counters.hpp>
+	   @endcode
+	 *
+	 * The counters are opened in one group (they are scheduled together):
+	 * - cycles
+	 * - instructions
+	 * - cache misses
+	 * - branch misses
+	 * - context switches
+	 *
+	 * A counter which can not be opened (not supported, /proc/sys/kernel/perf_event_paranoid, container) is not available and its value is 0 @n
+	 * If no counter can be opened (or if the platform is not Linux), hnc::perf_counters::available() returns false
+	 *
+	 * @code
+	   hnc::perf_counters counters;
+	   if (counters.available())
+	   {
+	   	counters.start();
+	   	// Some computation
+	   	hnc::perf_counters::values_t values = counters.stop();
+	   	std::cout << values[std::size_t(hnc::perf_counters::event_t::instructions)] << " instructions" << std::endl;
+	   }
+	   @endcode
+	 *
+	 * @note hnc::perf_counters is not copyable
+	 */
+	class perf_counters
+	{
+	public:
+
+		/// Events
+		enum class event_t : std::size_t { cycles, instructions, cache_misses, branch_misses, context_switches };
+
+		/// Number of events
+		static std::size_t const nb_event = 5;
+
+		/// Values of the counters (indexed by std::size_t(event_t))
+		using values_t = std::array<std::uint64_t, nb_event>;
+
+	private:
+
+		/// File descriptors of the counters (-1 if not available)
+		std::array<int, nb_event> m_fd;
+
+		/// File descriptor of the leader of the group
+		int m_leader_fd;
+
+		/// Events in the order of the group
+		std::vector<event_t> m_group;
+
+	public:
+
+		/// @brief Constructor, open the counters
+		perf_counters() :
+			m_leader_fd(-1),
+			m_group()
+		{
+			m_fd.fill(-1);
+
+			#ifdef hnc_linux
+				for (event_t const event : events())
+				{
+					perf_event_attr attr;
+					std::memset(&attr, 0, sizeof(perf_event_attr));
+					attr.size = sizeof(perf_event_attr);
+					attr.disabled = (m_leader_fd == -1) ? 1 : 0;
+					attr.exclude_hv = 1;
+					attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+					switch (event)
+					{
+						case event_t::cycles:           attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+						case event_t::instructions:     attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+						case event_t::cache_misses:     attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+						case event_t::branch_misses:    attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+						case event_t::context_switches: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES; break;
+					}
+					// Context switches happen in the kernel
+					attr.exclude_kernel = (event == event_t::context_switches) ? 0 : 1;
+
+					int const fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, m_leader_fd, 0));
+					if (fd != -1)
+					{
+						m_fd[std::size_t(event)] = fd;
+						m_group.push_back(event);
+						if (m_leader_fd == -1) { m_leader_fd = fd; }
+					}
+				}
+			#endif
+		}
+
+		/// @brief Copy constructor (deleted)
+		perf_counters(perf_counters const &) = delete;
+
+		/// @brief Copy assignment operator (deleted)
+		perf_counters & operator =(perf_counters const &) = delete;
+
+		/// @brief Destructor, close the counters
+		~perf_counters()
+		{
+			#ifdef hnc_linux
+				for (int const fd : m_fd) { if (fd != -1) { close(fd); } }
+			#endif
+		}
+
+		/// @brief Return all events
+		/// @return all events
+		static std::vector<event_t> events()
+		{
+			return { event_t::cycles, event_t::instructions, event_t::cache_misses, event_t::branch_misses, event_t::context_switches };
+		}
+
+		/// @brief Return the name of an event
+		/// @param[in] event An event
+		/// @return the name of an event
+		static std::string name(event_t const event)
+		{
+			switch (event)
+			{
+				case event_t::cycles:           return "cycles";
+				case event_t::instructions:     return "instructions";
+				case event_t::cache_misses:     return "cache misses";
+				case event_t::branch_misses:    return "branch misses";
+				case event_t::context_switches: return "context switches";
+			}
+			return "";
+		}
+
+		/// @brief Return true if at least one counter is available
+		/// @return true if at least one counter is available, false otherwise
+		bool available() const { return m_leader_fd != -1; }
+
+		/// @brief Return true if the counter is available
+		/// @param[in] event An event
+		/// @return true if the counter is available, false otherwise
+		bool available(event_t const event) const { return m_fd[std::size_t(event)] != -1; }
+
+		/// @brief Reset and start the counters
+		void start()
+		{
+			#ifdef hnc_linux
+				if (m_leader_fd == -1) { return; }
+				ioctl(m_leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(m_leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			#endif
+		}
+
+		/// @brief Stop the counters and return their values (scaled if the group was multiplexed)
+		/// @return the values of the counters
+		values_t stop()
+		{
+			values_t r;
+			r.fill(0);
+
+			#ifdef hnc_linux
+				if (m_leader_fd == -1) { return r; }
+				ioctl(m_leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+				// nr, time enabled, time running, values
+				std::array<std::uint64_t, 3 + nb_event> buffer;
+				buffer.fill(0);
+				if (read(m_leader_fd, buffer.data(), sizeof(buffer)) <= 0) { return r; }
+
+				std::uint64_t const nr = std::min(buffer[0], std::uint64_t(m_group.size()));
+				std::uint64_t const time_enabled = buffer[1];
+				std::uint64_t const time_running = buffer[2];
+				for (std::size_t i = 0; i < nr; ++i)
+				{
+					std::uint64_t value = buffer[3 + i];
+					if (time_running != 0 && time_running < time_enabled)
+					{
+						value = std::uint64_t((long double)(value) * (long double)(time_enabled) / (long double)(time_running));
+					}
+					r[std::size_t(m_group[i])] = value;
+				}
+			#endif
+
+			return r;
+		}
+	};
+}
+
+#endif
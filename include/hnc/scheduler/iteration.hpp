@@ -22,6 +22,8 @@
 #include <initializer_list>
 #include <functional>
 
+#include "../trace.hpp"
+
 
 namespace hnc
 {
@@ -152,6 +154,8 @@ namespace hnc
 			incr_t const & step = 1
 		)
 		{
+			hnc_trace_scope("hnc::scheduler::iteration");
+			
 			while (first < last)
 			{
 				// Index of the best version
@@ -161,12 +165,15 @@ namespace hnc
 				// Samples
 				for (std::size_t i = 0; i < versions.size() && first < last; ++i)
 				{
-					// Compute
-					auto time_first = std::chrono::steady_clock::now();
+					// Compute (the span is outside the measure of the version)
+					std::chrono::steady_clock::time_point time_first;
+					std::chrono::steady_clock::time_point time_last;
 					{
+						hnc_trace_scope("hnc::scheduler::iteration sample");
+						time_first = std::chrono::steady_clock::now();
 						versions[i](first, std::min(it_t(first) + it_t(nb_it_sample) * it_t(step), last));
+						time_last = std::chrono::steady_clock::now();
 					}
-					auto time_last = std::chrono::steady_clock::now();
 					
 					// Save best version
 					auto const time = (time_last - time_first).count();
@@ -184,6 +191,7 @@ namespace hnc
 				if (first < last)
 				{
 					// Compute
+					hnc_trace_scope("hnc::scheduler::iteration compute");
 					versions[best_version](first, std::min(it_t(first) + it_t(nb_it_compute) * it_t(step), last));
 					// Next iterations
 					first += it_t(nb_it_compute) * it_t(step);
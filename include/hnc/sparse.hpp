@@ -0,0 +1,40 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_SPARSE_HPP
+#define HNC_SPARSE_HPP
+
+#include "sparse/compress.hpp"
+#include "sparse/coo.hpp"
+#include "sparse/csc.hpp"
+#include "sparse/csr.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Sparse matrices (COO to build, CSR and CSC to compute), companions of hnc::vector2D
+	 *
+	 * @code
+	   #include <hnc/sparse.hpp>
+	   @endcode
+	 */
+	namespace sparse
+	{
+		// For Doxygen only
+	}
+}
+
+#endif
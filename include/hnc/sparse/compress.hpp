@@ -0,0 +1,148 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_SPARSE_COMPRESS_HPP
+#define HNC_SPARSE_COMPRESS_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace hnc
+{
+	namespace sparse
+	{
+		/**
+		 * @brief Compress (major, minor, value) triplets (CSR with major = row, CSC with major = column)
+		 *
+		 * @code
+		   #include <hnc/sparse/compress.hpp>
+		   @endcode
+		 *
+		 * The triplets are sorted by major index (counting sort) then by minor index (stable sort in each major index),
+		 * the values of the duplicated (major, minor) are summed in the order of the triplets
+		 *
+		 * @param[in]  nb_major   Number of major indexes (number of rows for CSR)
+		 * @param[in]  major      Major indexes (< nb_major)
+		 * @param[in]  minor      Minor indexes
+		 * @param[in]  values     Values
+		 * @param[out] ptr        Values of the major index m are in [ptr[m], ptr[m + 1]) (nb_major + 1 values)
+		 * @param[out] index      Minor indexes, sorted for each major index
+		 * @param[out] out_values Values
+		 */
+		template <class T>
+		void compress
+		(
+			std::size_t const nb_major,
+			std::vector<std::size_t> const & major,
+			std::vector<std::size_t> const & minor,
+			std::vector<T> const & values,
+			std::vector<std::size_t> & ptr,
+			std::vector<std::size_t> & index,
+			std::vector<T> & out_values
+		)
+		{
+			// Counting sort by major index
+			ptr.assign(nb_major + 1, 0);
+			for (std::size_t const m : major) { ++ptr[m + 1]; }
+			for (std::size_t m = 0; m < nb_major; ++m) { ptr[m + 1] += ptr[m]; }
+			std::vector<std::pair<std::size_t, T>> entries(values.size());
+			{
+				std::vector<std::size_t> next(ptr.begin(), ptr.end() - 1);
+				for (std::size_t k = 0; k < values.size(); ++k) { entries[next[major[k]]++] = std::make_pair(minor[k], values[k]); }
+			}
+
+			// Sort by minor index and sum the duplicates
+			index.clear();
+			out_values.clear();
+			index.reserve(entries.size());
+			out_values.reserve(entries.size());
+			std::size_t begin = 0;
+			for (std::size_t m = 0; m < nb_major; ++m)
+			{
+				std::size_t const end = ptr[m + 1];
+				std::stable_sort
+				(
+					entries.begin() + std::ptrdiff_t(begin), entries.begin() + std::ptrdiff_t(end),
+					[](std::pair<std::size_t, T> const & a, std::pair<std::size_t, T> const & b) { return a.first < b.first; }
+				);
+				std::size_t const first = index.size();
+				for (std::size_t k = begin; k < end; ++k)
+				{
+					if (index.size() > first && index.back() == entries[k].first) { out_values.back() += entries[k].second; }
+					else
+					{
+						index.push_back(entries[k].first);
+						out_values.push_back(entries[k].second);
+					}
+				}
+				ptr[m + 1] = index.size();
+				begin = end;
+			}
+		}
+
+		/**
+		 * @brief Transpose a compressed matrix (CSR to CSC or CSC to CSR)
+		 *
+		 * @code
+		   #include <hnc/sparse/compress.hpp>
+		   @endcode
+		 *
+		 * The minor indexes of the result are sorted
+		 *
+		 * @param[in]  nb_major   Number of major indexes
+		 * @param[in]  nb_minor   Number of minor indexes
+		 * @param[in]  ptr        Values of the major index m are in [ptr[m], ptr[m + 1])
+		 * @param[in]  index      Minor indexes
+		 * @param[in]  values     Values
+		 * @param[out] out_ptr    Values of the minor index m are in [out_ptr[m], out_ptr[m + 1]) (nb_minor + 1 values)
+		 * @param[out] out_index  Major indexes
+		 * @param[out] out_values Values
+		 */
+		template <class T>
+		void transpose_compressed
+		(
+			std::size_t const nb_major,
+			std::size_t const nb_minor,
+			std::vector<std::size_t> const & ptr,
+			std::vector<std::size_t> const & index,
+			std::vector<T> const & values,
+			std::vector<std::size_t> & out_ptr,
+			std::vector<std::size_t> & out_index,
+			std::vector<T> & out_values
+		)
+		{
+			out_ptr.assign(nb_minor + 1, 0);
+			for (std::size_t const m : index) { ++out_ptr[m + 1]; }
+			for (std::size_t m = 0; m < nb_minor; ++m) { out_ptr[m + 1] += out_ptr[m]; }
+			out_index.resize(index.size());
+			out_values.resize(values.size());
+			std::vector<std::size_t> next(out_ptr.begin(), out_ptr.end() - 1);
+			for (std::size_t m = 0; m < nb_major; ++m)
+			{
+				for (std::size_t k = ptr[m]; k < ptr[m + 1]; ++k)
+				{
+					std::size_t const position = next[index[k]]++;
+					out_index[position] = m;
+					out_values[position] = values[k];
+				}
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,168 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_SPARSE_COO_HPP
+#define HNC_SPARSE_COO_HPP
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+#include "../vector2D.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+#include "../serialization.hpp"
+
+
+namespace hnc
+{
+	namespace sparse
+	{
+		/**
+		 * @brief Sparse matrix in coordinate format (list of (row, column, value) triplets), to build a hnc::sparse::csr or a hnc::sparse::csc
+		 *
+		 * @code
+		   #include <hnc/sparse/coo.hpp>
+		   @endcode
+		 *
+		 * The triplets are not sorted, the duplicated (row, column) are summed by the conversions @n
+		 * The missing values are T() (0)
+		 *
+		 * @code
+		   hnc::sparse::coo<double> m(1000, 1000);
+		   for (std::size_t i = 0; i < 1000; ++i) { m.add(i, i, 2.); if (i != 0) { m.add(i, i - 1, -1.); } }
+		   hnc::sparse::csr<double> const m_csr(m);
+		   @endcode
+		 */
+		template <class T>
+		class coo
+		{
+		private:
+
+			/// Number of rows
+			std::size_t m_nb_row;
+
+			/// Number of columns
+			std::size_t m_nb_col;
+
+			/// Row indexes
+			std::vector<std::size_t> m_rows;
+
+			/// Column indexes
+			std::vector<std::size_t> m_cols;
+
+			/// Values
+			std::vector<T> m_values;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			coo(std::size_t const nb_row = 0, std::size_t const nb_col = 0) :
+				m_nb_row(nb_row),
+				m_nb_col(nb_col),
+				m_rows(),
+				m_cols(),
+				m_values()
+			{ }
+
+			/// @brief Constructor from a hnc::vector2D (the values different from T() are kept, in row-major order)
+			/// @param[in] m A hnc::vector2D
+			template <class storage_t>
+			explicit coo(hnc::vector2D<T, storage_t> const & m) :
+				coo(m.nb_row(), m.nb_col())
+			{
+				for (std::size_t i = 0; i < m.nb_row(); ++i)
+				{
+					for (std::size_t j = 0; j < m.nb_col(); ++j)
+					{
+						if (m(i, j) != T()) { add(i, j, m(i, j)); }
+					}
+				}
+			}
+
+			/// @brief Return the number of rows
+			/// @return the number of rows
+			std::size_t nb_row() const { return m_nb_row; }
+
+			/// @brief Return the number of columns
+			/// @return the number of columns
+			std::size_t nb_col() const { return m_nb_col; }
+
+			/// @brief Return the number of triplets (the duplicates are counted)
+			/// @return the number of triplets
+			std::size_t nb_non_zero() const { return m_values.size(); }
+
+			/// @brief Return the row indexes
+			/// @return the row indexes
+			std::vector<std::size_t> const & rows() const { return m_rows; }
+
+			/// @brief Return the column indexes
+			/// @return the column indexes
+			std::vector<std::size_t> const & cols() const { return m_cols; }
+
+			/// @brief Return the values
+			/// @return the values
+			std::vector<T> const & values() const { return m_values; }
+
+			/// @brief Reserve the memory for nb_non_zero triplets
+			/// @param[in] nb_non_zero Number of triplets
+			void reserve(std::size_t const nb_non_zero)
+			{
+				m_rows.reserve(nb_non_zero);
+				m_cols.reserve(nb_non_zero);
+				m_values.reserve(nb_non_zero);
+			}
+
+			/// @brief Add a value at (i, j) (it is summed with the other values at (i, j))
+			/// @param[in] i     Row index
+			/// @param[in] j     Column index
+			/// @param[in] value Value
+			/// @exception std::out_of_range hnc::hassert i < nb_row() and j < nb_col() if NDEBUG is not defined
+			void add(std::size_t const i, std::size_t const j, T const & value)
+			{
+				#ifndef NDEBUG
+					hnc::hassert(i < m_nb_row && j < m_nb_col, std::out_of_range("hnc::sparse::coo::add, (" + hnc::to_string(i) + ", " + hnc::to_string(j) + ") is out of the " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col) + " matrix"));
+				#endif
+				m_rows.push_back(i);
+				m_cols.push_back(j);
+				m_values.push_back(value);
+			}
+
+			/// @brief Remove all triplets (the size does not change)
+			void clear()
+			{
+				m_rows.clear();
+				m_cols.clear();
+				m_values.clear();
+			}
+
+			/// @brief Return the dense matrix
+			/// @return the hnc::vector2D (the duplicates are summed)
+			template <class storage_t = hnc::vector2D_storage::packed<T>>
+			hnc::vector2D<T, storage_t> to_vector2D() const
+			{
+				hnc::vector2D<T, storage_t> r(m_nb_row, m_nb_col);
+				for (std::size_t k = 0; k < m_values.size(); ++k) { r(m_rows[k], m_cols[k]) += m_values[k]; }
+				return r;
+			}
+
+			hnc_generate_serialize_member_function(m_nb_row, m_nb_col, m_rows, m_cols, m_values)
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,319 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_SPARSE_CSC_HPP
+#define HNC_SPARSE_CSC_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#include "coo.hpp"
+#include "csr.hpp"
+#include "compress.hpp"
+#include "../vector2D.hpp"
+#include "../openmp.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+#include "../serialization.hpp"
+
+
+namespace hnc
+{
+	namespace sparse
+	{
+		/**
+		 * @brief Sparse matrix in compressed sparse column format (CSC)
+		 *
+		 * @code
+		   #include <hnc/sparse/csc.hpp>
+		   @endcode
+		 *
+		 * The values of the column j are values()[col_ptr()[j]] to values()[col_ptr()[j + 1] - 1],
+		 * their rows are in row_index() (sorted) @n
+		 * The missing values are T() (0)
+		 *
+		 * The sparse matrix-vector product is parallelized on the columns with OpenMP (one partial result by thread, summed in a fixed order),
+		 * the sparse matrix-dense matrix product is parallelized on blocks of columns of the dense matrix
+		 *
+		 * @code
+		   hnc::sparse::coo<double> m(1000, 1000);
+		   for (std::size_t i = 0; i < 1000; ++i) { m.add(i, i, 2.); if (i != 0) { m.add(i, i - 1, -1.); } }
+		   hnc::sparse::csc<double> const a(m);
+		   std::vector<double> const y = a.multiply(std::vector<double>(1000, 1.));
+		   hnc::sparse::csr<double> const a_csr = a.to_csr();
+		   @endcode
+		 */
+		template <class T>
+		class csc
+		{
+		private:
+
+			/// Number of rows
+			std::size_t m_nb_row;
+
+			/// Number of columns
+			std::size_t m_nb_col;
+
+			/// Values of the column j are in [m_col_ptr[j], m_col_ptr[j + 1])
+			std::vector<std::size_t> m_col_ptr;
+
+			/// Row indexes
+			std::vector<std::size_t> m_row_index;
+
+			/// Values
+			std::vector<T> m_values;
+
+		public:
+
+			/// @brief Constructor of a matrix without value
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			csc(std::size_t const nb_row = 0, std::size_t const nb_col = 0) :
+				m_nb_row(nb_row),
+				m_nb_col(nb_col),
+				m_col_ptr(nb_col + 1, 0),
+				m_row_index(),
+				m_values()
+			{ }
+
+			/// @brief Constructor from a hnc::sparse::coo (the duplicates are summed)
+			/// @param[in] m A hnc::sparse::coo
+			explicit csc(hnc::sparse::coo<T> const & m) :
+				m_nb_row(m.nb_row()),
+				m_nb_col(m.nb_col()),
+				m_col_ptr(),
+				m_row_index(),
+				m_values()
+			{
+				hnc::sparse::compress(m_nb_col, m.cols(), m.rows(), m.values(), m_col_ptr, m_row_index, m_values);
+			}
+
+			/// @brief Constructor from a hnc::sparse::csr
+			/// @param[in] m A hnc::sparse::csr
+			explicit csc(hnc::sparse::csr<T> const & m) :
+				m_nb_row(m.nb_row()),
+				m_nb_col(m.nb_col()),
+				m_col_ptr(),
+				m_row_index(),
+				m_values()
+			{
+				hnc::sparse::transpose_compressed(m_nb_row, m_nb_col, m.row_ptr(), m.col_index(), m.values(), m_col_ptr, m_row_index, m_values);
+			}
+
+			/// @brief Constructor from a hnc::vector2D (the values different from T() are kept)
+			/// @param[in] m A hnc::vector2D
+			template <class storage_t>
+			explicit csc(hnc::vector2D<T, storage_t> const & m) :
+				m_nb_row(m.nb_row()),
+				m_nb_col(m.nb_col()),
+				m_col_ptr(m.nb_col() + 1, 0),
+				m_row_index(),
+				m_values()
+			{
+				for (std::size_t j = 0; j < m_nb_col; ++j)
+				{
+					for (std::size_t i = 0; i < m_nb_row; ++i)
+					{
+						if (m(i, j) != T())
+						{
+							m_row_index.push_back(i);
+							m_values.push_back(m(i, j));
+						}
+					}
+					m_col_ptr[j + 1] = m_values.size();
+				}
+			}
+
+			/// @brief Return the number of rows
+			/// @return the number of rows
+			std::size_t nb_row() const { return m_nb_row; }
+
+			/// @brief Return the number of columns
+			/// @return the number of columns
+			std::size_t nb_col() const { return m_nb_col; }
+
+			/// @brief Return the number of stored values
+			/// @return the number of stored values
+			std::size_t nb_non_zero() const { return m_values.size(); }
+
+			/// @brief Return the ratio of stored values (between 0 and 1)
+			/// @return nb_non_zero() / (nb_row() * nb_col())
+			double density() const { return (m_nb_row * m_nb_col == 0) ? 0. : double(nb_non_zero()) / double(m_nb_row * m_nb_col); }
+
+			/// @brief Return the column pointers (values of the column j are in [col_ptr()[j], col_ptr()[j + 1]))
+			/// @return the column pointers
+			std::vector<std::size_t> const & col_ptr() const { return m_col_ptr; }
+
+			/// @brief Return the row indexes
+			/// @return the row indexes
+			std::vector<std::size_t> const & row_index() const { return m_row_index; }
+
+			/// @brief Return the values
+			/// @return the values
+			std::vector<T> const & values() const { return m_values; }
+
+			/// @brief Return the value at (i, j) (binary search in the column j)
+			/// @param[in] i Row index
+			/// @param[in] j Column index
+			/// @return the value at (i, j), T() if there is no value
+			T operator()(std::size_t const i, std::size_t const j) const
+			{
+				auto const first = m_row_index.begin() + std::ptrdiff_t(m_col_ptr[j]);
+				auto const last = m_row_index.begin() + std::ptrdiff_t(m_col_ptr[j + 1]);
+				auto const it = std::lower_bound(first, last, i);
+				return (it != last && *it == i) ? m_values[std::size_t(it - m_row_index.begin())] : T();
+			}
+
+			/**
+			 * @brief Sparse matrix-vector product y = A * x
+			 *
+			 * Each thread computes a partial result with a contiguous block of columns,
+			 * the partial results are summed in the order of the threads (the result does not depend on the scheduling)
+			 *
+			 * @param[in]  x Values (nb_col() values)
+			 * @param[out] y Values (nb_row() values)
+			 */
+			void multiply(T const * const x, T * const y) const
+			{
+				std::vector<T> partial;
+				#pragma omp parallel
+				{
+					std::size_t const nb_thread = std::max(std::size_t(1), hnc::openmp::nb_thread_actual());
+					std::size_t const thread_id = hnc::openmp::thread_id();
+					#pragma omp single
+					partial.assign(nb_thread * m_nb_row, T());
+
+					T * const y_thread = partial.data() + thread_id * m_nb_row;
+					std::size_t const first_col = m_nb_col * thread_id / nb_thread;
+					std::size_t const last_col = m_nb_col * (thread_id + 1) / nb_thread;
+					for (std::size_t j = first_col; j < last_col; ++j)
+					{
+						T const x_j = x[j];
+						for (std::size_t k = m_col_ptr[j]; k < m_col_ptr[j + 1]; ++k) { y_thread[m_row_index[k]] += m_values[k] * x_j; }
+					}
+					#pragma omp barrier
+
+					#pragma omp for schedule(static)
+					for (long int i = 0; i < long(m_nb_row); ++i)
+					{
+						T r = T();
+						for (std::size_t t = 0; t < nb_thread; ++t) { r += partial[t * m_nb_row + std::size_t(i)]; }
+						y[i] = r;
+					}
+				}
+			}
+
+			/// @brief Sparse matrix-vector product (see multiply(T const *, T *))
+			/// @param[in] x A vector with nb_col() values
+			/// @exception std::invalid_argument hnc::hassert x.size() == nb_col() if NDEBUG is not defined
+			/// @return A * x
+			std::vector<T> multiply(std::vector<T> const & x) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(x.size() == m_nb_col, std::invalid_argument("hnc::sparse::csc::multiply, x has " + hnc::to_string(x.size()) + " values, number of columns = " + hnc::to_string(m_nb_col)));
+				#endif
+				std::vector<T> y(m_nb_row);
+				multiply(x.data(), y.data());
+				return y;
+			}
+
+			/// @brief Sparse matrix-dense matrix product (parallelized on blocks of 16 columns of b, the rows are combined with vectorized axpy)
+			/// @param[in] b A hnc::vector2D with nb_col() rows
+			/// @exception std::invalid_argument hnc::hassert b.nb_row() == nb_col() if NDEBUG is not defined
+			/// @return A * b
+			template <class storage_t>
+			hnc::vector2D<T, storage_t> multiply(hnc::vector2D<T, storage_t> const & b) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(b.nb_row() == m_nb_col, std::invalid_argument("hnc::sparse::csc::multiply, b has " + hnc::to_string(b.nb_row()) + " rows, number of columns = " + hnc::to_string(m_nb_col)));
+				#endif
+				hnc::vector2D<T, storage_t> c(m_nb_row, b.nb_col());
+				std::size_t const block_size = 16;
+				std::size_t const nb_block = (b.nb_col() + block_size - 1) / block_size;
+				#pragma omp parallel for schedule(dynamic)
+				for (long int block = 0; block < long(nb_block); ++block)
+				{
+					std::size_t const first = std::size_t(block) * block_size;
+					std::size_t const width = std::min(block_size, b.nb_col() - first);
+					for (std::size_t j = 0; j < m_nb_col; ++j)
+					{
+						T const * const b_row = b[j].data() + first;
+						for (std::size_t k = m_col_ptr[j]; k < m_col_ptr[j + 1]; ++k)
+						{
+							hnc::vector2D_kernel::axpy(width, m_values[k], b_row, c[m_row_index[k]].data() + first);
+						}
+					}
+				}
+				return c;
+			}
+
+			/// @brief Return the dense matrix
+			/// @return the hnc::vector2D
+			template <class storage_t = hnc::vector2D_storage::packed<T>>
+			hnc::vector2D<T, storage_t> to_vector2D() const
+			{
+				hnc::vector2D<T, storage_t> r(m_nb_row, m_nb_col);
+				for (std::size_t j = 0; j < m_nb_col; ++j)
+				{
+					for (std::size_t k = m_col_ptr[j]; k < m_col_ptr[j + 1]; ++k) { r(m_row_index[k], j) = m_values[k]; }
+				}
+				return r;
+			}
+
+			/// @brief Return the triplets
+			/// @return the hnc::sparse::coo (sorted by column then by row)
+			hnc::sparse::coo<T> to_coo() const
+			{
+				hnc::sparse::coo<T> r(m_nb_row, m_nb_col);
+				r.reserve(nb_non_zero());
+				for (std::size_t j = 0; j < m_nb_col; ++j)
+				{
+					for (std::size_t k = m_col_ptr[j]; k < m_col_ptr[j + 1]; ++k) { r.add(m_row_index[k], j, m_values[k]); }
+				}
+				return r;
+			}
+
+			/// @brief Return the matrix in CSR format
+			/// @return the hnc::sparse::csr
+			hnc::sparse::csr<T> to_csr() const
+			{
+				std::vector<std::size_t> row_ptr;
+				std::vector<std::size_t> col_index;
+				std::vector<T> values;
+				hnc::sparse::transpose_compressed(m_nb_col, m_nb_row, m_col_ptr, m_row_index, m_values, row_ptr, col_index, values);
+				return hnc::sparse::csr<T>(m_nb_row, m_nb_col, std::move(row_ptr), std::move(col_index), std::move(values));
+			}
+
+			/// @brief Equality operator
+			/// @param[in] m A hnc::sparse::csc
+			/// @return true if the matrices have the same size and the same stored values, false otherwise
+			bool operator ==(csc const & m) const
+			{
+				return m_nb_row == m.m_nb_row && m_nb_col == m.m_nb_col && m_col_ptr == m.m_col_ptr && m_row_index == m.m_row_index && m_values == m.m_values;
+			}
+
+			/// @brief Inequality operator
+			/// @param[in] m A hnc::sparse::csc
+			/// @return true if the matrices are different, false otherwise
+			bool operator !=(csc const & m) const { return (*this == m) == false; }
+
+			hnc_generate_serialize_member_function(m_nb_row, m_nb_col, m_col_ptr, m_row_index, m_values)
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,299 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_SPARSE_CSR_HPP
+#define HNC_SPARSE_CSR_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#include "coo.hpp"
+#include "compress.hpp"
+#include "../vector2D.hpp"
+#include "../vector2D_expression.hpp"
+#include "../assert.hpp"
+#include "../to_string.hpp"
+#include "../serialization.hpp"
+
+
+namespace hnc
+{
+	namespace sparse
+	{
+		/**
+		 * @brief Sparse matrix in compressed sparse row format (CSR)
+		 *
+		 * @code
+		   #include <hnc/sparse/csr.hpp>
+		   @endcode
+		 *
+		 * The values of the row i are values()[row_ptr()[i]] to values()[row_ptr()[i + 1] - 1],
+		 * their columns are in col_index() (sorted) @n
+		 * The missing values are T() (0)
+		 *
+		 * The products (sparse matrix-vector and sparse matrix-dense matrix) are parallelized on the rows with OpenMP
+		 *
+		 * @code
+		   hnc::sparse::coo<double> m(1000, 1000);
+		   for (std::size_t i = 0; i < 1000; ++i) { m.add(i, i, 2.); if (i != 0) { m.add(i, i - 1, -1.); } }
+		   hnc::sparse::csr<double> const a(m);
+		   std::vector<double> const y = a.multiply(std::vector<double>(1000, 1.));
+		   hnc::vector2D<double> const c = a.multiply(hnc::vector2D<double>(1000, 16, 1.));
+		   @endcode
+		 */
+		template <class T>
+		class csr
+		{
+		private:
+
+			/// Number of rows
+			std::size_t m_nb_row;
+
+			/// Number of columns
+			std::size_t m_nb_col;
+
+			/// Values of the row i are in [m_row_ptr[i], m_row_ptr[i + 1])
+			std::vector<std::size_t> m_row_ptr;
+
+			/// Column indexes
+			std::vector<std::size_t> m_col_index;
+
+			/// Values
+			std::vector<T> m_values;
+
+		public:
+
+			/// @brief Constructor of a matrix without value
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			csr(std::size_t const nb_row = 0, std::size_t const nb_col = 0) :
+				m_nb_row(nb_row),
+				m_nb_col(nb_col),
+				m_row_ptr(nb_row + 1, 0),
+				m_col_index(),
+				m_values()
+			{ }
+
+			/// @brief Constructor from a hnc::sparse::coo (the duplicates are summed)
+			/// @param[in] m A hnc::sparse::coo
+			explicit csr(hnc::sparse::coo<T> const & m) :
+				m_nb_row(m.nb_row()),
+				m_nb_col(m.nb_col()),
+				m_row_ptr(),
+				m_col_index(),
+				m_values()
+			{
+				hnc::sparse::compress(m_nb_row, m.rows(), m.cols(), m.values(), m_row_ptr, m_col_index, m_values);
+			}
+
+			/// @brief Constructor from a hnc::vector2D (the values different from T() are kept)
+			/// @param[in] m A hnc::vector2D
+			template <class storage_t>
+			explicit csr(hnc::vector2D<T, storage_t> const & m) :
+				m_nb_row(m.nb_row()),
+				m_nb_col(m.nb_col()),
+				m_row_ptr(m.nb_row() + 1, 0),
+				m_col_index(),
+				m_values()
+			{
+				for (std::size_t i = 0; i < m_nb_row; ++i)
+				{
+					for (std::size_t j = 0; j < m_nb_col; ++j)
+					{
+						if (m(i, j) != T())
+						{
+							m_col_index.push_back(j);
+							m_values.push_back(m(i, j));
+						}
+					}
+					m_row_ptr[i + 1] = m_values.size();
+				}
+			}
+
+			/// @brief Constructor from the arrays of a CSR matrix
+			/// @param[in] nb_row    Number of rows
+			/// @param[in] nb_col    Number of columns
+			/// @param[in] row_ptr   Values of the row i are in [row_ptr[i], row_ptr[i + 1]) (nb_row + 1 values)
+			/// @param[in] col_index Column indexes (sorted for each row)
+			/// @param[in] values    Values
+			/// @exception std::invalid_argument hnc::hassert the arrays are consistent if NDEBUG is not defined
+			csr(std::size_t const nb_row, std::size_t const nb_col, std::vector<std::size_t> row_ptr, std::vector<std::size_t> col_index, std::vector<T> values) :
+				m_nb_row(nb_row),
+				m_nb_col(nb_col),
+				m_row_ptr(std::move(row_ptr)),
+				m_col_index(std::move(col_index)),
+				m_values(std::move(values))
+			{
+				#ifndef NDEBUG
+					hnc::hassert
+					(
+						m_row_ptr.size() == m_nb_row + 1 && m_row_ptr.front() == 0 && m_row_ptr.back() == m_values.size() && m_col_index.size() == m_values.size() &&
+						std::is_sorted(m_row_ptr.begin(), m_row_ptr.end()) &&
+						std::all_of(m_col_index.begin(), m_col_index.end(), [nb_col](std::size_t const j) { return j < nb_col; }),
+						std::invalid_argument("hnc::sparse::csr, inconsistent arrays")
+					);
+				#endif
+			}
+
+			/// @brief Return the number of rows
+			/// @return the number of rows
+			std::size_t nb_row() const { return m_nb_row; }
+
+			/// @brief Return the number of columns
+			/// @return the number of columns
+			std::size_t nb_col() const { return m_nb_col; }
+
+			/// @brief Return the number of stored values
+			/// @return the number of stored values
+			std::size_t nb_non_zero() const { return m_values.size(); }
+
+			/// @brief Return the ratio of stored values (between 0 and 1)
+			/// @return nb_non_zero() / (nb_row() * nb_col())
+			double density() const { return (m_nb_row * m_nb_col == 0) ? 0. : double(nb_non_zero()) / double(m_nb_row * m_nb_col); }
+
+			/// @brief Return the row pointers (values of the row i are in [row_ptr()[i], row_ptr()[i + 1]))
+			/// @return the row pointers
+			std::vector<std::size_t> const & row_ptr() const { return m_row_ptr; }
+
+			/// @brief Return the column indexes
+			/// @return the column indexes
+			std::vector<std::size_t> const & col_index() const { return m_col_index; }
+
+			/// @brief Return the values
+			/// @return the values
+			std::vector<T> const & values() const { return m_values; }
+
+			/// @brief Return the value at (i, j) (binary search in the row i)
+			/// @param[in] i Row index
+			/// @param[in] j Column index
+			/// @return the value at (i, j), T() if there is no value
+			T operator()(std::size_t const i, std::size_t const j) const
+			{
+				auto const first = m_col_index.begin() + std::ptrdiff_t(m_row_ptr[i]);
+				auto const last = m_col_index.begin() + std::ptrdiff_t(m_row_ptr[i + 1]);
+				auto const it = std::lower_bound(first, last, j);
+				return (it != last && *it == j) ? m_values[std::size_t(it - m_col_index.begin())] : T();
+			}
+
+			/**
+			 * @brief Sparse matrix-vector product y = A * x (parallelized on the rows)
+			 *
+			 * @param[in]  x Values (nb_col() values)
+			 * @param[out] y Values (nb_row() values)
+			 */
+			void multiply(T const * const x, T * const y) const
+			{
+				#pragma omp parallel for schedule(dynamic, 64)
+				for (long int i = 0; i < long(m_nb_row); ++i)
+				{
+					T r = T();
+					for (std::size_t k = m_row_ptr[std::size_t(i)]; k < m_row_ptr[std::size_t(i) + 1]; ++k) { r += m_values[k] * x[m_col_index[k]]; }
+					y[i] = r;
+				}
+			}
+
+			/// @brief Sparse matrix-vector product (parallelized on the rows)
+			/// @param[in] x A vector with nb_col() values
+			/// @exception std::invalid_argument hnc::hassert x.size() == nb_col() if NDEBUG is not defined
+			/// @return A * x
+			std::vector<T> multiply(std::vector<T> const & x) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(x.size() == m_nb_col, std::invalid_argument("hnc::sparse::csr::multiply, x has " + hnc::to_string(x.size()) + " values, number of columns = " + hnc::to_string(m_nb_col)));
+				#endif
+				std::vector<T> y(m_nb_row);
+				multiply(x.data(), y.data());
+				return y;
+			}
+
+			/// @brief Sparse matrix-dense matrix product (parallelized on the rows, the rows of b are combined with vectorized axpy)
+			/// @param[in] b A hnc::vector2D with nb_col() rows
+			/// @exception std::invalid_argument hnc::hassert b.nb_row() == nb_col() if NDEBUG is not defined
+			/// @return A * b
+			template <class storage_t>
+			hnc::vector2D<T, storage_t> multiply(hnc::vector2D<T, storage_t> const & b) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(b.nb_row() == m_nb_col, std::invalid_argument("hnc::sparse::csr::multiply, b has " + hnc::to_string(b.nb_row()) + " rows, number of columns = " + hnc::to_string(m_nb_col)));
+				#endif
+				hnc::vector2D<T, storage_t> c(m_nb_row, b.nb_col());
+				#pragma omp parallel for schedule(dynamic, 16)
+				for (long int i = 0; i < long(m_nb_row); ++i)
+				{
+					T * const c_row = c[std::size_t(i)].data();
+					for (std::size_t k = m_row_ptr[std::size_t(i)]; k < m_row_ptr[std::size_t(i) + 1]; ++k)
+					{
+						hnc::vector2D_kernel::axpy(b.nb_col(), m_values[k], b[m_col_index[k]].data(), c_row);
+					}
+				}
+				return c;
+			}
+
+			/// @brief Return the dense matrix
+			/// @return the hnc::vector2D
+			template <class storage_t = hnc::vector2D_storage::packed<T>>
+			hnc::vector2D<T, storage_t> to_vector2D() const
+			{
+				hnc::vector2D<T, storage_t> r(m_nb_row, m_nb_col);
+				for (std::size_t i = 0; i < m_nb_row; ++i)
+				{
+					for (std::size_t k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k) { r(i, m_col_index[k]) = m_values[k]; }
+				}
+				return r;
+			}
+
+			/// @brief Return the triplets
+			/// @return the hnc::sparse::coo (sorted by row then by column)
+			hnc::sparse::coo<T> to_coo() const
+			{
+				hnc::sparse::coo<T> r(m_nb_row, m_nb_col);
+				r.reserve(nb_non_zero());
+				for (std::size_t i = 0; i < m_nb_row; ++i)
+				{
+					for (std::size_t k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k) { r.add(i, m_col_index[k], m_values[k]); }
+				}
+				return r;
+			}
+
+			/// @brief Return the transposed matrix
+			/// @return the transposed matrix
+			csr transposed() const
+			{
+				csr r(m_nb_col, m_nb_row);
+				hnc::sparse::transpose_compressed(m_nb_row, m_nb_col, m_row_ptr, m_col_index, m_values, r.m_row_ptr, r.m_col_index, r.m_values);
+				return r;
+			}
+
+			/// @brief Equality operator
+			/// @param[in] m A hnc::sparse::csr
+			/// @return true if the matrices have the same size and the same stored values, false otherwise
+			bool operator ==(csr const & m) const
+			{
+				return m_nb_row == m.m_nb_row && m_nb_col == m.m_nb_col && m_row_ptr == m.m_row_ptr && m_col_index == m.m_col_index && m_values == m.m_values;
+			}
+
+			/// @brief Inequality operator
+			/// @param[in] m A hnc::sparse::csr
+			/// @return true if the matrices are different, false otherwise
+			bool operator !=(csr const & m) const { return (*this == m) == false; }
+
+			hnc_generate_serialize_member_function(m_nb_row, m_nb_col, m_row_ptr, m_col_index, m_values)
+		};
+	}
+}
+
+#endif
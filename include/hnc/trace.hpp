@@ -0,0 +1,381 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_TRACE_HPP
+#define HNC_TRACE_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace hnc
+{
+	/**
+	 * @brief Low-overhead scoped tracing, exported in Chrome trace format (chrome://tracing, https://ui.perfetto.dev)
+	 *
+	 * @code
+	   #include <hnc/trace.hpp>
+	   @endcode
+	 *
+	 * A span is the lifetime of a hnc::trace::scope (use the macro hnc_trace_scope) @n
+	 * At the end of a span, one event (start timestamp, duration, span name) is written in the ring buffer of the thread:
+	 * no lock, no allocation, the oldest events are overwritten when the buffer is full (see set_buffer_size) @n
+	 * When the tracing is disabled (by default), a span costs one relaxed atomic load @n
+	 * If hnc_no_trace is defined, hnc_trace_scope expands to nothing (no cost at all)
+	 *
+	 * @code
+	   void compute()
+	   {
+	   	hnc_trace_scope("compute");
+	   	// Some computation
+	   }
+
+	   int main()
+	   {
+	   	hnc::trace::enable();
+	   	#pragma omp parallel for
+	   	for (int i = 0; i < 8; ++i) { compute(); }
+	   	hnc::trace::disable();
+	   	hnc::trace::save("trace.json"); // Open it in chrome://tracing or https://ui.perfetto.dev
+	   }
+	   @endcode
+	 *
+	 * @warning The span name must be a string literal (or a string which lives until the export): only the pointer is saved
+	 */
+	namespace trace
+	{
+		/// Event of a span
+		class event_t
+		{
+		public:
+
+			/// Start timestamp in nanoseconds (std::chrono::steady_clock)
+			std::uint64_t start;
+
+			/// Duration in nanoseconds
+			std::uint64_t duration;
+
+			/// Span name (span id)
+			char const * name;
+		};
+
+		/// Ring buffer of the events of one thread (one writer, the thread)
+		class thread_buffer_t
+		{
+		public:
+
+			/// Thread index (order of the first span of each thread)
+			std::size_t thread_index;
+
+			/// Events (the size is a power of two)
+			std::vector<hnc::trace::event_t> events;
+
+			/// Number of events written since the last clear (the event i is in events[i % events.size()])
+			std::atomic<std::uint64_t> nb_event;
+
+			/// @brief Constructor
+			/// @param[in] index Thread index
+			/// @param[in] size  Number of events in the ring buffer (a power of two)
+			thread_buffer_t(std::size_t const index, std::size_t const size) :
+				thread_index(index),
+				events(size),
+				nb_event(0)
+			{ }
+		};
+
+		/// Global state
+		class state_t
+		{
+		public:
+
+			/// Tracing enabled
+			std::atomic<bool> enabled;
+
+			/// Number of events in the ring buffer of the new threads
+			std::atomic<std::size_t> buffer_size;
+
+			/// Mutex for the buffers
+			std::mutex mutex;
+
+			/// Buffers of all threads (kept after the end of the threads)
+			std::vector<std::shared_ptr<hnc::trace::thread_buffer_t>> buffers;
+
+			/// @brief Default constructor
+			state_t() : enabled(false), buffer_size(16384), mutex(), buffers() { }
+		};
+
+		/// @brief Return the global state
+		/// @return the global state
+		inline hnc::trace::state_t & state()
+		{
+			static hnc::trace::state_t s;
+			return s;
+		}
+
+		/// @brief Enable the tracing
+		inline void enable() { hnc::trace::state().enabled.store(true, std::memory_order_relaxed); }
+
+		/// @brief Disable the tracing
+		inline void disable() { hnc::trace::state().enabled.store(false, std::memory_order_relaxed); }
+
+		/// @brief Return true if the tracing is enabled
+		/// @return true if the tracing is enabled, false otherwise
+		inline bool enabled() { return hnc::trace::state().enabled.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Set the number of events in the ring buffer of each thread (rounded up to a power of two, 16384 by default)
+		 *
+		 * Only the threads without span yet use the new size
+		 *
+		 * @param[in] nb_event Number of events (>= 1)
+		 */
+		inline void set_buffer_size(std::size_t const nb_event)
+		{
+			std::size_t size = 1;
+			while (size < nb_event) { size *= 2; }
+			hnc::trace::state().buffer_size = size;
+		}
+
+		/// @brief Return the timestamp in nanoseconds
+		/// @return the timestamp in nanoseconds
+		inline std::uint64_t now()
+		{
+			return std::uint64_t
+			(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+			);
+		}
+
+		/// @brief Return the ring buffer of the current thread (created and registered at the first call of the thread)
+		/// @return the ring buffer of the current thread
+		inline hnc::trace::thread_buffer_t & thread_buffer()
+		{
+			static thread_local std::shared_ptr<hnc::trace::thread_buffer_t> buffer;
+			if (buffer == nullptr)
+			{
+				hnc::trace::state_t & s = hnc::trace::state();
+				std::lock_guard<std::mutex> const lock(s.mutex);
+				buffer = std::make_shared<hnc::trace::thread_buffer_t>(s.buffers.size(), s.buffer_size.load());
+				s.buffers.push_back(buffer);
+			}
+			return *buffer;
+		}
+
+		/// @brief Write an event in the ring buffer of the current thread (lock-free, without allocation after the first event of the thread)
+		/// @param[in] name  Span name
+		/// @param[in] start Start timestamp in nanoseconds
+		/// @param[in] end   End timestamp in nanoseconds
+		inline void record(char const * const name, std::uint64_t const start, std::uint64_t const end)
+		{
+			hnc::trace::thread_buffer_t & buffer = hnc::trace::thread_buffer();
+			std::uint64_t const i = buffer.nb_event.load(std::memory_order_relaxed);
+			hnc::trace::event_t & e = buffer.events[std::size_t(i & (buffer.events.size() - 1))];
+			e.start = start;
+			e.duration = (end > start) ? end - start : 0;
+			e.name = name;
+			buffer.nb_event.store(i + 1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Span: an event is recorded from the construction to the destruction (if the tracing is enabled at the construction)
+		 *
+		 * @code
+		   #include <hnc/trace.hpp>
+		   @endcode
+		 *
+		 * Use the macro hnc_trace_scope(name) to compile it out when hnc_no_trace is defined
+		 */
+		class scope
+		{
+		private:
+
+			/// Span name (nullptr if the tracing is disabled)
+			char const * const m_name;
+
+			/// Start timestamp in nanoseconds
+			std::uint64_t const m_start;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] name Span name (a string literal)
+			explicit scope(char const * const name) :
+				m_name((hnc::trace::enabled()) ? name : nullptr),
+				m_start((m_name != nullptr) ? hnc::trace::now() : 0)
+			{ }
+
+			/// @brief Copy constructor (deleted)
+			scope(hnc::trace::scope const &) = delete;
+
+			/// @brief Copy assignment operator (deleted)
+			/// @return the hnc::trace::scope
+			hnc::trace::scope & operator =(hnc::trace::scope const &) = delete;
+
+			/// @brief Destructor, record the event
+			~scope()
+			{
+				if (m_name != nullptr) { hnc::trace::record(m_name, m_start, hnc::trace::now()); }
+			}
+		};
+
+		/// @brief Return the number of events lost (overwritten in the ring buffers)
+		/// @return the number of events lost
+		inline std::uint64_t nb_lost_event()
+		{
+			hnc::trace::state_t & s = hnc::trace::state();
+			std::lock_guard<std::mutex> const lock(s.mutex);
+			std::uint64_t r = 0;
+			for (auto const & buffer : s.buffers)
+			{
+				std::uint64_t const nb_event = buffer->nb_event.load(std::memory_order_acquire);
+				if (nb_event > buffer->events.size()) { r += nb_event - buffer->events.size(); }
+			}
+			return r;
+		}
+
+		/**
+		 * @brief Return all events in the ring buffers, by thread index
+		 *
+		 * Call it when the traced threads do not record (tracing disabled or threads finished),
+		 * otherwise the events being overwritten can be inconsistent
+		 *
+		 * @return all events in the ring buffers (the oldest first), by thread index
+		 */
+		inline std::vector<std::vector<hnc::trace::event_t>> events()
+		{
+			hnc::trace::state_t & s = hnc::trace::state();
+			std::lock_guard<std::mutex> const lock(s.mutex);
+			std::vector<std::vector<hnc::trace::event_t>> r(s.buffers.size());
+			for (auto const & buffer : s.buffers)
+			{
+				std::uint64_t const nb_event = buffer->nb_event.load(std::memory_order_acquire);
+				std::uint64_t const size = buffer->events.size();
+				std::uint64_t const first = (nb_event > size) ? nb_event - size : 0;
+				auto & thread_events = r[buffer->thread_index];
+				thread_events.reserve(std::size_t(nb_event - first));
+				for (std::uint64_t i = first; i < nb_event; ++i) { thread_events.push_back(buffer->events[std::size_t(i & (size - 1))]); }
+			}
+			return r;
+		}
+
+		/// @brief Remove all events (call it when the traced threads do not record)
+		inline void clear()
+		{
+			hnc::trace::state_t & s = hnc::trace::state();
+			std::lock_guard<std::mutex> const lock(s.mutex);
+			for (auto const & buffer : s.buffers) { buffer->nb_event.store(0, std::memory_order_release); }
+		}
+
+		/// @brief Return a JSON string (with quotes)
+		/// @param[in] s A string
+		/// @return the JSON string
+		inline std::string json_string(char const * s)
+		{
+			std::string r = "\"";
+			for (; *s != '\0'; ++s)
+			{
+				if (*s == '"' || *s == '\\') { r += '\\'; r += *s; }
+				else if ((unsigned char)(*s) < 0x20) { r += ' '; }
+				else { r += *s; }
+			}
+			return r + "\"";
+		}
+
+		/**
+		 * @brief Return the events in Chrome trace format (JSON)
+		 *
+		 * Each span is a complete event ("ph": "X") with the timestamp and the duration in microseconds,
+		 * the tid is the thread index (named "thread i") @n
+		 * Call it when the traced threads do not record (see hnc::trace::events)
+		 *
+		 * https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+		 *
+		 * @return the events in Chrome trace format
+		 */
+		inline std::string to_chrome_json()
+		{
+			std::vector<std::vector<hnc::trace::event_t>> const all_events = hnc::trace::events();
+
+			// Timestamps from the first event
+			std::uint64_t origin = std::numeric_limits<std::uint64_t>::max();
+			for (auto const & thread_events : all_events)
+			{
+				for (auto const & e : thread_events) { origin = std::min(origin, e.start); }
+			}
+
+			std::ostringstream o;
+			o << std::fixed << std::setprecision(3);
+			o << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+			bool first = true;
+			for (std::size_t tid = 0; tid < all_events.size(); ++tid)
+			{
+				o << ((first) ? "\n" : ",\n");
+				first = false;
+				o << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << tid << ", \"args\": {\"name\": \"thread " << tid << "\"}}";
+				for (auto const & e : all_events[tid])
+				{
+					o << ",\n";
+					o << "{\"name\": " << hnc::trace::json_string(e.name) << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << tid
+					  << ", \"ts\": " << (long double)(e.start - origin) / 1000 << ", \"dur\": " << (long double)(e.duration) / 1000 << "}";
+				}
+			}
+			o << "\n]}\n";
+			return o.str();
+		}
+
+		/// @brief Save the events in Chrome trace format (see hnc::trace::to_chrome_json)
+		/// @param[in] filename Filename (open it in chrome://tracing or https://ui.perfetto.dev)
+		/// @exception std::runtime_error if the file can not be written
+		inline void save(std::string const & filename)
+		{
+			std::ofstream f(filename);
+			f << hnc::trace::to_chrome_json();
+			if (f.good() == false) { throw std::runtime_error("hnc::trace::save, can not write \"" + filename + "\""); }
+		}
+	}
+}
+
+/// @brief Concatenation for hnc_trace_scope
+#define hnc_trace_concatenate_impl(a, b) a##b
+/// @brief Concatenation for hnc_trace_scope
+#define hnc_trace_concatenate(a, b) hnc_trace_concatenate_impl(a, b)
+
+/**
+ * @brief Trace the current scope as a span named name (see hnc::trace)
+ *
+ * @code
+   #include <hnc/trace.hpp>
+   @endcode
+ *
+ * Expands to nothing if hnc_no_trace is defined
+ */
+#ifndef hnc_no_trace
+	#define hnc_trace_scope(name) hnc::trace::scope const hnc_trace_concatenate(hnc_trace_scope_, __LINE__)(name)
+#else
+	#define hnc_trace_scope(name) static_cast<void>(0)
+#endif
+
+#endif
@@ -16,13 +16,22 @@
 #ifndef HNC_VECTOR2D_HPP
 #define HNC_VECTOR2D_HPP
 
+#include <algorithm>
 #include <vector>
+#include <iterator>
+#include <functional>
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
 
 #include "index2D.hpp"
+#include "vector2D_view.hpp"
+#include "vector2D_storage.hpp"
+#include "vector2D_expression.hpp"
 #include "assert.hpp"
 #include "to_string.hpp"
-#include "iterator.hpp"
 #include "serialization.hpp"
+#include "sfinae.hpp"
 
 
 namespace hnc
@@ -34,52 +43,250 @@ namespace hnc
 	   #include <hnc/vector2D.hpp>
 	   @endcode
 	 *
+	 * The storage policy gives the allocator and the distance between two rows (see hnc::vector2D_storage): @n
+	 * with hnc::vector2D_storage::aligned_padded, the data is aligned on 64 bytes and each row starts on an aligned address
+	 *
+	 * The element-wise operations (+, -, scalar *, /, hnc::element_wise_product) are expression templates (see hnc::vector2D_expression):
+	 * the chained operations are computed in one loop without temporary matrix @n
+	 * fill, axpy, sum, min, max and dot are vectorized (on the whole matrix and on the rows)
+	 *
+	 * @code
+	   hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>> a(1000, 1000, 1.f), b(1000, 1000, 2.f);
+	   hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>> c = 2.f * a + b / 4.f;
+	   c.axpy(0.5f, a);
+	   std::cout << c.sum() << " " << c.max() << " " << c[0].dot(a[0]) << std::endl;
+	   @endcode
+	 *
+	 * operator[], front, back and the iterators on the rows return the rows by value: a row is a view (a pointer on its first value
+	 * and its number of columns), so copying it is cheap and writing in it writes in the hnc::vector2D @n
+	 * Use "auto row = v[i];" (or "auto const row") to keep a row, "auto & row = v[i];" does not compile
+	 *
+	 * @code
+	   hnc::vector2D<int> v(3, 4, 0);
+	   auto row = v[1];
+	   row[2] = 42; // v(1, 2) == 42
+	   @endcode
+	 *
+	 * @warning T can not be bool: the rows point into the data and std::vector<bool> has no data(), use char instead
+	 *
 	 * @note For other use, have a look to:
 	 * - hnc::vector2D_minimal
 	 * - hnc::vector2D_C_style_minimal
+	 *
+	 * @tparam T         Type of the values
+	 * @tparam storage_t Storage policy (hnc::vector2D_storage::packed<T> by default)
 	 */
-	template <class T>
-	class vector2D
+	template <class T, class storage_t = hnc::vector2D_storage::packed<T>>
+	class vector2D : public hnc::vector2D_expression<vector2D<T, storage_t>>
 	{
+		static_assert(std::is_same<T, bool>::value == false, "hnc::vector2D<bool> is not supported: the rows are views on the data and std::vector<bool> has no data(), use hnc::vector2D<char>");
+
 	public:
 
+		/**
+		 * @brief Random access iterator on the values of a line of hnc::vector2D
+		 *
+		 * @code
+		   #include <hnc/vector2D.hpp>
+		   @endcode
+		 *
+		 * The iterator keeps a pointer to the values (not to the line), so it stays valid after the line is destroyed @n
+		 * The iterators are random access iterators, the end of a reverse iterator is before the first value
+		 *
+		 * @tparam U          T or T const
+		 * @tparam is_reverse true for a reverse iterator
+		 */
+		template <class U, bool is_reverse>
+		class value_iterator_t : public std::iterator<std::random_access_iterator_tag, typename std::remove_const<U>::type, std::ptrdiff_t, U *, U &>
+		{
+		private:
+
+			/// First value of the line
+			U * p_data;
+
+			/// Number of values
+			std::size_t m_size;
+
+			/// Index
+			std::size_t m_i;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] p    First value of the line
+			/// @param[in] size Number of values
+			/// @param[in] i    Index (an index >= size is the end, before the first value for a reverse iterator)
+			value_iterator_t(U * const p = nullptr, std::size_t const size = 0, std::size_t const i = 0) :
+				p_data(p), m_size(size), m_i((i < size) ? i : ((is_reverse) ? std::size_t(-1) : size))
+			{ }
+
+			/// @brief Go to the next value
+			/// @return the iterator
+			value_iterator_t & operator ++()
+			{
+				if (is_reverse) { --m_i; }
+				else { ++m_i; }
+				return *this;
+			}
+
+			/// @brief Go to the next value
+			/// @return the iterator before the increment
+			value_iterator_t operator ++(int)
+			{
+				value_iterator_t copy = *this;
+				++(*this);
+				return copy;
+			}
+
+			/// @brief Go to the previous value
+			/// @return the iterator
+			value_iterator_t & operator --()
+			{
+				if (is_reverse) { ++m_i; }
+				else { --m_i; }
+				return *this;
+			}
+
+			/// @brief Go to the previous value
+			/// @return the iterator before the decrement
+			value_iterator_t operator --(int)
+			{
+				value_iterator_t copy = *this;
+				--(*this);
+				return copy;
+			}
+
+			/// @brief Advance the iterator
+			/// @param[in] n Number of values
+			/// @return the iterator
+			value_iterator_t & operator +=(std::ptrdiff_t const n)
+			{
+				m_i = std::size_t(std::ptrdiff_t(m_i) + ((is_reverse) ? -n : n));
+				return *this;
+			}
+
+			/// @brief Move back the iterator
+			/// @param[in] n Number of values
+			/// @return the iterator
+			value_iterator_t & operator -=(std::ptrdiff_t const n)
+			{
+				return (*this) += -n;
+			}
+
+			/// @brief Return an advanced iterator
+			/// @param[in] n Number of values
+			/// @return the advanced iterator
+			value_iterator_t operator +(std::ptrdiff_t const n) const
+			{
+				value_iterator_t r = *this;
+				return r += n;
+			}
+
+			/// @brief Return a moved back iterator
+			/// @param[in] n Number of values
+			/// @return the moved back iterator
+			value_iterator_t operator -(std::ptrdiff_t const n) const
+			{
+				value_iterator_t r = *this;
+				return r -= n;
+			}
+
+			/// @brief Return the distance between two iterators
+			/// @param[in] it An iterator
+			/// @return the distance between the iterators
+			std::ptrdiff_t operator -(value_iterator_t const & it) const
+			{
+				std::ptrdiff_t const d = std::ptrdiff_t(m_i) - std::ptrdiff_t(it.m_i);
+				return (is_reverse) ? -d : d;
+			}
+
+			/// @brief Equality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are on the same value, false otherwise
+			bool operator ==(value_iterator_t const & it) const { return p_data == it.p_data && m_i == it.m_i; }
+
+			/// @brief Inequality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are not on the same value, false otherwise
+			bool operator !=(value_iterator_t const & it) const { return ! (*this == it); }
+
+			/// @brief Less than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is before it, false otherwise
+			bool operator <(value_iterator_t const & it) const { return (*this - it) < 0; }
+
+			/// @brief Greater than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is after it, false otherwise
+			bool operator >(value_iterator_t const & it) const { return it < *this; }
+
+			/// @brief Less than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not after it, false otherwise
+			bool operator <=(value_iterator_t const & it) const { return ! (it < *this); }
+
+			/// @brief Greater than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not before it, false otherwise
+			bool operator >=(value_iterator_t const & it) const { return ! (*this < it); }
+
+			/// @brief Return the current value
+			/// @return the current value
+			U & operator *() const { return p_data[m_i]; }
+
+			/// @brief Return a pointer to the current value
+			/// @return a pointer to the current value
+			U * operator ->() const { return p_data + m_i; }
+
+			/// @brief Return the value at n values of the iterator
+			/// @param[in] n Number of values
+			/// @return the value
+			U & operator [](std::ptrdiff_t const n) const { return *((*this) + n); }
+
+			/// @brief Conversion to a const iterator
+			/// @return the const iterator
+			operator value_iterator_t<U const, is_reverse>() const { return value_iterator_t<U const, is_reverse>(p_data, m_size, m_i); }
+		};
+
 		/**
 		 * @brief Proxy class for a line of const hnc::vector2D
 		 * 
 		 * @code
 		   #include <hnc/vector2D.hpp>
 		   @endcode
+		 *
+		 * A line is a view (pointer to the first value of the row, number of columns), created on demand
 		 */
 		template <class U>
 		class line_const_ptr
 		{
 		private:
 
-			/// Associated vector2D
-			hnc::vector2D<U> const * p_data;
+			/// First value of the row
+			U const * p_data;
 
-			/// Row index
-			std::size_t m_i;
+			/// Number of columns
+			std::size_t m_nb_col;
 
 		public:
 
 			/// Const iterator
-			using const_iterator = hnc::const_iterator<U, line_const_ptr<U>>;
+			using const_iterator = value_iterator_t<U const, false>;
 
 			/// Const reverse iterator
-			using const_reverse_iterator = hnc::const_reverse_iterator<U, line_const_ptr<U>>;
+			using const_reverse_iterator = value_iterator_t<U const, true>;
 
 			/// @brief Constructor
-			/// @param[in] p A hnc::vector2D
-			/// @param[in] i Row index
-			line_const_ptr(hnc::vector2D<U> const * p = nullptr, std::size_t const i = 0) : p_data(p), m_i(i)
+			/// @param[in] p      First value of the row
+			/// @param[in] nb_col Number of columns
+			line_const_ptr(U const * const p = nullptr, std::size_t const nb_col = 0) : p_data(p), m_nb_col(nb_col)
 			{ }
 
 			/// @brief Return the number of columns
 			/// @return the number of columns
 			std::size_t size() const
 			{
-				return p_data->nb_col();
+				return m_nb_col;
 			}
 
 			/// @brief Const access by [i][j]
@@ -87,7 +294,7 @@ namespace hnc
 			/// @return the value at [i][j]
 			U const & operator[](std::size_t const j) const
 			{
-				return (*p_data)(m_i, j);
+				return p_data[j];
 			}
 			
 			/// @brief Const access to the first value of the line
@@ -95,7 +302,7 @@ namespace hnc
 			/// @return a proxy to have the first value of the line
 			U const & front() const
 			{
-				return (*p_data)(m_i, 0);
+				return p_data[0];
 			}
 
 			/// @brief Const access to the last value of the line
@@ -103,35 +310,66 @@ namespace hnc
 			/// @return a proxy to have the last value of the line
 			U const & back() const
 			{
-				return (*p_data)(m_i, p_data->nb_col() - 1);
+				return p_data[m_nb_col - 1];
+			}
+
+			/// @brief Return a const pointer to the first value of the line (the values of a line are contiguous)
+			/// @return a const pointer to the first value of the line
+			U const * data() const { return p_data; }
+
+			/// @brief Return the sum of the values of the line (vectorized)
+			/// @return the sum of the values of the line
+			U sum() const { return hnc::vector2D_kernel::sum(p_data, m_nb_col); }
+
+			/// @brief Return the minimum of the values of the line (vectorized)
+			/// @pre Line has at least one value
+			/// @return the minimum of the values of the line
+			U min() const { return hnc::vector2D_kernel::min(p_data, m_nb_col); }
+
+			/// @brief Return the maximum of the values of the line (vectorized)
+			/// @pre Line has at least one value
+			/// @return the maximum of the values of the line
+			U max() const { return hnc::vector2D_kernel::max(p_data, m_nb_col); }
+
+			/// @brief Return the dot product with a line (vectorized)
+			/// @param[in] line A line with the same size (a line of a hnc::vector2D, a std::vector, ...)
+			/// @exception std::invalid_argument hnc::hassert the lines have the same size if NDEBUG is not defined
+			/// @return the sum of the products of the values
+			template <class line_t>
+			U dot(line_t const & line) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(line.size() == m_nb_col, std::invalid_argument("hnc::vector2D::line_const_ptr::dot, size = " + hnc::to_string(line.size()) + " instead of " + hnc::to_string(m_nb_col)));
+				#endif
+				return hnc::vector2D_kernel::dot(p_data, line.data(), m_nb_col);
 			}
 			
 			/// @brief Return a const iterator to the beginning
 			/// @return a const iterator to the beginning
 			const_iterator begin() const
 			{
-				return const_iterator(*this, 0);
+				return const_iterator(p_data, m_nb_col, 0);
 			}
 
 			/// @brief Return a const iterator to the end
 			/// @return a const iterator to the end
 			const_iterator end() const
 			{
-				return const_iterator(*this, size());
+				return const_iterator(p_data, m_nb_col, m_nb_col);
 			}
 
 			/// @brief Return a const iterator to the beginning
 			/// @return a const iterator to the beginning
 			const_reverse_iterator rbegin() const
 			{
-				return const_reverse_iterator(*this, size() - 1);
+				return const_reverse_iterator(p_data, m_nb_col, m_nb_col - 1);
 			}
 
 			/// @brief Return a const iterator to the end
 			/// @return a const iterator to the end
 			const_reverse_iterator rend() const
 			{
-				return const_reverse_iterator(*this, 0);
+				return const_reverse_iterator(p_data, m_nb_col, m_nb_col);
 			}
 		};
 
@@ -141,43 +379,45 @@ namespace hnc
 		 * @code
 		   #include <hnc/vector2D.hpp>
 		   @endcode
+		 *
+		 * A line is a view (pointer to the first value of the row, number of columns), created on demand
 		 */
 		template <class U>
 		class line_ptr
 		{
 		private:
 
-			/// Associated vector2D
-			hnc::vector2D<U> * p_data;
+			/// First value of the row
+			U * p_data;
 
-			/// Row index
-			std::size_t m_i;
+			/// Number of columns
+			std::size_t m_nb_col;
 
 		public:
 
 			/// Iterator
-			using iterator = hnc::iterator<U, line_ptr<U>>;
+			using iterator = value_iterator_t<U, false>;
 
 			/// Const iterator
-			using const_iterator = hnc::const_iterator<U, line_ptr<U>>;
+			using const_iterator = value_iterator_t<U const, false>;
 
 			/// Reverse iterator
-			using reverse_iterator = hnc::reverse_iterator<U, line_ptr<U>>;
+			using reverse_iterator = value_iterator_t<U, true>;
 
 			/// Const reverse iterator
-			using const_reverse_iterator = hnc::const_reverse_iterator<U, line_ptr<U>>;
+			using const_reverse_iterator = value_iterator_t<U const, true>;
 
 			/// @brief Constructor
-			/// @param[in,out] p A hnc::vector2D
-			/// @param[in]     i Row index
-			line_ptr(hnc::vector2D<U> * p = nullptr, std::size_t const i = 0) : p_data(p), m_i(i)
+			/// @param[in,out] p      First value of the row
+			/// @param[in]     nb_col Number of columns
+			line_ptr(U * const p = nullptr, std::size_t const nb_col = 0) : p_data(p), m_nb_col(nb_col)
 			{ }
 
 			/// @brief Return the number of columns
 			/// @return the number of columns
 			std::size_t size() const
 			{
-				return p_data->nb_col();
+				return m_nb_col;
 			}
 
 			/// @brief Const access by [i][j]
@@ -185,7 +425,7 @@ namespace hnc
 			/// @return the value at [i][j]
 			U const & operator[](std::size_t const j) const
 			{
-				return (*p_data)(m_i, j);
+				return p_data[j];
 			}
 
 			/// @brief Acces by [i][j]
@@ -193,7 +433,7 @@ namespace hnc
 			/// @return the value at [i][j]
 			U & operator[](std::size_t const j)
 			{
-				return (*p_data)(m_i, j);
+				return p_data[j];
 			}
 
 			/// @brief Const access to the first value of the line
@@ -201,7 +441,7 @@ namespace hnc
 			/// @return a proxy to have the first value of the line
 			U const & front() const
 			{
-				return (*p_data)(m_i, 0);
+				return p_data[0];
 			}
 			
 			/// @brief Access to the first value of the line
@@ -209,7 +449,7 @@ namespace hnc
 			/// @return a proxy to have the first value of the line
 			U & front()
 			{
-				return (*p_data)(m_i, 0);
+				return p_data[0];
 			}
 
 			/// @brief Const access to the last value of the line
@@ -217,7 +457,7 @@ namespace hnc
 			/// @return a proxy to have the last value of the line
 			U const & back() const
 			{
-				return (*p_data)(m_i, p_data->nb_col() - 1);
+				return p_data[m_nb_col - 1];
 			}
 			
 			/// @brief Const access to the last value of the line
@@ -225,82 +465,325 @@ namespace hnc
 			/// @return a proxy to have the last value of the line
 			U & back()
 			{
-				return (*p_data)(m_i, p_data->nb_col() - 1);
+				return p_data[m_nb_col - 1];
+			}
+
+			/// @brief Return a const pointer to the first value of the line (the values of a line are contiguous)
+			/// @return a const pointer to the first value of the line
+			U const * data() const { return p_data; }
+
+			/// @brief Return a pointer to the first value of the line (the values of a line are contiguous)
+			/// @return a pointer to the first value of the line
+			U * data() { return p_data; }
+
+			/// @brief Assign a value to all values of the line (vectorized)
+			/// @param[in] value A value
+			void fill(U const & value) { hnc::vector2D_kernel::fill(p_data, m_nb_col, value); }
+
+			/// @brief line = alpha * x + line (vectorized)
+			/// @param[in] alpha Scalar
+			/// @param[in] x     A line with the same size (a line of a hnc::vector2D, a std::vector, ...)
+			/// @exception std::invalid_argument hnc::hassert the lines have the same size if NDEBUG is not defined
+			template <class line_t>
+			void axpy(U const alpha, line_t const & x)
+			{
+				#ifndef NDEBUG
+					hnc::hassert(x.size() == m_nb_col, std::invalid_argument("hnc::vector2D::line_ptr::axpy, size = " + hnc::to_string(x.size()) + " instead of " + hnc::to_string(m_nb_col)));
+				#endif
+				hnc::vector2D_kernel::axpy(m_nb_col, alpha, x.data(), p_data);
+			}
+
+			/// @brief Return the sum of the values of the line (vectorized)
+			/// @return the sum of the values of the line
+			U sum() const { return hnc::vector2D_kernel::sum(p_data, m_nb_col); }
+
+			/// @brief Return the minimum of the values of the line (vectorized)
+			/// @pre Line has at least one value
+			/// @return the minimum of the values of the line
+			U min() const { return hnc::vector2D_kernel::min(p_data, m_nb_col); }
+
+			/// @brief Return the maximum of the values of the line (vectorized)
+			/// @pre Line has at least one value
+			/// @return the maximum of the values of the line
+			U max() const { return hnc::vector2D_kernel::max(p_data, m_nb_col); }
+
+			/// @brief Return the dot product with a line (vectorized)
+			/// @param[in] line A line with the same size (a line of a hnc::vector2D, a std::vector, ...)
+			/// @exception std::invalid_argument hnc::hassert the lines have the same size if NDEBUG is not defined
+			/// @return the sum of the products of the values
+			template <class line_t>
+			U dot(line_t const & line) const
+			{
+				#ifndef NDEBUG
+					hnc::hassert(line.size() == m_nb_col, std::invalid_argument("hnc::vector2D::line_ptr::dot, size = " + hnc::to_string(line.size()) + " instead of " + hnc::to_string(m_nb_col)));
+				#endif
+				return hnc::vector2D_kernel::dot(const_cast<U const *>(p_data), line.data(), m_nb_col);
 			}
 
 			/// @brief Return a iterator to the beginning
 			/// @return a iterator to the beginning
 			iterator begin()
 			{
-				return iterator(*this, 0);
+				return iterator(p_data, m_nb_col, 0);
 			}
 
 			/// @brief Return a iterator to the end
 			/// @return a iterator the to end
 			iterator end()
 			{
-				return iterator(*this, size());
+				return iterator(p_data, m_nb_col, m_nb_col);
 			}
 
 			/// @brief Return a const iterator to the beginning
 			/// @return a const iterator to the beginning
 			const_iterator begin() const
 			{
-				return const_iterator(*this, 0);
+				return const_iterator(p_data, m_nb_col, 0);
 			}
 
 			/// @brief Return a const iterator to the end
 			/// @return a const iterator to the end
 			const_iterator end() const
 			{
-				return const_iterator(*this, size());
+				return const_iterator(p_data, m_nb_col, m_nb_col);
 			}
 
 			/// @brief Return a reverse iterator to the beginning
 			/// @return a reverse iterator to the beginning
 			reverse_iterator rbegin()
 			{
-				return reverse_iterator(*this, size() - 1);
+				return reverse_iterator(p_data, m_nb_col, m_nb_col - 1);
 			}
 
 			/// @brief Return a reverse iterator to the end
 			/// @return a reverse iterator the to end
 			reverse_iterator rend()
 			{
-				return reverse_iterator(*this, 0);
+				return reverse_iterator(p_data, m_nb_col, m_nb_col);
 			}
 
 			/// @brief Return a const reverse iterator to the beginning
 			/// @return a const reverse iterator to the beginning
 			const_reverse_iterator rbegin() const
 			{
-				return const_reverse_iterator(*this, size() - 1);
+				return const_reverse_iterator(p_data, m_nb_col, m_nb_col - 1);
 			}
 
 			/// @brief Return a const reverse iterator to the end
 			/// @return a const reverse iterator to the end
 			const_reverse_iterator rend() const
 			{
-				return const_reverse_iterator(*this, 0);
+				return const_reverse_iterator(p_data, m_nb_col, m_nb_col);
+			}
+
+			/// @brief Conversion to a line of const hnc::vector2D
+			/// @return the line of const hnc::vector2D
+			operator line_const_ptr<U>() const
+			{
+				return line_const_ptr<U>(p_data, m_nb_col);
+			}
+		};
+
+		/**
+		 * @brief Random access iterator on the lines of a hnc::vector2D
+		 *
+		 * @code
+		   #include <hnc/vector2D.hpp>
+		   @endcode
+		 *
+		 * The lines are created on demand, so the iterator keeps the current line
+		 * and the dereference returns a reference to it (valid until the iterator moves) @n
+		 * The end of a reverse iterator is before the first line
+		 *
+		 * @tparam line_t     hnc::vector2D::line_ptr or hnc::vector2D::line_const_ptr
+		 * @tparam pointer_t  T * or T const *
+		 * @tparam is_reverse true for a reverse iterator
+		 */
+		template <class line_t, class pointer_t, bool is_reverse>
+		class line_iterator_t : public std::iterator<std::random_access_iterator_tag, line_t>
+		{
+		private:
+
+			/// Data
+			pointer_t p_data;
+
+			/// Number of rows
+			std::size_t m_nb_row;
+
+			/// Number of columns
+			std::size_t m_nb_col;
+
+			/// Distance between two rows
+			std::size_t m_row_stride;
+
+			/// Row index
+			std::size_t m_i;
+
+			/// Current line
+			mutable line_t m_line;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] p          Data
+			/// @param[in] nb_row     Number of rows
+			/// @param[in] nb_col     Number of columns
+			/// @param[in] row_stride Distance between two rows
+			/// @param[in] i          Row index (an index >= nb_row is the end, before the first row for a reverse iterator)
+			line_iterator_t(pointer_t const p = nullptr, std::size_t const nb_row = 0, std::size_t const nb_col = 0, std::size_t const row_stride = 0, std::size_t const i = 0) :
+				p_data(p), m_nb_row(nb_row), m_nb_col(nb_col), m_row_stride(row_stride), m_i((i < nb_row) ? i : ((is_reverse) ? std::size_t(-1) : nb_row))
+			{ }
+
+			/// @brief Go to the next line
+			/// @return the iterator
+			line_iterator_t & operator ++()
+			{
+				if (is_reverse) { --m_i; }
+				else { ++m_i; }
+				return *this;
+			}
+
+			/// @brief Go to the next line
+			/// @return the iterator before the increment
+			line_iterator_t operator ++(int)
+			{
+				line_iterator_t copy = *this;
+				++(*this);
+				return copy;
+			}
+
+			/// @brief Go to the previous line
+			/// @return the iterator
+			line_iterator_t & operator --()
+			{
+				if (is_reverse) { ++m_i; }
+				else { --m_i; }
+				return *this;
+			}
+
+			/// @brief Go to the previous line
+			/// @return the iterator before the decrement
+			line_iterator_t operator --(int)
+			{
+				line_iterator_t copy = *this;
+				--(*this);
+				return copy;
+			}
+
+			/// @brief Advance the iterator
+			/// @param[in] n Number of lines
+			/// @return the iterator
+			line_iterator_t & operator +=(std::ptrdiff_t const n)
+			{
+				m_i = std::size_t(std::ptrdiff_t(m_i) + ((is_reverse) ? -n : n));
+				return *this;
+			}
+
+			/// @brief Move back the iterator
+			/// @param[in] n Number of lines
+			/// @return the iterator
+			line_iterator_t & operator -=(std::ptrdiff_t const n)
+			{
+				return (*this) += -n;
+			}
+
+			/// @brief Return an advanced iterator
+			/// @param[in] n Number of lines
+			/// @return the advanced iterator
+			line_iterator_t operator +(std::ptrdiff_t const n) const
+			{
+				line_iterator_t r = *this;
+				return r += n;
+			}
+
+			/// @brief Return a moved back iterator
+			/// @param[in] n Number of lines
+			/// @return the moved back iterator
+			line_iterator_t operator -(std::ptrdiff_t const n) const
+			{
+				line_iterator_t r = *this;
+				return r -= n;
+			}
+
+			/// @brief Return the distance between two iterators
+			/// @param[in] it An iterator
+			/// @return the distance between the iterators
+			std::ptrdiff_t operator -(line_iterator_t const & it) const
+			{
+				std::ptrdiff_t const d = std::ptrdiff_t(m_i) - std::ptrdiff_t(it.m_i);
+				return (is_reverse) ? -d : d;
+			}
+
+			/// @brief Equality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are on the same line, false otherwise
+			bool operator ==(line_iterator_t const & it) const { return p_data == it.p_data && m_i == it.m_i; }
+
+			/// @brief Inequality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are not on the same line, false otherwise
+			bool operator !=(line_iterator_t const & it) const { return ! (*this == it); }
+
+			/// @brief Less than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is before it, false otherwise
+			bool operator <(line_iterator_t const & it) const { return (*this - it) < 0; }
+
+			/// @brief Greater than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is after it, false otherwise
+			bool operator >(line_iterator_t const & it) const { return it < *this; }
+
+			/// @brief Less than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not after it, false otherwise
+			bool operator <=(line_iterator_t const & it) const { return ! (it < *this); }
+
+			/// @brief Greater than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not before it, false otherwise
+			bool operator >=(line_iterator_t const & it) const { return ! (*this < it); }
+
+			/// @brief Return the current line
+			/// @return the current line (valid until the iterator moves)
+			line_t & operator *() const
+			{
+				m_line = line_t(p_data + m_i * m_row_stride, m_nb_col);
+				return m_line;
+			}
+
+			/// @brief Return a pointer to the current line
+			/// @return a pointer to the current line (valid until the iterator moves)
+			line_t * operator ->() const
+			{
+				return &(**this);
+			}
+
+			/// @brief Return the line at n lines of the iterator
+			/// @param[in] n Number of lines
+			/// @return the line
+			line_t operator [](std::ptrdiff_t const n) const
+			{
+				return *((*this) + n);
 			}
 		};
 
 		/// Iterator
-		using iterator = hnc::iterator<line_ptr<T>, std::vector<line_ptr<T>>>;
+		using iterator = line_iterator_t<line_ptr<T>, T *, false>;
 
 		/// Const iterator
-		using const_iterator = hnc::const_iterator<line_const_ptr<T>, std::vector<line_const_ptr<T>>>;
+		using const_iterator = line_iterator_t<line_const_ptr<T>, T const *, false>;
 
 		/// Reverse iterator
-		using reverse_iterator = hnc::reverse_iterator<line_ptr<T>, std::vector<line_ptr<T>>>;
+		using reverse_iterator = line_iterator_t<line_ptr<T>, T *, true>;
 
 		/// Const reverse iterator
-		using const_reverse_iterator = hnc::const_reverse_iterator<line_const_ptr<T>, std::vector<line_const_ptr<T>>>;
+		using const_reverse_iterator = line_iterator_t<line_const_ptr<T>, T const *, true>;
 
 	private:
 
-		/// Data
-		std::vector<T> m_data;
+		/// Data (nb_row() * row_stride() values)
+		std::vector<T, typename storage_t::allocator_type> m_data;
 
 		/// Number of rows
 		std::size_t m_nb_row;
@@ -308,12 +791,6 @@ namespace hnc
 		/// Number of columns
 		std::size_t m_nb_col;
 
-		/// Const lignes
-		std::vector<line_const_ptr<T>> m_lines_const_ptr;
-
-		/// Lignes
-		std::vector<line_ptr<T>> m_lines_ptr;
-
 	public:
 
 		/// @brief Constructor
@@ -321,31 +798,27 @@ namespace hnc
 		/// @param[in] nb_col        Number of columns
 		/// @param[in] default_value Default value (T() by default)
 		vector2D(std::size_t const nb_row = 0, std::size_t const nb_col = 0, T const & default_value = T()) :
-			m_data(nb_row * nb_col, default_value),
+			m_data(nb_row * storage_t::row_stride(nb_col), default_value),
 			m_nb_row(nb_row),
 			m_nb_col(nb_col)
-		{
-			update_lines_ptr();
-		}
+		{ }
 
 		/// @brief Constructor by copy
 		/// @param[in] v2D A vector2D
-		vector2D(vector2D<T> const & v2D) :
+		vector2D(vector2D const & v2D) :
 			m_data(v2D.m_data),
 			m_nb_row(v2D.nb_row()),
 			m_nb_col(v2D.nb_col())
-		{
-			update_lines_ptr();
-		}
+		{ }
 
-		/// @brief Constructor by RValues reference
-		/// @param[in] v2D A vector2D (will be destroyed)
-		vector2D(vector2D<T> && v2D) :
-			m_data(v2D.m_data), m_nb_row(v2D.m_nb_row), m_nb_col(v2D.m_nb_col)
+		/// @brief Constructor by RValues reference (O(1), without allocation)
+		/// @param[in] v2D A vector2D (will be empty)
+		vector2D(vector2D && v2D) noexcept :
+			m_data(std::move(v2D.m_data)), m_nb_row(v2D.m_nb_row), m_nb_col(v2D.m_nb_col)
 		{
+			v2D.m_data.clear();
 			v2D.m_nb_col = 0;
 			v2D.m_nb_row = 0;
-			update_lines_ptr();
 		}
 
 		/**
@@ -394,6 +867,40 @@ namespace hnc
 			}
 		}
 
+		/// @brief Constructor with a copy of the values of a view (a block, a transposed matrix, ...)
+		/// @param[in] v A hnc::vector2D_view
+		template <class U>
+		explicit vector2D(hnc::vector2D_view<U> const & v) :
+			m_data(),
+			m_nb_row(v.nb_row()),
+			m_nb_col(v.nb_col())
+		{
+			if (v.is_contiguous() && row_stride() == m_nb_col) { m_data.assign(v.data(), v.data() + v.size()); }
+			else
+			{
+				m_data.resize(m_nb_row * row_stride());
+				view().assign(v);
+			}
+		}
+
+		/**
+		 * @brief Constructor with an element-wise expression (computed in one loop, without temporary matrix)
+		 *
+		 * @code
+		   hnc::vector2D<double> const c = a + 2. * b;
+		   @endcode
+		 *
+		 * @param[in] e An expression (see hnc::vector2D_expression)
+		 */
+		template <class E>
+		vector2D(hnc::vector2D_expression<E> const & e) :
+			m_data(e.derived().nb_row() * storage_t::row_stride(e.derived().nb_col())),
+			m_nb_row(e.derived().nb_row()),
+			m_nb_col(e.derived().nb_col())
+		{
+			assign_expression(e.derived());
+		}
+
 		/// @brief Return the number of rows
 		/// @return the number of rows
 		std::size_t nb_row() const { return m_nb_row; }
@@ -407,9 +914,38 @@ namespace hnc
 		/// @return the number of columns
 		std::size_t nb_col() const { return m_nb_col; }
 
-		/// @brief Move assignment operator between two vector2D
-		/// @param[in] v2D A vector2D
-		vector2D<T> operator =(vector2D<T> && v2D)
+		/// @brief Return the distance between two rows (nb_col() rounded up by the storage policy, see hnc::vector2D_storage)
+		/// @return the distance between two rows
+		std::size_t row_stride() const { return storage_t::row_stride(m_nb_col); }
+
+		/// @brief Return a const pointer to the data (row-major, the row i starts at data() + i * row_stride())
+		/// @return a const pointer to the data
+		T const * data() const { return m_data.data(); }
+
+		/// @brief Return a pointer to the data (row-major, the row i starts at data() + i * row_stride())
+		/// @return a pointer to the data
+		T * data() { return m_data.data(); }
+
+		// Expression (see hnc::vector2D_expression)
+
+		/// Type of the values
+		using value_type = T;
+
+		/// Type used to keep the vector2D in an expression (a reference)
+		using expression_stored_t = vector2D const &;
+
+		/// Row of the vector2D in an expression
+		using expression_row_t = T const *;
+
+		/// @brief Return a row for an expression
+		/// @param[in] i Row index
+		/// @return a pointer to the first value of the row i
+		expression_row_t expression_row(std::size_t const i) const { return m_data.data() + i * row_stride(); }
+
+		/// @brief Move assignment operator between two vector2D (O(1), without allocation)
+		/// @param[in] v2D A vector2D (will be empty)
+		/// @return the vector2D
+		vector2D & operator =(vector2D && v2D) noexcept
 		{
 			// If it is a different vector2D
 			if (this != &v2D)
@@ -418,8 +954,8 @@ namespace hnc
 				m_data = std::move(v2D.m_data);
 				m_nb_row = v2D.m_nb_row;
 				m_nb_col = v2D.m_nb_col;
-				update_lines_ptr();
 				// Remove original object
+				v2D.m_data.clear();
 				v2D.m_nb_col = 0;
 				v2D.m_nb_row = 0;
 			}
@@ -429,7 +965,8 @@ namespace hnc
 
 		/// @brief Affectation operator between two vector2D
 		/// @param[in] v2D A vector2D
-		vector2D<T> operator =(vector2D<T> const & v2D)
+		/// @return the vector2D
+		vector2D & operator =(vector2D const & v2D)
 		{
 			// If it is a different vector2D
 			if (this != &v2D)
@@ -437,16 +974,64 @@ namespace hnc
 				m_data = v2D.m_data;
 				m_nb_row = v2D.nb_row();
 				m_nb_col = v2D.nb_col();
-				update_lines_ptr();
 			}
 			// Return
 			return *this;
 		}
+
+		/// @brief Assignment of an element-wise expression (computed in one loop, without temporary matrix if the size does not change)
+		/// @param[in] e An expression (see hnc::vector2D_expression)
+		/// @return the vector2D
+		template <class E>
+		vector2D & operator =(hnc::vector2D_expression<E> const & e)
+		{
+			if (e.derived().nb_row() == m_nb_row && e.derived().nb_col() == m_nb_col) { assign_expression(e.derived()); }
+			else { *this = vector2D(e); }
+			return *this;
+		}
+
+		/// @brief Element-wise addition of an expression or a vector2D (computed in one loop)
+		/// @param[in] e An expression (see hnc::vector2D_expression) with the same size
+		/// @return the vector2D
+		template <class E>
+		vector2D & operator +=(hnc::vector2D_expression<E> const & e)
+		{
+			assign_expression(*this + e);
+			return *this;
+		}
+
+		/// @brief Element-wise subtraction of an expression or a vector2D (computed in one loop)
+		/// @param[in] e An expression (see hnc::vector2D_expression) with the same size
+		/// @return the vector2D
+		template <class E>
+		vector2D & operator -=(hnc::vector2D_expression<E> const & e)
+		{
+			assign_expression(*this - e);
+			return *this;
+		}
+
+		/// @brief Multiply all values by a scalar
+		/// @param[in] scalar A scalar
+		/// @return the vector2D
+		vector2D & operator *=(T const & scalar)
+		{
+			assign_expression(*this * scalar);
+			return *this;
+		}
+
+		/// @brief Divide all values by a scalar
+		/// @param[in] scalar A scalar
+		/// @return the vector2D
+		vector2D & operator /=(T const & scalar)
+		{
+			assign_expression(*this / scalar);
+			return *this;
+		}
 		
 		hnc_generate_serialize_member_function(m_data, m_nb_row, m_nb_col)
 		
-		/// @brief After load serialization
-		void after_load_serialization() { update_lines_ptr(); }
+		/// @brief After load serialization (the lines are created on demand, nothing to update)
+		void after_load_serialization() { }
 
 		// operator () acces
 
@@ -456,7 +1041,7 @@ namespace hnc
 		/// @return the value at (i, j)
 		T const & operator()(std::size_t const i, std::size_t const j) const
 		{
-			return m_data[index2D::index1D(i, j, m_nb_col)];
+			return m_data[index2D::index1D(i, j, row_stride())];
 		}
 		
 		/// @brief Acces by fonctor
@@ -465,7 +1050,7 @@ namespace hnc
 		/// @return the value at (i, j)
 		T & operator()(std::size_t const i, std::size_t const j)
 		{
-			return m_data[index2D::index1D(i, j, m_nb_col)];
+			return m_data[index2D::index1D(i, j, row_stride())];
 		}
 
 		// .at acces
@@ -473,21 +1058,23 @@ namespace hnc
 		/// @brief Safe const acces
 		/// @param i Row index
 		/// @param j Column index
-		/// @exception std::out_of_range if out of range access (check by std::vector)
+		/// @exception std::out_of_range if out of range access
 		/// @return the value at .at(i, j)
 		T const & at(std::size_t const i, std::size_t const j) const
 		{
-			return m_data.at(index2D::index1D(i, j, m_nb_col));
+			check_range(i, j);
+			return m_data.at(index2D::index1D(i, j, row_stride()));
 		}
 		
 		/// @brief Safe acces
 		/// @param i Row index
 		/// @param j Column index
-		/// @exception std::out_of_range if out of range access (check by std::vector)
+		/// @exception std::out_of_range if out of range access
 		/// @return the value at .at(i, j)
 		T & at(std::size_t const i, std::size_t const j)
 		{
-			return m_data.at(index2D::index1D(i, j, m_nb_col));
+			check_range(i, j);
+			return m_data.at(index2D::index1D(i, j, row_stride()));
 		}
 
 		// operator [] access
@@ -495,17 +1082,17 @@ namespace hnc
 		/// @brief Const access by [i][j]
 		/// @param i Row index
 		/// @return a proxy to have [j]
-		hnc::vector2D<T>::line_const_ptr<T> const & operator[](std::size_t const i) const
+		line_const_ptr<T> operator[](std::size_t const i) const
 		{
-			return m_lines_const_ptr[i];
+			return line_const_ptr<T>(m_data.data() + i * row_stride(), m_nb_col);
 		}
 		
 		/// @brief Acces by [i][j]
 		/// @param i Row index
 		/// @return a proxy to have [j]
-		hnc::vector2D<T>::line_ptr<T> & operator[](std::size_t const i)
+		line_ptr<T> operator[](std::size_t const i)
 		{
-			return m_lines_ptr[i];
+			return line_ptr<T>(m_data.data() + i * row_stride(), m_nb_col);
 		}
 		
 		// front, back
@@ -513,33 +1100,33 @@ namespace hnc
 		/// @brief Const access to the first line
 		/// @pre vector2D has at least one line
 		/// @return a proxy to have the first line
-		hnc::vector2D<T>::line_const_ptr<T> const & front() const
+		line_const_ptr<T> front() const
 		{
-			return m_lines_const_ptr[0];
+			return (*this)[0];
 		}
 		
 		/// @brief Access to the first line
 		/// @pre vector2D has at least one line
 		/// @return a proxy to have the first line
-		hnc::vector2D<T>::line_ptr<T> & front()
+		line_ptr<T> front()
 		{
-			return m_lines_ptr[0];
+			return (*this)[0];
 		}
 
 		/// @brief Const access to the last line
 		/// @pre vector2D has at least one line
 		/// @return a proxy to have the last line
-		hnc::vector2D<T>::line_const_ptr<T> const & back() const
+		line_const_ptr<T> back() const
 		{
-			return m_lines_const_ptr[m_nb_row - 1];
+			return (*this)[m_nb_row - 1];
 		}
 		
 		/// @brief Access to the last line
 		/// @pre vector2D has at least one line
 		/// @return a proxy to have the last line
-		hnc::vector2D<T>::line_ptr<T> & back()
+		line_ptr<T> back()
 		{
-			return m_lines_ptr[m_nb_row - 1];
+			return (*this)[m_nb_row - 1];
 		}
 		
 		// Iterator
@@ -548,42 +1135,42 @@ namespace hnc
 		/// @return a iterator to the beginning
 		iterator begin()
 		{
-			return iterator(m_lines_ptr, 0);
+			return iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), 0);
 		}
 
 		/// @brief Return a iterator to the end
 		/// @return a iterator to the end
 		iterator end()
 		{
-			return iterator(m_lines_ptr, nb_row());
+			return iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), nb_row());
 		}
 		
 		/// @brief Return a const iterator to the beginning
 		/// @return a const iterator to the beginning
 		const_iterator begin() const
 		{
-			return const_iterator(m_lines_const_ptr, 0);
+			return const_iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), 0);
 		}
 
 		/// @brief Return a const iterator to the end
 		/// @return a const iterator to the end
 		const_iterator end() const
 		{
-			return const_iterator(m_lines_const_ptr, nb_row());
+			return const_iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), nb_row());
 		}
 		
 		/// @brief Return a const iterator to the beginning
 		/// @return a const iterator to the beginning
 		const_iterator cbegin() const
 		{
-			return const_iterator(m_lines_const_ptr, 0);
+			return begin();
 		}
 
 		/// @brief Return a const iterator to the end
 		/// @return a const iterator to the end
 		const_iterator cend() const
 		{
-			return const_iterator(m_lines_const_ptr, nb_row());
+			return end();
 		}
 		
 		// Reverse iterator
@@ -592,42 +1179,42 @@ namespace hnc
 		/// @return a reverse iterator to the beginning
 		reverse_iterator rbegin()
 		{
-			return reverse_iterator(m_lines_ptr, nb_row() - 1);
+			return reverse_iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), nb_row() - 1);
 		}
 
 		/// @brief Return a reverse iterator to the end
 		/// @return a reverse iterator to the end
 		reverse_iterator rend()
 		{
-			return reverse_iterator(m_lines_ptr, 0);
+			return reverse_iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), m_nb_row);
 		}
 
 		/// @brief Return a const reverse iterator to the beginning
 		/// @return a const reverse iterator to the beginning
 		const_reverse_iterator rbegin() const
 		{
-			return const_reverse_iterator(m_lines_const_ptr, nb_row() - 1);
+			return const_reverse_iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), nb_row() - 1);
 		}
 
 		/// @brief Return a const reverse iterator to the end
 		/// @return a const reverse iterator to the end
 		const_reverse_iterator rend() const
 		{
-			return const_reverse_iterator(m_lines_const_ptr, 0);
+			return const_reverse_iterator(m_data.data(), m_nb_row, m_nb_col, row_stride(), m_nb_row);
 		}
 
 		/// @brief Return a const reverse iterator to the beginning
 		/// @return a const reverse iterator to the beginning
 		const_reverse_iterator crbegin() const
 		{
-			return const_reverse_iterator(m_lines_const_ptr, nb_row() - 1);
+			return rbegin();
 		}
 
 		/// @brief Return a const reverse iterator to the end
 		/// @return a const reverse iterator to the end
 		const_reverse_iterator crend() const
 		{
-			return const_reverse_iterator(m_lines_const_ptr, 0);
+			return rend();
 		}
 
 		// Operator
@@ -635,30 +1222,114 @@ namespace hnc
 		/// @brief Equality operator
 		/// @param[in] v A hnc::vector2D<T> for the comparaison
 		/// @return true if hnc::vector2D<T> are equals, false otherwise
-		bool operator ==(hnc::vector2D<T> const & v) const
+		bool operator ==(vector2D const & v) const
 		{
 			// Different size
 			if (this->nb_row() != v.nb_row() || this->nb_col() != v.nb_col())
 			{
 				return false;
 			}
-			else
+			// Contiguous rows
+			else if (row_stride() == m_nb_col)
 			{
 				return (m_data == v.m_data);
 			}
+			// Compare the rows (not the padding)
+			else
+			{
+				for (std::size_t row = 0; row < m_nb_row; ++row)
+				{
+					if (std::equal(expression_row(row), expression_row(row) + m_nb_col, v.expression_row(row)) == false) { return false; }
+				}
+				return true;
+			}
 		}
 
 		/// @brief Inequality operator
 		/// @param[in] v A hnc::vector2D<T> for the comparaison
 		/// @return true if hnc::vector2D<T> are not equals, false otherwise
-		bool operator !=(hnc::vector2D<T> const & v) const
+		bool operator !=(vector2D const & v) const
 		{
 			return ! (*this == v);
 		}
 
+		// Views
+
+		/// @brief Return a const view on the vector2D (see hnc::vector2D_view)
+		/// @return a const view on the vector2D
+		hnc::vector2D_view<T const> view() const { return hnc::vector2D_view<T const>(m_data.data(), m_nb_row, m_nb_col, row_stride()); }
+
+		/// @brief Return a view on the vector2D (see hnc::vector2D_view)
+		/// @return a view on the vector2D
+		hnc::vector2D_view<T> view() { return hnc::vector2D_view<T>(m_data.data(), m_nb_row, m_nb_col, row_stride()); }
+
+		/// @brief Return a const view on a block (O(1), without copy)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::out_of_range hnc::hassert the block is in the vector2D if NDEBUG is not defined
+		/// @return a const view on the rows [i, i + nb_row) and the columns [j, j + nb_col)
+		hnc::vector2D_view<T const> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col) const
+		{ return view().sub_view(i, j, nb_row, nb_col); }
+
+		/// @brief Return a view on a block (O(1), without copy)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::out_of_range hnc::hassert the block is in the vector2D if NDEBUG is not defined
+		/// @return a view on the rows [i, i + nb_row) and the columns [j, j + nb_col)
+		hnc::vector2D_view<T> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col)
+		{ return view().sub_view(i, j, nb_row, nb_col); }
+
+		/// @brief Return a const transposed view (O(1), without copy)
+		/// @return a const view, the value (i, j) of the view is the value (j, i) of the vector2D
+		hnc::vector2D_view<T const> transposed_view() const { return view().transposed(); }
+
+		/// @brief Return a transposed view (O(1), without copy)
+		/// @return a view, the value (i, j) of the view is the value (j, i) of the vector2D
+		hnc::vector2D_view<T> transposed_view() { return view().transposed(); }
+
+		/// @brief Return a const view on a column
+		/// @param[in] j Column index
+		/// @exception std::out_of_range hnc::hassert j < number of columns if NDEBUG is not defined
+		/// @return a const view on the column j
+		hnc::vector2D_line_view<T const> col(std::size_t const j) const { return view().col(j); }
+
+		/// @brief Return a view on a column
+		/// @param[in] j Column index
+		/// @exception std::out_of_range hnc::hassert j < number of columns if NDEBUG is not defined
+		/// @return a view on the column j
+		hnc::vector2D_line_view<T> col(std::size_t const j) { return view().col(j); }
+
+		// Capacity
+
+		/// @brief Return the number of rows the vector2D can hold without reallocation (with the actual number of columns)
+		/// @return the number of rows the vector2D can hold without reallocation
+		std::size_t capacity_rows() const { return (row_stride() == 0) ? m_data.capacity() : m_data.capacity() / row_stride(); }
+
+		/// @brief Return the number of values by row the vector2D can hold without reallocation (with the actual number of rows)
+		/// @return the number of columns (with the padding) the vector2D can hold without reallocation
+		std::size_t capacity_cols() const { return (m_nb_row == 0) ? m_data.capacity() : m_data.capacity() / m_nb_row; }
+
+		/// @brief Reserve the memory for nb_row rows (with the actual number of columns), the next row insertions do not reallocate
+		/// @param[in] nb_row Number of rows
+		void reserve_rows(std::size_t const nb_row) { m_data.reserve(nb_row * row_stride()); }
+
+		/// @brief Reserve the memory for nb_col columns (with the actual number of rows), the next column insertions do not reallocate
+		/// @param[in] nb_col Number of columns
+		void reserve_cols(std::size_t const nb_col) { m_data.reserve(m_nb_row * storage_t::row_stride(nb_col)); }
+
+		/// @brief Free the unused memory (see reserve_rows and reserve_cols)
+		void shrink_to_fit() { m_data.shrink_to_fit(); }
+
 		// Add / remove
 		
 		/// @brief Add a row before
+		///
+		/// The rows after are shifted in the same buffer (amortized O(number of columns) at the end, see reserve_rows)
+		///
 		/// @param[in] i             Row is inserted before this one
 		/// @param[in] default_value Default value
 		/// @exception std::out_of_range hnc::hassert i <= number of rows if NDEBUG is not defined
@@ -668,25 +1339,9 @@ namespace hnc
 			#ifndef NDEBUG
 				hnc::hassert(i <= m_nb_row, std::out_of_range("hnc::vector2D::add_row_before could not insert before row " + hnc::to_string(i) + ", number of rows = " + hnc::to_string(m_nb_row)));
 			#endif
-			// New vector2D
-			hnc::vector2D<T> new_vector2D(m_nb_row + 1, m_nb_col);
-			// Copy rows before new row
-			for (std::size_t row = 0; row < i; ++row)
-			{
-				for (std::size_t col = 0; col < m_nb_col; ++col)
-				{ new_vector2D(row, col) = (*this)(row, col); }
-			}
-			// Insert line
-			for (std::size_t col = 0; col < new_vector2D.nb_col(); ++col)
-			{ new_vector2D(i, col) = default_value; }
-			// Copy rows after new row
-			for (std::size_t row = i; row < m_nb_row; ++row)
-			{
-				for (std::size_t col = 0; col < m_nb_col; ++col)
-				{ new_vector2D(row + 1, col) = (*this)(row, col); }
-			}
-			// Copy
-			*this = std::move(new_vector2D);
+			// Shift the rows after and insert the row
+			m_data.insert(m_data.begin() + std::ptrdiff_t(i * row_stride()), row_stride(), default_value);
+			++m_nb_row;
 		}
 		
 		/// @brief Add a row after
@@ -695,7 +1350,58 @@ namespace hnc
 		void add_row_after(std::size_t const i, T const & default_value = T())
 		{ add_row_before(i + 1, default_value); }
 
+		/// @brief Add a row at the end (amortized O(number of columns), see reserve_rows)
+		/// @param[in] default_value Default value
+		void push_back_row(T const & default_value = T())
+		{ add_row_before(m_nb_row, default_value); }
+
+		/**
+		 * @brief Add a row at the end with its values (amortized O(number of columns), see reserve_rows)
+		 *
+		 * If the vector2D is empty (no row and no column), the number of columns is the size of the row
+		 *
+		 * @code
+		   hnc::vector2D<double> table;
+		   table.reserve_rows(1000);
+		   while (stream_has_data()) { table.push_back_row(read_row()); }
+		   @endcode
+		 *
+		 * This overload is only for containers (with begin() and size()), push_back_row(0) calls push_back_row(T const &)
+		 *
+		 * @param[in] values Values of the row (a std::vector<T> for example)
+		 *
+		 * @exception std::invalid_argument hnc::hassert size of the row is the number of columns if NDEBUG is not defined
+		 */
+		template
+		<
+			class container_t,
+			class = typename hnc::this_type<decltype(std::declval<container_t const &>().begin(), std::declval<container_t const &>().size())>::is_valid
+		>
+		void push_back_row(container_t const & values)
+		{
+			if (m_nb_row == 0 && m_nb_col == 0) { m_nb_col = values.size(); }
+			#ifndef NDEBUG
+				hnc::hassert(values.size() == m_nb_col, std::invalid_argument("hnc::vector2D::push_back_row, the row has " + hnc::to_string(values.size()) + " values, number of columns = " + hnc::to_string(m_nb_col)));
+			#endif
+			// A row of this vector2D (v.push_back_row(v[0])) is copied by index: its iterators are invalidated by a reallocation
+			T const * const p_first = (values.size() != 0) ? &*values.begin() : nullptr;
+			if (p_first != nullptr && std::less<T const *>()(p_first, m_data.data() + m_data.size()) && std::less<T const *>()(p_first, m_data.data()) == false)
+			{
+				std::size_t const first = std::size_t(p_first - m_data.data());
+				for (std::size_t j = 0; j < m_nb_col; ++j) { m_data.push_back(m_data[first + j]); }
+			}
+			else
+			{
+				m_data.insert(m_data.end(), values.begin(), values.end());
+			}
+			m_data.resize(m_data.size() + row_stride() - m_nb_col);
+			++m_nb_row;
+		}
+
 		/// @brief Add a column before
+		///
+		/// The values are shifted in one pass in the same buffer (see reserve_cols)
+		///
 		/// @param[in] j             Column is inserted before this one
 		/// @param[in] default_value Default value
 		/// @exception std::out_of_range hnc::hassert j <= number of columns if NDEBUG is not defined
@@ -705,22 +1411,22 @@ namespace hnc
 			#ifndef NDEBUG
 				hnc::hassert(j <= m_nb_col, std::out_of_range("hnc::vector2D::add_col_before could not insert before column " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col)));
 			#endif
-			// New vector2D
-			hnc::vector2D<T> new_vector2D(m_nb_row, m_nb_col + 1);
-			// Copy rows before new row
-			for (std::size_t row = 0; row < m_nb_row; ++row)
+			// Copy of the value (it can be a value of the vector2D)
+			T const value = default_value;
+			std::size_t const new_nb_col = m_nb_col + 1;
+			std::size_t const old_row_stride = row_stride();
+			std::size_t const new_row_stride = storage_t::row_stride(new_nb_col);
+			m_data.resize(m_nb_row * new_row_stride, value);
+			// Shift from the end (a value never moves before its old position)
+			for (std::size_t row = m_nb_row; row-- > 0; )
 			{
-				// Copy all col before new col
-				for (std::size_t col = 0; col < j; ++col)
-				{ new_vector2D(row, col) = (*this)(row, col); }
-				// Insert value
-				new_vector2D(row, j) = default_value;
-				// Copy all col after new col
-				for (std::size_t col = j; col < m_nb_col; ++col)
-				{ new_vector2D(row, col + 1) = (*this)(row, col); }
+				T * const new_row = m_data.data() + row * new_row_stride;
+				T * const old_row = m_data.data() + row * old_row_stride;
+				for (std::size_t col = m_nb_col; col-- > j; ) { new_row[col + 1] = std::move(old_row[col]); }
+				new_row[j] = value;
+				if (row != 0 && new_row_stride != old_row_stride) { for (std::size_t col = j; col-- > 0; ) { new_row[col] = std::move(old_row[col]); } }
 			}
-			// Copy
-			*this = std::move(new_vector2D);
+			m_nb_col = new_nb_col;
 		}
 		
 		/// @brief Add a column after
@@ -732,6 +1438,9 @@ namespace hnc
 		// Remove a line/column
 
 		/// @brief Remove a line
+		///
+		/// The rows after are shifted in the same buffer, the capacity is kept (see shrink_to_fit)
+		///
 		/// @param[in] i Row removed
 		/// @exception std::out_of_range hnc::hassert i <= number of rows if NDEBUG is not defined
 		void remove_line(std::size_t const i)
@@ -740,25 +1449,16 @@ namespace hnc
 			#ifndef NDEBUG
 				hnc::hassert(i < m_nb_row, std::out_of_range("hnc::vector2D::remove_line could not remove the line " + hnc::to_string(i) + ", number of rows = " + hnc::to_string(m_nb_row)));
 			#endif
-			// New vector2D
-			hnc::vector2D<T> new_vector2D(m_nb_row - 1, m_nb_col);
-			// Copy lines before i
-			for (std::size_t row = 0; row < i; ++row)
-			{
-				for (std::size_t col = 0; col < m_nb_col; ++col)
-				{ new_vector2D(row, col) = (*this)(row, col); }
-			}
-			// Copy lines after i
-			for (std::size_t row = i + 1; row < m_nb_row; ++row)
-			{
-				for (std::size_t col = 0; col < m_nb_col; ++col)
-				{ new_vector2D(row - 1, col) = (*this)(row, col); }
-			}
-			// Copy
-			*this = std::move(new_vector2D);
+			// Shift the rows after
+			auto const first = m_data.begin() + std::ptrdiff_t(i * row_stride());
+			m_data.erase(first, first + std::ptrdiff_t(row_stride()));
+			--m_nb_row;
 		}
 
 		/// @brief Remove a column
+		///
+		/// The values are shifted in one pass in the same buffer, the capacity is kept (see shrink_to_fit)
+		///
 		/// @param[in] j Column removed
 		/// @exception std::out_of_range hnc::hassert j <= number of columns if NDEBUG is not defined
 		void remove_column(std::size_t const j)
@@ -767,28 +1467,113 @@ namespace hnc
 			#ifndef NDEBUG
 				hnc::hassert(j < m_nb_col, std::out_of_range("hnc::vector2D::remove_column could not remove the column " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col)));
 			#endif
-			// New vector2D
-			hnc::vector2D<T> new_vector2D(m_nb_row, m_nb_col - 1);
-			// Copy lines
+			std::size_t const new_nb_col = m_nb_col - 1;
+			std::size_t const old_row_stride = row_stride();
+			std::size_t const new_row_stride = storage_t::row_stride(new_nb_col);
+			// Shift from the beginning (a value never moves after its old position)
 			for (std::size_t row = 0; row < m_nb_row; ++row)
 			{
-				// Copy columns bejore j
-				for (std::size_t col = 0; col < j; ++col)
-				{
-					new_vector2D(row, col) = (*this)(row, col);
-				}
-				// Copy columns after j
-				for (std::size_t col = j + 1; col < m_nb_col; ++col)
-				{
-					new_vector2D(row, col - 1) = (*this)(row, col);
-				}
+				T * const new_row = m_data.data() + row * new_row_stride;
+				T * const old_row = m_data.data() + row * old_row_stride;
+				if (row != 0 && new_row_stride != old_row_stride) { for (std::size_t col = 0; col < j; ++col) { new_row[col] = std::move(old_row[col]); } }
+				for (std::size_t col = j + 1; col < m_nb_col; ++col) { new_row[col - 1] = std::move(old_row[col]); }
 			}
-			// Copy
-			*this = std::move(new_vector2D);
+			m_data.resize(m_nb_row * new_row_stride);
+			m_nb_col = new_nb_col;
+		}
+
+		// Vectorized operations
+
+		/// @brief Assign a value to all values (vectorized)
+		/// @param[in] value A value
+		void fill(T const & value)
+		{
+			if (row_stride() == m_nb_col) { hnc::vector2D_kernel::fill(m_data.data(), m_data.size(), value); }
+			else { for (std::size_t row = 0; row < m_nb_row; ++row) { (*this)[row].fill(value); } }
+		}
+
+		/// @brief *this = alpha * x + *this (vectorized)
+		/// @param[in] alpha Scalar
+		/// @param[in] x     A hnc::vector2D with the same size
+		/// @exception std::invalid_argument hnc::hassert the vector2D have the same size if NDEBUG is not defined
+		template <class storage_x_t>
+		void axpy(T const alpha, hnc::vector2D<T, storage_x_t> const & x)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(x.nb_row() == m_nb_row && x.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D::axpy, x is a " + hnc::to_string(x.nb_row()) + "x" + hnc::to_string(x.nb_col()) + " matrix instead of " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col)));
+			#endif
+			if (row_stride() == m_nb_col && x.row_stride() == m_nb_col) { hnc::vector2D_kernel::axpy(m_data.size(), alpha, x.data(), m_data.data()); }
+			else { for (std::size_t row = 0; row < m_nb_row; ++row) { (*this)[row].axpy(alpha, x[row]); } }
+		}
+
+		/// @brief Return the sum of the values (vectorized)
+		/// @return the sum of the values
+		T sum() const
+		{
+			if (row_stride() == m_nb_col) { return hnc::vector2D_kernel::sum(m_data.data(), m_data.size()); }
+			T r = T();
+			for (std::size_t row = 0; row < m_nb_row; ++row) { r += (*this)[row].sum(); }
+			return r;
+		}
+
+		/// @brief Return the minimum of the values (vectorized)
+		/// @pre The vector2D has at least one value
+		/// @return the minimum of the values
+		T min() const
+		{
+			if (row_stride() == m_nb_col) { return hnc::vector2D_kernel::min(m_data.data(), m_data.size()); }
+			T r = (*this)[0].min();
+			for (std::size_t row = 1; row < m_nb_row; ++row) { r = std::min(r, (*this)[row].min()); }
+			return r;
+		}
+
+		/// @brief Return the maximum of the values (vectorized)
+		/// @pre The vector2D has at least one value
+		/// @return the maximum of the values
+		T max() const
+		{
+			if (row_stride() == m_nb_col) { return hnc::vector2D_kernel::max(m_data.data(), m_data.size()); }
+			T r = (*this)[0].max();
+			for (std::size_t row = 1; row < m_nb_row; ++row) { r = std::max(r, (*this)[row].max()); }
+			return r;
+		}
+
+		/// @brief Return the Frobenius inner product (sum of the element-wise products) with a hnc::vector2D (vectorized)
+		/// @param[in] v A hnc::vector2D with the same size
+		/// @exception std::invalid_argument hnc::hassert the vector2D have the same size if NDEBUG is not defined
+		/// @return the sum of the products of the values
+		template <class storage_v_t>
+		T dot(hnc::vector2D<T, storage_v_t> const & v) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(v.nb_row() == m_nb_row && v.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D::dot, v is a " + hnc::to_string(v.nb_row()) + "x" + hnc::to_string(v.nb_col()) + " matrix instead of " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col)));
+			#endif
+			if (row_stride() == m_nb_col && v.row_stride() == m_nb_col) { return hnc::vector2D_kernel::dot(m_data.data(), v.data(), m_data.size()); }
+			T r = T();
+			for (std::size_t row = 0; row < m_nb_row; ++row) { r += (*this)[row].dot(v[row]); }
+			return r;
 		}
 
 	private:
 
+		/// @brief Compute an expression in the vector2D, row by row
+		/// @param[in] e An expression with the same size
+		/// @exception std::invalid_argument hnc::hassert the expression has the same size if NDEBUG is not defined
+		template <class E>
+		void assign_expression(E const & e)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(e.nb_row() == m_nb_row && e.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D, the expression is a " + hnc::to_string(e.nb_row()) + "x" + hnc::to_string(e.nb_col()) + " matrix instead of " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col)));
+			#endif
+			for (std::size_t row = 0; row < m_nb_row; ++row)
+			{
+				typename E::expression_row_t const e_row = e.expression_row(row);
+				T * const p = m_data.data() + row * row_stride();
+				#pragma omp simd
+				for (std::size_t col = 0; col < m_nb_col; ++col) { p[col] = e_row[col]; }
+			}
+		}
+
 		#ifndef NDEBUG
 			/**
 			 * @brief Check if acces is out of range with hnc::hassert if NDEBUG is not defined
@@ -823,26 +1608,14 @@ namespace hnc
 				throw std::out_of_range("hnc::vector2D, id column = " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col));
 			}
 		}
-
-		/// @brief Udapte lines const and lines after each modifications of the vector2D (constructors, operator =, add/remove line/column)
-		void update_lines_ptr()
-		{
-			m_lines_const_ptr.resize(nb_row());
-			m_lines_ptr.resize(nb_row());
-			for (std::size_t row = 0; row < m_nb_row; ++row)
-			{
-				m_lines_const_ptr[row] = line_const_ptr<T>(this, row);
-				m_lines_ptr[row] = line_ptr<T>(this, row);
-			}
-		}
 	};
 	
 	/// @brief Operator << between a std::ostream and a hnc::vector2D<T>
 	/// @param[in,out] o Output stream
 	/// @param[in]     v A hnc::vector2D<T>
 	/// @return the output stream
-	template <class T>
-	std::ostream & operator <<(std::ostream & o, hnc::vector2D<T> const & v)
+	template <class T, class storage_t>
+	std::ostream & operator <<(std::ostream & o, hnc::vector2D<T, storage_t> const & v)
 	{
 		// Display data
 		for (std::size_t row = 0; row < v.nb_row(); ++row)
@@ -0,0 +1,447 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR2D_EXPRESSION_HPP
+#define HNC_VECTOR2D_EXPRESSION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Vectorized kernels on contiguous values (used by hnc::vector2D for the whole matrix and for the rows)
+	 *
+	 * @code
+	   #include <hnc/vector2D.hpp>
+	   @endcode
+	 *
+	 * The loops are vectorized with OpenMP SIMD (the reductions too, without -ffast-math)
+	 */
+	namespace vector2D_kernel
+	{
+		/// @brief Assign a value to n values
+		/// @param[out] p     Values
+		/// @param[in]  n     Number of values
+		/// @param[in]  value A value
+		template <class T>
+		void fill(T * const p, std::size_t const n, T const value)
+		{
+			#pragma omp simd
+			for (std::size_t i = 0; i < n; ++i) { p[i] = value; }
+		}
+
+		/// @brief y = alpha * x + y
+		/// @param[in]     n     Number of values
+		/// @param[in]     alpha Scalar
+		/// @param[in]     x     Values
+		/// @param[in,out] y     Values
+		template <class T>
+		void axpy(std::size_t const n, T const alpha, T const * const x, T * const y)
+		{
+			#pragma omp simd
+			for (std::size_t i = 0; i < n; ++i) { y[i] = T(alpha * x[i] + y[i]); }
+		}
+
+		/// @brief Return the sum of n values
+		/// @param[in] p Values
+		/// @param[in] n Number of values
+		/// @return the sum of the values (0 if n is 0)
+		template <class T>
+		T sum(T const * const p, std::size_t const n)
+		{
+			T r = T(0);
+			#pragma omp simd reduction(+:r)
+			for (std::size_t i = 0; i < n; ++i) { r = T(r + p[i]); }
+			return r;
+		}
+
+		/// @brief Return the minimum of n values
+		/// @param[in] p Values
+		/// @param[in] n Number of values (at least 1)
+		/// @return the minimum of the values
+		template <class T>
+		T min(T const * const p, std::size_t const n)
+		{
+			T r = p[0];
+			#pragma omp simd reduction(min:r)
+			for (std::size_t i = 1; i < n; ++i) { r = (p[i] < r) ? p[i] : r; }
+			return r;
+		}
+
+		/// @brief Return the maximum of n values
+		/// @param[in] p Values
+		/// @param[in] n Number of values (at least 1)
+		/// @return the maximum of the values
+		template <class T>
+		T max(T const * const p, std::size_t const n)
+		{
+			T r = p[0];
+			#pragma omp simd reduction(max:r)
+			for (std::size_t i = 1; i < n; ++i) { r = (r < p[i]) ? p[i] : r; }
+			return r;
+		}
+
+		/// @brief Return the dot product of n values
+		/// @param[in] x Values
+		/// @param[in] y Values
+		/// @param[in] n Number of values
+		/// @return the sum of x[i] * y[i]
+		template <class T>
+		T dot(T const * const x, T const * const y, std::size_t const n)
+		{
+			T r = T(0);
+			#pragma omp simd reduction(+:r)
+			for (std::size_t i = 0; i < n; ++i) { r = T(r + x[i] * y[i]); }
+			return r;
+		}
+	}
+
+	/**
+	 * @brief Base class of the element-wise expressions on hnc::vector2D (expression templates)
+	 *
+	 * @code
+	   #include <hnc/vector2D.hpp>
+	   @endcode
+	 *
+	 * An expression (a + b, 2 * a, ...) is not computed: it keeps its operands,
+	 * the values are computed only when the expression is assigned to a hnc::vector2D, in one loop without temporary matrix
+	 *
+	 * @code
+	   hnc::vector2D<double> a(1000, 1000, 1.), b(1000, 1000, 2.), c(1000, 1000, 3.);
+	   hnc::vector2D<double> r = a + 2. * b - c / 4.; // One loop, no temporary
+	   r += hnc::element_wise_product(a, b);           // One loop, no temporary
+	   @endcode
+	 *
+	 * An expression E has:
+	 * - value_type, nb_row() and nb_col()
+	 * - expression_stored_t, the type used to keep E in an other expression (a reference for a hnc::vector2D, a copy for an expression)
+	 * - expression_row_t expression_row(i), with expression_row(i)[j] the value (i, j) of the expression
+	 *
+	 * @warning An expression keeps references to the matrices, do not keep an expression (with auto) after the matrices are destroyed
+	 *
+	 * @tparam E Type of the expression (CRTP)
+	 */
+	template <class E>
+	class vector2D_expression
+	{
+	public:
+
+		/// @brief Return the expression
+		/// @return the expression
+		E const & derived() const { return static_cast<E const &>(*this); }
+	};
+
+	/// @brief Element-wise operations of the expressions on hnc::vector2D
+	namespace vector2D_expression_op
+	{
+		/// @brief a + b
+		template <class T>
+		class plus
+		{
+		public:
+			/// @brief Return a + b
+			/// @param[in] a A value
+			/// @param[in] b A value
+			/// @return a + b
+			T operator ()(T const a, T const b) const { return T(a + b); }
+		};
+
+		/// @brief a - b
+		template <class T>
+		class minus
+		{
+		public:
+			/// @brief Return a - b
+			/// @param[in] a A value
+			/// @param[in] b A value
+			/// @return a - b
+			T operator ()(T const a, T const b) const { return T(a - b); }
+		};
+
+		/// @brief a * b
+		template <class T>
+		class multiplies
+		{
+		public:
+			/// @brief Return a * b
+			/// @param[in] a A value
+			/// @param[in] b A value
+			/// @return a * b
+			T operator ()(T const a, T const b) const { return T(a * b); }
+		};
+
+		/// @brief -a
+		template <class T>
+		class negate
+		{
+		public:
+			/// @brief Return -a
+			/// @param[in] a A value
+			/// @return -a
+			T operator ()(T const a) const { return T(-a); }
+		};
+
+		/// @brief a * scalar
+		template <class T>
+		class multiplies_by
+		{
+		public:
+			/// Scalar
+			T scalar;
+			/// @brief Return a * scalar
+			/// @param[in] a A value
+			/// @return a * scalar
+			T operator ()(T const a) const { return T(a * scalar); }
+		};
+
+		/// @brief a / scalar
+		template <class T>
+		class divides_by
+		{
+		public:
+			/// Scalar
+			T scalar;
+			/// @brief Return a / scalar
+			/// @param[in] a A value
+			/// @return a / scalar
+			T operator ()(T const a) const { return T(a / scalar); }
+		};
+	}
+
+	/**
+	 * @brief Element-wise binary expression on hnc::vector2D: op(a(i, j), b(i, j))
+	 *
+	 * @code
+	   #include <hnc/vector2D.hpp>
+	   @endcode
+	 */
+	template <class A, class B, class op_t>
+	class vector2D_binary_expression : public hnc::vector2D_expression<vector2D_binary_expression<A, B, op_t>>
+	{
+	public:
+
+		/// Type of the values
+		using value_type = typename A::value_type;
+
+		/// Type used to keep the expression in an other expression (a copy)
+		using expression_stored_t = vector2D_binary_expression<A, B, op_t>;
+
+		/// Row of the expression
+		class expression_row_t
+		{
+		public:
+
+			/// Row of a
+			typename A::expression_row_t a;
+
+			/// Row of b
+			typename B::expression_row_t b;
+
+			/// Operation
+			op_t op;
+
+			/// @brief Return the value j of the row
+			/// @param[in] j Column index
+			/// @return op(a[j], b[j])
+			value_type operator [](std::size_t const j) const { return op(a[j], b[j]); }
+		};
+
+	private:
+
+		/// First operand
+		typename A::expression_stored_t m_a;
+
+		/// Second operand
+		typename B::expression_stored_t m_b;
+
+		/// Operation
+		op_t m_op;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] a  First operand
+		/// @param[in] b  Second operand (same size)
+		/// @param[in] op Operation
+		/// @exception std::invalid_argument hnc::hassert a and b have the same size if NDEBUG is not defined
+		vector2D_binary_expression(A const & a, B const & b, op_t const & op = op_t()) : m_a(a), m_b(b), m_op(op)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(a.nb_row() == b.nb_row() && a.nb_col() == b.nb_col(), std::invalid_argument("hnc::vector2D_binary_expression, size " + hnc::to_string(a.nb_row()) + " x " + hnc::to_string(a.nb_col()) + " and size " + hnc::to_string(b.nb_row()) + " x " + hnc::to_string(b.nb_col())));
+			#endif
+		}
+
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		std::size_t nb_row() const { return m_a.nb_row(); }
+
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		std::size_t nb_col() const { return m_a.nb_col(); }
+
+		/// @brief Return a row of the expression
+		/// @param[in] i Row index
+		/// @return the row i
+		expression_row_t expression_row(std::size_t const i) const { return expression_row_t{ m_a.expression_row(i), m_b.expression_row(i), m_op }; }
+	};
+
+	/**
+	 * @brief Element-wise unary expression on hnc::vector2D: f(a(i, j))
+	 *
+	 * @code
+	   #include <hnc/vector2D.hpp>
+	   @endcode
+	 */
+	template <class A, class function_t>
+	class vector2D_unary_expression : public hnc::vector2D_expression<vector2D_unary_expression<A, function_t>>
+	{
+	public:
+
+		/// Type of the values
+		using value_type = typename A::value_type;
+
+		/// Type used to keep the expression in an other expression (a copy)
+		using expression_stored_t = vector2D_unary_expression<A, function_t>;
+
+		/// Row of the expression
+		class expression_row_t
+		{
+		public:
+
+			/// Row of a
+			typename A::expression_row_t a;
+
+			/// Function
+			function_t f;
+
+			/// @brief Return the value j of the row
+			/// @param[in] j Column index
+			/// @return f(a[j])
+			value_type operator [](std::size_t const j) const { return f(a[j]); }
+		};
+
+	private:
+
+		/// Operand
+		typename A::expression_stored_t m_a;
+
+		/// Function
+		function_t m_f;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] a Operand
+		/// @param[in] f Function
+		vector2D_unary_expression(A const & a, function_t const & f = function_t()) : m_a(a), m_f(f)
+		{ }
+
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		std::size_t nb_row() const { return m_a.nb_row(); }
+
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		std::size_t nb_col() const { return m_a.nb_col(); }
+
+		/// @brief Return a row of the expression
+		/// @param[in] i Row index
+		/// @return the row i
+		expression_row_t expression_row(std::size_t const i) const { return expression_row_t{ m_a.expression_row(i), m_f }; }
+	};
+
+	/// @brief Element-wise sum of two matrices (hnc::vector2D or expressions)
+	/// @param[in] a A hnc::vector2D or an expression
+	/// @param[in] b A hnc::vector2D or an expression with the same size
+	/// @return the expression a + b
+	template <class A, class B>
+	hnc::vector2D_binary_expression<A, B, hnc::vector2D_expression_op::plus<typename A::value_type>>
+	operator +(hnc::vector2D_expression<A> const & a, hnc::vector2D_expression<B> const & b)
+	{
+		return hnc::vector2D_binary_expression<A, B, hnc::vector2D_expression_op::plus<typename A::value_type>>(a.derived(), b.derived());
+	}
+
+	/// @brief Element-wise difference of two matrices (hnc::vector2D or expressions)
+	/// @param[in] a A hnc::vector2D or an expression
+	/// @param[in] b A hnc::vector2D or an expression with the same size
+	/// @return the expression a - b
+	template <class A, class B>
+	hnc::vector2D_binary_expression<A, B, hnc::vector2D_expression_op::minus<typename A::value_type>>
+	operator -(hnc::vector2D_expression<A> const & a, hnc::vector2D_expression<B> const & b)
+	{
+		return hnc::vector2D_binary_expression<A, B, hnc::vector2D_expression_op::minus<typename A::value_type>>(a.derived(), b.derived());
+	}
+
+	/// @brief Element-wise product (Hadamard product) of two matrices (hnc::vector2D or expressions)
+	/// @param[in] a A hnc::vector2D or an expression
+	/// @param[in] b A hnc::vector2D or an expression with the same size
+	/// @return the expression a(i, j) * b(i, j)
+	template <class A, class B>
+	hnc::vector2D_binary_expression<A, B, hnc::vector2D_expression_op::multiplies<typename A::value_type>>
+	element_wise_product(hnc::vector2D_expression<A> const & a, hnc::vector2D_expression<B> const & b)
+	{
+		return hnc::vector2D_binary_expression<A, B, hnc::vector2D_expression_op::multiplies<typename A::value_type>>(a.derived(), b.derived());
+	}
+
+	/// @brief Element-wise opposite of a matrix (hnc::vector2D or expression)
+	/// @param[in] a A hnc::vector2D or an expression
+	/// @return the expression -a
+	template <class A>
+	hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::negate<typename A::value_type>>
+	operator -(hnc::vector2D_expression<A> const & a)
+	{
+		return hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::negate<typename A::value_type>>(a.derived());
+	}
+
+	/// @brief Product of a matrix (hnc::vector2D or expression) and a scalar
+	/// @param[in] a      A hnc::vector2D or an expression
+	/// @param[in] scalar A scalar
+	/// @return the expression a * scalar
+	template <class A>
+	hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::multiplies_by<typename A::value_type>>
+	operator *(hnc::vector2D_expression<A> const & a, typename A::value_type const & scalar)
+	{
+		return hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::multiplies_by<typename A::value_type>>(a.derived(), { scalar });
+	}
+
+	/// @brief Product of a scalar and a matrix (hnc::vector2D or expression)
+	/// @param[in] scalar A scalar
+	/// @param[in] a      A hnc::vector2D or an expression
+	/// @return the expression scalar * a
+	template <class A>
+	hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::multiplies_by<typename A::value_type>>
+	operator *(typename A::value_type const & scalar, hnc::vector2D_expression<A> const & a)
+	{
+		return a * scalar;
+	}
+
+	/// @brief Division of a matrix (hnc::vector2D or expression) by a scalar
+	/// @param[in] a      A hnc::vector2D or an expression
+	/// @param[in] scalar A scalar
+	/// @return the expression a / scalar
+	template <class A>
+	hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::divides_by<typename A::value_type>>
+	operator /(hnc::vector2D_expression<A> const & a, typename A::value_type const & scalar)
+	{
+		return hnc::vector2D_unary_expression<A, hnc::vector2D_expression_op::divides_by<typename A::value_type>>(a.derived(), { scalar });
+	}
+}
+
+#endif
@@ -0,0 +1,539 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR2D_FIXED_HPP
+#define HNC_VECTOR2D_FIXED_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
+#include <ostream>
+
+#include "vector2D.hpp"
+#include "vector2D_view.hpp"
+#include "vector2D_expression.hpp"
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Tag type of the hnc::vector2D_fixed constructor with all values in row-major order
+	 *
+	 * @code
+	   #include <hnc/vector2D_fixed.hpp>
+	   @endcode
+	 */
+	struct row_major_values_t
+	{
+		/// @brief Constructor
+		constexpr row_major_values_t() { }
+	};
+
+	/// Tag of the hnc::vector2D_fixed constructor with all values in row-major order (see hnc::row_major_values_t)
+	constexpr hnc::row_major_values_t row_major_values = hnc::row_major_values_t();
+
+	/**
+	 * @brief 2D container with the number of rows and columns known at compile time (a small matrix: 3 x 3, 4 x 4, ...)
+	 *
+	 * @code
+	   #include <hnc/vector2D_fixed.hpp>
+	   @endcode
+	 *
+	 * The values are in the object (no allocation, on the stack for a local variable), in row-major order without padding @n
+	 * The indexes are computed at compile time when they are constants and the matrix can be constexpr
+	 *
+	 * The API is the API of hnc::vector2D (operator(), at, operator[] with the same line types, iteration on the rows,
+	 * views, element-wise expressions, fill, sum, min, max, dot), so generic code can use both @n
+	 * See hnc::math::multiply, hnc::math::transpose, hnc::math::determinant and hnc::math::inverse (unrolled) in <hnc/math/vector2D_fixed.hpp>
+	 *
+	 * @code
+	   constexpr hnc::vector2D_fixed<double, 2, 2> rotation(hnc::row_major_values, 0., -1., 1., 0.);
+	   static_assert(rotation(1, 0) == 1., "");
+	   hnc::vector2D_fixed<double, 3, 3> m = { { 2, 0, 0 }, { 0, 3, 0 }, { 0, 0, 4 } };
+	   for (auto row : m) { std::cout << row.sum() << std::endl; }
+	   @endcode
+	 *
+	 * @tparam T            Type of the values
+	 * @tparam nb_row_fixed Number of rows
+	 * @tparam nb_col_fixed Number of columns
+	 */
+	template <class T, std::size_t nb_row_fixed, std::size_t nb_col_fixed>
+	class vector2D_fixed : public hnc::vector2D_expression<vector2D_fixed<T, nb_row_fixed, nb_col_fixed>>
+	{
+		static_assert(nb_row_fixed != 0 && nb_col_fixed != 0, "hnc::vector2D_fixed, the number of rows and the number of columns must not be 0");
+
+	public:
+
+		/// Const iterator on a row
+		template <class U>
+		using line_const_ptr = typename hnc::vector2D<T>::template line_const_ptr<U>;
+
+		/// Iterator on a row
+		template <class U>
+		using line_ptr = typename hnc::vector2D<T>::template line_ptr<U>;
+
+		/// Iterator on rows
+		using iterator = typename hnc::vector2D<T>::iterator;
+
+		/// Const iterator on rows
+		using const_iterator = typename hnc::vector2D<T>::const_iterator;
+
+		/// Reverse iterator on rows
+		using reverse_iterator = typename hnc::vector2D<T>::reverse_iterator;
+
+		/// Const reverse iterator on rows
+		using const_reverse_iterator = typename hnc::vector2D<T>::const_reverse_iterator;
+
+	private:
+
+		/// Values (row-major)
+		T m_data[nb_row_fixed * nb_col_fixed];
+
+	public:
+
+		/// @brief Constructor (the values are T())
+		constexpr vector2D_fixed() : m_data() { }
+
+		/// @brief Constructor with the API of hnc::vector2D
+		/// @param[in] nb_row        Number of rows (nb_row_fixed)
+		/// @param[in] nb_col        Number of columns (nb_col_fixed)
+		/// @param[in] default_value Default value (T() by default)
+		/// @exception std::invalid_argument hnc::hassert the sizes are the fixed sizes if NDEBUG is not defined
+		vector2D_fixed(std::size_t const nb_row, std::size_t const nb_col, T const & default_value = T()) :
+			m_data()
+		{
+			#ifndef NDEBUG
+				hnc::hassert(nb_row == nb_row_fixed && nb_col == nb_col_fixed, std::invalid_argument("hnc::vector2D_fixed, size " + hnc::to_string(nb_row) + " x " + hnc::to_string(nb_col) + " instead of " + hnc::to_string(nb_row_fixed) + " x " + hnc::to_string(nb_col_fixed)));
+			#else
+				static_cast<void>(nb_row);
+				static_cast<void>(nb_col);
+			#endif
+			fill(default_value);
+		}
+
+		/// @brief Constructor with all values in row-major order (constexpr)
+		/// @param[in] values nb_row_fixed * nb_col_fixed values after the tag hnc::row_major_values
+		template <class... U, class = typename std::enable_if<sizeof...(U) == nb_row_fixed * nb_col_fixed>::type>
+		constexpr vector2D_fixed(hnc::row_major_values_t const, U const & ... values) : m_data{ T(values)... } { }
+
+		/**
+		 * @brief Constructor with initializer list of initializer list
+		 *
+		 * @param[in] values Values in { {10, 11, 12}, {20, 21, 22} }
+		 *
+		 * @warning The missing values are T() and the values out of the fixed sizes are ignored
+		 */
+		vector2D_fixed(std::initializer_list<std::initializer_list<T>> const & values) :
+			m_data()
+		{
+			std::size_t row = 0;
+			for (std::initializer_list<T> const & rows : values)
+			{
+				if (row == nb_row_fixed) { break; }
+				std::copy(rows.begin(), rows.begin() + std::min(rows.size(), nb_col_fixed), m_data + row * nb_col_fixed);
+				++row;
+			}
+		}
+
+		/// @brief Constructor with a copy of the values of a view (a block of a hnc::vector2D, ...)
+		/// @param[in] v A hnc::vector2D_view with nb_row_fixed rows and nb_col_fixed columns
+		/// @exception std::invalid_argument hnc::hassert the view has the fixed sizes if NDEBUG is not defined
+		template <class U>
+		explicit vector2D_fixed(hnc::vector2D_view<U> const & v) :
+			m_data()
+		{
+			view().assign(v);
+		}
+
+		/**
+		 * @brief Constructor with an element-wise expression (see hnc::vector2D_expression)
+		 *
+		 * @param[in] e An expression with nb_row_fixed rows and nb_col_fixed columns
+		 *
+		 * @exception std::invalid_argument hnc::hassert the expression has the fixed sizes if NDEBUG is not defined
+		 */
+		template <class E>
+		vector2D_fixed(hnc::vector2D_expression<E> const & e) :
+			m_data()
+		{
+			assign_expression(e.derived());
+		}
+
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		static constexpr std::size_t nb_row() { return nb_row_fixed; }
+
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		static constexpr std::size_t size() { return nb_row_fixed; }
+
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		static constexpr std::size_t nb_col() { return nb_col_fixed; }
+
+		/// @brief Return the distance between two rows (the number of columns, there is no padding)
+		/// @return the distance between two rows
+		static constexpr std::size_t row_stride() { return nb_col_fixed; }
+
+		/// @brief Return the index of (i, j) in data()
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @return i * nb_col() + j
+		static constexpr std::size_t index(std::size_t const i, std::size_t const j) { return i * nb_col_fixed + j; }
+
+		/// @brief Return a const pointer to the data (row-major, the row i starts at data() + i * row_stride())
+		/// @return a const pointer to the data
+		T const * data() const { return m_data; }
+
+		/// @brief Return a pointer to the data (row-major, the row i starts at data() + i * row_stride())
+		/// @return a pointer to the data
+		T * data() { return m_data; }
+
+		// Expression (see hnc::vector2D_expression)
+
+		/// Type of the values
+		using value_type = T;
+
+		/// Type used to keep the vector2D_fixed in an expression (a reference)
+		using expression_stored_t = vector2D_fixed const &;
+
+		/// Row of the vector2D_fixed in an expression
+		using expression_row_t = T const *;
+
+		/// @brief Return a row for an expression
+		/// @param[in] i Row index
+		/// @return a pointer to the first value of the row i
+		expression_row_t expression_row(std::size_t const i) const { return m_data + i * nb_col_fixed; }
+
+		/// @brief Assignment of an element-wise expression
+		/// @param[in] e An expression with nb_row_fixed rows and nb_col_fixed columns
+		/// @exception std::invalid_argument hnc::hassert the expression has the fixed sizes if NDEBUG is not defined
+		/// @return the vector2D_fixed
+		template <class E>
+		vector2D_fixed & operator =(hnc::vector2D_expression<E> const & e)
+		{
+			assign_expression(e.derived());
+			return *this;
+		}
+
+		/// @brief Element-wise addition of an expression or a matrix
+		/// @param[in] e An expression (see hnc::vector2D_expression) with the same size
+		/// @return the vector2D_fixed
+		template <class E>
+		vector2D_fixed & operator +=(hnc::vector2D_expression<E> const & e)
+		{
+			assign_expression(*this + e);
+			return *this;
+		}
+
+		/// @brief Element-wise subtraction of an expression or a matrix
+		/// @param[in] e An expression (see hnc::vector2D_expression) with the same size
+		/// @return the vector2D_fixed
+		template <class E>
+		vector2D_fixed & operator -=(hnc::vector2D_expression<E> const & e)
+		{
+			assign_expression(*this - e);
+			return *this;
+		}
+
+		/// @brief Multiply all values by a scalar
+		/// @param[in] scalar A scalar
+		/// @return the vector2D_fixed
+		vector2D_fixed & operator *=(T const & scalar)
+		{
+			for (T & value : m_data) { value *= scalar; }
+			return *this;
+		}
+
+		/// @brief Divide all values by a scalar
+		/// @param[in] scalar A scalar
+		/// @return the vector2D_fixed
+		vector2D_fixed & operator /=(T const & scalar)
+		{
+			for (T & value : m_data) { value /= scalar; }
+			return *this;
+		}
+
+		// Access
+
+		/// @brief Const access by fonctor (constexpr)
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @exception std::out_of_range if out of range access and NDEBUG is not defined
+		/// @return the value at (i, j)
+		constexpr T const & operator ()(std::size_t const i, std::size_t const j) const
+		{
+			#ifndef NDEBUG
+				return m_data[checked_index(i, j)];
+			#else
+				return m_data[index(i, j)];
+			#endif
+		}
+
+		/// @brief Access by fonctor
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @exception std::out_of_range if out of range access and NDEBUG is not defined
+		/// @return the value at (i, j)
+		T & operator ()(std::size_t const i, std::size_t const j)
+		{
+			#ifndef NDEBUG
+				return m_data[checked_index(i, j)];
+			#else
+				return m_data[index(i, j)];
+			#endif
+		}
+
+		/// @brief Safe const acces (constexpr)
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at (i, j)
+		constexpr T const & at(std::size_t const i, std::size_t const j) const { return m_data[checked_index(i, j)]; }
+
+		/// @brief Safe acces
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at (i, j)
+		T & at(std::size_t const i, std::size_t const j) { return m_data[checked_index(i, j)]; }
+
+		/// @brief Const access by [i][j]
+		/// @param[in] i Row index
+		/// @return a proxy to have [j]
+		line_const_ptr<T> operator [](std::size_t const i) const { return line_const_ptr<T>(m_data + i * nb_col_fixed, nb_col_fixed); }
+
+		/// @brief Acces by [i][j]
+		/// @param[in] i Row index
+		/// @return a proxy to have [j]
+		line_ptr<T> operator [](std::size_t const i) { return line_ptr<T>(m_data + i * nb_col_fixed, nb_col_fixed); }
+
+		/// @brief Const access to the first line
+		/// @return a proxy to have the first line
+		line_const_ptr<T> front() const { return (*this)[0]; }
+
+		/// @brief Access to the first line
+		/// @return a proxy to have the first line
+		line_ptr<T> front() { return (*this)[0]; }
+
+		/// @brief Const access to the last line
+		/// @return a proxy to have the last line
+		line_const_ptr<T> back() const { return (*this)[nb_row_fixed - 1]; }
+
+		/// @brief Access to the last line
+		/// @return a proxy to have the last line
+		line_ptr<T> back() { return (*this)[nb_row_fixed - 1]; }
+
+		// Iterator
+
+		/// @brief Return a iterator to the beginning
+		/// @return a iterator to the beginning
+		iterator begin() { return iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, 0); }
+
+		/// @brief Return a iterator to the end
+		/// @return a iterator to the end
+		iterator end() { return iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, nb_row_fixed); }
+
+		/// @brief Return a const iterator to the beginning
+		/// @return a const iterator to the beginning
+		const_iterator begin() const { return const_iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, 0); }
+
+		/// @brief Return a const iterator to the end
+		/// @return a const iterator to the end
+		const_iterator end() const { return const_iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, nb_row_fixed); }
+
+		/// @brief Return a const iterator to the beginning
+		/// @return a const iterator to the beginning
+		const_iterator cbegin() const { return begin(); }
+
+		/// @brief Return a const iterator to the end
+		/// @return a const iterator to the end
+		const_iterator cend() const { return end(); }
+
+		/// @brief Return a reverse iterator to the reverse beginning
+		/// @return a reverse iterator to the reverse beginning
+		reverse_iterator rbegin() { return reverse_iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, nb_row_fixed - 1); }
+
+		/// @brief Return a reverse iterator to the reverse end
+		/// @return a reverse iterator to the reverse end
+		reverse_iterator rend() { return reverse_iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, nb_row_fixed); }
+
+		/// @brief Return a const reverse iterator to the reverse beginning
+		/// @return a const reverse iterator to the reverse beginning
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, nb_row_fixed - 1); }
+
+		/// @brief Return a const reverse iterator to the reverse end
+		/// @return a const reverse iterator to the reverse end
+		const_reverse_iterator rend() const { return const_reverse_iterator(m_data, nb_row_fixed, nb_col_fixed, nb_col_fixed, nb_row_fixed); }
+
+		/// @brief Return a const reverse iterator to the reverse beginning
+		/// @return a const reverse iterator to the reverse beginning
+		const_reverse_iterator crbegin() const { return rbegin(); }
+
+		/// @brief Return a const reverse iterator to the reverse end
+		/// @return a const reverse iterator to the reverse end
+		const_reverse_iterator crend() const { return rend(); }
+
+		// Operator
+
+		/// @brief Equality operator
+		/// @param[in] v A hnc::vector2D_fixed with the same size
+		/// @return true if the values are equal, false otherwise
+		bool operator ==(vector2D_fixed const & v) const { return std::equal(m_data, m_data + nb_row_fixed * nb_col_fixed, v.m_data); }
+
+		/// @brief Inequality operator
+		/// @param[in] v A hnc::vector2D_fixed with the same size
+		/// @return true if the values are not equal, false otherwise
+		bool operator !=(vector2D_fixed const & v) const { return ! (*this == v); }
+
+		// Views
+
+		/// @brief Return a const view on the vector2D_fixed (see hnc::vector2D_view)
+		/// @return a const view on the vector2D_fixed
+		hnc::vector2D_view<T const> view() const { return hnc::vector2D_view<T const>(m_data, nb_row_fixed, nb_col_fixed); }
+
+		/// @brief Return a view on the vector2D_fixed (see hnc::vector2D_view)
+		/// @return a view on the vector2D_fixed
+		hnc::vector2D_view<T> view() { return hnc::vector2D_view<T>(m_data, nb_row_fixed, nb_col_fixed); }
+
+		/// @brief Return a const view on a block (O(1), without copy)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::out_of_range hnc::hassert the block is in the vector2D_fixed if NDEBUG is not defined
+		/// @return a const view on the rows [i, i + nb_row) and the columns [j, j + nb_col)
+		hnc::vector2D_view<T const> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col) const
+		{ return view().sub_view(i, j, nb_row, nb_col); }
+
+		/// @brief Return a view on a block (O(1), without copy)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::out_of_range hnc::hassert the block is in the vector2D_fixed if NDEBUG is not defined
+		/// @return a view on the rows [i, i + nb_row) and the columns [j, j + nb_col)
+		hnc::vector2D_view<T> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col)
+		{ return view().sub_view(i, j, nb_row, nb_col); }
+
+		/// @brief Return a const transposed view (O(1), without copy)
+		/// @return a const view, the value (i, j) of the view is the value (j, i) of the vector2D_fixed
+		hnc::vector2D_view<T const> transposed_view() const { return view().transposed(); }
+
+		/// @brief Return a transposed view (O(1), without copy)
+		/// @return a view, the value (i, j) of the view is the value (j, i) of the vector2D_fixed
+		hnc::vector2D_view<T> transposed_view() { return view().transposed(); }
+
+		/// @brief Return a const view on a column
+		/// @param[in] j Column index
+		/// @exception std::out_of_range hnc::hassert j < number of columns if NDEBUG is not defined
+		/// @return a const view on the column j
+		hnc::vector2D_line_view<T const> col(std::size_t const j) const { return view().col(j); }
+
+		/// @brief Return a view on a column
+		/// @param[in] j Column index
+		/// @exception std::out_of_range hnc::hassert j < number of columns if NDEBUG is not defined
+		/// @return a view on the column j
+		hnc::vector2D_line_view<T> col(std::size_t const j) { return view().col(j); }
+
+		// Operations (the loops have a size known at compile time)
+
+		/// @brief Assign a value to all values
+		/// @param[in] value A value
+		void fill(T const & value) { std::fill(m_data, m_data + nb_row_fixed * nb_col_fixed, value); }
+
+		/// @brief *this = alpha * x + *this
+		/// @param[in] alpha Scalar
+		/// @param[in] x     A hnc::vector2D_fixed with the same size
+		void axpy(T const alpha, vector2D_fixed const & x)
+		{
+			for (std::size_t k = 0; k < nb_row_fixed * nb_col_fixed; ++k) { m_data[k] += alpha * x.m_data[k]; }
+		}
+
+		/// @brief Return the sum of the values
+		/// @return the sum of the values
+		T sum() const
+		{
+			T r = T();
+			for (T const & value : m_data) { r += value; }
+			return r;
+		}
+
+		/// @brief Return the minimum of the values
+		/// @return the minimum of the values
+		T min() const { return *std::min_element(m_data, m_data + nb_row_fixed * nb_col_fixed); }
+
+		/// @brief Return the maximum of the values
+		/// @return the maximum of the values
+		T max() const { return *std::max_element(m_data, m_data + nb_row_fixed * nb_col_fixed); }
+
+		/// @brief Return the Frobenius inner product (sum of the element-wise products) with a hnc::vector2D_fixed
+		/// @param[in] v A hnc::vector2D_fixed with the same size
+		/// @return the sum of the products of the values
+		T dot(vector2D_fixed const & v) const
+		{
+			T r = T();
+			for (std::size_t k = 0; k < nb_row_fixed * nb_col_fixed; ++k) { r += m_data[k] * v.m_data[k]; }
+			return r;
+		}
+
+	private:
+
+		/// @brief Return the index of (i, j) in data() after a range check (constexpr)
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @exception std::out_of_range if out of range access
+		/// @return i * nb_col() + j
+		static constexpr std::size_t checked_index(std::size_t const i, std::size_t const j)
+		{
+			return (i < nb_row_fixed && j < nb_col_fixed) ?
+				index(i, j) :
+				throw std::out_of_range("hnc::vector2D_fixed, (" + hnc::to_string(i) + ", " + hnc::to_string(j) + ") is out of a " + hnc::to_string(nb_row_fixed) + " x " + hnc::to_string(nb_col_fixed) + " matrix");
+		}
+
+		/// @brief Compute an expression in the vector2D_fixed, row by row
+		/// @param[in] e An expression with the same size
+		/// @exception std::invalid_argument hnc::hassert the expression has the same size if NDEBUG is not defined
+		template <class E>
+		void assign_expression(E const & e)
+		{
+			#ifndef NDEBUG
+				hnc::hassert(e.nb_row() == nb_row_fixed && e.nb_col() == nb_col_fixed, std::invalid_argument("hnc::vector2D_fixed, the expression is a " + hnc::to_string(e.nb_row()) + "x" + hnc::to_string(e.nb_col()) + " matrix instead of " + hnc::to_string(nb_row_fixed) + "x" + hnc::to_string(nb_col_fixed)));
+			#endif
+			for (std::size_t row = 0; row < nb_row_fixed; ++row)
+			{
+				typename E::expression_row_t const e_row = e.expression_row(row);
+				T * const p = m_data + row * nb_col_fixed;
+				for (std::size_t col = 0; col < nb_col_fixed; ++col) { p[col] = e_row[col]; }
+			}
+		}
+	};
+
+	/// @brief Operator << between a std::ostream and a hnc::vector2D_fixed
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector2D_fixed
+	/// @return the output stream
+	template <class T, std::size_t nb_row_fixed, std::size_t nb_col_fixed>
+	std::ostream & operator <<(std::ostream & o, hnc::vector2D_fixed<T, nb_row_fixed, nb_col_fixed> const & v)
+	{
+		return o << v.view();
+	}
+}
+
+#endif
@@ -0,0 +1,782 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR2D_MMAP_HPP
+#define HNC_VECTOR2D_MMAP_HPP
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "vector2D.hpp"
+#include "vector2D_view.hpp"
+#include "vector2D_expression.hpp"
+#include "except.hpp"
+#include "assert.hpp"
+#include "to_string.hpp"
+#include "unused.hpp"
+
+#ifdef hnc_unix
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/types.h>
+#endif
+
+
+namespace hnc
+{
+	/**
+	 * @brief 2D container (like hnc::vector2D) stored in a memory-mapped file (for matrices larger than the memory)
+	 *
+	 * @code
+	   #include <hnc/vector2D_mmap.hpp>
+	   @endcode
+	 *
+	 * The file has a header of 64 bytes (see hnc::vector2D_mmap::header_t) followed by the values (row-major): @n
+	 * magic "hnc2Dmm", version, byte order, number of rows, number of columns, size and type of the values @n
+	 * Reopening a file maps it, the values are loaded on demand by the operating system (no parsing, no copy)
+	 *
+	 * The API is the API of hnc::vector2D (operator(), at, operator[], iterators on rows, views, element-wise expressions, fill, axpy, sum, min, max, dot)
+	 * but the size can not change
+	 *
+	 * @code
+	   // Create a file with a 100000 x 10000 matrix of double
+	   {
+	   	hnc::vector2D_mmap<double> m("grid.hnc2D", 100000, 10000, 0., hnc::vector2D_mmap<double>::advice_t::sequential);
+	   	for (auto line : m) { line.fill(1.); }
+	   	m.flush();
+	   }
+	   // Reopen it (instant)
+	   hnc::vector2D_mmap<double> const m("grid.hnc2D", hnc::vector2D_mmap<double>::mode_t::read_only, hnc::vector2D_mmap<double>::advice_t::random);
+	   std::cout << m(42, 42) << std::endl;
+	   @endcode
+	 *
+	 * @note Available on Unix only (hnc::except::incomplete_implementation is thrown otherwise)
+	 *
+	 * @tparam T Type of the values (trivially copyable)
+	 */
+	template <class T>
+	class vector2D_mmap : public hnc::vector2D_expression<vector2D_mmap<T>>
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "hnc::vector2D_mmap, the values must be trivially copyable");
+
+	public:
+
+		/// Const iterator on a row
+		template <class U>
+		using line_const_ptr = typename hnc::vector2D<T>::template line_const_ptr<U>;
+
+		/// Iterator on a row
+		template <class U>
+		using line_ptr = typename hnc::vector2D<T>::template line_ptr<U>;
+
+		/// Iterator on rows
+		using iterator = typename hnc::vector2D<T>::iterator;
+
+		/// Const iterator on rows
+		using const_iterator = typename hnc::vector2D<T>::const_iterator;
+
+		/// Reverse iterator on rows
+		using reverse_iterator = typename hnc::vector2D<T>::reverse_iterator;
+
+		/// Const reverse iterator on rows
+		using const_reverse_iterator = typename hnc::vector2D<T>::const_reverse_iterator;
+
+		/// Access mode of the file
+		enum class mode_t
+		{
+			/// Read and write the values (the modifications are written in the file)
+			read_write,
+			/// Read the values only (fill, axpy and the assignment throw, the non-const access hnc::hassert if NDEBUG is not defined, use a const hnc::vector2D_mmap)
+			read_only
+		};
+
+		/// Access pattern given to the operating system (madvise)
+		enum class advice_t
+		{
+			/// No advice
+			normal,
+			/// Sequential access (aggressive read-ahead, pages can be freed after access)
+			sequential,
+			/// Random access (no read-ahead)
+			random,
+			/// The values will be accessed soon (read-ahead of the whole file)
+			will_need
+		};
+
+		/// Header of the file (64 bytes, the values are aligned on 64 bytes in the mapping)
+		struct header_t
+		{
+			/// "hnc2Dmm"
+			char magic[8];
+			/// Version of the format
+			std::uint32_t version;
+			/// 0x01020304 written with the byte order of the machine
+			std::uint32_t byte_order;
+			/// Number of rows
+			std::uint64_t nb_row;
+			/// Number of columns
+			std::uint64_t nb_col;
+			/// sizeof(T)
+			std::uint32_t value_size;
+			/// Type of the values (see hnc::vector2D_mmap::value_type_id)
+			std::uint32_t value_type;
+			/// Reserved
+			char padding[24];
+		};
+
+		static_assert(sizeof(header_t) == 64, "hnc::vector2D_mmap::header_t, the header must have 64 bytes");
+
+	private:
+
+		/// Filename
+		std::string m_filename;
+
+		/// Mapping (header and values)
+		void * p_map;
+
+		/// Size of the mapping
+		std::size_t m_map_size;
+
+		/// Values
+		T * p_data;
+
+		/// Number of rows
+		std::size_t m_nb_row;
+
+		/// Number of columns
+		std::size_t m_nb_col;
+
+		/// Access mode
+		mode_t m_mode;
+
+	public:
+
+		/**
+		 * @brief Constructor, create (or overwrite) a file with a nb_row x nb_col matrix
+		 *
+		 * The file is extended with zeros, the values are written only if default_value is not zero
+		 *
+		 * @param[in] filename      Filename
+		 * @param[in] nb_row        Number of rows
+		 * @param[in] nb_col        Number of columns
+		 * @param[in] default_value Default value
+		 * @param[in] advice        Access pattern (see hnc::vector2D_mmap::advice_t)
+		 *
+		 * @exception std::runtime_error if the file can not be created or mapped
+		 */
+		vector2D_mmap
+		(
+			std::string const & filename,
+			std::size_t const nb_row,
+			std::size_t const nb_col,
+			T const & default_value = T(),
+			advice_t const advice = advice_t::normal
+		) :
+			m_filename(filename),
+			p_map(nullptr),
+			m_map_size(0),
+			p_data(nullptr),
+			m_nb_row(nb_row),
+			m_nb_col(nb_col),
+			m_mode(mode_t::read_write)
+		{
+			if (nb_col != 0 && nb_row > (std::numeric_limits<std::size_t>::max() - sizeof(header_t)) / sizeof(T) / nb_col)
+			{
+				throw std::runtime_error("hnc::vector2D_mmap, the matrix " + hnc::to_string(nb_row) + "x" + hnc::to_string(nb_col) + " is too large");
+			}
+			m_map_size = sizeof(header_t) + nb_row * nb_col * sizeof(T);
+
+			#ifdef hnc_unix
+				int const fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+				if (fd == -1) { throw std::runtime_error("hnc::vector2D_mmap, can not create \"" + filename + "\": " + std::strerror(errno)); }
+				if (::ftruncate(fd, off_t(m_map_size)) == -1)
+				{
+					int const error = errno;
+					::close(fd);
+					throw std::runtime_error("hnc::vector2D_mmap, can not resize \"" + filename + "\": " + std::strerror(error));
+				}
+				map(fd, mode_t::read_write);
+			#else
+				throw hnc::except::incomplete_implementation("hnc::vector2D_mmap is available on Unix only");
+			#endif
+
+			// Header
+			header_t header;
+			std::memset(&header, 0, sizeof(header_t));
+			std::memcpy(header.magic, "hnc2Dmm", 8);
+			header.version = 1;
+			header.byte_order = 0x01020304;
+			header.nb_row = nb_row;
+			header.nb_col = nb_col;
+			header.value_size = sizeof(T);
+			header.value_type = value_type_id();
+			std::memcpy(p_map, &header, sizeof(header_t));
+
+			// Values (the file is already filled with zeros)
+			unsigned char const zero[sizeof(T)] = { };
+			if (std::memcmp(&default_value, zero, sizeof(T)) != 0) { fill(default_value); }
+
+			advise(advice);
+		}
+
+		/**
+		 * @brief Constructor, create (or overwrite) a file with the values of a view (of a hnc::vector2D for example)
+		 *
+		 * @param[in] filename Filename
+		 * @param[in] v        A view (see hnc::vector2D::view)
+		 * @param[in] advice   Access pattern (see hnc::vector2D_mmap::advice_t)
+		 *
+		 * @exception std::runtime_error if the file can not be created or mapped
+		 */
+		template <class U>
+		vector2D_mmap(std::string const & filename, hnc::vector2D_view<U> const & v, advice_t const advice = advice_t::normal) :
+			vector2D_mmap(filename, v.nb_row(), v.nb_col(), T(), advice)
+		{
+			view().assign(v);
+		}
+
+		/**
+		 * @brief Constructor, open a file created by hnc::vector2D_mmap
+		 *
+		 * @param[in] filename Filename
+		 * @param[in] mode     Access mode (see hnc::vector2D_mmap::mode_t)
+		 * @param[in] advice   Access pattern (see hnc::vector2D_mmap::advice_t)
+		 *
+		 * @exception hnc::except::file_not_found if the file can not be opened
+		 * @exception std::runtime_error if the file is not a hnc::vector2D_mmap file of T (with the byte order of the machine) or can not be mapped
+		 */
+		explicit vector2D_mmap(std::string const & filename, mode_t const mode = mode_t::read_write, advice_t const advice = advice_t::normal) :
+			m_filename(filename),
+			p_map(nullptr),
+			m_map_size(0),
+			p_data(nullptr),
+			m_nb_row(0),
+			m_nb_col(0),
+			m_mode(mode)
+		{
+			#ifdef hnc_unix
+				int const fd = ::open(filename.c_str(), (mode == mode_t::read_only) ? O_RDONLY : O_RDWR);
+				if (fd == -1) { throw hnc::except::file_not_found("hnc::vector2D_mmap, can not open \"" + filename + "\": " + std::strerror(errno)); }
+				struct stat file_stat;
+				if (::fstat(fd, &file_stat) == -1 || std::size_t(file_stat.st_size) < sizeof(header_t))
+				{
+					::close(fd);
+					throw std::runtime_error("hnc::vector2D_mmap, \"" + filename + "\" is not a hnc::vector2D_mmap file (no header)");
+				}
+				m_map_size = std::size_t(file_stat.st_size);
+				map(fd, mode);
+			#else
+				hnc_unused(mode);
+				throw hnc::except::incomplete_implementation("hnc::vector2D_mmap is available on Unix only");
+			#endif
+
+			// Check the header
+			header_t header;
+			std::memcpy(&header, p_map, sizeof(header_t));
+			std::string error;
+			if (std::memcmp(header.magic, "hnc2Dmm", 8) != 0) { error = "is not a hnc::vector2D_mmap file"; }
+			else if (header.version != 1) { error = "has an unknown version " + hnc::to_string(header.version); }
+			else if (header.byte_order != 0x01020304) { error = "has a different byte order"; }
+			else if (header.value_size != sizeof(T) || header.value_type != value_type_id()) { error = "has values of an other type"; }
+			else if (header.nb_col != 0 && header.nb_row > (m_map_size - sizeof(header_t)) / sizeof(T) / header.nb_col) { error = "is truncated"; }
+			if (error.empty() == false)
+			{
+				unmap();
+				throw std::runtime_error("hnc::vector2D_mmap, \"" + filename + "\" " + error);
+			}
+			m_nb_row = std::size_t(header.nb_row);
+			m_nb_col = std::size_t(header.nb_col);
+
+			advise(advice);
+		}
+
+		/// @brief Copy constructor (deleted, the file is the data)
+		vector2D_mmap(vector2D_mmap const &) = delete;
+
+		/// @brief Copy assignment operator (deleted, the file is the data)
+		vector2D_mmap & operator =(vector2D_mmap const &) = delete;
+
+		/// @brief Move constructor
+		/// @param[in] v A hnc::vector2D_mmap
+		vector2D_mmap(vector2D_mmap && v) noexcept :
+			m_filename(std::move(v.m_filename)),
+			p_map(v.p_map),
+			m_map_size(v.m_map_size),
+			p_data(v.p_data),
+			m_nb_row(v.m_nb_row),
+			m_nb_col(v.m_nb_col),
+			m_mode(v.m_mode)
+		{
+			v.p_map = nullptr;
+			v.m_map_size = 0;
+			v.p_data = nullptr;
+			v.m_nb_row = 0;
+			v.m_nb_col = 0;
+		}
+
+		/// @brief Move assignment operator
+		/// @param[in] v A hnc::vector2D_mmap
+		/// @return the hnc::vector2D_mmap
+		vector2D_mmap & operator =(vector2D_mmap && v) noexcept
+		{
+			if (this != &v)
+			{
+				unmap();
+				m_filename = std::move(v.m_filename);
+				p_map = v.p_map;
+				m_map_size = v.m_map_size;
+				p_data = v.p_data;
+				m_nb_row = v.m_nb_row;
+				m_nb_col = v.m_nb_col;
+				m_mode = v.m_mode;
+				v.p_map = nullptr;
+				v.m_map_size = 0;
+				v.p_data = nullptr;
+				v.m_nb_row = 0;
+				v.m_nb_col = 0;
+			}
+			return *this;
+		}
+
+		/// @brief Assignment of an element-wise expression with the same size (computed in one loop, without temporary matrix)
+		/// @param[in] e An expression (see hnc::vector2D_expression)
+		/// @exception std::invalid_argument hnc::hassert the expression has the same size if NDEBUG is not defined
+		/// @exception std::logic_error if the file is mapped read only
+		/// @return the hnc::vector2D_mmap
+		template <class E>
+		vector2D_mmap & operator =(hnc::vector2D_expression<E> const & e)
+		{
+			check_writable("hnc::vector2D_mmap::operator =");
+			E const & expression = e.derived();
+			#ifndef NDEBUG
+				hnc::hassert(expression.nb_row() == m_nb_row && expression.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D_mmap, the expression is a " + hnc::to_string(expression.nb_row()) + "x" + hnc::to_string(expression.nb_col()) + " matrix instead of " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col)));
+			#endif
+			for (std::size_t row = 0; row < m_nb_row; ++row)
+			{
+				typename E::expression_row_t const e_row = expression.expression_row(row);
+				T * const p = p_data + row * m_nb_col;
+				#pragma omp simd
+				for (std::size_t col = 0; col < m_nb_col; ++col) { p[col] = e_row[col]; }
+			}
+			return *this;
+		}
+
+		/// @brief Destructor, unmap the file (the modifications are written by the operating system, see flush)
+		~vector2D_mmap() { unmap(); }
+
+		/// @brief Return the filename
+		/// @return the filename
+		std::string const & filename() const { return m_filename; }
+
+		/// @brief Return the access mode
+		/// @return the access mode (see hnc::vector2D_mmap::mode_t)
+		mode_t mode() const { return m_mode; }
+
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		std::size_t nb_row() const { return m_nb_row; }
+
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		std::size_t nb_col() const { return m_nb_col; }
+
+		/// @brief Return the distance between two rows (the number of columns)
+		/// @return the distance between two rows
+		std::size_t row_stride() const { return m_nb_col; }
+
+		/// @brief Return the number of values
+		/// @return the number of values
+		std::size_t size() const { return m_nb_row * m_nb_col; }
+
+		/// @brief Return true if there is no value
+		/// @return true if there is no value, false otherwise
+		bool empty() const { return size() == 0; }
+
+		/// @brief Return a const pointer to the values (row-major)
+		/// @return a const pointer to the values
+		T const * data() const { return p_data; }
+
+		/// @brief Return a pointer to the values (row-major)
+		/// @exception std::logic_error hnc::hassert the file is not mapped read only if NDEBUG is not defined
+		/// @return a pointer to the values
+		T * data()
+		{
+			assert_writable("hnc::vector2D_mmap::data");
+			return p_data;
+		}
+
+		// Expression (see hnc::vector2D_expression)
+
+		/// Type of the values
+		using value_type = T;
+
+		/// Type used to keep the hnc::vector2D_mmap in an expression (a reference)
+		using expression_stored_t = vector2D_mmap const &;
+
+		/// Row of the hnc::vector2D_mmap in an expression
+		using expression_row_t = T const *;
+
+		/// @brief Return a row for an expression
+		/// @param[in] i Row index
+		/// @return a pointer to the first value of the row i
+		expression_row_t expression_row(std::size_t const i) const { return p_data + i * m_nb_col; }
+
+		// File
+
+		/**
+		 * @brief Write the modifications in the file (msync)
+		 * @param[in] wait Wait the end of the writing (MS_SYNC) or schedule it (MS_ASYNC)
+		 * @exception std::runtime_error if msync fails
+		 */
+		void flush(bool const wait = true)
+		{
+			#ifdef hnc_unix
+				if (p_map != nullptr && ::msync(p_map, m_map_size, wait ? MS_SYNC : MS_ASYNC) == -1)
+				{
+					throw std::runtime_error("hnc::vector2D_mmap::flush, msync of \"" + m_filename + "\" fails: " + std::strerror(errno));
+				}
+			#else
+				hnc_unused(wait);
+			#endif
+		}
+
+		/// @brief Give the access pattern to the operating system (madvise, the advice is ignored if it is not supported)
+		/// @param[in] advice Access pattern (see hnc::vector2D_mmap::advice_t)
+		void advise(advice_t const advice) const
+		{
+			#ifdef hnc_unix
+				if (p_map == nullptr) { return; }
+				int flag = MADV_NORMAL;
+				switch (advice)
+				{
+					case advice_t::normal:     flag = MADV_NORMAL; break;
+					case advice_t::sequential: flag = MADV_SEQUENTIAL; break;
+					case advice_t::random:     flag = MADV_RANDOM; break;
+					case advice_t::will_need:  flag = MADV_WILLNEED; break;
+				}
+				::madvise(p_map, m_map_size, flag);
+			#else
+				hnc_unused(advice);
+			#endif
+		}
+
+		// Access
+
+		/// @brief Const acces by fonctor
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T const & operator()(std::size_t const i, std::size_t const j) const { return p_data[index2D::index1D(i, j, m_nb_col)]; }
+
+		/// @brief Acces by fonctor
+		/// @param i Row index
+		/// @param j Column index
+		/// @exception std::logic_error hnc::hassert the file is not mapped read only if NDEBUG is not defined
+		/// @return the value at (i, j)
+		T & operator()(std::size_t const i, std::size_t const j)
+		{
+			assert_writable("hnc::vector2D_mmap::operator()");
+			return p_data[index2D::index1D(i, j, m_nb_col)];
+		}
+
+		/// @brief Safe const acces
+		/// @param i Row index
+		/// @param j Column index
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at .at(i, j)
+		T const & at(std::size_t const i, std::size_t const j) const
+		{
+			check_range(i, j);
+			return (*this)(i, j);
+		}
+
+		/// @brief Safe acces
+		/// @param i Row index
+		/// @param j Column index
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at .at(i, j)
+		T & at(std::size_t const i, std::size_t const j)
+		{
+			check_range(i, j);
+			return (*this)(i, j);
+		}
+
+		/// @brief Const access by [i][j]
+		/// @param i Row index
+		/// @return a proxy to have [j]
+		line_const_ptr<T> operator[](std::size_t const i) const { return line_const_ptr<T>(p_data + i * m_nb_col, m_nb_col); }
+
+		/// @brief Acces by [i][j]
+		/// @param i Row index
+		/// @exception std::logic_error hnc::hassert the file is not mapped read only if NDEBUG is not defined
+		/// @return a proxy to have [j]
+		line_ptr<T> operator[](std::size_t const i)
+		{
+			assert_writable("hnc::vector2D_mmap::operator[]");
+			return line_ptr<T>(p_data + i * m_nb_col, m_nb_col);
+		}
+
+		/// @brief Const access to the first line
+		/// @pre hnc::vector2D_mmap has at least one line
+		/// @return a proxy to have the first line
+		line_const_ptr<T> front() const { return (*this)[0]; }
+
+		/// @brief Access to the first line
+		/// @pre hnc::vector2D_mmap has at least one line
+		/// @return a proxy to have the first line
+		line_ptr<T> front() { return (*this)[0]; }
+
+		/// @brief Const access to the last line
+		/// @pre hnc::vector2D_mmap has at least one line
+		/// @return a proxy to have the last line
+		line_const_ptr<T> back() const { return (*this)[m_nb_row - 1]; }
+
+		/// @brief Access to the last line
+		/// @pre hnc::vector2D_mmap has at least one line
+		/// @return a proxy to have the last line
+		line_ptr<T> back() { return (*this)[m_nb_row - 1]; }
+
+		// Iterators
+
+		/// @brief Return an iterator to the first row
+		/// @return an iterator to the first row
+		iterator begin()
+		{
+			assert_writable("hnc::vector2D_mmap::begin");
+			return iterator(p_data, m_nb_row, m_nb_col, m_nb_col, 0);
+		}
+
+		/// @brief Return an iterator to the end
+		/// @return an iterator to the end
+		iterator end()
+		{
+			assert_writable("hnc::vector2D_mmap::end");
+			return iterator(p_data, m_nb_row, m_nb_col, m_nb_col, m_nb_row);
+		}
+
+		/// @brief Return a const iterator to the first row
+		/// @return a const iterator to the first row
+		const_iterator begin() const { return const_iterator(p_data, m_nb_row, m_nb_col, m_nb_col, 0); }
+
+		/// @brief Return a const iterator to the end
+		/// @return a const iterator to the end
+		const_iterator end() const { return const_iterator(p_data, m_nb_row, m_nb_col, m_nb_col, m_nb_row); }
+
+		/// @brief Return a const iterator to the first row
+		/// @return a const iterator to the first row
+		const_iterator cbegin() const { return begin(); }
+
+		/// @brief Return a const iterator to the end
+		/// @return a const iterator to the end
+		const_iterator cend() const { return end(); }
+
+		/// @brief Return a reverse iterator to the last row
+		/// @return a reverse iterator to the last row
+		reverse_iterator rbegin()
+		{
+			assert_writable("hnc::vector2D_mmap::rbegin");
+			return reverse_iterator(p_data, m_nb_row, m_nb_col, m_nb_col, m_nb_row - 1);
+		}
+
+		/// @brief Return a reverse iterator to the reverse end
+		/// @return a reverse iterator to the reverse end
+		reverse_iterator rend()
+		{
+			assert_writable("hnc::vector2D_mmap::rend");
+			return reverse_iterator(p_data, m_nb_row, m_nb_col, m_nb_col, m_nb_row);
+		}
+
+		/// @brief Return a const reverse iterator to the last row
+		/// @return a const reverse iterator to the last row
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(p_data, m_nb_row, m_nb_col, m_nb_col, m_nb_row - 1); }
+
+		/// @brief Return a const reverse iterator to the reverse end
+		/// @return a const reverse iterator to the reverse end
+		const_reverse_iterator rend() const { return const_reverse_iterator(p_data, m_nb_row, m_nb_col, m_nb_col, m_nb_row); }
+
+		// Views
+
+		/// @brief Return a const view on the matrix
+		/// @return a const view on the matrix
+		hnc::vector2D_view<T const> view() const { return hnc::vector2D_view<T const>(p_data, m_nb_row, m_nb_col, m_nb_col); }
+
+		/// @brief Return a view on the matrix
+		/// @return a view on the matrix
+		hnc::vector2D_view<T> view()
+		{
+			assert_writable("hnc::vector2D_mmap::view");
+			return hnc::vector2D_view<T>(p_data, m_nb_row, m_nb_col, m_nb_col);
+		}
+
+		/// @brief Return a const view on the block [i, i + nb_row) x [j, j + nb_col)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows of the block
+		/// @param[in] nb_col Number of columns of the block
+		/// @return a const view on the block
+		hnc::vector2D_view<T const> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col) const { return view().sub_view(i, j, nb_row, nb_col); }
+
+		/// @brief Return a view on the block [i, i + nb_row) x [j, j + nb_col)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows of the block
+		/// @param[in] nb_col Number of columns of the block
+		/// @return a view on the block
+		hnc::vector2D_view<T> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col) { return view().sub_view(i, j, nb_row, nb_col); }
+
+		// Vectorized operations
+
+		/// @brief Assign a value to all values (vectorized)
+		/// @param[in] value A value
+		/// @exception std::logic_error if the file is mapped read only
+		void fill(T const & value)
+		{
+			check_writable("hnc::vector2D_mmap::fill");
+			hnc::vector2D_kernel::fill(p_data, size(), value);
+		}
+
+		/// @brief *this = alpha * x + *this (vectorized)
+		/// @param[in] alpha Scalar
+		/// @param[in] x     A matrix with the same size (hnc::vector2D, hnc::vector2D_mmap)
+		/// @exception std::invalid_argument hnc::hassert the matrices have the same size if NDEBUG is not defined
+		/// @exception std::logic_error if the file is mapped read only
+		template <class matrix_t>
+		void axpy(T const alpha, matrix_t const & x)
+		{
+			check_writable("hnc::vector2D_mmap::axpy");
+			#ifndef NDEBUG
+				hnc::hassert(x.nb_row() == m_nb_row && x.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D_mmap::axpy, x is a " + hnc::to_string(x.nb_row()) + "x" + hnc::to_string(x.nb_col()) + " matrix instead of " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col)));
+			#endif
+			for (std::size_t row = 0; row < m_nb_row; ++row) { hnc::vector2D_kernel::axpy(m_nb_col, alpha, x[row].data(), p_data + row * m_nb_col); }
+		}
+
+		/// @brief Return the sum of the values (vectorized)
+		/// @return the sum of the values
+		T sum() const { return hnc::vector2D_kernel::sum(p_data, size()); }
+
+		/// @brief Return the Frobenius inner product (sum of the element-wise products) with a matrix (vectorized)
+		/// @param[in] v A matrix with the same size (hnc::vector2D, hnc::vector2D_mmap)
+		/// @exception std::invalid_argument hnc::hassert the matrices have the same size if NDEBUG is not defined
+		/// @return the sum of the products of the values
+		template <class matrix_t>
+		T dot(matrix_t const & v) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(v.nb_row() == m_nb_row && v.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D_mmap::dot, v is a " + hnc::to_string(v.nb_row()) + "x" + hnc::to_string(v.nb_col()) + " matrix instead of " + hnc::to_string(m_nb_row) + "x" + hnc::to_string(m_nb_col)));
+			#endif
+			T r = T();
+			for (std::size_t row = 0; row < m_nb_row; ++row) { r += hnc::vector2D_kernel::dot(p_data + row * m_nb_col, v[row].data(), m_nb_col); }
+			return r;
+		}
+
+		/// @brief Return the minimum of the values (vectorized)
+		/// @pre The hnc::vector2D_mmap has at least one value
+		/// @return the minimum of the values
+		T min() const { return hnc::vector2D_kernel::min(p_data, size()); }
+
+		/// @brief Return the maximum of the values (vectorized)
+		/// @pre The hnc::vector2D_mmap has at least one value
+		/// @return the maximum of the values
+		T max() const { return hnc::vector2D_kernel::max(p_data, size()); }
+
+		/// @brief Return the type of the values stored in the header
+		/// @return 0 for an unknown type, otherwise 256 * kind + sizeof(T) with kind = 1 for signed integers, 2 for unsigned integers, 3 for floating point numbers
+		static std::uint32_t value_type_id()
+		{
+			std::uint32_t const kind =
+				(std::is_floating_point<T>::value) ? 3u :
+				(std::is_integral<T>::value && std::is_signed<T>::value) ? 1u :
+				(std::is_integral<T>::value) ? 2u : 0u;
+			return (kind == 0) ? 0u : std::uint32_t(256 * kind + sizeof(T));
+		}
+
+	private:
+
+		#ifdef hnc_unix
+			/// @brief Map the file and close the file descriptor
+			/// @param[in] fd   File descriptor
+			/// @param[in] mode Access mode
+			/// @exception std::runtime_error if mmap fails
+			void map(int const fd, mode_t const mode)
+			{
+				int const protection = (mode == mode_t::read_only) ? PROT_READ : (PROT_READ | PROT_WRITE);
+				void * const p = ::mmap(nullptr, m_map_size, protection, MAP_SHARED, fd, 0);
+				int const error = errno;
+				::close(fd);
+				if (p == MAP_FAILED) { throw std::runtime_error("hnc::vector2D_mmap, can not map \"" + m_filename + "\": " + std::strerror(error)); }
+				p_map = p;
+				p_data = reinterpret_cast<T *>(static_cast<char *>(p_map) + sizeof(header_t));
+			}
+		#endif
+
+		/// @brief Unmap the file
+		void unmap() noexcept
+		{
+			#ifdef hnc_unix
+				if (p_map != nullptr) { ::munmap(p_map, m_map_size); }
+			#endif
+			p_map = nullptr;
+			p_data = nullptr;
+		}
+
+		/// @brief Throw if the file is mapped read only
+		/// @param[in] function Name of the function for the message
+		/// @exception std::logic_error if the file is mapped read only
+		void check_writable(char const * const function) const
+		{
+			if (m_mode == mode_t::read_only)
+			{
+				throw std::logic_error(std::string(function) + ", \"" + m_filename + "\" is mapped read only (use a const hnc::vector2D_mmap to read the values)");
+			}
+		}
+
+		/// @brief Throw if the file is mapped read only and if NDEBUG is not defined (non-const access)
+		/// @param[in] function Name of the function for the message
+		/// @exception std::logic_error hnc::hassert the file is not mapped read only if NDEBUG is not defined
+		void assert_writable(char const * const function) const
+		{
+			#ifndef NDEBUG
+				check_writable(function);
+			#else
+				hnc_unused(function);
+			#endif
+		}
+
+		/// @brief Check if acces is out of range
+		/// @param i Row index
+		/// @param j Column index
+		void check_range(std::size_t const i, std::size_t const j) const
+		{
+			if (i >= m_nb_row)
+			{
+				throw std::out_of_range("hnc::vector2D_mmap, id row = " + hnc::to_string(i) + ", number of rows = " + hnc::to_string(m_nb_row));
+			}
+			if (j >= m_nb_col)
+			{
+				throw std::out_of_range("hnc::vector2D_mmap, id column = " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col));
+			}
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR2D_STORAGE_HPP
+#define HNC_VECTOR2D_STORAGE_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include "aligned_allocator.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Storage policies of hnc::vector2D (allocator and distance between two rows)
+	 *
+	 * @code
+	   #include <hnc/vector2D.hpp>
+	   @endcode
+	 *
+	 * - hnc::vector2D_storage::packed: std::allocator, rows are contiguous (default)
+	 * - hnc::vector2D_storage::aligned: 64-byte aligned data, rows are contiguous
+	 * - hnc::vector2D_storage::aligned_padded: 64-byte aligned data, each row is padded to a multiple of 64 bytes,
+	 * so each row starts on an aligned address (the loops on the rows use aligned vector loads)
+	 *
+	 * @code
+	   hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>> m(100, 100);
+	   // m.row_stride() == 112, m.data() + i * m.row_stride() is aligned on 64 bytes
+	   @endcode
+	 *
+	 * A storage policy has an allocator_type, an alignment and a static function row_stride(nb_col)
+	 */
+	namespace vector2D_storage
+	{
+		/// @brief Default storage of hnc::vector2D: std::allocator, rows are contiguous
+		template <class T>
+		class packed
+		{
+		public:
+
+			/// Allocator
+			using allocator_type = std::allocator<T>;
+
+			/// Alignment of the data in bytes
+			static constexpr std::size_t alignment = alignof(T);
+
+			/// @brief Return the distance between two rows
+			/// @param[in] nb_col Number of columns
+			/// @return nb_col
+			static std::size_t row_stride(std::size_t const nb_col) { return nb_col; }
+		};
+
+		/// @brief Storage of hnc::vector2D with aligned data (see hnc::aligned_allocator), rows are contiguous
+		template <class T, std::size_t alignment_in_bytes = 64>
+		class aligned
+		{
+		public:
+
+			/// Allocator
+			using allocator_type = hnc::aligned_allocator<T, alignment_in_bytes>;
+
+			/// Alignment of the data in bytes
+			static constexpr std::size_t alignment = alignment_in_bytes;
+
+			/// @brief Return the distance between two rows
+			/// @param[in] nb_col Number of columns
+			/// @return nb_col
+			static std::size_t row_stride(std::size_t const nb_col) { return nb_col; }
+		};
+
+		/// @brief Storage of hnc::vector2D with aligned data (see hnc::aligned_allocator), each row starts on an aligned address
+		template <class T, std::size_t alignment_in_bytes = 64>
+		class aligned_padded
+		{
+			static_assert(alignment_in_bytes % sizeof(T) == 0, "hnc::vector2D_storage::aligned_padded, the alignment must be a multiple of the size of the values");
+
+		public:
+
+			/// Allocator
+			using allocator_type = hnc::aligned_allocator<T, alignment_in_bytes>;
+
+			/// Alignment of the data (and of the rows) in bytes
+			static constexpr std::size_t alignment = alignment_in_bytes;
+
+			/// @brief Return the distance between two rows
+			/// @param[in] nb_col Number of columns
+			/// @return nb_col rounded up to a multiple of alignment / sizeof(T)
+			static std::size_t row_stride(std::size_t const nb_col)
+			{
+				std::size_t const nb_value = alignment_in_bytes / sizeof(T);
+				return (nb_col + nb_value - 1) / nb_value * nb_value;
+			}
+		};
+
+		// Definitions of the static members (C++11)
+
+		template <class T>
+		constexpr std::size_t packed<T>::alignment;
+
+		template <class T, std::size_t alignment_in_bytes>
+		constexpr std::size_t aligned<T, alignment_in_bytes>::alignment;
+
+		template <class T, std::size_t alignment_in_bytes>
+		constexpr std::size_t aligned_padded<T, alignment_in_bytes>::alignment;
+	}
+}
+
+#endif
@@ -0,0 +1,735 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR2D_VIEW_HPP
+#define HNC_VECTOR2D_VIEW_HPP
+
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
+#include <ostream>
+
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Non-owning view on strided values (a row, a column or a diagonal of a matrix)
+	 *
+	 * @code
+	   #include <hnc/vector2D_view.hpp>
+	   @endcode
+	 *
+	 * The view is a pointer, a number of values and a stride (distance between two consecutive values) @n
+	 * The view is shallow: a const view gives a mutable access to the values, use vector2D_line_view<T const> for a read-only view
+	 *
+	 * @code
+	   hnc::vector2D<double> m(100, 100);
+	   auto const column = m.view().col(42);
+	   double const sum = hnc::algo::sum(column);
+	   @endcode
+	 *
+	 * @tparam T Type of the values (T const for a read-only view)
+	 */
+	template <class T>
+	class vector2D_line_view
+	{
+	public:
+
+		/**
+		 * @brief Random access iterator on strided values
+		 *
+		 * @code
+		   #include <hnc/vector2D_view.hpp>
+		   @endcode
+		 */
+		class iterator_t : public std::iterator<std::random_access_iterator_tag, typename std::remove_const<T>::type, std::ptrdiff_t, T *, T &>
+		{
+		private:
+
+			/// First value
+			T * p_data;
+
+			/// Distance between two consecutive values
+			std::size_t m_stride;
+
+			/// Index
+			std::size_t m_i;
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] p      First value
+			/// @param[in] stride Distance between two consecutive values
+			/// @param[in] i      Index
+			iterator_t(T * const p = nullptr, std::size_t const stride = 1, std::size_t const i = 0) :
+				p_data(p), m_stride(stride), m_i(i)
+			{ }
+
+			/// @brief Go to the next value
+			/// @return the iterator
+			iterator_t & operator ++() { ++m_i; return *this; }
+
+			/// @brief Go to the next value
+			/// @return the iterator before the increment
+			iterator_t operator ++(int) { iterator_t copy = *this; ++m_i; return copy; }
+
+			/// @brief Go to the previous value
+			/// @return the iterator
+			iterator_t & operator --() { --m_i; return *this; }
+
+			/// @brief Go to the previous value
+			/// @return the iterator before the decrement
+			iterator_t operator --(int) { iterator_t copy = *this; --m_i; return copy; }
+
+			/// @brief Advance the iterator
+			/// @param[in] n Number of values
+			/// @return the iterator
+			iterator_t & operator +=(std::ptrdiff_t const n) { m_i = std::size_t(std::ptrdiff_t(m_i) + n); return *this; }
+
+			/// @brief Move back the iterator
+			/// @param[in] n Number of values
+			/// @return the iterator
+			iterator_t & operator -=(std::ptrdiff_t const n) { return (*this) += -n; }
+
+			/// @brief Return an advanced iterator
+			/// @param[in] n Number of values
+			/// @return the advanced iterator
+			iterator_t operator +(std::ptrdiff_t const n) const { iterator_t r = *this; return r += n; }
+
+			/// @brief Return a moved back iterator
+			/// @param[in] n Number of values
+			/// @return the moved back iterator
+			iterator_t operator -(std::ptrdiff_t const n) const { iterator_t r = *this; return r -= n; }
+
+			/// @brief Return the distance between two iterators
+			/// @param[in] it An iterator
+			/// @return the distance between the iterators
+			std::ptrdiff_t operator -(iterator_t const & it) const { return std::ptrdiff_t(m_i) - std::ptrdiff_t(it.m_i); }
+
+			/// @brief Equality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are on the same value, false otherwise
+			bool operator ==(iterator_t const & it) const { return p_data == it.p_data && m_i == it.m_i; }
+
+			/// @brief Inequality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are not on the same value, false otherwise
+			bool operator !=(iterator_t const & it) const { return ! (*this == it); }
+
+			/// @brief Less than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is before it, false otherwise
+			bool operator <(iterator_t const & it) const { return m_i < it.m_i; }
+
+			/// @brief Greater than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is after it, false otherwise
+			bool operator >(iterator_t const & it) const { return it < *this; }
+
+			/// @brief Less than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not after it, false otherwise
+			bool operator <=(iterator_t const & it) const { return ! (it < *this); }
+
+			/// @brief Greater than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not before it, false otherwise
+			bool operator >=(iterator_t const & it) const { return ! (*this < it); }
+
+			/// @brief Return the current value
+			/// @return the current value
+			T & operator *() const { return p_data[m_i * m_stride]; }
+
+			/// @brief Return a pointer to the current value
+			/// @return a pointer to the current value
+			T * operator ->() const { return p_data + m_i * m_stride; }
+
+			/// @brief Return the value at n values of the iterator
+			/// @param[in] n Number of values
+			/// @return the value
+			T & operator [](std::ptrdiff_t const n) const { return *((*this) + n); }
+		};
+
+		/// Type of the values
+		using value_type = typename std::remove_const<T>::type;
+
+		/// Iterator
+		using iterator = iterator_t;
+
+		/// Const iterator (the view is shallow, same as iterator)
+		using const_iterator = iterator_t;
+
+	private:
+
+		/// First value
+		T * p_data;
+
+		/// Number of values
+		std::size_t m_size;
+
+		/// Distance between two consecutive values
+		std::size_t m_stride;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] p      First value
+		/// @param[in] size   Number of values
+		/// @param[in] stride Distance between two consecutive values (1 by default, contiguous values)
+		vector2D_line_view(T * const p = nullptr, std::size_t const size = 0, std::size_t const stride = 1) :
+			p_data(p), m_size(size), m_stride(stride)
+		{ }
+
+		/// @brief Constructor from a view on mutable values (vector2D_line_view<T> to vector2D_line_view<T const>)
+		/// @param[in] v A vector2D_line_view
+		template <class U, class = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+		vector2D_line_view(vector2D_line_view<U> const & v) :
+			p_data(v.data()), m_size(v.size()), m_stride(v.stride())
+		{ }
+
+		/// @brief Return the number of values
+		/// @return the number of values
+		std::size_t size() const { return m_size; }
+
+		/// @brief Return true if the view has no value
+		/// @return true if the view has no value, false otherwise
+		bool empty() const { return m_size == 0; }
+
+		/// @brief Return a pointer to the first value
+		/// @return a pointer to the first value
+		T * data() const { return p_data; }
+
+		/// @brief Return the distance between two consecutive values
+		/// @return the distance between two consecutive values
+		std::size_t stride() const { return m_stride; }
+
+		/// @brief Return true if the values are contiguous ([data(), data() + size()) is the range of the values)
+		/// @return true if the values are contiguous, false otherwise
+		bool is_contiguous() const { return m_stride == 1 || m_size <= 1; }
+
+		/// @brief Access to a value
+		/// @param[in] i Index
+		/// @return the value i
+		T & operator [](std::size_t const i) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(i < m_size, std::out_of_range("hnc::vector2D_line_view, index = " + hnc::to_string(i) + ", size = " + hnc::to_string(m_size)));
+			#endif
+			return p_data[i * m_stride];
+		}
+
+		/// @brief Safe access to a value
+		/// @param[in] i Index
+		/// @exception std::out_of_range if out of range access
+		/// @return the value i
+		T & at(std::size_t const i) const
+		{
+			if (i >= m_size) { throw std::out_of_range("hnc::vector2D_line_view, index = " + hnc::to_string(i) + ", size = " + hnc::to_string(m_size)); }
+			return p_data[i * m_stride];
+		}
+
+		/// @brief Access to the first value
+		/// @pre The view has at least one value
+		/// @return the first value
+		T & front() const { return p_data[0]; }
+
+		/// @brief Access to the last value
+		/// @pre The view has at least one value
+		/// @return the last value
+		T & back() const { return p_data[(m_size - 1) * m_stride]; }
+
+		/// @brief Return a iterator to the beginning
+		/// @return a iterator to the beginning
+		iterator begin() const { return iterator(p_data, m_stride, 0); }
+
+		/// @brief Return a iterator to the end
+		/// @return a iterator to the end
+		iterator end() const { return iterator(p_data, m_stride, m_size); }
+
+		/// @brief Return a view on a part of the values (O(1), without copy)
+		/// @param[in] i    First value
+		/// @param[in] size Number of values
+		/// @exception std::out_of_range hnc::hassert i + size <= size of the view if NDEBUG is not defined
+		/// @return the view on the values [i, i + size)
+		vector2D_line_view<T> sub_view(std::size_t const i, std::size_t const size) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(i + size <= m_size, std::out_of_range("hnc::vector2D_line_view::sub_view, [" + hnc::to_string(i) + ", " + hnc::to_string(i + size) + "), size = " + hnc::to_string(m_size)));
+			#endif
+			return vector2D_line_view<T>(p_data + i * m_stride, size, m_stride);
+		}
+
+		/// @brief Assign a value to all values
+		/// @param[in] value A value
+		void fill(value_type const & value) const
+		{
+			for (std::size_t i = 0; i < m_size; ++i) { p_data[i * m_stride] = value; }
+		}
+	};
+
+	/**
+	 * @brief Non-owning strided view on a matrix (a hnc::vector2D, a block, a transposed matrix, ...)
+	 *
+	 * @code
+	   #include <hnc/vector2D_view.hpp>
+	   @endcode
+	 *
+	 * The view is a pointer, a number of rows, a number of columns, a row stride and a column stride: @n
+	 * the value (i, j) is data()[i * row_stride() + j * col_stride()] @n
+	 * A sub-view (block, row, column) or the transposed view of a view is O(1), without copy
+	 *
+	 * The view is a range of nb_row() * nb_col() values in row-major order (size(), begin(), end()),
+	 * so the algorithms of hnc::algo and hnc::math accept the views @n
+	 * If is_contiguous(), the values are [data(), data() + size()) and the tiled code can use the pointer directly
+	 *
+	 * The view is shallow: a const view gives a mutable access to the values, use vector2D_view<T const> for a read-only view
+	 *
+	 * @code
+	   hnc::vector2D<double> m(1024, 1024);
+	   // Blocks of 64 x 64
+	   for (std::size_t i = 0; i < m.nb_row(); i += 64)
+	   {
+	      for (std::size_t j = 0; j < m.nb_col(); j += 64)
+	      {
+	         auto const block = m.sub_view(i, j, 64, 64);
+	         std::cout << hnc::math::mean(block) << std::endl;
+	      }
+	   }
+	   @endcode
+	 *
+	 * @tparam T Type of the values (T const for a read-only view)
+	 */
+	template <class T>
+	class vector2D_view
+	{
+	public:
+
+		/**
+		 * @brief Random access iterator on the values of a hnc::vector2D_view (row-major order)
+		 *
+		 * @code
+		   #include <hnc/vector2D_view.hpp>
+		   @endcode
+		 */
+		class iterator_t : public std::iterator<std::random_access_iterator_tag, typename std::remove_const<T>::type, std::ptrdiff_t, T *, T &>
+		{
+		private:
+
+			/// Value (0, 0)
+			T * p_data;
+
+			/// Number of columns
+			std::size_t m_nb_col;
+
+			/// Distance between (i, j) and (i + 1, j)
+			std::size_t m_row_stride;
+
+			/// Distance between (i, j) and (i, j + 1)
+			std::size_t m_col_stride;
+
+			/// Row index
+			std::size_t m_i;
+
+			/// Column index
+			std::size_t m_j;
+
+			/// @brief Return the index of the value (row-major order)
+			/// @return the index of the value
+			std::ptrdiff_t index() const { return std::ptrdiff_t(m_i * m_nb_col + m_j); }
+
+		public:
+
+			/// @brief Constructor
+			/// @param[in] view A view (the iterator keeps a copy of the geometry, so it stays valid after the view is destroyed)
+			/// @param[in] i    Row index
+			/// @param[in] j    Column index
+			iterator_t(vector2D_view<T> const & view = vector2D_view<T>(), std::size_t const i = 0, std::size_t const j = 0) :
+				p_data(view.data()), m_nb_col(view.nb_col()), m_row_stride(view.row_stride()), m_col_stride(view.col_stride()), m_i(i), m_j(j)
+			{ }
+
+			/// @brief Return the row index
+			/// @return the row index
+			std::size_t i() const { return m_i; }
+
+			/// @brief Return the column index
+			/// @return the column index
+			std::size_t j() const { return m_j; }
+
+			/// @brief Go to the next value
+			/// @return the iterator
+			iterator_t & operator ++()
+			{
+				if (++m_j == m_nb_col) { m_j = 0; ++m_i; }
+				return *this;
+			}
+
+			/// @brief Go to the next value
+			/// @return the iterator before the increment
+			iterator_t operator ++(int) { iterator_t copy = *this; ++(*this); return copy; }
+
+			/// @brief Go to the previous value
+			/// @return the iterator
+			iterator_t & operator --()
+			{
+				if (m_j == 0) { m_j = m_nb_col; --m_i; }
+				--m_j;
+				return *this;
+			}
+
+			/// @brief Go to the previous value
+			/// @return the iterator before the decrement
+			iterator_t operator --(int) { iterator_t copy = *this; --(*this); return copy; }
+
+			/// @brief Advance the iterator
+			/// @param[in] n Number of values
+			/// @return the iterator
+			iterator_t & operator +=(std::ptrdiff_t const n)
+			{
+				// N x 0 view: begin() == end(), the only valid move is 0
+				if (m_nb_col == 0) { return *this; }
+				std::size_t const k = std::size_t(index() + n);
+				m_i = k / m_nb_col;
+				m_j = k % m_nb_col;
+				return *this;
+			}
+
+			/// @brief Move back the iterator
+			/// @param[in] n Number of values
+			/// @return the iterator
+			iterator_t & operator -=(std::ptrdiff_t const n) { return (*this) += -n; }
+
+			/// @brief Return an advanced iterator
+			/// @param[in] n Number of values
+			/// @return the advanced iterator
+			iterator_t operator +(std::ptrdiff_t const n) const { iterator_t r = *this; return r += n; }
+
+			/// @brief Return a moved back iterator
+			/// @param[in] n Number of values
+			/// @return the moved back iterator
+			iterator_t operator -(std::ptrdiff_t const n) const { iterator_t r = *this; return r -= n; }
+
+			/// @brief Return the distance between two iterators
+			/// @param[in] it An iterator
+			/// @return the distance between the iterators
+			std::ptrdiff_t operator -(iterator_t const & it) const { return index() - it.index(); }
+
+			/// @brief Equality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are on the same value, false otherwise
+			bool operator ==(iterator_t const & it) const { return p_data == it.p_data && m_i == it.m_i && m_j == it.m_j; }
+
+			/// @brief Inequality operator
+			/// @param[in] it An iterator
+			/// @return true if the iterators are not on the same value, false otherwise
+			bool operator !=(iterator_t const & it) const { return ! (*this == it); }
+
+			/// @brief Less than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is before it, false otherwise
+			bool operator <(iterator_t const & it) const { return index() < it.index(); }
+
+			/// @brief Greater than operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is after it, false otherwise
+			bool operator >(iterator_t const & it) const { return it < *this; }
+
+			/// @brief Less than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not after it, false otherwise
+			bool operator <=(iterator_t const & it) const { return ! (it < *this); }
+
+			/// @brief Greater than or equal operator
+			/// @param[in] it An iterator
+			/// @return true if the iterator is not before it, false otherwise
+			bool operator >=(iterator_t const & it) const { return ! (*this < it); }
+
+			/// @brief Return the current value
+			/// @return the current value
+			T & operator *() const { return p_data[m_i * m_row_stride + m_j * m_col_stride]; }
+
+			/// @brief Return a pointer to the current value
+			/// @return a pointer to the current value
+			T * operator ->() const { return &(**this); }
+
+			/// @brief Return the value at n values of the iterator
+			/// @param[in] n Number of values
+			/// @return the value
+			T & operator [](std::ptrdiff_t const n) const { return *((*this) + n); }
+		};
+
+		/// Type of the values
+		using value_type = typename std::remove_const<T>::type;
+
+		/// Iterator on the values (row-major order)
+		using iterator = iterator_t;
+
+		/// Const iterator on the values (the view is shallow, same as iterator)
+		using const_iterator = iterator_t;
+
+	private:
+
+		/// Value (0, 0)
+		T * p_data;
+
+		/// Number of rows
+		std::size_t m_nb_row;
+
+		/// Number of columns
+		std::size_t m_nb_col;
+
+		/// Distance between (i, j) and (i + 1, j)
+		std::size_t m_row_stride;
+
+		/// Distance between (i, j) and (i, j + 1)
+		std::size_t m_col_stride;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] p          Value (0, 0)
+		/// @param[in] nb_row     Number of rows
+		/// @param[in] nb_col     Number of columns
+		/// @param[in] row_stride Distance between (i, j) and (i + 1, j)
+		/// @param[in] col_stride Distance between (i, j) and (i, j + 1) (1 by default)
+		vector2D_view(T * const p, std::size_t const nb_row, std::size_t const nb_col, std::size_t const row_stride, std::size_t const col_stride = 1) :
+			p_data(p), m_nb_row(nb_row), m_nb_col(nb_col), m_row_stride(row_stride), m_col_stride(col_stride)
+		{ }
+
+		/// @brief Constructor of a view on a row-major matrix (row stride is the number of columns)
+		/// @param[in] p      Value (0, 0)
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		vector2D_view(T * const p = nullptr, std::size_t const nb_row = 0, std::size_t const nb_col = 0) :
+			vector2D_view(p, nb_row, nb_col, nb_col, 1)
+		{ }
+
+		/// @brief Constructor from a view on mutable values (vector2D_view<T> to vector2D_view<T const>)
+		/// @param[in] v A vector2D_view
+		template <class U, class = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+		vector2D_view(vector2D_view<U> const & v) :
+			vector2D_view(v.data(), v.nb_row(), v.nb_col(), v.row_stride(), v.col_stride())
+		{ }
+
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		std::size_t nb_row() const { return m_nb_row; }
+
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		std::size_t nb_col() const { return m_nb_col; }
+
+		/// @brief Return the number of values (nb_row() * nb_col())
+		/// @return the number of values
+		std::size_t size() const { return m_nb_row * m_nb_col; }
+
+		/// @brief Return true if the view has no value
+		/// @return true if the view has no value, false otherwise
+		bool empty() const { return size() == 0; }
+
+		/// @brief Return a pointer to the value (0, 0)
+		/// @return a pointer to the value (0, 0)
+		T * data() const { return p_data; }
+
+		/// @brief Return the distance between (i, j) and (i + 1, j)
+		/// @return the row stride
+		std::size_t row_stride() const { return m_row_stride; }
+
+		/// @brief Return the distance between (i, j) and (i, j + 1)
+		/// @return the column stride
+		std::size_t col_stride() const { return m_col_stride; }
+
+		/// @brief Return true if the values are contiguous in row-major order ([data(), data() + size()) is the range of the values)
+		/// @return true if the values are contiguous, false otherwise
+		bool is_contiguous() const
+		{
+			return (m_col_stride == 1 || m_nb_col <= 1) && (m_row_stride == m_nb_col * m_col_stride || m_nb_row <= 1);
+		}
+
+		/// @brief Access by fonctor
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @return the value at (i, j)
+		T & operator ()(std::size_t const i, std::size_t const j) const
+		{
+			#ifndef NDEBUG
+				check_range_assert(i, j);
+			#endif
+			return p_data[i * m_row_stride + j * m_col_stride];
+		}
+
+		/// @brief Safe access
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at (i, j)
+		T & at(std::size_t const i, std::size_t const j) const
+		{
+			if (i >= m_nb_row) { throw std::out_of_range("hnc::vector2D_view, id row = " + hnc::to_string(i) + ", number of rows = " + hnc::to_string(m_nb_row)); }
+			if (j >= m_nb_col) { throw std::out_of_range("hnc::vector2D_view, id column = " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col)); }
+			return p_data[i * m_row_stride + j * m_col_stride];
+		}
+
+		/// @brief Access by [i][j]
+		/// @param[in] i Row index
+		/// @return the row i
+		vector2D_line_view<T> operator [](std::size_t const i) const { return row(i); }
+
+		/// @brief Return a row
+		/// @param[in] i Row index
+		/// @exception std::out_of_range hnc::hassert i < number of rows if NDEBUG is not defined
+		/// @return the row i
+		vector2D_line_view<T> row(std::size_t const i) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(i < m_nb_row, std::out_of_range("hnc::vector2D_view::row, id row = " + hnc::to_string(i) + ", number of rows = " + hnc::to_string(m_nb_row)));
+			#endif
+			return vector2D_line_view<T>(p_data + i * m_row_stride, m_nb_col, m_col_stride);
+		}
+
+		/// @brief Return a column
+		/// @param[in] j Column index
+		/// @exception std::out_of_range hnc::hassert j < number of columns if NDEBUG is not defined
+		/// @return the column j
+		vector2D_line_view<T> col(std::size_t const j) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(j < m_nb_col, std::out_of_range("hnc::vector2D_view::col, id column = " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col)));
+			#endif
+			return vector2D_line_view<T>(p_data + j * m_col_stride, m_nb_row, m_row_stride);
+		}
+
+		/// @brief Return the diagonal ((0, 0), (1, 1), ...)
+		/// @return the diagonal
+		vector2D_line_view<T> diagonal() const
+		{
+			return vector2D_line_view<T>(p_data, (m_nb_row < m_nb_col) ? m_nb_row : m_nb_col, m_row_stride + m_col_stride);
+		}
+
+		/// @brief Return a view on a block (O(1), without copy)
+		/// @param[in] i      First row
+		/// @param[in] j      First column
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::out_of_range hnc::hassert the block is in the view if NDEBUG is not defined
+		/// @return the view on the rows [i, i + nb_row) and the columns [j, j + nb_col)
+		vector2D_view<T> sub_view(std::size_t const i, std::size_t const j, std::size_t const nb_row, std::size_t const nb_col) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(i + nb_row <= m_nb_row, std::out_of_range("hnc::vector2D_view::sub_view, rows [" + hnc::to_string(i) + ", " + hnc::to_string(i + nb_row) + "), number of rows = " + hnc::to_string(m_nb_row)));
+				hnc::hassert(j + nb_col <= m_nb_col, std::out_of_range("hnc::vector2D_view::sub_view, columns [" + hnc::to_string(j) + ", " + hnc::to_string(j + nb_col) + "), number of columns = " + hnc::to_string(m_nb_col)));
+			#endif
+			return vector2D_view<T>(p_data + i * m_row_stride + j * m_col_stride, nb_row, nb_col, m_row_stride, m_col_stride);
+		}
+
+		/// @brief Return the transposed view (O(1), without copy)
+		/// @return the transposed view, the value (i, j) of the transposed view is the value (j, i) of the view
+		vector2D_view<T> transposed() const
+		{
+			return vector2D_view<T>(p_data, m_nb_col, m_nb_row, m_col_stride, m_row_stride);
+		}
+
+		/// @brief Return a iterator to the beginning (row-major order)
+		/// @return a iterator to the beginning
+		iterator begin() const { return iterator(*this, 0, 0); }
+
+		/// @brief Return a iterator to the end (row-major order)
+		/// @return a iterator to the end
+		iterator end() const { return iterator(*this, (m_nb_col == 0) ? 0 : m_nb_row, 0); }
+
+		/// @brief Assign a value to all values
+		/// @param[in] value A value
+		void fill(value_type const & value) const
+		{
+			for (std::size_t i = 0; i < m_nb_row; ++i)
+			{
+				T * const row = p_data + i * m_row_stride;
+				for (std::size_t j = 0; j < m_nb_col; ++j) { row[j * m_col_stride] = value; }
+			}
+		}
+
+		/// @brief Copy the values of a view with the same size
+		/// @param[in] v A view with the same number of rows and columns
+		/// @exception std::invalid_argument hnc::hassert the views have the same size if NDEBUG is not defined
+		template <class U>
+		void assign(vector2D_view<U> const & v) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(v.nb_row() == m_nb_row && v.nb_col() == m_nb_col, std::invalid_argument("hnc::vector2D_view::assign, size " + hnc::to_string(v.nb_row()) + " x " + hnc::to_string(v.nb_col()) + " instead of " + hnc::to_string(m_nb_row) + " x " + hnc::to_string(m_nb_col)));
+			#endif
+			for (std::size_t i = 0; i < m_nb_row; ++i)
+			{
+				T * const row = p_data + i * m_row_stride;
+				U const * const v_row = v.data() + i * v.row_stride();
+				for (std::size_t j = 0; j < m_nb_col; ++j) { row[j * m_col_stride] = v_row[j * v.col_stride()]; }
+			}
+		}
+
+	private:
+
+		#ifndef NDEBUG
+			/// @brief Check if acces is out of range with hnc::hassert
+			/// @param i Row index
+			/// @param j Column index
+			/// @exception std::out_of_range hnc::hassert i < number of rows and j < number of columns
+			void check_range_assert(std::size_t const i, std::size_t const j) const
+			{
+				hnc::hassert(i < m_nb_row, std::out_of_range("hnc::vector2D_view, id row = " + hnc::to_string(i) + ", number of rows = " + hnc::to_string(m_nb_row)));
+				hnc::hassert(j < m_nb_col, std::out_of_range("hnc::vector2D_view, id column = " + hnc::to_string(j) + ", number of columns = " + hnc::to_string(m_nb_col)));
+			}
+		#endif
+	};
+
+	/// @brief Operator << between a std::ostream and a hnc::vector2D_line_view<T>
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector2D_line_view<T>
+	/// @return the output stream
+	template <class T>
+	std::ostream & operator <<(std::ostream & o, hnc::vector2D_line_view<T> const & v)
+	{
+		o << "{";
+		for (std::size_t i = 0; i < v.size(); ++i)
+		{
+			o << ((i == 0) ? " " : ", ") << v[i];
+		}
+		return o << " }";
+	}
+
+	/// @brief Operator << between a std::ostream and a hnc::vector2D_view<T>
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector2D_view<T>
+	/// @return the output stream
+	template <class T>
+	std::ostream & operator <<(std::ostream & o, hnc::vector2D_view<T> const & v)
+	{
+		for (std::size_t row = 0; row < v.nb_row(); ++row)
+		{
+			o << ((row == 0) ? ("{") : (" "));
+			o << " {";
+			for (std::size_t col = 0; col < v.nb_col(); ++col)
+			{
+				if (col != 0) { o << ", "; }
+				o << v(row, col);
+			}
+			o << ((row == v.nb_row() - 1) ? ("} }") : ("},\n"));
+		}
+		return o;
+	}
+}
+
+#endif
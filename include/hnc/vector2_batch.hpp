@@ -0,0 +1,419 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR2_BATCH_HPP
+#define HNC_VECTOR2_BATCH_HPP
+
+#include <vector>
+#include <initializer_list>
+#include <string>
+#include <cstddef>
+#include <cmath>
+#include <stdexcept>
+#include <ostream>
+
+#include "vector2.hpp"
+#include "vector2D_fixed.hpp"
+#include "aligned_allocator.hpp"
+#include "serialization.hpp"
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Batch of hnc::vector2 stored as a structure of arrays (one aligned array for x, one for y)
+	 *
+	 * @code
+	   #include <hnc/vector2_batch.hpp>
+	   @endcode
+	 *
+	 * The i-th point is (x()[i], y()[i]) and the batch operations (add, scale, dot, cross, norm, normalize,
+	 * transform by a 2 x 2 matrix) are simple loops on contiguous arrays vectorized with OpenMP SIMD @n
+	 * See hnc::vector3_batch for the 3D version
+	 *
+	 * @code
+	   hnc::vector2_batch<double> batch(points); // points is a std::vector<hnc::vector2<double>>
+	   batch *= 2.;
+	   auto const lengths = batch.norm();
+	   @endcode
+	 *
+	 * @tparam T Type of the coordinates
+	 */
+	template <class T>
+	class vector2_batch
+	{
+	public:
+
+		/// Type of the points
+		using value_type = hnc::vector2<T>;
+
+		/// Type of an array of coordinates (aligned, see hnc::aligned_allocator)
+		using container_t = std::vector<T, hnc::aligned_allocator<T>>;
+
+	private:
+
+		/// x of the points
+		container_t m_x;
+
+		/// y of the points
+		container_t m_y;
+
+	public:
+
+		/// @brief Default constructor (empty batch)
+		vector2_batch() : m_x(), m_y() { }
+
+		/// @brief Constructor
+		/// @param[in] size  Number of points
+		/// @param[in] value Value of the points
+		explicit vector2_batch(std::size_t const size, hnc::vector2<T> const & value = hnc::vector2<T>()) :
+			m_x(size, value.x), m_y(size, value.y)
+		{ }
+
+		/// @brief Constructor from a std::vector<hnc::vector2<T>> (array of structures)
+		/// @param[in] points Points
+		explicit vector2_batch(std::vector<hnc::vector2<T>> const & points) :
+			vector2_batch(points.begin(), points.end())
+		{ }
+
+		/// @brief Constructor from a std::initializer_list<hnc::vector2<T>>
+		/// @param[in] points Points
+		vector2_batch(std::initializer_list<hnc::vector2<T>> const points) :
+			vector2_batch(points.begin(), points.end())
+		{ }
+
+		/// @brief Constructor from a range of hnc::vector2<T>
+		/// @param[in] first Iterator on the first point
+		/// @param[in] last  Iterator after the last point
+		template <class iterator_t>
+		vector2_batch(iterator_t first, iterator_t const last) :
+			m_x(), m_y()
+		{
+			for (; first != last; ++first) { push_back(*first); }
+		}
+
+		hnc_generate_serialize_member_function(m_x, m_y)
+
+		/// @brief Return the points in a std::vector<hnc::vector2<T>> (array of structures)
+		/// @return the points in a std::vector<hnc::vector2<T>>
+		std::vector<hnc::vector2<T>> to_vector() const
+		{
+			std::vector<hnc::vector2<T>> r;
+			r.reserve(size());
+			for (std::size_t i = 0; i < size(); ++i) { r.emplace_back(m_x[i], m_y[i]); }
+			return r;
+		}
+
+		// Size
+
+		/// @brief Return the number of points
+		/// @return the number of points
+		std::size_t size() const { return m_x.size(); }
+
+		/// @brief Return true if the batch is empty
+		/// @return true if the batch is empty, false otherwise
+		bool empty() const { return m_x.empty(); }
+
+		/// @brief Reserve memory for size points
+		/// @param[in] size Number of points
+		void reserve(std::size_t const size) { m_x.reserve(size); m_y.reserve(size); }
+
+		/// @brief Change the number of points
+		/// @param[in] size  Number of points
+		/// @param[in] value Value of the new points
+		void resize(std::size_t const size, hnc::vector2<T> const & value = hnc::vector2<T>()) { m_x.resize(size, value.x); m_y.resize(size, value.y); }
+
+		/// @brief Remove all points
+		void clear() { m_x.clear(); m_y.clear(); }
+
+		/// @brief Add a point at the end
+		/// @param[in] v A hnc::vector2<T>
+		void push_back(hnc::vector2<T> const & v) { m_x.push_back(v.x); m_y.push_back(v.y); }
+
+		// Access
+
+		/// @brief Return the i-th point (copy)
+		/// @param[in] i Index of the point
+		/// @exception std::out_of_range hnc::hassert i < size() if NDEBUG is not defined
+		/// @return the i-th point
+		hnc::vector2<T> operator[](std::size_t const i) const
+		{
+			check_range_assert(i);
+			return hnc::vector2<T>(m_x[i], m_y[i]);
+		}
+
+		/// @brief Return the i-th point (copy)
+		/// @param[in] i Index of the point
+		/// @exception std::out_of_range if i >= size()
+		/// @return the i-th point
+		hnc::vector2<T> at(std::size_t const i) const
+		{
+			check_range(i);
+			return hnc::vector2<T>(m_x[i], m_y[i]);
+		}
+
+		/// @brief Set the i-th point
+		/// @param[in] i Index of the point
+		/// @param[in] v A hnc::vector2<T>
+		/// @exception std::out_of_range hnc::hassert i < size() if NDEBUG is not defined
+		void set(std::size_t const i, hnc::vector2<T> const & v)
+		{
+			check_range_assert(i);
+			m_x[i] = v.x; m_y[i] = v.y;
+		}
+
+		/// @brief Return the x of the points
+		/// @return a pointer on the x of the points (aligned)
+		T * x() { return m_x.data(); }
+
+		/// @brief Return the x of the points
+		/// @return a const pointer on the x of the points (aligned)
+		T const * x() const { return m_x.data(); }
+
+		/// @brief Return the y of the points
+		/// @return a pointer on the y of the points (aligned)
+		T * y() { return m_y.data(); }
+
+		/// @brief Return the y of the points
+		/// @return a const pointer on the y of the points (aligned)
+		T const * y() const { return m_y.data(); }
+
+		// Comparison
+
+		/// @brief Equality operator
+		/// @param[in] v A hnc::vector2_batch
+		/// @return true if the hnc::vector2_batch have the same points, false otherwise
+		bool operator ==(vector2_batch const & v) const { return m_x == v.m_x && m_y == v.m_y; }
+
+		/// @brief Inequality operator
+		/// @param[in] v A hnc::vector2_batch
+		/// @return true if the hnc::vector2_batch have different points, false otherwise
+		bool operator !=(vector2_batch const & v) const { return ! ((*this) == v); }
+
+		// Batch operations
+
+		/// @brief Add the points of a hnc::vector2_batch (vectorized)
+		/// @param[in] v A hnc::vector2_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the hnc::vector2_batch
+		vector2_batch & operator +=(vector2_batch const & v)
+		{
+			check_size(v, "operator +=");
+			T * const x = m_x.data(); T * const y = m_y.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(x[i] + vx[i]); y[i] = T(y[i] + vy[i]); }
+			return *this;
+		}
+
+		/// @brief Subtract the points of a hnc::vector2_batch (vectorized)
+		/// @param[in] v A hnc::vector2_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the hnc::vector2_batch
+		vector2_batch & operator -=(vector2_batch const & v)
+		{
+			check_size(v, "operator -=");
+			T * const x = m_x.data(); T * const y = m_y.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(x[i] - vx[i]); y[i] = T(y[i] - vy[i]); }
+			return *this;
+		}
+
+		/// @brief Add a hnc::vector2 to all points (translation, vectorized)
+		/// @param[in] v A hnc::vector2<T>
+		/// @return the hnc::vector2_batch
+		vector2_batch & operator +=(hnc::vector2<T> const & v)
+		{
+			T * const x = m_x.data(); T * const y = m_y.data();
+			T const vx = v.x; T const vy = v.y;
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(x[i] + vx); y[i] = T(y[i] + vy); }
+			return *this;
+		}
+
+		/// @brief Scale all points (vectorized)
+		/// @param[in] alpha Scalar
+		/// @return the hnc::vector2_batch
+		vector2_batch & operator *=(T const alpha)
+		{
+			T * const x = m_x.data(); T * const y = m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(alpha * x[i]); y[i] = T(alpha * y[i]); }
+			return *this;
+		}
+
+		/// @brief Return the dot products with the points of a hnc::vector2_batch (vectorized)
+		/// @param[in] v A hnc::vector2_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the dot product of each pair of points
+		container_t dot(vector2_batch const & v) const
+		{
+			check_size(v, "dot");
+			container_t r(size());
+			T * const p = r.data();
+			T const * const x = m_x.data(); T const * const y = m_y.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { p[i] = T(x[i] * vx[i] + y[i] * vy[i]); }
+			return r;
+		}
+
+		/// @brief Return the 2D cross products with the points of a hnc::vector2_batch (vectorized)
+		/// @param[in] v A hnc::vector2_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the z of the cross product (*this)[i] x v[i] of each pair of points (x y' - y x')
+		container_t cross(vector2_batch const & v) const
+		{
+			check_size(v, "cross");
+			container_t r(size());
+			T * const p = r.data();
+			T const * const x = m_x.data(); T const * const y = m_y.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { p[i] = T(x[i] * vy[i] - y[i] * vx[i]); }
+			return r;
+		}
+
+		/// @brief Return the Euclidean norms of the points (vectorized)
+		/// @return the norm of each point
+		container_t norm() const
+		{
+			container_t r(size());
+			T * const p = r.data();
+			T const * const x = m_x.data(); T const * const y = m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { p[i] = T(std::sqrt(x[i] * x[i] + y[i] * y[i])); }
+			return r;
+		}
+
+		/// @brief Divide each point by its norm (vectorized)
+		///
+		/// The null points stay null
+		void normalize()
+		{
+			T * const x = m_x.data(); T * const y = m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				T const n = T(std::sqrt(x[i] * x[i] + y[i] * y[i]));
+				T const inv = (n == T(0)) ? T(0) : T(T(1) / n);
+				x[i] = T(x[i] * inv); y[i] = T(y[i] * inv);
+			}
+		}
+
+		/// @brief Replace each point p by the matrix product m p (vectorized)
+		/// @param[in] m A 2 x 2 matrix
+		void transform(hnc::vector2D_fixed<T, 2, 2> const & m)
+		{
+			T const m00 = m(0, 0); T const m01 = m(0, 1);
+			T const m10 = m(1, 0); T const m11 = m(1, 1);
+			T * const x = m_x.data(); T * const y = m_y.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				T const px = x[i]; T const py = y[i];
+				x[i] = T(m00 * px + m01 * py);
+				y[i] = T(m10 * px + m11 * py);
+			}
+		}
+
+		/// @brief Replace each point p by m p + translation (vectorized)
+		/// @param[in] m           A 2 x 2 matrix
+		/// @param[in] translation A hnc::vector2<T>
+		void transform(hnc::vector2D_fixed<T, 2, 2> const & m, hnc::vector2<T> const & translation)
+		{
+			transform(m);
+			(*this) += translation;
+		}
+
+	private:
+
+		/// @brief Check if the hnc::vector2_batch have the same size with hnc::hassert if NDEBUG is not defined
+		/// @param[in] v         A hnc::vector2_batch
+		/// @param[in] operation Name of the operation
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		#ifndef NDEBUG
+			void check_size(vector2_batch const & v, char const * const operation) const
+			{
+				hnc::hassert(v.size() == size(), std::invalid_argument(std::string("hnc::vector2_batch::") + operation + ", the batch has " + hnc::to_string(v.size()) + " points instead of " + hnc::to_string(size())));
+			}
+		#else
+			void check_size(vector2_batch const & /*v*/, char const * const /*operation*/) const { }
+		#endif
+
+		/// @brief Check if acces is out of range with hnc::hassert if NDEBUG is not defined
+		/// @param i Index of the point
+		/// @exception std::out_of_range hnc::hassert i < size() if NDEBUG is not defined
+		#ifndef NDEBUG
+			void check_range_assert(std::size_t const i) const { hnc::hassert(i < size(), std::out_of_range("hnc::vector2_batch, id = " + hnc::to_string(i) + ", size = " + hnc::to_string(size()))); }
+		#else
+			void check_range_assert(std::size_t const /*i*/) const { }
+		#endif
+
+		/// @brief Check if acces is out of range
+		/// @param i Index of the point
+		/// @exception std::out_of_range if i >= size()
+		void check_range(std::size_t const i) const
+		{
+			if (i >= size()) { throw std::out_of_range("hnc::vector2_batch, id = " + hnc::to_string(i) + ", size = " + hnc::to_string(size())); }
+		}
+	};
+
+	/// @brief Return the sum of two hnc::vector2_batch
+	/// @param[in] a A hnc::vector2_batch
+	/// @param[in] b A hnc::vector2_batch with the same size
+	/// @return a + b
+	template <class T>
+	hnc::vector2_batch<T> operator +(hnc::vector2_batch<T> a, hnc::vector2_batch<T> const & b) { a += b; return a; }
+
+	/// @brief Return the difference of two hnc::vector2_batch
+	/// @param[in] a A hnc::vector2_batch
+	/// @param[in] b A hnc::vector2_batch with the same size
+	/// @return a - b
+	template <class T>
+	hnc::vector2_batch<T> operator -(hnc::vector2_batch<T> a, hnc::vector2_batch<T> const & b) { a -= b; return a; }
+
+	/// @brief Return a scaled hnc::vector2_batch
+	/// @param[in] alpha Scalar
+	/// @param[in] a     A hnc::vector2_batch
+	/// @return alpha * a
+	template <class T>
+	hnc::vector2_batch<T> operator *(T const alpha, hnc::vector2_batch<T> a) { a *= alpha; return a; }
+
+	/// @brief Return a scaled hnc::vector2_batch
+	/// @param[in] a     A hnc::vector2_batch
+	/// @param[in] alpha Scalar
+	/// @return a * alpha
+	template <class T>
+	hnc::vector2_batch<T> operator *(hnc::vector2_batch<T> a, T const alpha) { a *= alpha; return a; }
+
+	/// @brief Operator << between a std::ostream and a hnc::vector2_batch<T>
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector2_batch<T>
+	/// @return the output stream
+	template <class T>
+	std::ostream & operator <<(std::ostream & o, hnc::vector2_batch<T> const & v)
+	{
+		o << "{";
+		for (std::size_t i = 0; i < v.size(); ++i) { o << ((i == 0) ? " " : ", ") << v[i]; }
+		o << " }";
+		return o;
+	}
+}
+
+#endif
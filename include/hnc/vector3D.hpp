@@ -0,0 +1,460 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR3D_HPP
+#define HNC_VECTOR3D_HPP
+
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <ostream>
+
+#include "vector3D_view.hpp"
+#include "vector2D_view.hpp"
+#include "vector2D_storage.hpp"
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Layout of a hnc::vector3D (the contiguous dimension)
+	 *
+	 * @code
+	   #include <hnc/vector3D.hpp>
+	   @endcode
+	 */
+	enum class vector3D_layout
+	{
+		/// (x, y, z) and (x, y, z + 1) are contiguous, like a C array T[x][y][z]
+		z_contiguous,
+		/// (x, y, z) and (x + 1, y, z) are contiguous, like a Fortran array T(x, y, z)
+		x_contiguous
+	};
+
+	/**
+	 * @brief 3D container (a tensor) implemented with one contiguous and aligned std::vector<T> with 3D access
+	 *
+	 * @code
+	   #include <hnc/vector3D.hpp>
+	   @endcode
+	 *
+	 * The values are in one allocation (aligned on 64 bytes by default), the layout gives the contiguous dimension (see hnc::vector3D_layout) @n
+	 * The storage policy gives the allocator and the distance between two lines of the contiguous dimension (see hnc::vector2D_storage): @n
+	 * with hnc::vector2D_storage::aligned_padded, each line starts on an aligned address
+	 *
+	 * The planes (x, y or z fixed) are hnc::vector2D_view, the blocks are hnc::vector3D_view (O(1), without copy) @n
+	 * See hnc::math::stencil for 7-point and 27-point stencils
+	 *
+	 * @code
+	   hnc::vector3D<double> v(64, 64, 64, 0.);
+	   v(1, 2, 3) = 42.;
+	   // Plane z = 3, a 64 x 64 matrix
+	   hnc::vector2D<double> const plane(v.slice_z(3));
+	   @endcode
+	 *
+	 * @tparam T         Type of the values
+	 * @tparam storage_t Storage policy (see hnc::vector2D_storage, aligned on 64 bytes by default)
+	 */
+	template <class T, class storage_t = hnc::vector2D_storage::aligned<T>>
+	class vector3D
+	{
+	public:
+
+		/// Type of the values
+		using value_type = T;
+
+	private:
+
+		/// Data (size of the non-contiguous dimensions * line_stride() values)
+		std::vector<T, typename storage_t::allocator_type> m_data;
+
+		/// Size of the dimension x
+		std::size_t m_size_x;
+
+		/// Size of the dimension y
+		std::size_t m_size_y;
+
+		/// Size of the dimension z
+		std::size_t m_size_z;
+
+		/// Layout
+		hnc::vector3D_layout m_layout;
+
+		/// Distance between (x, y, z) and (x + 1, y, z)
+		std::size_t m_stride_x;
+
+		/// Distance between (x, y, z) and (x, y + 1, z)
+		std::size_t m_stride_y;
+
+		/// Distance between (x, y, z) and (x, y, z + 1)
+		std::size_t m_stride_z;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] size_x        Size of the dimension x
+		/// @param[in] size_y        Size of the dimension y
+		/// @param[in] size_z        Size of the dimension z
+		/// @param[in] default_value Default value (T() by default)
+		/// @param[in] layout        Layout (hnc::vector3D_layout::z_contiguous by default)
+		vector3D
+		(
+			std::size_t const size_x = 0, std::size_t const size_y = 0, std::size_t const size_z = 0,
+			T const & default_value = T(),
+			hnc::vector3D_layout const layout = hnc::vector3D_layout::z_contiguous
+		) :
+			m_data(),
+			m_size_x(size_x),
+			m_size_y(size_y),
+			m_size_z(size_z),
+			m_layout(layout),
+			m_stride_x(0),
+			m_stride_y(0),
+			m_stride_z(0)
+		{
+			compute_strides();
+			m_data.assign(nb_line() * line_stride(), default_value);
+		}
+
+		/// @brief Constructor with a copy of the values of a view (a block, a plane of a 4D array, ...)
+		/// @param[in] v      A hnc::vector3D_view
+		/// @param[in] layout Layout (hnc::vector3D_layout::z_contiguous by default)
+		template <class U>
+		explicit vector3D(hnc::vector3D_view<U> const & v, hnc::vector3D_layout const layout = hnc::vector3D_layout::z_contiguous) :
+			vector3D(v.size_x(), v.size_y(), v.size_z(), T(), layout)
+		{
+			view().assign(v);
+		}
+
+		/// @brief Constructor by copy
+		/// @param[in] v3D A vector3D
+		vector3D(vector3D const & v3D) = default;
+
+		/// @brief Constructor by RValues reference (O(1), without allocation)
+		/// @param[in] v3D A vector3D (will be empty)
+		vector3D(vector3D && v3D) noexcept :
+			m_data(std::move(v3D.m_data)),
+			m_size_x(v3D.m_size_x), m_size_y(v3D.m_size_y), m_size_z(v3D.m_size_z),
+			m_layout(v3D.m_layout),
+			m_stride_x(v3D.m_stride_x), m_stride_y(v3D.m_stride_y), m_stride_z(v3D.m_stride_z)
+		{
+			v3D.m_data.clear();
+			v3D.m_size_z = 0;
+			v3D.m_size_y = 0;
+			v3D.m_size_x = 0;
+			v3D.compute_strides();
+		}
+
+		/// @brief Affectation operator between two vector3D
+		/// @param[in] v3D A vector3D
+		/// @return the vector3D
+		vector3D & operator =(vector3D const & v3D) = default;
+
+		/// @brief Move assignment operator between two vector3D (O(1), without allocation)
+		/// @param[in] v3D A vector3D (will be empty)
+		/// @return the vector3D
+		vector3D & operator =(vector3D && v3D) noexcept
+		{
+			// If it is a different vector3D
+			if (this != &v3D)
+			{
+				// Move
+				m_data = std::move(v3D.m_data);
+				m_size_x = v3D.m_size_x;
+				m_size_y = v3D.m_size_y;
+				m_size_z = v3D.m_size_z;
+				m_layout = v3D.m_layout;
+				m_stride_x = v3D.m_stride_x;
+				m_stride_y = v3D.m_stride_y;
+				m_stride_z = v3D.m_stride_z;
+				// Remove original object
+				v3D.m_data.clear();
+				v3D.m_size_z = 0;
+				v3D.m_size_y = 0;
+				v3D.m_size_x = 0;
+				v3D.compute_strides();
+			}
+			// Return
+			return *this;
+		}
+
+		/// @brief Return the size of the dimension x
+		/// @return the size of the dimension x
+		std::size_t size_x() const { return m_size_x; }
+
+		/// @brief Return the size of the dimension y
+		/// @return the size of the dimension y
+		std::size_t size_y() const { return m_size_y; }
+
+		/// @brief Return the size of the dimension z
+		/// @return the size of the dimension z
+		std::size_t size_z() const { return m_size_z; }
+
+		/// @brief Return the number of values (size_x() * size_y() * size_z())
+		/// @return the number of values
+		std::size_t size() const { return m_size_x * m_size_y * m_size_z; }
+
+		/// @brief Return true if the vector3D has no value
+		/// @return true if the vector3D has no value, false otherwise
+		bool empty() const { return size() == 0; }
+
+		/// @brief Return the layout
+		/// @return the layout
+		hnc::vector3D_layout layout() const { return m_layout; }
+
+		/// @brief Return the distance between two lines of the contiguous dimension (rounded up by the storage policy, see hnc::vector2D_storage)
+		/// @return the distance between two lines of the contiguous dimension
+		std::size_t line_stride() const
+		{
+			return storage_t::row_stride((m_layout == hnc::vector3D_layout::z_contiguous) ? m_size_z : m_size_x);
+		}
+
+		/// @brief Return the distance between (x, y, z) and (x + 1, y, z)
+		/// @return the stride of the dimension x
+		std::size_t stride_x() const { return m_stride_x; }
+
+		/// @brief Return the distance between (x, y, z) and (x, y + 1, z)
+		/// @return the stride of the dimension y
+		std::size_t stride_y() const { return m_stride_y; }
+
+		/// @brief Return the distance between (x, y, z) and (x, y, z + 1)
+		/// @return the stride of the dimension z
+		std::size_t stride_z() const { return m_stride_z; }
+
+		/// @brief Return a const pointer to the data (the value (x, y, z) is at data() + x * stride_x() + y * stride_y() + z * stride_z())
+		/// @return a const pointer to the data
+		T const * data() const { return m_data.data(); }
+
+		/// @brief Return a pointer to the data (the value (x, y, z) is at data() + x * stride_x() + y * stride_y() + z * stride_z())
+		/// @return a pointer to the data
+		T * data() { return m_data.data(); }
+
+		/// @brief Const access by fonctor
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @return the value at (x, y, z)
+		T const & operator ()(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			#ifndef NDEBUG
+				check_range_assert(x, y, z);
+			#endif
+			return m_data[x * m_stride_x + y * m_stride_y + z * m_stride_z];
+		}
+
+		/// @brief Access by fonctor
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @return the value at (x, y, z)
+		T & operator ()(std::size_t const x, std::size_t const y, std::size_t const z)
+		{
+			#ifndef NDEBUG
+				check_range_assert(x, y, z);
+			#endif
+			return m_data[x * m_stride_x + y * m_stride_y + z * m_stride_z];
+		}
+
+		/// @brief Const safe access
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at (x, y, z)
+		T const & at(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			check_range(x, y, z);
+			return m_data[x * m_stride_x + y * m_stride_y + z * m_stride_z];
+		}
+
+		/// @brief Safe access
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at (x, y, z)
+		T & at(std::size_t const x, std::size_t const y, std::size_t const z)
+		{
+			check_range(x, y, z);
+			return m_data[x * m_stride_x + y * m_stride_y + z * m_stride_z];
+		}
+
+		/// @brief Return a read-only view on the values
+		/// @return a read-only view on the values
+		hnc::vector3D_view<T const> view() const
+		{
+			return hnc::vector3D_view<T const>(m_data.data(), m_size_x, m_size_y, m_size_z, stride_x(), stride_y(), stride_z());
+		}
+
+		/// @brief Return a view on the values
+		/// @return a view on the values
+		hnc::vector3D_view<T> view()
+		{
+			return hnc::vector3D_view<T>(m_data.data(), m_size_x, m_size_y, m_size_z, stride_x(), stride_y(), stride_z());
+		}
+
+		/// @brief Return a read-only view on the plane x (see hnc::vector3D_view::slice_x)
+		/// @param[in] x Index in the dimension x
+		/// @return the plane x, the value (y, z) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T const> slice_x(std::size_t const x) const { return view().slice_x(x); }
+
+		/// @brief Return a view on the plane x (see hnc::vector3D_view::slice_x)
+		/// @param[in] x Index in the dimension x
+		/// @return the plane x, the value (y, z) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T> slice_x(std::size_t const x) { return view().slice_x(x); }
+
+		/// @brief Return a read-only view on the plane y (see hnc::vector3D_view::slice_y)
+		/// @param[in] y Index in the dimension y
+		/// @return the plane y, the value (x, z) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T const> slice_y(std::size_t const y) const { return view().slice_y(y); }
+
+		/// @brief Return a view on the plane y (see hnc::vector3D_view::slice_y)
+		/// @param[in] y Index in the dimension y
+		/// @return the plane y, the value (x, z) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T> slice_y(std::size_t const y) { return view().slice_y(y); }
+
+		/// @brief Return a read-only view on the plane z (see hnc::vector3D_view::slice_z)
+		/// @param[in] z Index in the dimension z
+		/// @return the plane z, the value (x, y) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T const> slice_z(std::size_t const z) const { return view().slice_z(z); }
+
+		/// @brief Return a view on the plane z (see hnc::vector3D_view::slice_z)
+		/// @param[in] z Index in the dimension z
+		/// @return the plane z, the value (x, y) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T> slice_z(std::size_t const z) { return view().slice_z(z); }
+
+		/// @brief Return a read-only view on a block (see hnc::vector3D_view::sub_view)
+		/// @param[in] x      First index in the dimension x
+		/// @param[in] y      First index in the dimension y
+		/// @param[in] z      First index in the dimension z
+		/// @param[in] size_x Size of the block in the dimension x
+		/// @param[in] size_y Size of the block in the dimension y
+		/// @param[in] size_z Size of the block in the dimension z
+		/// @return the view on [x, x + size_x) x [y, y + size_y) x [z, z + size_z)
+		hnc::vector3D_view<T const> sub_view
+		(
+			std::size_t const x, std::size_t const y, std::size_t const z,
+			std::size_t const size_x, std::size_t const size_y, std::size_t const size_z
+		) const
+		{
+			return view().sub_view(x, y, z, size_x, size_y, size_z);
+		}
+
+		/// @brief Return a view on a block (see hnc::vector3D_view::sub_view)
+		/// @param[in] x      First index in the dimension x
+		/// @param[in] y      First index in the dimension y
+		/// @param[in] z      First index in the dimension z
+		/// @param[in] size_x Size of the block in the dimension x
+		/// @param[in] size_y Size of the block in the dimension y
+		/// @param[in] size_z Size of the block in the dimension z
+		/// @return the view on [x, x + size_x) x [y, y + size_y) x [z, z + size_z)
+		hnc::vector3D_view<T> sub_view
+		(
+			std::size_t const x, std::size_t const y, std::size_t const z,
+			std::size_t const size_x, std::size_t const size_y, std::size_t const size_z
+		)
+		{
+			return view().sub_view(x, y, z, size_x, size_y, size_z);
+		}
+
+		/// @brief Assign a value to all values (the padding too, in one loop)
+		/// @param[in] value A value
+		void fill(T const & value) { std::fill(m_data.begin(), m_data.end(), value); }
+
+		/// @brief Equality operator (same sizes and same values, the layouts can be different)
+		/// @param[in] v3D A vector3D
+		/// @return true if the vector3D are equal, false otherwise
+		template <class storage_other_t>
+		bool operator ==(hnc::vector3D<T, storage_other_t> const & v3D) const
+		{
+			if (m_size_x != v3D.size_x() || m_size_y != v3D.size_y() || m_size_z != v3D.size_z()) { return false; }
+			for (std::size_t x = 0; x < m_size_x; ++x)
+			{
+				for (std::size_t y = 0; y < m_size_y; ++y)
+				{
+					for (std::size_t z = 0; z < m_size_z; ++z)
+					{
+						if ((*this)(x, y, z) != v3D(x, y, z)) { return false; }
+					}
+				}
+			}
+			return true;
+		}
+
+		/// @brief Inequality operator
+		/// @param[in] v3D A vector3D
+		/// @return true if the vector3D are different, false otherwise
+		template <class storage_other_t>
+		bool operator !=(hnc::vector3D<T, storage_other_t> const & v3D) const { return ! (*this == v3D); }
+
+	private:
+
+		/// @brief Compute the strides from the sizes and the layout
+		void compute_strides()
+		{
+			m_stride_y = line_stride();
+			m_stride_x = (m_layout == hnc::vector3D_layout::z_contiguous) ? m_size_y * m_stride_y : 1;
+			m_stride_z = (m_layout == hnc::vector3D_layout::z_contiguous) ? 1 : m_size_y * m_stride_y;
+		}
+
+		/// @brief Return the number of lines of the contiguous dimension
+		/// @return the number of lines of the contiguous dimension
+		std::size_t nb_line() const
+		{
+			return m_size_y * ((m_layout == hnc::vector3D_layout::z_contiguous) ? m_size_x : m_size_z);
+		}
+
+		/// @brief Check if acces is out of range
+		/// @param x Index in the dimension x
+		/// @param y Index in the dimension y
+		/// @param z Index in the dimension z
+		/// @exception std::out_of_range if out of range access
+		void check_range(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			if (x >= m_size_x) { throw std::out_of_range("hnc::vector3D, x = " + hnc::to_string(x) + ", size x = " + hnc::to_string(m_size_x)); }
+			if (y >= m_size_y) { throw std::out_of_range("hnc::vector3D, y = " + hnc::to_string(y) + ", size y = " + hnc::to_string(m_size_y)); }
+			if (z >= m_size_z) { throw std::out_of_range("hnc::vector3D, z = " + hnc::to_string(z) + ", size z = " + hnc::to_string(m_size_z)); }
+		}
+
+		#ifndef NDEBUG
+			/// @brief Check if acces is out of range with hnc::hassert
+			/// @param x Index in the dimension x
+			/// @param y Index in the dimension y
+			/// @param z Index in the dimension z
+			/// @exception std::out_of_range hnc::hassert x < size_x(), y < size_y() and z < size_z()
+			void check_range_assert(std::size_t const x, std::size_t const y, std::size_t const z) const
+			{
+				hnc::hassert(x < m_size_x, std::out_of_range("hnc::vector3D, x = " + hnc::to_string(x) + ", size x = " + hnc::to_string(m_size_x)));
+				hnc::hassert(y < m_size_y, std::out_of_range("hnc::vector3D, y = " + hnc::to_string(y) + ", size y = " + hnc::to_string(m_size_y)));
+				hnc::hassert(z < m_size_z, std::out_of_range("hnc::vector3D, z = " + hnc::to_string(z) + ", size z = " + hnc::to_string(m_size_z)));
+			}
+		#endif
+	};
+
+	/// @brief Operator << between a std::ostream and a hnc::vector3D<T>
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector3D<T>
+	/// @return the output stream
+	template <class T, class storage_t>
+	std::ostream & operator <<(std::ostream & o, hnc::vector3D<T, storage_t> const & v)
+	{
+		return o << v.view();
+	}
+}
+
+#endif
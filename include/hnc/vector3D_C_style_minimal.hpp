@@ -16,6 +16,11 @@
 #ifndef HNC_VECTOR3D_C_STYLE_MINIMAL_HPP
 #define HNC_VECTOR3D_C_STYLE_MINIMAL_HPP
 
+#include <cstddef>
+#include <memory>
+#include <algorithm>
+#include <ostream>
+
 
 namespace hnc
 {
@@ -26,19 +31,26 @@ namespace hnc
 	   #include <hnc/vector3D_C_style_minimal.hpp>
 	   @endcode
 	 *
-	 * @note For other use, have a look to:
-	 * - hnc::vector3D
-	 * - hnc::vector3D_C_style
-	 * - hnc::vector3D_minimal
+	 * The values are contiguous (x, then y, then z) in one allocation, with one table of size_x * size_y pointers to the lines z
+	 * and one table of size_x pointers to the planes x (3 allocations, whatever the sizes)
+	 *
+	 * @deprecated Use hnc::vector3D: one aligned allocation without tables of pointers, a layout choice, strides,
+	 * views on planes and blocks (hnc::vector3D_view) and stencils (hnc::math::stencil)
 	 */
 	template <class T>
 	class vector3D_C_style_minimal
 	{
 	private:
 
-		/// T[][][] data
+		/// T[][][] data (size_x pointers in p_table)
 		T * * * p_data;
 
+		/// Pointers to the lines z (size_x * size_y pointers in p_values)
+		T * * p_table;
+
+		/// Values (size_x * size_y * size_z values)
+		T * p_values;
+
 		/// Size of the dimension x
 		std::size_t m_size_x;
 
@@ -61,26 +73,32 @@ namespace hnc
 			T const & default_value = T()
 		) :
 			p_data(nullptr),
+			p_table(nullptr),
+			p_values(nullptr),
 			m_size_x(size_x),
 			m_size_y(size_y),
 			m_size_z(size_z)
 		{
-			p_data = new T * *[m_size_x];
+			// The allocations are owned by std::unique_ptr until the construction succeeds (no leak if an allocation or T::operator= throws)
+			std::unique_ptr<T[]> values(new T[m_size_x * m_size_y * m_size_z]);
+			std::unique_ptr<T *[]> table(new T *[m_size_x * m_size_y]);
+			std::unique_ptr<T * *[]> data(new T * *[m_size_x]);
+
+			std::fill(values.get(), values.get() + m_size_x * m_size_y * m_size_z, default_value);
 
 			for (std::size_t x = 0; x < m_size_x; ++x)
 			{
-				p_data[x] = new T *[m_size_y];
-				
+				data[x] = table.get() + x * m_size_y;
+
 				for (std::size_t y = 0; y < m_size_y; ++y)
 				{
-					p_data[x][y] = new T[m_size_z];
-
-					for (std::size_t z = 0; z < m_size_z; ++z)
-					{
-						p_data[x][y][z] = default_value;
-					}
+					data[x][y] = values.get() + (x * m_size_y + y) * m_size_z;
 				}
 			}
+
+			p_values = values.release();
+			p_table = table.release();
+			p_data = data.release();
 		}
 
 		/// @brief Constructor by copy
@@ -88,22 +106,15 @@ namespace hnc
 		vector3D_C_style_minimal(vector3D_C_style_minimal<T> const & v3D) :
 			vector3D_C_style_minimal(v3D.size_x(), v3D.size_y(), v3D.size_z())
 		{
-			for (std::size_t x = 0; x < m_size_x; ++x)
-			{
-				for (std::size_t y = 0; y < m_size_y; ++y)
-				{
-					for (std::size_t z = 0; z < m_size_z; ++z)
-					{
-						p_data[x][y][z] = v3D[x][y][z];
-					}
-				}
-			}
+			std::copy(v3D.p_values, v3D.p_values + m_size_x * m_size_y * m_size_z, p_values);
 		}
 
 		/// @brief Constructor by RValues reference
 		/// @param[in] v3D A vector3D (will be destroyed)
 		vector3D_C_style_minimal(vector3D_C_style_minimal<T> && v3D) :
 			p_data(v3D.p_data),
+			p_table(v3D.p_table),
+			p_values(v3D.p_values),
 			m_size_x(v3D.m_size_x),
 			m_size_y(v3D.m_size_y),
 			m_size_z(v3D.m_size_z)
@@ -111,6 +122,8 @@ namespace hnc
 			v3D.m_size_z = 0;
 			v3D.m_size_y = 0;
 			v3D.m_size_x = 0;
+			v3D.p_values = nullptr;
+			v3D.p_table = nullptr;
 			v3D.p_data = nullptr;
 		}
 
@@ -144,6 +157,8 @@ namespace hnc
 				destructor();
 				// Move
 				p_data = v3D.p_data;
+				p_table = v3D.p_table;
+				p_values = v3D.p_values;
 				m_size_x = v3D.m_size_x;
 				m_size_y = v3D.m_size_y;
 				m_size_z = v3D.m_size_z;
@@ -151,6 +166,8 @@ namespace hnc
 				v3D.m_size_z = 0;
 				v3D.m_size_y = 0;
 				v3D.m_size_x = 0;
+				v3D.p_values = nullptr;
+				v3D.p_table = nullptr;
 				v3D.p_data = nullptr;
 			}
 			// Return
@@ -174,6 +191,14 @@ namespace hnc
 			return *this;
 		}
 
+		/// @brief Return a const pointer to the values (contiguous, the value [x][y][z] is at data()[(x * size_y() + y) * size_z() + z])
+		/// @return a const pointer to the values
+		T const * data() const { return p_values; }
+
+		/// @brief Return a pointer to the values (contiguous, the value [x][y][z] is at data()[(x * size_y() + y) * size_z() + z])
+		/// @return a pointer to the values
+		T * data() { return p_values; }
+
 		/// @brief Const access by [x][y][z]
 		/// @param x Dimension x
 		/// @return a T const * * to have [y][z]
@@ -189,27 +214,18 @@ namespace hnc
 		/// @brief Fake destructor
 		void destructor()
 		{
-				std::size_t size_x_for_delete = m_size_x;
-				std::size_t size_y_for_delete = m_size_y;
-
 				m_size_x = 0;
 				m_size_y = 0;
 				m_size_z = 0;
 
-				for (std::size_t x = 0; x < size_x_for_delete; ++x)
-				{
-					for (std::size_t y = 0; y < size_y_for_delete; ++y)
-					{
-						delete[] p_data[x][y];
-						p_data[x][y] = nullptr;
-					}
-					
-					delete[] p_data[x];
-					p_data[x] = nullptr;
-				}
-
 				delete[] p_data;
 				p_data = nullptr;
+
+				delete[] p_table;
+				p_table = nullptr;
+
+				delete[] p_values;
+				p_values = nullptr;
 		}
 	};
 	
@@ -0,0 +1,341 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR3D_VIEW_HPP
+#define HNC_VECTOR3D_VIEW_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
+#include <ostream>
+
+#include "vector2D_view.hpp"
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Non-owning view on a 3D array with strides (a hnc::vector3D, a block of a hnc::vector3D, a C array T[x][y][z], ...)
+	 *
+	 * @code
+	   #include <hnc/vector3D_view.hpp>
+	   @endcode
+	 *
+	 * The view is a pointer to the value (0, 0, 0), the sizes of the dimensions and the strides (distance between (x, y, z) and (x + 1, y, z), ...) @n
+	 * A slice (x, y or z fixed) is a hnc::vector2D_view, a block is a hnc::vector3D_view (O(1), without copy) @n
+	 * The view is shallow: a const view gives a mutable access to the values, use vector3D_view<T const> for a read-only view
+	 *
+	 * @code
+	   hnc::vector3D<double> v(100, 200, 300);
+	   // Plane x = 42, a 200 x 300 matrix
+	   auto const plane = v.view().slice_x(42);
+	   // Values without the boundary
+	   auto const interior = v.view().sub_view(1, 1, 1, 98, 198, 298);
+	   @endcode
+	 *
+	 * @tparam T Type of the values (T const for a read-only view)
+	 */
+	template <class T>
+	class vector3D_view
+	{
+	public:
+
+		/// Type of the values
+		using value_type = typename std::remove_const<T>::type;
+
+	private:
+
+		/// Value (0, 0, 0)
+		T * p_data;
+
+		/// Size of the dimension x
+		std::size_t m_size_x;
+
+		/// Size of the dimension y
+		std::size_t m_size_y;
+
+		/// Size of the dimension z
+		std::size_t m_size_z;
+
+		/// Distance between (x, y, z) and (x + 1, y, z)
+		std::size_t m_stride_x;
+
+		/// Distance between (x, y, z) and (x, y + 1, z)
+		std::size_t m_stride_y;
+
+		/// Distance between (x, y, z) and (x, y, z + 1)
+		std::size_t m_stride_z;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] p        Value (0, 0, 0)
+		/// @param[in] size_x   Size of the dimension x
+		/// @param[in] size_y   Size of the dimension y
+		/// @param[in] size_z   Size of the dimension z
+		/// @param[in] stride_x Distance between (x, y, z) and (x + 1, y, z)
+		/// @param[in] stride_y Distance between (x, y, z) and (x, y + 1, z)
+		/// @param[in] stride_z Distance between (x, y, z) and (x, y, z + 1)
+		vector3D_view
+		(
+			T * const p,
+			std::size_t const size_x, std::size_t const size_y, std::size_t const size_z,
+			std::size_t const stride_x, std::size_t const stride_y, std::size_t const stride_z
+		) :
+			p_data(p),
+			m_size_x(size_x), m_size_y(size_y), m_size_z(size_z),
+			m_stride_x(stride_x), m_stride_y(stride_y), m_stride_z(stride_z)
+		{ }
+
+		/// @brief Constructor of a view on a C array T[size_x][size_y][size_z]
+		/// @param[in] p      Value (0, 0, 0)
+		/// @param[in] size_x Size of the dimension x
+		/// @param[in] size_y Size of the dimension y
+		/// @param[in] size_z Size of the dimension z
+		vector3D_view(T * const p = nullptr, std::size_t const size_x = 0, std::size_t const size_y = 0, std::size_t const size_z = 0) :
+			vector3D_view(p, size_x, size_y, size_z, size_y * size_z, size_z, 1)
+		{ }
+
+		/// @brief Constructor from a view on mutable values (vector3D_view<T> to vector3D_view<T const>)
+		/// @param[in] v A vector3D_view
+		template <class U, class = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+		vector3D_view(vector3D_view<U> const & v) :
+			vector3D_view(v.data(), v.size_x(), v.size_y(), v.size_z(), v.stride_x(), v.stride_y(), v.stride_z())
+		{ }
+
+		/// @brief Return the size of the dimension x
+		/// @return the size of the dimension x
+		std::size_t size_x() const { return m_size_x; }
+
+		/// @brief Return the size of the dimension y
+		/// @return the size of the dimension y
+		std::size_t size_y() const { return m_size_y; }
+
+		/// @brief Return the size of the dimension z
+		/// @return the size of the dimension z
+		std::size_t size_z() const { return m_size_z; }
+
+		/// @brief Return the number of values (size_x() * size_y() * size_z())
+		/// @return the number of values
+		std::size_t size() const { return m_size_x * m_size_y * m_size_z; }
+
+		/// @brief Return true if the view has no value
+		/// @return true if the view has no value, false otherwise
+		bool empty() const { return size() == 0; }
+
+		/// @brief Return a pointer to the value (0, 0, 0)
+		/// @return a pointer to the value (0, 0, 0)
+		T * data() const { return p_data; }
+
+		/// @brief Return the distance between (x, y, z) and (x + 1, y, z)
+		/// @return the stride of the dimension x
+		std::size_t stride_x() const { return m_stride_x; }
+
+		/// @brief Return the distance between (x, y, z) and (x, y + 1, z)
+		/// @return the stride of the dimension y
+		std::size_t stride_y() const { return m_stride_y; }
+
+		/// @brief Return the distance between (x, y, z) and (x, y, z + 1)
+		/// @return the stride of the dimension z
+		std::size_t stride_z() const { return m_stride_z; }
+
+		/// @brief Return the index of (x, y, z) from data()
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @return the index of (x, y, z)
+		std::size_t index(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			return x * m_stride_x + y * m_stride_y + z * m_stride_z;
+		}
+
+		/// @brief Access by fonctor
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @return the value at (x, y, z)
+		T & operator ()(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			#ifndef NDEBUG
+				check_range_assert(x, y, z);
+			#endif
+			return p_data[index(x, y, z)];
+		}
+
+		/// @brief Safe access
+		/// @param[in] x Index in the dimension x
+		/// @param[in] y Index in the dimension y
+		/// @param[in] z Index in the dimension z
+		/// @exception std::out_of_range if out of range access
+		/// @return the value at (x, y, z)
+		T & at(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			check_range(x, y, z);
+			return p_data[index(x, y, z)];
+		}
+
+		/// @brief Return the plane x (a view of size_y() x size_z())
+		/// @param[in] x Index in the dimension x
+		/// @exception std::out_of_range hnc::hassert x < size_x() if NDEBUG is not defined
+		/// @return the plane x, the value (y, z) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T> slice_x(std::size_t const x) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(x < m_size_x, std::out_of_range("hnc::vector3D_view::slice_x, x = " + hnc::to_string(x) + ", size x = " + hnc::to_string(m_size_x)));
+			#endif
+			return hnc::vector2D_view<T>(p_data + x * m_stride_x, m_size_y, m_size_z, m_stride_y, m_stride_z);
+		}
+
+		/// @brief Return the plane y (a view of size_x() x size_z())
+		/// @param[in] y Index in the dimension y
+		/// @exception std::out_of_range hnc::hassert y < size_y() if NDEBUG is not defined
+		/// @return the plane y, the value (x, z) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T> slice_y(std::size_t const y) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(y < m_size_y, std::out_of_range("hnc::vector3D_view::slice_y, y = " + hnc::to_string(y) + ", size y = " + hnc::to_string(m_size_y)));
+			#endif
+			return hnc::vector2D_view<T>(p_data + y * m_stride_y, m_size_x, m_size_z, m_stride_x, m_stride_z);
+		}
+
+		/// @brief Return the plane z (a view of size_x() x size_y())
+		/// @param[in] z Index in the dimension z
+		/// @exception std::out_of_range hnc::hassert z < size_z() if NDEBUG is not defined
+		/// @return the plane z, the value (x, y) of the plane is the value (x, y, z)
+		hnc::vector2D_view<T> slice_z(std::size_t const z) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(z < m_size_z, std::out_of_range("hnc::vector3D_view::slice_z, z = " + hnc::to_string(z) + ", size z = " + hnc::to_string(m_size_z)));
+			#endif
+			return hnc::vector2D_view<T>(p_data + z * m_stride_z, m_size_x, m_size_y, m_stride_x, m_stride_y);
+		}
+
+		/// @brief Return a view on a block (O(1), without copy)
+		/// @param[in] x      First index in the dimension x
+		/// @param[in] y      First index in the dimension y
+		/// @param[in] z      First index in the dimension z
+		/// @param[in] size_x Size of the block in the dimension x
+		/// @param[in] size_y Size of the block in the dimension y
+		/// @param[in] size_z Size of the block in the dimension z
+		/// @exception std::out_of_range hnc::hassert the block is in the view if NDEBUG is not defined
+		/// @return the view on [x, x + size_x) x [y, y + size_y) x [z, z + size_z)
+		vector3D_view<T> sub_view
+		(
+			std::size_t const x, std::size_t const y, std::size_t const z,
+			std::size_t const size_x, std::size_t const size_y, std::size_t const size_z
+		) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(x + size_x <= m_size_x, std::out_of_range("hnc::vector3D_view::sub_view, x in [" + hnc::to_string(x) + ", " + hnc::to_string(x + size_x) + "), size x = " + hnc::to_string(m_size_x)));
+				hnc::hassert(y + size_y <= m_size_y, std::out_of_range("hnc::vector3D_view::sub_view, y in [" + hnc::to_string(y) + ", " + hnc::to_string(y + size_y) + "), size y = " + hnc::to_string(m_size_y)));
+				hnc::hassert(z + size_z <= m_size_z, std::out_of_range("hnc::vector3D_view::sub_view, z in [" + hnc::to_string(z) + ", " + hnc::to_string(z + size_z) + "), size z = " + hnc::to_string(m_size_z)));
+			#endif
+			return vector3D_view<T>(p_data + index(x, y, z), size_x, size_y, size_z, m_stride_x, m_stride_y, m_stride_z);
+		}
+
+		/// @brief Assign a value to all values
+		/// @param[in] value A value
+		void fill(value_type const & value) const
+		{
+			for (std::size_t x = 0; x < m_size_x; ++x)
+			{
+				for (std::size_t y = 0; y < m_size_y; ++y)
+				{
+					T * const line = p_data + x * m_stride_x + y * m_stride_y;
+					for (std::size_t z = 0; z < m_size_z; ++z) { line[z * m_stride_z] = value; }
+				}
+			}
+		}
+
+		/// @brief Copy the values of a view with the same sizes
+		/// @param[in] v A view with the same sizes
+		/// @exception std::invalid_argument hnc::hassert the views have the same sizes if NDEBUG is not defined
+		template <class U>
+		void assign(vector3D_view<U> const & v) const
+		{
+			#ifndef NDEBUG
+				hnc::hassert(v.size_x() == m_size_x && v.size_y() == m_size_y && v.size_z() == m_size_z, std::invalid_argument("hnc::vector3D_view::assign, size " + hnc::to_string(v.size_x()) + " x " + hnc::to_string(v.size_y()) + " x " + hnc::to_string(v.size_z()) + " instead of " + hnc::to_string(m_size_x) + " x " + hnc::to_string(m_size_y) + " x " + hnc::to_string(m_size_z)));
+			#endif
+			for (std::size_t x = 0; x < m_size_x; ++x)
+			{
+				for (std::size_t y = 0; y < m_size_y; ++y)
+				{
+					T * const line = p_data + x * m_stride_x + y * m_stride_y;
+					U const * const v_line = v.data() + x * v.stride_x() + y * v.stride_y();
+					for (std::size_t z = 0; z < m_size_z; ++z) { line[z * m_stride_z] = v_line[z * v.stride_z()]; }
+				}
+			}
+		}
+
+	private:
+
+		/// @brief Check if acces is out of range
+		/// @param x Index in the dimension x
+		/// @param y Index in the dimension y
+		/// @param z Index in the dimension z
+		/// @exception std::out_of_range if out of range access
+		void check_range(std::size_t const x, std::size_t const y, std::size_t const z) const
+		{
+			if (x >= m_size_x) { throw std::out_of_range("hnc::vector3D_view, x = " + hnc::to_string(x) + ", size x = " + hnc::to_string(m_size_x)); }
+			if (y >= m_size_y) { throw std::out_of_range("hnc::vector3D_view, y = " + hnc::to_string(y) + ", size y = " + hnc::to_string(m_size_y)); }
+			if (z >= m_size_z) { throw std::out_of_range("hnc::vector3D_view, z = " + hnc::to_string(z) + ", size z = " + hnc::to_string(m_size_z)); }
+		}
+
+		#ifndef NDEBUG
+			/// @brief Check if acces is out of range with hnc::hassert
+			/// @param x Index in the dimension x
+			/// @param y Index in the dimension y
+			/// @param z Index in the dimension z
+			/// @exception std::out_of_range hnc::hassert x < size_x(), y < size_y() and z < size_z()
+			void check_range_assert(std::size_t const x, std::size_t const y, std::size_t const z) const
+			{
+				hnc::hassert(x < m_size_x, std::out_of_range("hnc::vector3D_view, x = " + hnc::to_string(x) + ", size x = " + hnc::to_string(m_size_x)));
+				hnc::hassert(y < m_size_y, std::out_of_range("hnc::vector3D_view, y = " + hnc::to_string(y) + ", size y = " + hnc::to_string(m_size_y)));
+				hnc::hassert(z < m_size_z, std::out_of_range("hnc::vector3D_view, z = " + hnc::to_string(z) + ", size z = " + hnc::to_string(m_size_z)));
+			}
+		#endif
+	};
+
+	/// @brief Operator << between a std::ostream and a hnc::vector3D_view<T>
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector3D_view<T>
+	/// @return the output stream
+	template <class T>
+	std::ostream & operator <<(std::ostream & o, hnc::vector3D_view<T> const & v)
+	{
+		o << "{";
+		for (std::size_t x = 0; x < v.size_x(); ++x)
+		{
+			if (x == 0) { o << "\n"; }
+			for (std::size_t y = 0; y < v.size_y(); ++y)
+			{
+				o << ((y == 0) ? ("  {") : ("   "));
+				o << " {";
+				for (std::size_t z = 0; z < v.size_z(); ++z)
+				{
+					if (z != 0) { o << ", "; }
+					o << v(x, y, z);
+				}
+				o << ((y == v.size_y() - 1) ? ("} }") : ("},\n"));
+			}
+			o << ((x == v.size_x() - 1) ? ("\n") : (",\n"));
+		}
+		return o << "}";
+	}
+}
+
+#endif
@@ -0,0 +1,444 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HNC_VECTOR3_BATCH_HPP
+#define HNC_VECTOR3_BATCH_HPP
+
+#include <vector>
+#include <initializer_list>
+#include <string>
+#include <cstddef>
+#include <cmath>
+#include <stdexcept>
+#include <ostream>
+
+#include "vector3.hpp"
+#include "vector2D_fixed.hpp"
+#include "aligned_allocator.hpp"
+#include "serialization.hpp"
+#include "assert.hpp"
+#include "to_string.hpp"
+
+
+namespace hnc
+{
+	/**
+	 * @brief Batch of hnc::vector3 stored as a structure of arrays (one aligned array for x, one for y, one for z)
+	 *
+	 * @code
+	   #include <hnc/vector3_batch.hpp>
+	   @endcode
+	 *
+	 * A std::vector<hnc::vector3<T>> is an array of structures: x, y and z are interleaved, so the compiler cannot
+	 * vectorize a loop over the points without shuffles @n
+	 * In a hnc::vector3_batch, the i-th point is (x()[i], y()[i], z()[i]) and the batch operations (add, scale, dot,
+	 * cross, norm, normalize, transform by a 3 x 3 matrix) are simple loops on contiguous arrays vectorized with OpenMP SIMD
+	 *
+	 * @code
+	   std::vector<hnc::vector3<float>> points = ...;
+	   hnc::vector3_batch<float> batch(points);
+	   batch.transform(rotation); // rotation is a hnc::vector2D_fixed<float, 3, 3>
+	   batch += hnc::vector3<float>(0.f, 0.f, 1.f);
+	   batch.normalize();
+	   points = batch.to_vector();
+	   @endcode
+	 *
+	 * @tparam T Type of the coordinates
+	 */
+	template <class T>
+	class vector3_batch
+	{
+	public:
+
+		/// Type of the points
+		using value_type = hnc::vector3<T>;
+
+		/// Type of an array of coordinates (aligned, see hnc::aligned_allocator)
+		using container_t = std::vector<T, hnc::aligned_allocator<T>>;
+
+	private:
+
+		/// x of the points
+		container_t m_x;
+
+		/// y of the points
+		container_t m_y;
+
+		/// z of the points
+		container_t m_z;
+
+	public:
+
+		/// @brief Default constructor (empty batch)
+		vector3_batch() : m_x(), m_y(), m_z() { }
+
+		/// @brief Constructor
+		/// @param[in] size  Number of points
+		/// @param[in] value Value of the points
+		explicit vector3_batch(std::size_t const size, hnc::vector3<T> const & value = hnc::vector3<T>()) :
+			m_x(size, value.x), m_y(size, value.y), m_z(size, value.z)
+		{ }
+
+		/// @brief Constructor from a std::vector<hnc::vector3<T>> (array of structures)
+		/// @param[in] points Points
+		explicit vector3_batch(std::vector<hnc::vector3<T>> const & points) :
+			vector3_batch(points.begin(), points.end())
+		{ }
+
+		/// @brief Constructor from a std::initializer_list<hnc::vector3<T>>
+		/// @param[in] points Points
+		vector3_batch(std::initializer_list<hnc::vector3<T>> const points) :
+			vector3_batch(points.begin(), points.end())
+		{ }
+
+		/// @brief Constructor from a range of hnc::vector3<T>
+		/// @param[in] first Iterator on the first point
+		/// @param[in] last  Iterator after the last point
+		template <class iterator_t>
+		vector3_batch(iterator_t first, iterator_t const last) :
+			m_x(), m_y(), m_z()
+		{
+			for (; first != last; ++first) { push_back(*first); }
+		}
+
+		hnc_generate_serialize_member_function(m_x, m_y, m_z)
+
+		/// @brief Return the points in a std::vector<hnc::vector3<T>> (array of structures)
+		/// @return the points in a std::vector<hnc::vector3<T>>
+		std::vector<hnc::vector3<T>> to_vector() const
+		{
+			std::vector<hnc::vector3<T>> r;
+			r.reserve(size());
+			for (std::size_t i = 0; i < size(); ++i) { r.emplace_back(m_x[i], m_y[i], m_z[i]); }
+			return r;
+		}
+
+		// Size
+
+		/// @brief Return the number of points
+		/// @return the number of points
+		std::size_t size() const { return m_x.size(); }
+
+		/// @brief Return true if the batch is empty
+		/// @return true if the batch is empty, false otherwise
+		bool empty() const { return m_x.empty(); }
+
+		/// @brief Reserve memory for size points
+		/// @param[in] size Number of points
+		void reserve(std::size_t const size) { m_x.reserve(size); m_y.reserve(size); m_z.reserve(size); }
+
+		/// @brief Change the number of points
+		/// @param[in] size  Number of points
+		/// @param[in] value Value of the new points
+		void resize(std::size_t const size, hnc::vector3<T> const & value = hnc::vector3<T>())
+		{
+			m_x.resize(size, value.x); m_y.resize(size, value.y); m_z.resize(size, value.z);
+		}
+
+		/// @brief Remove all points
+		void clear() { m_x.clear(); m_y.clear(); m_z.clear(); }
+
+		/// @brief Add a point at the end
+		/// @param[in] v A hnc::vector3<T>
+		void push_back(hnc::vector3<T> const & v) { m_x.push_back(v.x); m_y.push_back(v.y); m_z.push_back(v.z); }
+
+		// Access
+
+		/// @brief Return the i-th point (copy)
+		/// @param[in] i Index of the point
+		/// @exception std::out_of_range hnc::hassert i < size() if NDEBUG is not defined
+		/// @return the i-th point
+		hnc::vector3<T> operator[](std::size_t const i) const
+		{
+			check_range_assert(i);
+			return hnc::vector3<T>(m_x[i], m_y[i], m_z[i]);
+		}
+
+		/// @brief Return the i-th point (copy)
+		/// @param[in] i Index of the point
+		/// @exception std::out_of_range if i >= size()
+		/// @return the i-th point
+		hnc::vector3<T> at(std::size_t const i) const
+		{
+			check_range(i);
+			return hnc::vector3<T>(m_x[i], m_y[i], m_z[i]);
+		}
+
+		/// @brief Set the i-th point
+		/// @param[in] i Index of the point
+		/// @param[in] v A hnc::vector3<T>
+		/// @exception std::out_of_range hnc::hassert i < size() if NDEBUG is not defined
+		void set(std::size_t const i, hnc::vector3<T> const & v)
+		{
+			check_range_assert(i);
+			m_x[i] = v.x; m_y[i] = v.y; m_z[i] = v.z;
+		}
+
+		/// @brief Return the x of the points
+		/// @return a pointer on the x of the points (aligned)
+		T * x() { return m_x.data(); }
+
+		/// @brief Return the x of the points
+		/// @return a const pointer on the x of the points (aligned)
+		T const * x() const { return m_x.data(); }
+
+		/// @brief Return the y of the points
+		/// @return a pointer on the y of the points (aligned)
+		T * y() { return m_y.data(); }
+
+		/// @brief Return the y of the points
+		/// @return a const pointer on the y of the points (aligned)
+		T const * y() const { return m_y.data(); }
+
+		/// @brief Return the z of the points
+		/// @return a pointer on the z of the points (aligned)
+		T * z() { return m_z.data(); }
+
+		/// @brief Return the z of the points
+		/// @return a const pointer on the z of the points (aligned)
+		T const * z() const { return m_z.data(); }
+
+		// Comparison
+
+		/// @brief Equality operator
+		/// @param[in] v A hnc::vector3_batch
+		/// @return true if the hnc::vector3_batch have the same points, false otherwise
+		bool operator ==(vector3_batch const & v) const { return m_x == v.m_x && m_y == v.m_y && m_z == v.m_z; }
+
+		/// @brief Inequality operator
+		/// @param[in] v A hnc::vector3_batch
+		/// @return true if the hnc::vector3_batch have different points, false otherwise
+		bool operator !=(vector3_batch const & v) const { return ! ((*this) == v); }
+
+		// Batch operations
+
+		/// @brief Add the points of a hnc::vector3_batch (vectorized)
+		/// @param[in] v A hnc::vector3_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the hnc::vector3_batch
+		vector3_batch & operator +=(vector3_batch const & v)
+		{
+			check_size(v, "operator +=");
+			T * const x = m_x.data(); T * const y = m_y.data(); T * const z = m_z.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data(); T const * const vz = v.m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(x[i] + vx[i]); y[i] = T(y[i] + vy[i]); z[i] = T(z[i] + vz[i]); }
+			return *this;
+		}
+
+		/// @brief Subtract the points of a hnc::vector3_batch (vectorized)
+		/// @param[in] v A hnc::vector3_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the hnc::vector3_batch
+		vector3_batch & operator -=(vector3_batch const & v)
+		{
+			check_size(v, "operator -=");
+			T * const x = m_x.data(); T * const y = m_y.data(); T * const z = m_z.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data(); T const * const vz = v.m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(x[i] - vx[i]); y[i] = T(y[i] - vy[i]); z[i] = T(z[i] - vz[i]); }
+			return *this;
+		}
+
+		/// @brief Add a hnc::vector3 to all points (translation, vectorized)
+		/// @param[in] v A hnc::vector3<T>
+		/// @return the hnc::vector3_batch
+		vector3_batch & operator +=(hnc::vector3<T> const & v)
+		{
+			T * const x = m_x.data(); T * const y = m_y.data(); T * const z = m_z.data();
+			T const vx = v.x; T const vy = v.y; T const vz = v.z;
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(x[i] + vx); y[i] = T(y[i] + vy); z[i] = T(z[i] + vz); }
+			return *this;
+		}
+
+		/// @brief Scale all points (vectorized)
+		/// @param[in] alpha Scalar
+		/// @return the hnc::vector3_batch
+		vector3_batch & operator *=(T const alpha)
+		{
+			T * const x = m_x.data(); T * const y = m_y.data(); T * const z = m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { x[i] = T(alpha * x[i]); y[i] = T(alpha * y[i]); z[i] = T(alpha * z[i]); }
+			return *this;
+		}
+
+		/// @brief Return the dot products with the points of a hnc::vector3_batch (vectorized)
+		/// @param[in] v A hnc::vector3_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the dot product of each pair of points
+		container_t dot(vector3_batch const & v) const
+		{
+			check_size(v, "dot");
+			container_t r(size());
+			T * const p = r.data();
+			T const * const x = m_x.data(); T const * const y = m_y.data(); T const * const z = m_z.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data(); T const * const vz = v.m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { p[i] = T(x[i] * vx[i] + y[i] * vy[i] + z[i] * vz[i]); }
+			return r;
+		}
+
+		/// @brief Return the cross products with the points of a hnc::vector3_batch (vectorized)
+		/// @param[in] v A hnc::vector3_batch with the same size
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		/// @return the cross product (*this)[i] x v[i] of each pair of points
+		vector3_batch cross(vector3_batch const & v) const
+		{
+			check_size(v, "cross");
+			vector3_batch r(size());
+			T * const rx = r.m_x.data(); T * const ry = r.m_y.data(); T * const rz = r.m_z.data();
+			T const * const x = m_x.data(); T const * const y = m_y.data(); T const * const z = m_z.data();
+			T const * const vx = v.m_x.data(); T const * const vy = v.m_y.data(); T const * const vz = v.m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				rx[i] = T(y[i] * vz[i] - z[i] * vy[i]);
+				ry[i] = T(z[i] * vx[i] - x[i] * vz[i]);
+				rz[i] = T(x[i] * vy[i] - y[i] * vx[i]);
+			}
+			return r;
+		}
+
+		/// @brief Return the Euclidean norms of the points (vectorized)
+		/// @return the norm of each point
+		container_t norm() const
+		{
+			container_t r(size());
+			T * const p = r.data();
+			T const * const x = m_x.data(); T const * const y = m_y.data(); T const * const z = m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i) { p[i] = T(std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i])); }
+			return r;
+		}
+
+		/// @brief Divide each point by its norm (vectorized)
+		///
+		/// The null points stay null
+		void normalize()
+		{
+			T * const x = m_x.data(); T * const y = m_y.data(); T * const z = m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				T const n = T(std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]));
+				T const inv = (n == T(0)) ? T(0) : T(T(1) / n);
+				x[i] = T(x[i] * inv); y[i] = T(y[i] * inv); z[i] = T(z[i] * inv);
+			}
+		}
+
+		/// @brief Replace each point p by the matrix product m p (vectorized)
+		/// @param[in] m A 3 x 3 matrix
+		void transform(hnc::vector2D_fixed<T, 3, 3> const & m)
+		{
+			T const m00 = m(0, 0); T const m01 = m(0, 1); T const m02 = m(0, 2);
+			T const m10 = m(1, 0); T const m11 = m(1, 1); T const m12 = m(1, 2);
+			T const m20 = m(2, 0); T const m21 = m(2, 1); T const m22 = m(2, 2);
+			T * const x = m_x.data(); T * const y = m_y.data(); T * const z = m_z.data();
+			#pragma omp simd
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				T const px = x[i]; T const py = y[i]; T const pz = z[i];
+				x[i] = T(m00 * px + m01 * py + m02 * pz);
+				y[i] = T(m10 * px + m11 * py + m12 * pz);
+				z[i] = T(m20 * px + m21 * py + m22 * pz);
+			}
+		}
+
+		/// @brief Replace each point p by m p + translation (vectorized)
+		/// @param[in] m           A 3 x 3 matrix
+		/// @param[in] translation A hnc::vector3<T>
+		void transform(hnc::vector2D_fixed<T, 3, 3> const & m, hnc::vector3<T> const & translation)
+		{
+			transform(m);
+			(*this) += translation;
+		}
+
+	private:
+
+		/// @brief Check if the hnc::vector3_batch have the same size with hnc::hassert if NDEBUG is not defined
+		/// @param[in] v         A hnc::vector3_batch
+		/// @param[in] operation Name of the operation
+		/// @exception std::invalid_argument hnc::hassert the batches have the same size if NDEBUG is not defined
+		#ifndef NDEBUG
+			void check_size(vector3_batch const & v, char const * const operation) const
+			{
+				hnc::hassert(v.size() == size(), std::invalid_argument(std::string("hnc::vector3_batch::") + operation + ", the batch has " + hnc::to_string(v.size()) + " points instead of " + hnc::to_string(size())));
+			}
+		#else
+			void check_size(vector3_batch const & /*v*/, char const * const /*operation*/) const { }
+		#endif
+
+		/// @brief Check if acces is out of range with hnc::hassert if NDEBUG is not defined
+		/// @param i Index of the point
+		/// @exception std::out_of_range hnc::hassert i < size() if NDEBUG is not defined
+		#ifndef NDEBUG
+			void check_range_assert(std::size_t const i) const { hnc::hassert(i < size(), std::out_of_range("hnc::vector3_batch, id = " + hnc::to_string(i) + ", size = " + hnc::to_string(size()))); }
+		#else
+			void check_range_assert(std::size_t const /*i*/) const { }
+		#endif
+
+		/// @brief Check if acces is out of range
+		/// @param i Index of the point
+		/// @exception std::out_of_range if i >= size()
+		void check_range(std::size_t const i) const
+		{
+			if (i >= size()) { throw std::out_of_range("hnc::vector3_batch, id = " + hnc::to_string(i) + ", size = " + hnc::to_string(size())); }
+		}
+	};
+
+	/// @brief Return the sum of two hnc::vector3_batch
+	/// @param[in] a A hnc::vector3_batch
+	/// @param[in] b A hnc::vector3_batch with the same size
+	/// @return a + b
+	template <class T>
+	hnc::vector3_batch<T> operator +(hnc::vector3_batch<T> a, hnc::vector3_batch<T> const & b) { a += b; return a; }
+
+	/// @brief Return the difference of two hnc::vector3_batch
+	/// @param[in] a A hnc::vector3_batch
+	/// @param[in] b A hnc::vector3_batch with the same size
+	/// @return a - b
+	template <class T>
+	hnc::vector3_batch<T> operator -(hnc::vector3_batch<T> a, hnc::vector3_batch<T> const & b) { a -= b; return a; }
+
+	/// @brief Return a scaled hnc::vector3_batch
+	/// @param[in] alpha Scalar
+	/// @param[in] a     A hnc::vector3_batch
+	/// @return alpha * a
+	template <class T>
+	hnc::vector3_batch<T> operator *(T const alpha, hnc::vector3_batch<T> a) { a *= alpha; return a; }
+
+	/// @brief Return a scaled hnc::vector3_batch
+	/// @param[in] a     A hnc::vector3_batch
+	/// @param[in] alpha Scalar
+	/// @return a * alpha
+	template <class T>
+	hnc::vector3_batch<T> operator *(hnc::vector3_batch<T> a, T const alpha) { a *= alpha; return a; }
+
+	/// @brief Operator << between a std::ostream and a hnc::vector3_batch<T>
+	/// @param[in,out] o Output stream
+	/// @param[in]     v A hnc::vector3_batch<T>
+	/// @return the output stream
+	template <class T>
+	std::ostream & operator <<(std::ostream & o, hnc::vector3_batch<T> const & v)
+	{
+		o << "{";
+		for (std::size_t i = 0; i < v.size(); ++i) { o << ((i == 0) ? " " : ", ") << v[i]; }
+		o << " }";
+		return o;
+	}
+}
+
+#endif
@@ -0,0 +1,163 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#if defined(_OPENMP)
+	#include <omp.h>
+#endif
+
+#include <hnc/algo/vector2D_parallel.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_storage.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+/// @brief Run a function with nb_thread OpenMP threads
+template <class function_t>
+void with_threads(int const nb_thread, function_t f)
+{
+	#if defined(_OPENMP)
+		int const previous_nb_thread = omp_get_max_threads();
+		omp_set_num_threads(nb_thread);
+		f();
+		omp_set_num_threads(previous_nb_thread);
+	#else
+		(void)(nb_thread);
+		f();
+	#endif
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	// Matrix with rows longer than a tile
+	std::size_t const nb_row = 23;
+	std::size_t const nb_col = 9000;
+	hnc::vector2D<double, hnc::vector2D_storage::aligned_padded<double>> m(nb_row, nb_col);
+
+	// for_each_index
+	hnc::algo::for_each_index(m, [](std::size_t const i, std::size_t const j, double & value) { value = 1. / double(1 + i * 7 + j * 13 % 101); });
+	{
+		bool ok = true;
+		for (std::size_t i = 0; i < nb_row; ++i) { for (std::size_t j = 0; j < nb_col; ++j) { ok = ok && m(i, j) == 1. / double(1 + i * 7 + j * 13 % 101); } }
+		++nb_test;
+		nb_test -= hnc::test::warning(ok, "hnc::algo::for_each_index fails\n");
+	}
+
+	// transform
+	{
+		hnc::vector2D<double> dst(nb_row, nb_col);
+		hnc::algo::transform(m, dst, [](double const x) { return 2. * x; });
+		hnc::vector2D<double> sum(nb_row, nb_col);
+		hnc::algo::transform(m, dst, sum, [](double const x, double const y) { return x + y; });
+		bool ok = true;
+		for (std::size_t i = 0; i < nb_row; ++i) { for (std::size_t j = 0; j < nb_col; ++j) { ok = ok && dst(i, j) == 2. * m(i, j) && sum(i, j) == m(i, j) + 2. * m(i, j); } }
+		++nb_test;
+		nb_test -= hnc::test::warning(ok, "hnc::algo::transform fails\n");
+
+		// In place
+		hnc::algo::transform(dst, dst, [](double const x) { return -x; });
+		++nb_test;
+		nb_test -= hnc::test::warning(dst(nb_row - 1, nb_col - 1) == -2. * m(nb_row - 1, nb_col - 1) && dst(0, 0) == -2. * m(0, 0), "hnc::algo::transform in place fails\n");
+	}
+
+	// reduce (deterministic)
+	{
+		double sequential = 0.;
+		for (std::size_t i = 0; i < nb_row; ++i) { for (std::size_t j = 0; j < nb_col; ++j) { sequential += m(i, j); } }
+
+		std::vector<double> results;
+		for (int const nb_thread : { 1, 2, 3, 5, 8 })
+		{
+			with_threads(nb_thread, [&]() { results.push_back(hnc::algo::reduce(m, 0., std::plus<double>(), hnc::algo::reduction_t::deterministic)); });
+		}
+		std::cout << "Deterministic sum = " << results.front() << " (sequential sum = " << sequential << ")" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(std::all_of(results.begin(), results.end(), [&results](double const r) { return r == results.front(); }), "hnc::algo::reduce deterministic depends on the number of threads\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(results.front() - sequential) < 1e-9 * sequential, "hnc::algo::reduce deterministic fails\n");
+
+		double fast_1 = 0.;
+		with_threads(1, [&]() { fast_1 = hnc::algo::reduce(m, 0., std::plus<double>()); });
+		double const fast = hnc::algo::reduce(m, 0., std::plus<double>(), hnc::algo::reduction_t::fast);
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(fast_1 - sequential) < 1e-9 * sequential && std::abs(fast - sequential) < 1e-9 * sequential, "hnc::algo::reduce fast fails\n");
+	}
+
+	// reduce with other monoids
+	{
+		double const max = hnc::algo::reduce(m, -std::numeric_limits<double>::infinity(), [](double const a, double const b) { return std::max(a, b); });
+		++nb_test;
+		nb_test -= hnc::test::warning(max == 1., "hnc::algo::reduce with max fails\n");
+
+		// Not commutative
+		hnc::vector2D<std::string> words(7, 5000);
+		hnc::algo::for_each_index(words, [](std::size_t const i, std::size_t const j, std::string & word) { word = std::string(1, char('a' + (i * 5000 + j) % 26)); });
+		std::string ref;
+		for (std::size_t i = 0; i < words.nb_row(); ++i) { for (std::size_t j = 0; j < words.nb_col(); ++j) { ref += words(i, j); } }
+		for (hnc::algo::reduction_t const reduction : { hnc::algo::reduction_t::fast, hnc::algo::reduction_t::deterministic })
+		{
+			for (int const nb_thread : { 1, 4 })
+			{
+				std::string r;
+				with_threads(nb_thread, [&]() { r = hnc::algo::reduce(words, std::string(), std::plus<std::string>(), reduction); });
+				++nb_test;
+				nb_test -= hnc::test::warning(r == ref, "hnc::algo::reduce does not keep the order with " + hnc::to_string(nb_thread) + " threads\n");
+			}
+		}
+
+		// bool result (the partial results are not in a std::vector<bool>)
+		hnc::vector2D<int> flags(7, 5000, 1);
+		for (hnc::algo::reduction_t const reduction : { hnc::algo::reduction_t::fast, hnc::algo::reduction_t::deterministic })
+		{
+			bool all_true = false;
+			bool all_true_with_0 = true;
+			with_threads(4, [&]() { all_true = hnc::algo::reduce(flags, true, std::logical_and<int>(), reduction); });
+			flags(6, 4999) = 0;
+			with_threads(4, [&]() { all_true_with_0 = hnc::algo::reduce(flags, true, std::logical_and<int>(), reduction); });
+			flags(6, 4999) = 1;
+			++nb_test;
+			nb_test -= hnc::test::warning(all_true && all_true_with_0 == false, "hnc::algo::reduce with std::logical_and fails\n");
+		}
+
+		// Empty matrix
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::algo::reduce(hnc::vector2D<int>(), 0, std::plus<int>()) == 0 && hnc::algo::reduce(hnc::vector2D<int>(3, 0), 1, std::multiplies<int>(), hnc::algo::reduction_t::deterministic) == 1, "hnc::algo::reduce of an empty matrix fails\n");
+	}
+
+	// map_rows
+	{
+		using row_t = hnc::vector2D<double, hnc::vector2D_storage::aligned_padded<double>>::line_const_ptr<double>;
+		std::vector<double> const row_sum = hnc::algo::map_rows(m, [](row_t const & row) { return row.sum(); });
+		std::vector<std::size_t> const row_size = hnc::algo::map_rows(m, [](row_t const & row) { return row.size(); });
+		bool ok = row_sum.size() == nb_row && row_size.size() == nb_row;
+		for (std::size_t i = 0; i < nb_row; ++i) { ok = ok && row_sum[i] == m[i].sum() && row_size[i] == nb_col; }
+		++nb_test;
+		nb_test -= hnc::test::warning(ok, "hnc::algo::map_rows fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::algo vector2D parallel: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,72 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include <cstdint>
+
+#include <hnc/aligned_allocator.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// std::vector with 64-byte alignment
+	{
+		std::vector<double, hnc::aligned_allocator<double>> v(1000, 1.);
+		++nb_test;
+		nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0, "hnc::aligned_allocator, std::vector<double> is not aligned on 64 bytes\n");
+		v.resize(5000, 2.);
+		++nb_test;
+		nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0 && v[999] == 1. && v[4999] == 2., "hnc::aligned_allocator, std::vector<double> resize fails\n");
+	}
+
+	// Other alignment and type
+	{
+		for (std::size_t n = 1; n < 100; ++n)
+		{
+			std::vector<char, hnc::aligned_allocator<char, 256>> v(n, 'a');
+			++nb_test;
+			nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(v.data()) % 256 == 0, "hnc::aligned_allocator, std::vector<char> of size " + hnc::to_string(n) + " is not aligned on 256 bytes\n");
+		}
+		std::vector<std::string, hnc::aligned_allocator<std::string, 32>> v(10, "hnc");
+		v.push_back("aligned");
+		++nb_test;
+		nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(v.data()) % 32 == 0 && v.front() == "hnc" && v.back() == "aligned", "hnc::aligned_allocator, std::vector<std::string> fails\n");
+	}
+
+	// Rebind (node-based container)
+	{
+		std::list<int, hnc::aligned_allocator<int>> l = { 1, 2, 3 };
+		l.push_front(0);
+		++nb_test;
+		nb_test -= hnc::test::warning(l.size() == 4 && l.front() == 0 && l.back() == 3, "hnc::aligned_allocator, std::list fails\n");
+	}
+
+	// Comparison
+	{
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::aligned_allocator<int>() == hnc::aligned_allocator<float>() && (hnc::aligned_allocator<int>() != hnc::aligned_allocator<int>()) == false, "hnc::aligned_allocator comparison fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::aligned_allocator: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
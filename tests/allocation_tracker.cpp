@@ -0,0 +1,101 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <vector>
+#include <memory>
+
+#include <hnc/allocation_tracker.hpp>
+#include <hnc/benchmark.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+hnc_allocation_tracker_define_global_operators();
+
+
+int main()
+{
+	int nb_test = 0;
+
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::allocation_tracker::installed(), "hnc::allocation_tracker: global operators must be installed\n");
+
+	// hnc::allocation_tracker
+	{
+		hnc::allocation_tracker::start();
+		{
+			std::vector<int> v(1000);
+			std::unique_ptr<double> p(new double(42.));
+			std::unique_ptr<char[]> a(new char[100]);
+		}
+		std::vector<char> v(50);
+		hnc::allocation_tracker::values_t const values = hnc::allocation_tracker::stop();
+		std::cout << "hnc::allocation_tracker:" << std::endl;
+		std::cout << "- allocations:     " << values.nb_allocation << " (must be 4)" << std::endl;
+		std::cout << "- allocated bytes: " << values.nb_byte << " (must be " << 1000 * sizeof(int) + sizeof(double) + 100 + 50 << ")" << std::endl;
+		std::cout << "- peak live bytes: " << values.peak_live_byte << " (must be " << 1000 * sizeof(int) + sizeof(double) + 100 << ")" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(values.nb_allocation == 4, "hnc::allocation_tracker: must have 4 allocations\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(values.nb_byte == 1000 * sizeof(int) + sizeof(double) + 100 + 50, "hnc::allocation_tracker: allocated bytes are wrong\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(values.peak_live_byte == 1000 * sizeof(int) + sizeof(double) + 100, "hnc::allocation_tracker: peak live bytes are wrong\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark with allocation tracker
+	{
+		hnc::benchmark b;
+		b["reserve"].set_allocation_tracker();
+		b["push_back"].set_allocation_tracker();
+		for (std::size_t run = 0; run < 3; ++run)
+		{
+			b["reserve"].start();
+			{
+				std::vector<int> v;
+				v.reserve(1000);
+				for (int i = 0; i < 1000; ++i) { v.push_back(i); }
+			}
+			b["reserve"].stop();
+
+			b["push_back"].start();
+			{
+				std::vector<int> v;
+				for (int i = 0; i < 1000; ++i) { v.push_back(i); }
+			}
+			b["push_back"].stop();
+		}
+
+		std::cout << b << std::endl;
+		std::cout << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(b["reserve"].has_allocation_tracker() && b["reserve"].all_allocations.size() == 3, "hnc::benchmark with allocation tracker: must have 3 allocations values\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b["reserve"].allocations_mean()[0] == 1, "hnc::benchmark with allocation tracker: reserve must have 1 allocation\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b["push_back"].allocations_mean()[0] > 1, "hnc::benchmark with allocation tracker: push_back must have more than 1 allocation\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b["reserve"].all_allocations.back().peak_live_byte == 1000 * sizeof(int), "hnc::benchmark with allocation tracker: peak live bytes of reserve must be 4000\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::allocation_tracker: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
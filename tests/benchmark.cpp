@@ -17,6 +17,8 @@
 
 
 #include <iostream>
+#include <cmath>
+#include <stdexcept>
 
 #include <hnc/benchmark.hpp>
 #include <hnc/ostream_std.hpp>
@@ -102,6 +104,64 @@ int main()
 	nb_test -= hnc::test::warning(b["Test 3"].median() == 1., "hnc::benchmark Test 3: min is not 1.\n");
 	std::cout << std::endl;
 
+	b["Test 4"].set_streaming();
+	b["Test 4"].push_back(20.);
+	b["Test 4"].push_back(0.);
+	b["Test 4"].push_back(1.);
+	b["Test 4"].push_back(10.);
+	b["Test 4"].push_back(1.);
+	b["Test 4"].push_back(1.);
+	std::cout << "Test 4 (streaming) have " << b["Test 4"].size() << " times (must be 6)" << std::endl;
+	std::cout << "Test 4: min:    " << b["Test 4"].min() << " seconds (must be 0.)" << std::endl;
+	std::cout << "Test 4: max:    " << b["Test 4"].max() << " seconds (must be 20.)" << std::endl;
+	std::cout << "Test 4: mean:   " << b["Test 4"].mean() << " seconds (must be 5.5)" << std::endl;
+	std::cout << "Test 4: median: " << b["Test 4"].median() << " seconds (must be close to 1)" << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Test 4"].all.empty() && b["Test 4"].size() == 6, "hnc::benchmark Test 4: must be have 6 times and no saved time\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Test 4"].min() == 0. && b["Test 4"].max() == 20., "hnc::benchmark Test 4: min and max are not 0. and 20.\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(std::abs(b["Test 4"].mean() - 5.5L) <= 1e-12L * 5.5L, "hnc::benchmark Test 4: mean is not 5.5\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Test 4"].median() >= 0.98 && b["Test 4"].median() <= 1.02, "hnc::benchmark Test 4: median is not close to 1.\n");
+	// Welford (streaming) and two-pass (Test 3) variances can differ in the last bits
+	++nb_test;
+	nb_test -= hnc::test::warning(std::abs(b["Test 4"].variance() - b["Test 3"].variance()) <= 1e-12L * b["Test 3"].variance(), "hnc::benchmark Test 4: variance is not the same as Test 3\n");
+	std::cout << std::endl;
+
+	// The running statistics are updated in streaming mode only, a quantile without elapsed time is an error
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Test 3"].statistics().size() == 0 && b["Test 4"].statistics().size() == 6, "hnc::benchmark: the statistics must be updated in streaming mode only\n");
+	#ifndef NDEBUG
+		++nb_test;
+		try { b["Empty"].quantile(0.5); }
+		catch (std::length_error const &) { --nb_test; }
+		b.erase("Empty");
+	#endif
+
+	{
+		std::size_t const nb_iteration = 1000;
+		double x = 2.;
+		b["Test 5"].start();
+		for (std::size_t i = 0; i < nb_iteration; ++i)
+		{
+			x = x * 1.000001;
+			hnc::do_not_optimize(x);
+		}
+		b["Test 5"].stop(nb_iteration);
+		hnc::clobber_memory();
+		b["Test 6"].start();
+		for (std::size_t i = 0; i < nb_iteration; ++i) { hnc::do_not_optimize(x); }
+		b["Test 6"].stop();
+	}
+	std::cout << "Test 5 (batch of 1000 iterations) took " << b["Test 5"].all.back() << " seconds per iteration (must be close to 0 second)" << std::endl;
+	std::cout << "Test 6 (1000 iterations) took " << b["Test 6"].all.back() << " seconds" << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Test 5"].nb_iteration() == 1000 && b["Test 6"].nb_iteration() == 1, "hnc::benchmark Test 5: number of iterations must be 1000 and 1\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Test 5"].all.size() == 1 && b["Test 5"].all.back() < 0.001, "hnc::benchmark Test 5: time of one iteration must be < 0.001 second\n");
+	std::cout << std::endl;
+
 	std::cout << hnc::benchmark_extract_mean(b) << std::endl;
 	std::cout << std::endl;
 
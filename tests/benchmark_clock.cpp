@@ -0,0 +1,83 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+
+#include <hnc/benchmark.hpp>
+#include <hnc/ostream_std.hpp>
+#include <hnc/sleep.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Steady clock
+	{
+		std::cout << "hnc::benchmark_clock::steady:" << std::endl;
+		std::cout << "- ticks per second = " << hnc::benchmark_clock::steady::ticks_per_second() << std::endl;
+		std::cout << "- overhead         = " << hnc::benchmark_clock::steady::overhead() << " ticks" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_clock::steady::overhead() == 0, "hnc::benchmark_clock::steady: overhead must be 0\n");
+		std::cout << std::endl;
+	}
+
+	// TSC
+	{
+		std::cout << "hnc::benchmark_clock::tsc:" << std::endl;
+		std::cout << "- ticks per second = " << hnc::benchmark_clock::tsc::ticks_per_second() << std::endl;
+		std::cout << "- overhead         = " << hnc::benchmark_clock::tsc::overhead() << " ticks" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_clock::tsc::ticks_per_second() > 0, "hnc::benchmark_clock::tsc: ticks per second must be > 0\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark_t with TSC
+	{
+		hnc::benchmark_t<hnc::benchmark_clock::tsc> b;
+
+		b["Empty"].start();
+		b["Empty"].stop();
+
+		b["Sleep 10 ms"].start();
+		hnc::sleep::ms(10);
+		b["Sleep 10 ms"].stop();
+
+		std::cout << "Empty took       " << b["Empty"].all.back() << " s = " << b["Empty"].all_ticks.back() << " ticks (must be close to 0)" << std::endl;
+		std::cout << "Sleep 10 ms took " << b["Sleep 10 ms"].all.back() << " s = " << b["Sleep 10 ms"].all_ticks.back() << " ticks (must be close to 0.01 s)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(b["Empty"].all_ticks.size() == 1 && b["Empty"].all.size() == 1, "hnc::benchmark_t<hnc::benchmark_clock::tsc>: must have 1 time and 1 tick count\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b["Sleep 10 ms"].all.back() >= 0.009 && b["Sleep 10 ms"].all.back() <= 0.5, "hnc::benchmark_t<hnc::benchmark_clock::tsc>: sleep 10 ms took " + hnc::to_string(b["Sleep 10 ms"].all.back()) + " s\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b["Empty"].all.back() < b["Sleep 10 ms"].all.back(), "hnc::benchmark_t<hnc::benchmark_clock::tsc>: empty is not faster than sleep\n");
+		std::cout << std::endl;
+
+		std::cout << hnc::benchmark_extract_mean(b) << std::endl;
+		std::cout << std::endl;
+
+		std::cout << b << std::endl;
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_clock: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
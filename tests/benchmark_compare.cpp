@@ -0,0 +1,109 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+
+#include <hnc/benchmark_compare.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Baseline
+	hnc::benchmark baseline;
+	// Benchmark: "slower" is 20% slower, "noise" has the same distribution, "faster" is 20% faster
+	hnc::benchmark b;
+	for (std::size_t i = 0; i < 20; ++i)
+	{
+		double const noise = 1. + 0.01 * double(i % 5);
+		baseline["slower"].push_back(1. * noise);
+		baseline["noise"].push_back(1. * noise);
+		baseline["faster"].push_back(1. * noise);
+		baseline["only in baseline"].push_back(1.);
+		b["slower"].push_back(1.2 * noise);
+		b["noise"].push_back(1. * (1. + 0.01 * double((i + 2) % 5)));
+		b["faster"].push_back(0.8 * noise);
+		b["only in benchmark"].push_back(1.);
+	}
+
+	auto const comparisons = hnc::benchmark_compare(baseline, b);
+	std::cout << hnc::benchmark_comparison_tabular(comparisons, "Comparison with the baseline") << std::endl;
+	std::cout << std::endl;
+
+	++nb_test;
+	nb_test -= hnc::test::warning(comparisons.size() == 3, "hnc::benchmark_compare: must have 3 comparisons\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(comparisons.at("slower").is_regression(), "hnc::benchmark_compare: slower must be a regression\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(comparisons.at("noise").significant == false, "hnc::benchmark_compare: noise must not be significant\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(comparisons.at("faster").is_improvement(), "hnc::benchmark_compare: faster must be an improvement\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::benchmark_has_regression(comparisons), "hnc::benchmark_has_regression: must have a regression\n");
+
+	// With a baseline file
+	{
+		hnc::benchmark_save("hnc_benchmark_compare_baseline.json", baseline);
+		auto const comparisons_file = hnc::benchmark_compare("hnc_benchmark_compare_baseline.json", b);
+		hnc::filesystem::remove("hnc_benchmark_compare_baseline.json");
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			comparisons_file.size() == 3 && comparisons_file.at("slower").p_value == comparisons.at("slower").p_value,
+			"hnc::benchmark_compare: comparison with a baseline file must be the same\n"
+		);
+	}
+
+	// Streaming benchmark (no elapsed times in .all): not testable, never a regression
+	{
+		hnc::benchmark b_streaming;
+		b_streaming["slower"].set_streaming();
+		for (std::size_t i = 0; i < 20; ++i) { b_streaming["slower"].push_back(2. * (1. + 0.01 * double(i % 5))); }
+		auto const comparisons_streaming = hnc::benchmark_compare(baseline, b_streaming);
+		std::cout << hnc::benchmark_comparison_tabular(comparisons_streaming, "Comparison of a streaming benchmark with the baseline") << std::endl;
+		std::cout << std::endl;
+		hnc::benchmark_comparison const & c = comparisons_streaming.at("slower");
+		++nb_test;
+		nb_test -= hnc::test::warning(c.testable == false && c.significant == false && c.is_regression() == false && c.relative_change > 0.9L, "hnc::benchmark_compare: streaming benchmark must not be testable\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_has_not_testable(comparisons_streaming) && hnc::benchmark_has_not_testable(comparisons) == false, "hnc::benchmark_has_not_testable fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_comparison_tabular(comparisons_streaming, "").to_string().find("not testable") != std::string::npos, "hnc::benchmark_comparison_tabular: streaming benchmark must be \"not testable\"\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(comparisons.at("slower").testable, "hnc::benchmark_compare: slower must be testable\n");
+	}
+
+	// hnc::benchmark_name_opt
+	{
+		hnc::benchmark_name_opt baseline_name_opt;
+		hnc::benchmark_name_opt b_name_opt;
+		baseline_name_opt["Test"]["option"] = baseline["slower"];
+		b_name_opt["Test"]["option"] = b["slower"];
+		auto const comparisons_name_opt = hnc::benchmark_compare(baseline_name_opt, b_name_opt);
+		++nb_test;
+		nb_test -= hnc::test::warning(comparisons_name_opt.size() == 1 && comparisons_name_opt.at("Test[option]").is_regression(), "hnc::benchmark_compare: Test[option] must be a regression\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_compare: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
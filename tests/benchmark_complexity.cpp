@@ -0,0 +1,62 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <map>
+#include <cmath>
+
+#include <hnc/benchmark_complexity.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	for (auto const complexity : hnc::complexities())
+	{
+		// Times of the complexity (with 5% of noise)
+		std::map<std::size_t, long double> times;
+		long double noise = 1.05L;
+		for (std::size_t n = 16; n <= 65536; n *= 2)
+		{
+			times[n] = 1e-9L * hnc::complexity_function(complexity, (long double)(n)) * noise;
+			noise = 2.L - noise;
+		}
+
+		// Fits
+		std::cout << "Times in " << complexity << ":" << std::endl;
+		for (auto const & fit : hnc::benchmark_complexity_fits(times))
+		{
+			std::cout << "- " << fit.complexity << ": coefficient = " << fit.coefficient << ", rms = " << fit.rms << std::endl;
+		}
+
+		hnc::complexity_fit const best = hnc::benchmark_complexity_best_fit(times);
+		std::cout << "Best fit: " << best.complexity << " (must be " << complexity << ")" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(best.complexity == complexity, "hnc::benchmark_complexity_best_fit: best fit must be " + hnc::to_string(complexity) + "\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(best.coefficient - 1e-9L) < 1e-10L, "hnc::benchmark_complexity_best_fit: coefficient must be close to 1e-9\n");
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_complexity: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
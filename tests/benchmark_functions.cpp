@@ -19,6 +19,9 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <tuple>
+#include <functional>
 
 #include <hnc/benchmark_functions.hpp>
 #include <hnc/sleep.hpp>
@@ -68,6 +71,133 @@ int main()
 		std::cout << std::endl;
 	}
 
+	// With hardware performance counters
+	{
+		std::vector<double> v(100000, 1.);
+		auto benchmark_functions = hnc::benchmark_functions
+		(
+			{
+				{ [&]() -> void { double sum = 0; for (double const x : v) { sum += x; } v[0] = sum; }, "sum" },
+				{ [&]() -> void { std::sort(v.begin(), v.end()); }, "sort" }
+			},
+			"Title",
+			"hnc_benchmark_functions_perf_counters_gnuplot",
+			3,
+			"Versions",
+			"Time (in second)",
+			true
+		);
+		hnc::benchmark const & benchmark = std::get<0>(benchmark_functions);
+		hnc::tabular const & tabular = std::get<2>(benchmark_functions);
+
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("sum").all.size() == 3 && benchmark.at("sort").all.size() == 3, "hnc::benchmark_functions: versions must have 3 times\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("sum").has_perf_counters() == false || tabular.nb_row() > 1, "hnc::benchmark_functions: tabular must have hardware performance counters\n");
+
+		// Bench
+		std::cout << benchmark << std::endl;
+		std::cout << std::endl;
+
+		// Tabular
+		std::cout << tabular << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Auto-calibrated batches of iterations
+	{
+		double x = 2.;
+		auto const small_function = [&]() -> void { x = x * 1.000001; hnc::do_not_optimize(x); };
+
+		std::size_t const nb_iteration = hnc::benchmark_calibrate(small_function, 0.001);
+		std::cout << "hnc::benchmark_calibrate: " << nb_iteration << " iterations for 0.001 second" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(nb_iteration > 1, "hnc::benchmark_calibrate: number of iterations must be > 1\n");
+
+		auto benchmark_functions = hnc::benchmark_functions
+		(
+			{
+				{ small_function, "small" },
+				{ []() -> void { hnc::sleep::ms(2); }, "sleep" }
+			},
+			"Title",
+			"hnc_benchmark_functions_calibrate_gnuplot",
+			3,
+			"Versions",
+			"Time (in second)",
+			false,
+			0.001
+		);
+		hnc::benchmark const & benchmark = std::get<0>(benchmark_functions);
+
+		std::cout << benchmark << std::endl;
+		std::cout << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("small").nb_iteration() > 1 && benchmark.at("sleep").nb_iteration() == 1, "hnc::benchmark_functions: number of iterations must be > 1 for small and 1 for sleep\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("small").median() < 0.0001, "hnc::benchmark_functions: time of one iteration of small must be < 0.0001 second\n");
+	}
+
+	// Shuffled order, warmup runs and CPU pinning
+	{
+		std::size_t nb_call_v0 = 0;
+		std::size_t nb_call_v1 = 0;
+		auto benchmark_functions = hnc::benchmark_functions
+		(
+			hnc::benchmark_policy().set_shuffle().set_nb_warmup_run(2).set_cpu(0),
+			{
+				{ [&]() -> void { ++nb_call_v0; hnc::sleep::ms(1); }, "v0" },
+				{ [&]() -> void { ++nb_call_v1; hnc::sleep::ms(2); }, "v1" }
+			},
+			"Title",
+			"hnc_benchmark_functions_policy_gnuplot",
+			5
+		);
+		hnc::benchmark const & benchmark = std::get<0>(benchmark_functions);
+		hnc::benchmark_policy const & policy = std::get<3>(benchmark_functions);
+
+		std::cout << "Policy used: " << policy << std::endl;
+		std::cout << benchmark << std::endl;
+		std::cout << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(nb_call_v0 == 7 && nb_call_v1 == 7, "hnc::benchmark_functions: versions must be called 7 times (2 warmup runs + 5 runs)\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("v0").all.size() == 5 && benchmark.at("v1").all.size() == 5, "hnc::benchmark_functions: warmup runs must be discarded\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(policy.shuffle() && policy.nb_warmup_run() == 2 && policy.seed() != 0, "hnc::benchmark_functions: policy used must be recorded with its seed\n");
+	}
+
+	// Warmup runs in shuffled order
+	{
+		std::vector<std::string> calls;
+		hnc::benchmark_functions
+		(
+			hnc::benchmark_policy().set_shuffle().set_nb_warmup_run(20).set_seed(42),
+			{
+				{ [&]() -> void { calls.push_back("v0"); }, "v0" },
+				{ [&]() -> void { calls.push_back("v1"); }, "v1" }
+			},
+			"Title",
+			"hnc_benchmark_functions_warmup_gnuplot",
+			1
+		);
+		std::size_t nb_warmup_run_v1_first = 0;
+		for (std::size_t run = 0; run < 20; ++run) { if (calls.at(2 * run) == "v1") { ++nb_warmup_run_v1_first; } }
+		++nb_test;
+		nb_test -= hnc::test::warning(calls.size() == 42 && nb_warmup_run_v1_first > 0 && nb_warmup_run_v1_first < 20, "hnc::benchmark_functions: warmup runs must be shuffled\n");
+	}
+
+	// Without policy: the tuple has 3 elements
+	{
+		hnc::benchmark benchmark;
+		std::tie(benchmark, std::ignore, std::ignore) = hnc::benchmark_functions({ { []() -> void { }, "v0" } }, "Title", "hnc_benchmark_functions_tie_gnuplot", 2);
+		static_assert(std::tuple_size<decltype(hnc::benchmark_functions(std::vector<std::pair<std::function<void()>, std::string>>(), "", ""))>::value == 3, "hnc::benchmark_functions without policy must return 3 values");
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("v0").all.size() == 2, "hnc::benchmark_functions: std::tie with 3 values fails\n");
+	}
+
 	hnc::test::warning(nb_test == 0, "hnc::benchmark_functions: " + hnc::to_string(nb_test) + " test fail!\n");
 
 	return nb_test;
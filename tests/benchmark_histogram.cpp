@@ -0,0 +1,103 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <cmath>
+
+#include <hnc/benchmark_histogram.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	hnc::benchmark b;
+
+	// Histogram mode
+	b["Histogram"].set_histogram(1, 3);
+	// Exact mode
+	b["Exact"];
+	for (std::size_t i = 1; i <= 1000; ++i)
+	{
+		b["Histogram"].push_back(double(i) * 1e-6);
+		b["Exact"].push_back(double(i) * 1e-6);
+	}
+	// Saturated
+	b["Histogram"].push_back(10.);
+
+	std::cout << "Histogram mode:" << std::endl;
+	std::cout << "- is streaming = " << b["Histogram"].is_streaming() << " (must be 1)" << std::endl;
+	std::cout << "- size         = " << b["Histogram"].size() << " (must be 1001)" << std::endl;
+	std::cout << "- median       = " << b["Histogram"].median() << " (must be close to 0.000501)" << std::endl;
+	std::cout << "- p99          = " << b["Histogram"].quantile(0.99) << " (must be close to 0.000991)" << std::endl;
+	std::cout << "- max          = " << b["Histogram"].max() << " (must be 10)" << std::endl;
+	std::cout << "- nb saturated = " << b["Histogram"].histogram().nb_saturated() << " (must be 1)" << std::endl;
+	std::cout << std::endl;
+
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Histogram"].has_histogram() && b["Histogram"].is_streaming() && b["Histogram"].all.empty(), "hnc::benchmark_base::set_histogram: histogram mode must be a streaming mode\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Histogram"].size() == 1001 && b["Histogram"].histogram().size() == 1001, "hnc::benchmark_base::set_histogram: size must be 1001\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(std::abs(b["Histogram"].median() - 0.000501L) <= 0.000501L * 0.001L, "hnc::benchmark_base::median: median is " + hnc::to_string(b["Histogram"].median()) + " instead of 0.000501\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(b["Histogram"].max() == 10 && b["Histogram"].histogram().nb_saturated() == 1, "hnc::benchmark_base::max: max must be exact\n");
+
+	// Disable
+	{
+		hnc::benchmark_base bench;
+		bench.set_histogram();
+		bench.set_histogram(false);
+		++nb_test;
+		nb_test -= hnc::test::warning(bench.has_histogram() == false && bench.is_streaming(), "hnc::benchmark_base::set_histogram: the streaming mode must stay enabled\n");
+		bench.set_histogram();
+		bench.set_streaming(false);
+		++nb_test;
+		nb_test -= hnc::test::warning(bench.has_histogram() == false, "hnc::benchmark_base::set_streaming: the histogram mode must be disabled\n");
+	}
+
+	// Tabulars
+	std::cout << hnc::benchmark_percentile_tabular(b, "Percentiles (s)") << std::endl;
+	std::cout << std::endl;
+	hnc::tabular const histogram_tabular = hnc::hdr_histogram_tabular(hnc::benchmark_histograms(b), "Percentiles (ns)");
+	std::cout << histogram_tabular << std::endl;
+	std::cout << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::benchmark_histograms(b).size() == 1, "hnc::benchmark_histograms: only one test has a histogram\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::benchmark_percentile_name(99.9) == "p99.9", "hnc::benchmark_percentile_name: name of 99.9 must be p99.9\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::benchmark_percentile_key(9.) < hnc::benchmark_percentile_key(99.999), "hnc::benchmark_percentile_key: keys must be sorted\n");
+
+	// Gnuplots
+	{
+		hnc::gnuplot::gnuplot_lines gp = hnc::benchmark_cdf_gnuplot(b, "Percentile distribution", "hnc_benchmark_histogram_gnuplot");
+		++nb_test;
+		nb_test -= hnc::test::warning(gp.plots().size() == 2, "hnc::benchmark_cdf_gnuplot: must have 2 lines\n");
+		hnc::gnuplot::gnuplot_lines gp_histogram = hnc::hdr_histogram_gnuplot(hnc::benchmark_histograms(b), "Percentile distribution", "hnc_hdr_histogram_gnuplot", 1e-9L, "Time (s)");
+		++nb_test;
+		nb_test -= hnc::test::warning(gp_histogram.plots().size() == 1, "hnc::hdr_histogram_gnuplot: must have 1 line\n");
+		std::cout << gp_histogram.script() << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_histogram: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
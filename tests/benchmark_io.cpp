@@ -0,0 +1,192 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <locale>
+
+#include <hnc/benchmark_io.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+/// @brief Numeric punctuation with a comma as decimal point
+class comma_numpunct : public std::numpunct<char>
+{
+protected:
+
+	char do_decimal_point() const override { return ','; }
+};
+
+int main()
+{
+	int nb_test = 0;
+
+	hnc::benchmark b;
+	b["Test 0"].push_back(0.1);
+	b["Test 0"].push_back(0.3);
+	b["Test 0"].push_back(0.2);
+	b["Test \"1\", with comma"].push_back(1.5);
+	b["Test 2 (streaming)"].set_streaming();
+	b["Test 2 (streaming)"].push_back(2.);
+
+	hnc::benchmark_name_opt b_name_opt;
+	b_name_opt["Test"]["option 0"].push_back(0.5);
+	b_name_opt["Test"]["option 0"].push_back(0.25);
+	b_name_opt["Test"]["option 1"].push_back(1e-9);
+
+	// operator << writes in the given stream
+	{
+		std::ostringstream o;
+		o << b;
+		++nb_test;
+		nb_test -= hnc::test::warning(o.str().find("Test 0:\n") != std::string::npos, "hnc::benchmark: operator << must write in the given stream\n");
+	}
+
+	// JSON
+	{
+		std::string const json = hnc::benchmark_to_json(b);
+		std::cout << json << std::endl;
+		hnc::benchmark const b_loaded = hnc::benchmark_from_json(json);
+		++nb_test;
+		nb_test -= hnc::test::warning(b_loaded.size() == 3, "hnc::benchmark_from_json: must have 3 tests\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b_loaded.at("Test 0").all == b.at("Test 0").all, "hnc::benchmark_from_json: elapsed times of Test 0 are wrong\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b_loaded.at("Test \"1\", with comma").all.size() == 1, "hnc::benchmark_from_json: Test \"1\", with comma must have 1 elapsed time\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b_loaded.at("Test 2 (streaming)").median() == 2., "hnc::benchmark_from_json: median of Test 2 (streaming) must be 2\n");
+
+		std::string const json_name_opt = hnc::benchmark_to_json(b_name_opt);
+		std::cout << json_name_opt << std::endl;
+		hnc::benchmark_name_opt const b_name_opt_loaded = hnc::benchmark_name_opt_from_json(json_name_opt);
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			b_name_opt_loaded.at("Test").at("option 0").all == b_name_opt.at("Test").at("option 0").all &&
+			b_name_opt_loaded.at("Test").at("option 1").all == b_name_opt.at("Test").at("option 1").all,
+			"hnc::benchmark_name_opt_from_json: elapsed times are wrong\n"
+		);
+
+		++nb_test;
+		try { hnc::benchmark_from_json("{ \"Test\": [ }"); }
+		catch (std::invalid_argument const & e) { std::cout << "Invalid JSON: " << e.what() << std::endl; --nb_test; }
+	}
+
+	// JSON with metadata
+	{
+		std::map<std::string, std::string> const metadata = { { "processor", "Test \"CPU\"" }, { "L1", "32768" } };
+		std::string const json = hnc::benchmark_to_json(b_name_opt, metadata);
+		std::cout << json << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_metadata_from_json(json) == metadata, "hnc::benchmark_metadata_from_json: metadata are wrong\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_name_opt_from_json(json).at("Test").at("option 0").all == b_name_opt.at("Test").at("option 0").all, "hnc::benchmark_name_opt_from_json: elapsed times with metadata are wrong\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_from_json(hnc::benchmark_to_json(b, metadata)).at("Test 0").all == b.at("Test 0").all, "hnc::benchmark_from_json: elapsed times with metadata are wrong\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_metadata_from_json(hnc::benchmark_to_json(b)).empty(), "hnc::benchmark_metadata_from_json: metadata must be empty without metadata\n");
+	}
+
+	// CSV
+	{
+		std::string const csv = hnc::benchmark_to_csv(b);
+		std::cout << csv << std::endl;
+		hnc::benchmark const b_loaded = hnc::benchmark_from_csv(csv);
+		++nb_test;
+		nb_test -= hnc::test::warning(b_loaded.size() == 3 && b_loaded.at("Test 0").all == b.at("Test 0").all, "hnc::benchmark_from_csv: elapsed times of Test 0 are wrong\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b_loaded.at("Test \"1\", with comma").all.size() == 1, "hnc::benchmark_from_csv: Test \"1\", with comma must have 1 elapsed time\n");
+
+		std::string const csv_name_opt = hnc::benchmark_to_csv(b_name_opt);
+		std::cout << csv_name_opt << std::endl;
+		hnc::benchmark_name_opt const b_name_opt_loaded = hnc::benchmark_name_opt_from_csv(csv_name_opt);
+		++nb_test;
+		nb_test -= hnc::test::warning(b_name_opt_loaded.at("Test").at("option 0").all == b_name_opt.at("Test").at("option 0").all, "hnc::benchmark_name_opt_from_csv: elapsed times are wrong\n");
+	}
+
+	// Round trip of measured elapsed times (long double, not representable as double)
+	{
+		hnc::benchmark measured;
+		for (std::size_t i = 0; i < 20; ++i)
+		{
+			measured["Measured"].start();
+			double volatile x = 0;
+			for (std::size_t j = 0; j < 100 * i; ++j) { x = x + 1.; }
+			measured["Measured"].stop(3);
+		}
+		measured["Measured"].push_back(1.L / 3.L);
+		hnc::benchmark_name_opt measured_name_opt;
+		measured_name_opt["Measured"]["option"] = measured.at("Measured");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_from_json(hnc::benchmark_to_json(measured)).at("Measured").all == measured.at("Measured").all, "hnc::benchmark_from_json: measured elapsed times do not round trip\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_from_csv(hnc::benchmark_to_csv(measured)).at("Measured").all == measured.at("Measured").all, "hnc::benchmark_from_csv: measured elapsed times do not round trip\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_name_opt_from_json(hnc::benchmark_to_json(measured_name_opt)).at("Measured").at("option").all == measured.at("Measured").all, "hnc::benchmark_name_opt_from_json: measured elapsed times do not round trip\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::benchmark_name_opt_from_csv(hnc::benchmark_to_csv(measured_name_opt)).at("Measured").at("option").all == measured.at("Measured").all, "hnc::benchmark_name_opt_from_csv: measured elapsed times do not round trip\n");
+	}
+
+	// The global locale is ignored
+	{
+		std::locale const previous_locale = std::locale::global(std::locale(std::locale::classic(), new comma_numpunct()));
+		std::string const json = hnc::benchmark_to_json(b);
+		std::string const csv = hnc::benchmark_to_csv(b);
+		bool const json_ok = json.find("0,1") == std::string::npos && hnc::benchmark_from_json(json).at("Test 0").all == b.at("Test 0").all;
+		bool const csv_ok = hnc::benchmark_from_csv(csv).at("Test 0").all == b.at("Test 0").all;
+		std::locale::global(previous_locale);
+		++nb_test;
+		nb_test -= hnc::test::warning(json_ok, "hnc::benchmark_to_json and hnc::benchmark_from_json must not depend on the global locale\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(csv_ok, "hnc::benchmark_to_csv and hnc::benchmark_from_csv must not depend on the global locale\n");
+
+		++nb_test;
+		try { hnc::benchmark_from_csv("name,time\nTest,0.1x\n"); }
+		catch (std::invalid_argument const & e) { std::cout << "Invalid CSV: " << e.what() << std::endl; --nb_test; }
+	}
+
+	// Files
+	{
+		hnc::benchmark_save("hnc_benchmark_io.json", b);
+		hnc::benchmark_save("hnc_benchmark_io.csv", b);
+		hnc::benchmark_save("hnc_benchmark_io_name_opt.json", b_name_opt, { { "processor", "Test CPU" } });
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			hnc::benchmark_load("hnc_benchmark_io.json").at("Test 0").all == b.at("Test 0").all &&
+			hnc::benchmark_load("hnc_benchmark_io.csv").at("Test 0").all == b.at("Test 0").all &&
+			hnc::benchmark_name_opt_load("hnc_benchmark_io_name_opt.json").at("Test").size() == 2 &&
+			hnc::benchmark_metadata_from_json(hnc::filesystem::read_file("hnc_benchmark_io_name_opt.json")).at("processor") == "Test CPU",
+			"hnc::benchmark_load: loaded benchmarks are wrong\n"
+		);
+		hnc::filesystem::remove("hnc_benchmark_io.json");
+		hnc::filesystem::remove("hnc_benchmark_io.csv");
+		hnc::filesystem::remove("hnc_benchmark_io_name_opt.json");
+	}
+
+	std::cout << std::endl;
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_io: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,105 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <tuple>
+
+#include <hnc/benchmark_memory.hpp>
+#include <hnc/ostream_std.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	hnc::computer::topology_t const topology = hnc::computer::topology();
+
+	// hnc::benchmark_machine_metadata
+	{
+		std::map<std::string, std::string> const metadata = hnc::benchmark_machine_metadata(topology);
+		std::cout << "hnc::benchmark_machine_metadata() = " << metadata << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(metadata.at("topology") == topology.to_string(), "hnc::benchmark_machine_metadata: metadata must have the topology\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark_memory_working_set_sizes
+	{
+		std::vector<std::size_t> const sizes = hnc::benchmark_memory_working_set_sizes(topology);
+		std::cout << "hnc::benchmark_memory_working_set_sizes() = " << sizes << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(sizes.front() == 4096 && sizes.back() >= (std::size_t(8) << 20) && sizes.back() <= (std::size_t(256) << 20), "hnc::benchmark_memory_working_set_sizes: sizes must be from 4 KiB to [8 MiB, 256 MiB]\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark_memory_latency
+	{
+		auto benchmark_latency = hnc::benchmark_memory_latency({ 4096, 65536 }, "Memory latency", "hnc_benchmark_memory_latency_gnuplot", 2, 10000);
+		hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_latency);
+		hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_latency);
+		hnc::tabular const & tabular = std::get<2>(benchmark_latency);
+		std::cout << benchmark << std::endl;
+		std::cout << gnuplot.script() << std::endl;
+		std::cout << tabular << std::endl;
+		std::cout << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("pointer chasing").size() == 2 && benchmark.at("pointer chasing").at(hnc::benchmark_memory_size_key(4096)).all.size() == 2, "hnc::benchmark_memory_latency: benchmark must have 2 sizes with 2 times\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(tabular.nb_row() == 2 && tabular.nb_col() == 2, "hnc::benchmark_memory_latency: tabular must have 2 rows and 2 columns\n");
+	}
+
+	// hnc::benchmark_memory_bandwidth
+	{
+		auto benchmark_bandwidth = hnc::benchmark_memory_bandwidth(1 << 20, { 1 }, "Memory bandwidth", "hnc_benchmark_memory_bandwidth_gnuplot", 2);
+		hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_bandwidth);
+		hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_bandwidth);
+		hnc::tabular const & tabular = std::get<2>(benchmark_bandwidth);
+		std::cout << benchmark << std::endl;
+		std::cout << gnuplot.script() << std::endl;
+		std::cout << tabular << std::endl;
+		std::cout << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.size() == 3 && benchmark.at("copy").at("1").all.size() == 2, "hnc::benchmark_memory_bandwidth: benchmark must have read, write and copy with 2 times\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(tabular.nb_row() == 1 && tabular.nb_col() == 4, "hnc::benchmark_memory_bandwidth: tabular must have 1 row and 4 columns\n");
+	}
+
+	// hnc::benchmark_cache_line_ping_pong
+	{
+		std::vector<std::pair<int, int>> const cpu_pairs = hnc::benchmark_cache_line_ping_pong_cpu_pairs(topology);
+		++nb_test;
+		nb_test -= hnc::test::warning(cpu_pairs.empty() == false && cpu_pairs.front().first == 0, "hnc::benchmark_cache_line_ping_pong_cpu_pairs: pairs must begin with cpu 0\n");
+		auto benchmark_ping_pong = hnc::benchmark_cache_line_ping_pong({ cpu_pairs.front() }, "Cache line ping-pong", 2, 1000);
+		hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_ping_pong);
+		hnc::tabular const & tabular = std::get<1>(benchmark_ping_pong);
+		std::cout << benchmark << std::endl;
+		std::cout << tabular << std::endl;
+		std::cout << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("ping-pong").size() == 1 && benchmark.at("ping-pong").begin()->second.all.size() == 2, "hnc::benchmark_cache_line_ping_pong: benchmark must have 1 pair with 2 times\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_memory: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
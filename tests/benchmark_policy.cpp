@@ -0,0 +1,75 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+
+#include <hnc/benchmark_policy.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Default policy
+	{
+		hnc::benchmark_policy const policy;
+		std::cout << "Default policy: " << policy << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			policy.shuffle() == false && policy.nb_warmup_run() == 0 && policy.cpu() == -1 && policy.seed() == 0,
+			"hnc::benchmark_policy: default policy must be not shuffled, without warmup, not pinned\n"
+		);
+		++nb_test;
+		nb_test -= hnc::test::warning(policy.with_seed().seed() != 0, "hnc::benchmark_policy: with_seed must choose a seed\n");
+	}
+
+	// Policy
+	{
+		hnc::benchmark_policy policy;
+		policy.set_shuffle().set_nb_warmup_run(2).set_cpu(0).set_seed(42);
+		std::cout << "Policy: " << policy << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			policy.to_string() == "shuffle: 1, warmup runs: 2, cpu: 0, seed: 42",
+			"hnc::benchmark_policy: policy must be \"shuffle: 1, warmup runs: 2, cpu: 0, seed: 42\"\n"
+		);
+		++nb_test;
+		nb_test -= hnc::test::warning(policy.with_seed().seed() == 42, "hnc::benchmark_policy: with_seed must keep the seed\n");
+	}
+
+	// CPU pinning
+	{
+		{
+			hnc::benchmark_cpu_pinning const pinning(0);
+			std::cout << "Pinned on CPU 0: " << pinning.pinned() << std::endl;
+		}
+		hnc::benchmark_cpu_pinning const not_pinning(-1);
+		++nb_test;
+		nb_test -= hnc::test::warning(not_pinning.pinned() == false, "hnc::benchmark_cpu_pinning: CPU -1 must not be pinned\n");
+	}
+
+	std::cout << std::endl;
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_policy: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
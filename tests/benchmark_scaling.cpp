@@ -0,0 +1,106 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+
+#include <hnc/benchmark_scaling.hpp>
+#include <hnc/ostream_std.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// hnc::benchmark_nb_threads
+	{
+		std::vector<std::size_t> const nb_threads = hnc::benchmark_nb_threads(6);
+		std::cout << "hnc::benchmark_nb_threads(6) = " << nb_threads << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(nb_threads == std::vector<std::size_t>({ 1, 2, 4, 6 }), "hnc::benchmark_nb_threads: numbers of threads must be { 1, 2, 4, 6 }\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark_amdahl_serial_fraction
+	{
+		std::map<std::size_t, long double> speedups;
+		for (std::size_t p = 1; p <= 16; p *= 2) { speedups[p] = hnc::benchmark_amdahl_speedup(0.1L, p); }
+		long double const serial_fraction = hnc::benchmark_amdahl_serial_fraction(speedups);
+		std::cout << "Speedups = " << speedups << std::endl;
+		std::cout << "Serial fraction = " << serial_fraction << " (must be 0.1)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(serial_fraction - 0.1L) < 1e-6L, "hnc::benchmark_amdahl_serial_fraction: serial fraction must be 0.1\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark_scaling
+	{
+		std::vector<double> v(4000000, 2.);
+		std::vector<std::size_t> nb_threads_used;
+		auto benchmark_scaling = hnc::benchmark_scaling
+		(
+			[&](std::size_t const nb_thread) -> void
+			{
+				nb_threads_used.push_back(nb_thread);
+				long int const size = long(v.size());
+				#pragma omp parallel for
+				for (long int i = 0; i < size; ++i) { v[std::size_t(i)] = std::sqrt(v[std::size_t(i)] + 2.); }
+			},
+			hnc::benchmark_nb_threads(4),
+			"Title",
+			"hnc_benchmark_scaling_gnuplot",
+			3
+		);
+		hnc::benchmark const & benchmark = std::get<0>(benchmark_scaling);
+		hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_scaling);
+		hnc::tabular const & tabular = std::get<2>(benchmark_scaling);
+		long double const serial_fraction = std::get<3>(benchmark_scaling);
+
+		// Bench
+		std::cout << benchmark << std::endl;
+		std::cout << std::endl;
+
+		// Gnuplot
+		std::cout << gnuplot.script() << std::endl;
+		std::cout << std::endl;
+
+		// Tabular
+		std::cout << tabular << std::endl;
+		std::cout << std::endl;
+
+		std::cout << "Serial fraction = " << serial_fraction << std::endl;
+		std::cout << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.size() == 3 && benchmark.at("1").all.size() == 3, "hnc::benchmark_scaling: benchmark must have 3 numbers of threads with 3 times\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(nb_threads_used == std::vector<std::size_t>({ 1, 1, 1, 2, 2, 2, 4, 4, 4 }), "hnc::benchmark_scaling: workload must be called with 1, 2 and 4 threads\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(tabular.nb_row() == 3 && tabular.nb_col() == 4, "hnc::benchmark_scaling: tabular must have 3 rows and 4 columns\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(serial_fraction >= 0 && serial_fraction <= 1, "hnc::benchmark_scaling: serial fraction must be in [0, 1]\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_scaling: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
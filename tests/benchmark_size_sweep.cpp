@@ -0,0 +1,101 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <vector>
+#include <numeric>
+
+#include <hnc/benchmark_size_sweep.hpp>
+#include <hnc/ostream_std.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// hnc::benchmark_sizes
+	{
+		std::vector<std::size_t> const sizes = hnc::benchmark_sizes(8, 1000);
+		std::cout << "hnc::benchmark_sizes(8, 1000) = " << sizes << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(sizes == std::vector<std::size_t>({ 8, 16, 32, 64, 128, 256, 512, 1000 }), "hnc::benchmark_sizes: sizes must be { 8, 16, 32, 64, 128, 256, 512, 1000 }\n");
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark_size_sweep
+	{
+		std::vector<double> v;
+		auto benchmark_size_sweep = hnc::benchmark_size_sweep
+		(
+			{
+				{ [&](std::size_t const n) -> void { v.assign(n, 1.); hnc::do_not_optimize(std::accumulate(v.begin(), v.end(), 0.)); }, "accumulate" },
+				{
+					[&](std::size_t const n) -> void
+					{
+						v.assign(n, 1.);
+						double sum = 0;
+						for (double const x : v) { for (double const y : v) { sum += x * y; } }
+						hnc::do_not_optimize(sum);
+					},
+					"all pairs"
+				}
+			},
+			hnc::benchmark_sizes(256, 4096),
+			"Title",
+			"hnc_benchmark_size_sweep_gnuplot",
+			3,
+			"Size",
+			"Time (in second)",
+			0.001
+		);
+		hnc::benchmark_name_opt const & benchmark = std::get<0>(benchmark_size_sweep);
+		hnc::gnuplot::gnuplot_lines & gnuplot = std::get<1>(benchmark_size_sweep);
+		hnc::tabular const & tabular = std::get<2>(benchmark_size_sweep);
+
+		// Bench
+		std::cout << benchmark << std::endl;
+		std::cout << std::endl;
+
+		// Gnuplot
+		std::cout << gnuplot.script() << std::endl;
+		std::cout << std::endl;
+
+		// Tabular
+		std::cout << tabular << std::endl;
+		std::cout << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("accumulate").size() == 5 && benchmark.at("all pairs").size() == 5, "hnc::benchmark_size_sweep: versions must have 5 sizes\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(benchmark.at("accumulate").begin()->first == " 256", "hnc::benchmark_size_sweep: first size must be \" 256\"\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(tabular.nb_row() == 2 && tabular.nb_col() == 7, "hnc::benchmark_size_sweep: tabular must have 2 rows and 7 columns\n");
+
+		hnc::complexity_t const complexity = hnc::benchmark_complexity_best_fit(hnc::benchmark_extract_median_by_size(benchmark.at("all pairs"))).complexity;
+		std::cout << "Complexity of all pairs: " << complexity << " (must be O(n^2))" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(complexity == hnc::complexity_t::o_n2, "hnc::benchmark_size_sweep: complexity of all pairs must be O(n^2)\n");
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::benchmark_size_sweep: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
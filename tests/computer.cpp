@@ -14,18 +14,120 @@
 
 
 #include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
 
 #include <hnc/computer.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
 
 
 int main()
 {
+	int nb_test = 0;
+	
 	std::cout << "Computer system name    = " << hnc::computer::system_name() << std::endl;
 	std::cout << "Computer system version = " << hnc::computer::system_version() << std::endl;
 	std::cout << std::endl;
 	
 	std::cout << "Processor name = " << hnc::computer::processor_name() << std::endl;
 	std::cout << std::endl;
-
-	return 0;
+	
+	// Topology of this computer
+	{
+		hnc::computer::topology_t const topology = hnc::computer::topology();
+		std::cout << "Topology = " << topology << std::endl;
+		std::cout << std::endl;
+		
+		++nb_test;
+		nb_test -= hnc::test::warning(topology.nb_logical_core >= 1, "hnc::computer::topology: number of logical cores must be >= 1\n");
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			topology.nb_physical_core >= 1 && topology.nb_physical_core <= topology.nb_logical_core,
+			"hnc::computer::topology: number of physical cores must be in [1, number of logical cores]\n"
+		);
+	}
+	
+	// Topology of a fake sysfs: 1 package, 2 physical cores with 2 logical cores, L1d 32K, L1i 32K, L2 1M, 2 NUMA nodes
+	#ifdef hnc_unix
+	{
+		std::string const path = "hnc_computer_sys";
+		std::vector<std::string> directories;
+		std::vector<std::string> files;
+		auto write = [&](std::string const & filename, std::string const & content) -> void
+		{
+			std::ofstream(path + "/" + filename) << content << "\n";
+			files.push_back(path + "/" + filename);
+		};
+		for (char const * const directory : { "", "/cpu", "/node", "/node/node0", "/node/node1" }) { directories.push_back(path + directory); }
+		for (std::size_t cpu = 0; cpu < 4; ++cpu)
+		{
+			std::string const cpu_path = path + "/cpu/cpu" + hnc::to_string(cpu);
+			for (char const * const directory : { "", "/topology", "/cache" }) { directories.push_back(cpu_path + directory); }
+		}
+		for (std::size_t index = 0; index < 3; ++index) { directories.push_back(path + "/cpu/cpu0/cache/index" + hnc::to_string(index)); }
+		for (auto const & directory : directories) { hnc::filesystem::create_directory(directory); }
+		
+		write("cpu/online", "0-3");
+		for (std::size_t cpu = 0; cpu < 4; ++cpu)
+		{
+			write("cpu/cpu" + hnc::to_string(cpu) + "/topology/physical_package_id", "0");
+			write("cpu/cpu" + hnc::to_string(cpu) + "/topology/core_id", hnc::to_string(cpu % 2));
+		}
+		std::vector<std::vector<std::string>> const caches = { { "1", "Data", "32K" }, { "1", "Instruction", "32K" }, { "2", "Unified", "1024K" } };
+		for (std::size_t index = 0; index < caches.size(); ++index)
+		{
+			std::string const index_path = "cpu/cpu0/cache/index" + hnc::to_string(index);
+			write(index_path + "/level", caches[index][0]);
+			write(index_path + "/type", caches[index][1]);
+			write(index_path + "/size", caches[index][2]);
+			write(index_path + "/coherency_line_size", "64");
+			write(index_path + "/shared_cpu_list", "0,2");
+		}
+		write("node/online", "0-1");
+		write("node/node0/cpulist", "0-1");
+		write("node/node1/cpulist", "2-3");
+		
+		hnc::computer::topology_t const topology = hnc::computer::topology(path);
+		std::cout << "Fake topology = " << topology << std::endl;
+		std::cout << std::endl;
+		
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			topology.nb_logical_core == 4 && topology.nb_physical_core == 2 && topology.nb_package == 1 && topology.nb_smt() == 2,
+			"hnc::computer::topology: fake topology must have 4 logical cores, 2 physical cores, 1 package and 2 SMT siblings\n"
+		);
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			topology.physical_cores.size() == 2 && topology.physical_cores[0] == std::vector<std::size_t>({ 0, 2 }),
+			"hnc::computer::topology: logical cores 0 and 2 must be SMT siblings\n"
+		);
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			topology.caches.size() == 3 && topology.cache_size(1) == 32 * 1024 && topology.cache_size(2) == 1024 * 1024 &&
+			topology.cache_size(3) == 0 && topology.cache_line_size() == 64 &&
+			topology.caches[0].shared_logical_cores == std::vector<std::size_t>({ 0, 2 }),
+			"hnc::computer::topology: caches of the fake topology are wrong\n"
+		);
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			topology.nb_numa_node() == 2 && topology.numa_nodes[1] == std::vector<std::size_t>({ 2, 3 }),
+			"hnc::computer::topology: NUMA nodes of the fake topology are wrong\n"
+		);
+		
+		for (auto const & file : files) { hnc::filesystem::remove(file); }
+		for (auto it = directories.rbegin(); it != directories.rend(); ++it) { hnc::filesystem::remove(*it); }
+	}
+	#endif
+	
+	hnc::test::warning(nb_test == 0, "hnc::computer: " + hnc::to_string(nb_test) + " test fail!\n");
+	
+	return nb_test;
 }
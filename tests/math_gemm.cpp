@@ -0,0 +1,139 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <iostream>
+#include <cstdint>
+#include <cmath>
+
+#include <hnc/math/gemm.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+// Fill a matrix with small values (exact products with float)
+template <class T>
+hnc::vector2D<T> matrix(std::size_t const nb_row, std::size_t const nb_col, std::size_t const seed)
+{
+	hnc::vector2D<T> m(nb_row, nb_col);
+	for (std::size_t i = 0; i < nb_row; ++i)
+	{
+		for (std::size_t j = 0; j < nb_col; ++j) { m(i, j) = T((i * 7 + j * 3 + seed) % 11) - T(5); }
+	}
+	return m;
+}
+
+// C = alpha * A * B + beta * C with the naive loop
+template <class T>
+void naive_gemm(T const alpha, hnc::vector2D_view<T const> const & a, hnc::vector2D_view<T const> const & b, T const beta, hnc::vector2D_view<T> const & c)
+{
+	for (std::size_t i = 0; i < c.nb_row(); ++i)
+	{
+		for (std::size_t j = 0; j < c.nb_col(); ++j)
+		{
+			T sum = T(0);
+			for (std::size_t p = 0; p < a.nb_col(); ++p) { sum = T(sum + a(i, p) * b(p, j)); }
+			c(i, j) = T(alpha * sum + beta * c(i, j));
+		}
+	}
+}
+
+// Test with a type
+template <class T>
+int test_gemm(std::string const & type_name)
+{
+	int nb_test = 0;
+
+	std::cout << "hnc::math::gemm<" << type_name << ">: mc = " << hnc::math::gemm_blocking<T>().mc << ", kc = " << hnc::math::gemm_blocking<T>().kc << ", nc = " << hnc::math::gemm_blocking<T>().nc << std::endl;
+
+	// Sizes which are not multiples of the micro-kernel and of the blocks
+	hnc::vector2D<T> const a = matrix<T>(37, 53, 1);
+	hnc::vector2D<T> const b = matrix<T>(53, 29, 2);
+
+	// multiply
+	{
+		hnc::vector2D<T> ref(37, 29);
+		naive_gemm(T(1), a.view(), b.view(), T(0), ref.view());
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::math::multiply(a, b) == ref, "hnc::math::multiply<" + type_name + "> fails\n");
+	}
+
+	// alpha and beta with small blocks (several blocks in each dimension)
+	{
+		hnc::vector2D<T> ref = matrix<T>(37, 29, 3);
+		hnc::vector2D<T> c = ref;
+		naive_gemm(T(2), a.view(), b.view(), T(3), ref.view());
+		hnc::math::gemm_blocking_t blocking;
+		blocking.mc = 8;
+		blocking.kc = 10;
+		blocking.nc = 16;
+		hnc::math::gemm(T(2), a.view(), b.view(), T(3), c.view(), blocking);
+		++nb_test;
+		nb_test -= hnc::test::warning(c == ref, "hnc::math::gemm<" + type_name + "> with alpha, beta and small blocks fails\n");
+	}
+
+	// Views: C block += A * transpose(B')
+	{
+		hnc::vector2D<T> const b_t = matrix<T>(29, 53, 2);
+		hnc::vector2D<T> ref = matrix<T>(50, 40, 4);
+		hnc::vector2D<T> c = ref;
+		naive_gemm(T(1), a.view(), b_t.transposed_view(), T(1), ref.sub_view(5, 7, 37, 29));
+		hnc::math::gemm(T(1), a.view(), b_t.transposed_view(), T(1), c.sub_view(5, 7, 37, 29));
+		++nb_test;
+		nb_test -= hnc::test::warning(c == ref, "hnc::math::gemm<" + type_name + "> with views fails\n");
+	}
+
+	// Empty matrices
+	{
+		hnc::vector2D<T> const a0(4, 0);
+		hnc::vector2D<T> const b0(0, 3);
+		hnc::vector2D<T> c(4, 3, T(1));
+		hnc::math::gemm(T(1), a0.view(), b0.view(), T(2), c.view());
+		++nb_test;
+		nb_test -= hnc::test::warning(c == hnc::vector2D<T>(4, 3, T(2)), "hnc::math::gemm<" + type_name + "> with k = 0 fails\n");
+	}
+
+	std::cout << std::endl;
+
+	return nb_test;
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	nb_test += test_gemm<float>("float");
+	nb_test += test_gemm<double>("double");
+	nb_test += test_gemm<int>("int");
+	nb_test += test_gemm<std::int64_t>("std::int64_t");
+	nb_test += test_gemm<short>("short");
+
+	// Identity
+	{
+		hnc::vector2D<double> const m = matrix<double>(100, 100, 5);
+		hnc::vector2D<double> identity(100, 100, 0.);
+		for (std::size_t i = 0; i < 100; ++i) { identity(i, i) = 1.; }
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::math::multiply(m, identity) == m && hnc::math::multiply(identity, m) == m, "hnc::math::multiply with identity fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::gemm: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,121 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <cmath>
+
+#include <hnc/math/hdr_histogram.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Relative error
+	auto relative_error = [](long double const x, long double const ref) -> long double
+	{
+		return std::abs(x - ref) / ref;
+	};
+
+	// 1, 2, ..., 1000000
+	{
+		hnc::math::hdr_histogram h(3600000000000, 3);
+		for (std::uint64_t i = 1; i <= 1000000; ++i) { h.record(i); }
+
+		std::cout << "Values 1, 2, ..., 1000000:" << std::endl;
+		std::cout << "- size     = " << h.size() << std::endl;
+		std::cout << "- nb count = " << h.nb_count() << std::endl;
+		std::cout << "- p50      = " << h.value_at_percentile(50) << " (must be close to 500000)" << std::endl;
+		std::cout << "- p99.9    = " << h.value_at_percentile(99.9) << " (must be close to 999000)" << std::endl;
+		std::cout << "- p100     = " << h.value_at_percentile(100) << " (must be 1000000)" << std::endl;
+		std::cout << "- mean     = " << h.mean() << " (must be close to 500000.5)" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(h.size() == 1000000, "hnc::math::hdr_histogram: size must be 1000000\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error((long double)(h.value_at_percentile(50)), 500000.L) <= 0.001L, "hnc::math::hdr_histogram: p50 is " + hnc::to_string(h.value_at_percentile(50)) + " instead of 500000\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error((long double)(h.value_at_percentile(99.9)), 999000.L) <= 0.001L, "hnc::math::hdr_histogram: p99.9 is " + hnc::to_string(h.value_at_percentile(99.9)) + " instead of 999000\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(h.value_at_percentile(100) == 1000000 && h.min() == 1 && h.max() == 1000000, "hnc::math::hdr_histogram: min and max must be exact\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error(h.mean(), 500000.5L) <= 0.001L, "hnc::math::hdr_histogram: mean is " + hnc::to_string(h.mean()) + " instead of 500000.5\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(h.percentile_at_value(250000) - 25.) < 0.1, "hnc::math::hdr_histogram: percentile at 250000 is " + hnc::to_string(h.percentile_at_value(250000)) + " instead of 25\n");
+		std::cout << std::endl;
+	}
+
+	// Equivalent values
+	{
+		hnc::math::hdr_histogram h(1000000000, 2);
+
+		std::cout << "Equivalent values (2 significant digits):" << std::endl;
+		std::cout << "- lowest equivalent of 100   = " << h.lowest_equivalent_value(100) << " (must be 100)" << std::endl;
+		std::cout << "- lowest equivalent of 10007 = " << h.lowest_equivalent_value(10007) << " (must be close to 10007)" << std::endl;
+		std::cout << "- highest equivalent of 10007 = " << h.highest_equivalent_value(10007) << " (must be close to 10007)" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(h.lowest_equivalent_value(100) == 100 && h.highest_equivalent_value(100) == 100, "hnc::math::hdr_histogram: 100 must have 1 unit of resolution\n");
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			h.lowest_equivalent_value(10007) <= 10007 && h.highest_equivalent_value(10007) >= 10007 &&
+			relative_error((long double)(h.highest_equivalent_value(10007)), (long double)(h.lowest_equivalent_value(10007))) <= 0.01L,
+			"hnc::math::hdr_histogram: 10007 must have 1% of resolution\n"
+		);
+		std::cout << std::endl;
+	}
+
+	// Merge and saturation
+	{
+		hnc::math::hdr_histogram h_0(1000000, 3);
+		hnc::math::hdr_histogram h_1(1000000, 3);
+		for (std::uint64_t i = 1; i <= 500; ++i) { h_0.record(i * 1000); }
+		for (std::uint64_t i = 501; i <= 1000; ++i) { h_1.record(i * 1000); }
+		h_1.record(5000000);
+		h_0.merge(h_1);
+
+		std::cout << "Merge 1000, ..., 500000 with 501000, ..., 1000000 and 5000000 (saturated):" << std::endl;
+		std::cout << "- size         = " << h_0.size() << " (must be 1001)" << std::endl;
+		std::cout << "- nb saturated = " << h_0.nb_saturated() << " (must be 1)" << std::endl;
+		std::cout << "- p50          = " << h_0.value_at_percentile(50) << " (must be close to 501000)" << std::endl;
+		std::cout << "- max          = " << h_0.max() << " (must be 1000000)" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(h_0.size() == 1001 && h_0.nb_saturated() == 1, "hnc::math::hdr_histogram::merge: size must be 1001 with 1 saturated value\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error((long double)(h_0.value_at_percentile(50)), 501000.L) <= 0.001L, "hnc::math::hdr_histogram::merge: p50 is " + hnc::to_string(h_0.value_at_percentile(50)) + " instead of 501000\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(h_0.max() == 1000000, "hnc::math::hdr_histogram: max must be the highest trackable value\n");
+
+		++nb_test;
+		try { h_0.merge(hnc::math::hdr_histogram(1000000, 2)); }
+		catch (std::invalid_argument const &) { --nb_test; }
+
+		h_0.clear();
+		++nb_test;
+		nb_test -= hnc::test::warning(h_0.empty() && h_0.nb_count() != 0, "hnc::math::hdr_histogram::clear: histogram must be empty\n");
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::hdr_histogram: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,74 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <hnc/math.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Different distributions
+	{
+		std::vector<double> const a = { 1.0, 1.1, 0.9, 1.0, 1.2, 1.1, 0.9, 1.0 };
+		std::vector<double> const b = { 2.0, 2.1, 1.9, 2.0, 2.2, 2.1, 1.9, 2.0 };
+		hnc::math::mann_whitney_u_result const r = hnc::math::mann_whitney_u(a, b);
+		std::cout << "U = " << r.u << " (must be 0), z = " << r.z << ", p-value = " << r.p_value << " (must be < 0.001)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(r.u == 0 && r.z < 0 && r.p_value < 0.001L, "hnc::math::mann_whitney_u: different distributions must have U = 0 and a p-value < 0.001\n");
+	}
+
+	// Same distribution
+	{
+		std::vector<double> const a = { 1.0, 1.3, 0.9, 1.1, 1.2, 0.8, 1.05, 0.95 };
+		std::vector<double> const b = { 1.02, 1.25, 0.92, 1.08, 1.18, 0.85, 1.0, 0.97 };
+		hnc::math::mann_whitney_u_result const r = hnc::math::mann_whitney_u(a, b);
+		std::cout << "U = " << r.u << ", z = " << r.z << ", p-value = " << r.p_value << " (must be > 0.5)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(r.p_value > 0.5L, "hnc::math::mann_whitney_u: same distribution must have a p-value > 0.5\n");
+	}
+
+	// With ties: ranks of a are 1, 2, 3.5, 5.5, 7.5 so U = 19.5 - 15 = 4.5
+	{
+		std::vector<int> const a = { 1, 2, 3, 4, 5 };
+		std::vector<int> const b = { 3, 4, 5, 6, 7, 8 };
+		hnc::math::mann_whitney_u_result const r = hnc::math::mann_whitney_u(a, b);
+		std::cout << "U = " << r.u << " (must be 4.5), p-value = " << r.p_value << " (must be close to 0.0660)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(r.u == 4.5L && std::abs(r.p_value - 0.0660L) < 0.001L, "hnc::math::mann_whitney_u: U must be 4.5 and p-value close to 0.0660\n");
+	}
+
+	// Empty sample
+	{
+		hnc::math::mann_whitney_u_result const r = hnc::math::mann_whitney_u(std::vector<double>(), std::vector<double>({ 1., 2. }));
+		++nb_test;
+		nb_test -= hnc::test::warning(r.p_value == 1, "hnc::math::mann_whitney_u: p-value must be 1 with an empty sample\n");
+	}
+
+	std::cout << std::endl;
+
+	hnc::test::warning(nb_test == 0, "hnc::math::mann_whitney_u: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
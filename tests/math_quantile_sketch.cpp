@@ -0,0 +1,101 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <cmath>
+
+#include <hnc/math/quantile_sketch.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Relative error
+	auto relative_error = [](long double const x, long double const ref) -> long double
+	{
+		return std::abs(x - ref) / ref;
+	};
+
+	// 1, 2, ..., 1000
+	{
+		hnc::math::quantile_sketch sketch;
+		for (std::size_t i = 1; i <= 1000; ++i) { sketch.push_back((long double)(i)); }
+
+		std::cout << "Values 1, 2, ..., 1000:" << std::endl;
+		std::cout << "- size   = " << sketch.size() << std::endl;
+		std::cout << "- nb bin = " << sketch.nb_bin() << std::endl;
+		std::cout << "- q 0.5  = " << sketch.quantile(0.5) << " (must be close to 500.5)" << std::endl;
+		std::cout << "- q 0.99 = " << sketch.quantile(0.99) << " (must be close to 990)" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(sketch.size() == 1000, "hnc::math::quantile_sketch: size must be 1000\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error(sketch.quantile(0.5), 500.5L) <= 0.02L, "hnc::math::quantile_sketch: median is " + hnc::to_string(sketch.quantile(0.5)) + " instead of 500.5\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error(sketch.quantile(0.99), 990.L) <= 0.02L, "hnc::math::quantile_sketch: quantile 0.99 is " + hnc::to_string(sketch.quantile(0.99)) + " instead of 990\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error(sketch.quantile(0.), 1.L) <= 0.02L, "hnc::math::quantile_sketch: quantile 0 is " + hnc::to_string(sketch.quantile(0.)) + " instead of 1\n");
+		std::cout << std::endl;
+	}
+
+	// Merge
+	{
+		hnc::math::quantile_sketch sketch_0;
+		hnc::math::quantile_sketch sketch_1;
+		for (std::size_t i = 1; i <= 500; ++i) { sketch_0.push_back((long double)(i) * 1e-6L); }
+		for (std::size_t i = 501; i <= 1000; ++i) { sketch_1.push_back((long double)(i) * 1e-6L); }
+		sketch_0.merge(sketch_1);
+
+		std::cout << "Merge 1e-6, ..., 500e-6 with 501e-6, ..., 1000e-6:" << std::endl;
+		std::cout << "- size  = " << sketch_0.size() << std::endl;
+		std::cout << "- q 0.5 = " << sketch_0.quantile(0.5) << " (must be close to 500.5e-6)" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(sketch_0.size() == 1000, "hnc::math::quantile_sketch::merge: size must be 1000\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error(sketch_0.quantile(0.5), 500.5e-6L) <= 0.02L, "hnc::math::quantile_sketch::merge: median is " + hnc::to_string(sketch_0.quantile(0.5)) + " instead of 500.5e-6\n");
+		std::cout << std::endl;
+	}
+
+	// Zeros and bounded number of bins
+	{
+		hnc::math::quantile_sketch sketch(0.01, 64);
+		for (std::size_t i = 0; i < 10; ++i) { sketch.push_back(0); }
+		for (long double x = 1e-9L; x < 1e3L; x *= 10) { sketch.push_back(x); }
+
+		std::cout << "Zeros and bounded number of bins:" << std::endl;
+		std::cout << "- nb bin = " << sketch.nb_bin() << " (must be <= 64)" << std::endl;
+		std::cout << "- q 0.25 = " << sketch.quantile(0.25) << " (must be 0)" << std::endl;
+		std::cout << "- q 1    = " << sketch.quantile(1.) << " (must be close to 100)" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(sketch.nb_bin() <= 64, "hnc::math::quantile_sketch: too many bins\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(sketch.quantile(0.25) == 0, "hnc::math::quantile_sketch: quantile 0.25 must be 0\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(relative_error(sketch.quantile(1.), 100.L) <= 0.02L, "hnc::math::quantile_sketch: quantile 1 is " + hnc::to_string(sketch.quantile(1.)) + " instead of 100\n");
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::quantile_sketch: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
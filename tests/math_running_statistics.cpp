@@ -0,0 +1,94 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <hnc/math/running_statistics.hpp>
+#include <hnc/math/variance.hpp>
+#include <hnc/math/geometric_mean.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// 2, 4, 6, 8
+	{
+		hnc::math::running_statistics s;
+		for (long double x : { 2.L, 4.L, 6.L, 8.L }) { s.push_back(x); }
+
+		std::cout << "Values 2, 4, 6, 8:" << std::endl;
+		std::cout << "- size           = " << s.size() << std::endl;
+		std::cout << "- min            = " << s.min() << std::endl;
+		std::cout << "- max            = " << s.max() << std::endl;
+		std::cout << "- mean           = " << s.mean() << std::endl;
+		std::cout << "- variance       = " << s.variance() << std::endl;
+		std::cout << "- geometric mean = " << s.geometric_mean() << std::endl;
+		std::cout << "- median         = " << s.median() << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(s.size() == 4, "hnc::math::running_statistics: size must be 4\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(s.min() == 2 && s.max() == 8, "hnc::math::running_statistics: min and max must be 2 and 8\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(s.mean() == 5, "hnc::math::running_statistics: mean must be 5\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(s.variance() - 5) < 1e-9L, "hnc::math::running_statistics: variance must be 5\n");
+		++nb_test;
+		{
+			long double const ref = hnc::math::geometric_mean(std::vector<long double>({ 2, 4, 6, 8 }));
+			nb_test -= hnc::test::warning(std::abs(s.geometric_mean() - ref) < 1e-9L, "hnc::math::running_statistics: geometric mean must be " + hnc::to_string(ref) + "\n");
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(s.median() >= 4 * 0.98L && s.median() <= 6 * 1.02L, "hnc::math::running_statistics: median must be between 4 and 6\n");
+		std::cout << std::endl;
+	}
+
+	// Merge
+	{
+		std::vector<long double> all;
+		hnc::math::running_statistics s_0;
+		hnc::math::running_statistics s_1;
+		for (std::size_t i = 1; i <= 100; ++i)
+		{
+			long double const x = (long double)(i * i % 37 + 1);
+			all.push_back(x);
+			((i % 3 == 0) ? s_0 : s_1).push_back(x);
+		}
+		s_0.merge(s_1);
+
+		long double const variance_ref = hnc::math::variance(all);
+		std::cout << "Merge:" << std::endl;
+		std::cout << "- size     = " << s_0.size() << std::endl;
+		std::cout << "- variance = " << s_0.variance() << " (reference = " << variance_ref << ")" << std::endl;
+
+		++nb_test;
+		nb_test -= hnc::test::warning(s_0.size() == 100, "hnc::math::running_statistics::merge: size must be 100\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(s_0.variance() - variance_ref) < 1e-9L, "hnc::math::running_statistics::merge: variance is " + hnc::to_string(s_0.variance()) + " instead of " + hnc::to_string(variance_ref) + "\n");
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::running_statistics: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,188 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include <hnc/math/stencil.hpp>
+#include <hnc/vector3D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+// Naive 27-point stencil on the interior values
+template <class T>
+void naive_stencil(hnc::vector3D_view<T const> const & src, hnc::vector3D_view<T> const & dst, hnc::math::stencil_27_point_t<T> const & s)
+{
+	for (std::size_t x = 1; x + 1 < src.size_x(); ++x)
+	{
+		for (std::size_t y = 1; y + 1 < src.size_y(); ++y)
+		{
+			for (std::size_t z = 1; z + 1 < src.size_z(); ++z)
+			{
+				T r = T();
+				for (int dx = -1; dx <= 1; ++dx)
+				{
+					for (int dy = -1; dy <= 1; ++dy)
+					{
+						for (int dz = -1; dz <= 1; ++dz)
+						{
+							r += s(dx, dy, dz) * src(std::size_t(long(x) + dx), std::size_t(long(y) + dy), std::size_t(long(z) + dz));
+						}
+					}
+				}
+				dst(x, y, z) = r;
+			}
+		}
+	}
+}
+
+// Values (x, y, z) -> small integers
+hnc::vector3D<int> values(std::size_t const size_x, std::size_t const size_y, std::size_t const size_z, hnc::vector3D_layout const layout)
+{
+	hnc::vector3D<int> v(size_x, size_y, size_z, 0, layout);
+	for (std::size_t x = 0; x < size_x; ++x)
+	{
+		for (std::size_t y = 0; y < size_y; ++y)
+		{
+			for (std::size_t z = 0; z < size_z; ++z) { v(x, y, z) = int((x * 7 + y * 13 + z * 29) % 17) - 8; }
+		}
+	}
+	return v;
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	hnc::math::stencil_tile_t const tile = hnc::math::stencil_tile<double>();
+	std::cout << "hnc::math::stencil_tile<double>() = " << tile.nb_line << " lines of " << tile.line_size << " values" << std::endl;
+	std::cout << std::endl;
+
+	// Asymmetric weights
+	hnc::math::stencil_7_point_t<int> s7(-6, 1);
+	s7.x_minus = 2; s7.x_plus = 3; s7.y_minus = -1; s7.y_plus = 4; s7.z_minus = 5; s7.z_plus = -7;
+	hnc::math::stencil_27_point_t<int> s27;
+	for (int dx = -1; dx <= 1; ++dx) { for (int dy = -1; dy <= 1; ++dy) { for (int dz = -1; dz <= 1; ++dz) { s27(dx, dy, dz) = dx * 9 + dy * 3 + dz + (dx * dy * dz) % 5; } } }
+
+	// Layouts and tile sizes (tiles which are not divisors of the sizes)
+	for (hnc::vector3D_layout const src_layout : { hnc::vector3D_layout::z_contiguous, hnc::vector3D_layout::x_contiguous })
+	{
+		for (hnc::vector3D_layout const dst_layout : { hnc::vector3D_layout::z_contiguous, hnc::vector3D_layout::x_contiguous })
+		{
+			for (std::size_t const nb_line : { std::size_t(1), std::size_t(3), std::size_t(1000) })
+			{
+				std::string const name = std::string((src_layout == hnc::vector3D_layout::z_contiguous) ? "z" : "x") + "_contiguous to " + ((dst_layout == hnc::vector3D_layout::z_contiguous) ? "z" : "x") + "_contiguous with " + hnc::to_string(nb_line) + " lines";
+				hnc::math::stencil_tile_t t;
+				t.nb_line = nb_line;
+				t.line_size = nb_line + 4;
+
+				hnc::vector3D<int> const src = values(9, 11, 17, src_layout);
+				hnc::vector3D<int> expected(9, 11, 17, 1000, dst_layout);
+				hnc::vector3D<int> dst(9, 11, 17, 1000, dst_layout);
+
+				naive_stencil(src.view(), expected.view(), hnc::math::stencil_27_point_t<int>(s7));
+				hnc::math::stencil(src.view(), dst.view(), s7, t);
+				++nb_test;
+				nb_test -= hnc::test::warning(dst == expected, "hnc::math::stencil 7-point " + name + " fails\n");
+
+				naive_stencil(src.view(), expected.view(), s27);
+				hnc::math::stencil(src.view(), dst.view(), s27, t);
+				++nb_test;
+				nb_test -= hnc::test::warning(dst == expected, "hnc::math::stencil 27-point " + name + " fails\n");
+			}
+		}
+	}
+
+	// Boundary values are not modified
+	{
+		hnc::vector3D<int> const src = values(4, 5, 6, hnc::vector3D_layout::z_contiguous);
+		hnc::vector3D<int> dst(4, 5, 6, 1000);
+		hnc::math::stencil(src.view(), dst.view(), s27);
+		++nb_test;
+		nb_test -= hnc::test::warning(dst(0, 2, 2) == 1000 && dst(3, 2, 2) == 1000 && dst(1, 0, 1) == 1000 && dst(2, 4, 3) == 1000 && dst(1, 1, 5) == 1000 && dst(1, 1, 1) != 1000, "hnc::math::stencil modifies the boundary\n");
+	}
+
+	// Blocks with strides (a plane y of a permuted view)
+	{
+		hnc::vector3D<int> const src = values(12, 10, 14, hnc::vector3D_layout::z_contiguous);
+		hnc::vector3D<int> expected(12, 10, 14, 0);
+		hnc::vector3D<int> dst(12, 10, 14, 0);
+		naive_stencil(src.sub_view(2, 1, 3, 7, 8, 9), expected.sub_view(3, 2, 1, 7, 8, 9), s27);
+		hnc::math::stencil(src.sub_view(2, 1, 3, 7, 8, 9), dst.sub_view(3, 2, 1, 7, 8, 9), s27);
+		++nb_test;
+		nb_test -= hnc::test::warning(dst == expected, "hnc::math::stencil on blocks fails\n");
+		hnc::vector3D_view<int const> const v = src.view();
+		hnc::vector3D_view<int const> const permuted(v.data(), v.size_z(), v.size_x(), v.size_y(), v.stride_z(), v.stride_x(), v.stride_y());
+		hnc::vector3D<int> expected_permuted(14, 12, 10, 0);
+		hnc::vector3D<int> dst_permuted(14, 12, 10, 0);
+		naive_stencil(permuted, expected_permuted.view(), s27);
+		hnc::math::stencil(permuted, dst_permuted.view(), s27);
+		++nb_test;
+		nb_test -= hnc::test::warning(dst_permuted == expected_permuted, "hnc::math::stencil on a permuted view fails\n");
+	}
+
+	// Too small: nothing to compute
+	{
+		hnc::vector3D<int> const src(2, 8, 8, 1);
+		hnc::vector3D<int> dst(2, 8, 8, 5);
+		hnc::math::stencil(src.view(), dst.view(), s7);
+		++nb_test;
+		nb_test -= hnc::test::warning(dst == hnc::vector3D<int>(2, 8, 8, 5), "hnc::math::stencil on a 2 x 8 x 8 array modifies values\n");
+	}
+
+	// Laplacian of x² + y² + z² is 6
+	{
+		double const h = 0.5;
+		hnc::vector3D<double> u(10, 12, 14, 0., hnc::vector3D_layout::x_contiguous);
+		for (std::size_t x = 0; x < u.size_x(); ++x)
+		{
+			for (std::size_t y = 0; y < u.size_y(); ++y)
+			{
+				for (std::size_t z = 0; z < u.size_z(); ++z) { u(x, y, z) = (double(x) * h) * (double(x) * h) + (double(y) * h) * (double(y) * h) + (double(z) * h) * (double(z) * h); }
+			}
+		}
+		hnc::vector3D<double> const laplacian_7 = hnc::math::stencil(u, hnc::math::stencil_7_point_t<double>::laplacian(h));
+		hnc::vector3D<double> const laplacian_27 = hnc::math::stencil(u, hnc::math::stencil_27_point_t<double>::laplacian(h));
+		bool test_7 = laplacian_7(0, 3, 3) == u(0, 3, 3);
+		bool test_27 = laplacian_27(9, 3, 3) == u(9, 3, 3);
+		for (std::size_t x = 1; x + 1 < u.size_x(); ++x)
+		{
+			for (std::size_t y = 1; y + 1 < u.size_y(); ++y)
+			{
+				for (std::size_t z = 1; z + 1 < u.size_z(); ++z)
+				{
+					test_7 = test_7 && std::abs(laplacian_7(x, y, z) - 6.) < 1e-9;
+					test_27 = test_27 && std::abs(laplacian_27(x, y, z) - 6.) < 1e-9;
+				}
+			}
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(test_7, "hnc::math::stencil_7_point_t::laplacian fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(test_27, "hnc::math::stencil_27_point_t::laplacian fails\n");
+		hnc::vector3D<double> const mean = hnc::math::stencil(hnc::vector3D<double>(5, 5, 5, 3.), hnc::math::stencil_27_point_t<double>::mean());
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(mean(2, 2, 2) - 3.) < 1e-12, "hnc::math::stencil_27_point_t::mean fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::stencil: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,72 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+
+#include <iostream>
+#include <string>
+
+#include <hnc/math/transpose.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	std::cout << "hnc::math::transpose_tile_size<double>() = " << hnc::math::transpose_tile_size<double>() << std::endl;
+	std::cout << "hnc::math::transpose_tile_size<float>()  = " << hnc::math::transpose_tile_size<float>() << std::endl;
+	std::cout << std::endl;
+
+	// Sizes which are not multiples of the tile size
+	for (std::size_t const tile : { std::size_t(0), std::size_t(1), std::size_t(4), std::size_t(7) })
+	{
+		hnc::vector2D<int> m(37, 53);
+		for (std::size_t i = 0; i < m.nb_row(); ++i) { for (std::size_t j = 0; j < m.nb_col(); ++j) { m(i, j) = int(i * 100 + j); } }
+		hnc::vector2D<int> t(53, 37);
+		hnc::math::transpose(m.view(), t.view(), tile);
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::vector2D<int>(m.transposed_view()) == t, "hnc::math::transpose with tile = " + hnc::to_string(tile) + " fails\n");
+	}
+
+	// Transposed matrix
+	{
+		hnc::vector2D<double> const m = { { 1, 2, 3 }, { 4, 5, 6 } };
+		hnc::vector2D<double> const t = hnc::math::transpose(m);
+		std::cout << "Matrix:\n" << m << "\nTransposed:\n" << t << "\n" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(t == hnc::vector2D<double>({ { 1, 4 }, { 2, 5 }, { 3, 6 } }), "hnc::math::transpose of a hnc::vector2D fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::math::transpose(t) == m, "hnc::math::transpose of the transposed matrix fails\n");
+	}
+
+	// Block in a block
+	{
+		hnc::vector2D<int> m(10, 10, 0);
+		for (std::size_t i = 0; i < m.nb_row(); ++i) { for (std::size_t j = 0; j < m.nb_col(); ++j) { m(i, j) = int(i * 10 + j); } }
+		hnc::vector2D<int> r(10, 10, -1);
+		hnc::math::transpose(m.sub_view(1, 2, 3, 4), r.sub_view(5, 6, 4, 3), 2);
+		++nb_test;
+		nb_test -= hnc::test::warning(r(5, 6) == 12 && r(5, 8) == 32 && r(8, 6) == 15 && r(8, 8) == 35 && r(4, 6) == -1 && r(5, 9) == -1, "hnc::math::transpose of a block fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::transpose: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
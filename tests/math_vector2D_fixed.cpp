@@ -0,0 +1,125 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <stdexcept>
+
+#include <hnc/math/vector2D_fixed.hpp>
+#include <hnc/math/gemm.hpp>
+#include <hnc/vector2D_fixed.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+// Return true if a * inverse(a) is the identity
+template <std::size_t n>
+bool is_inverse(hnc::vector2D_fixed<double, n, n> const & a, hnc::vector2D_fixed<double, n, n> const & inv)
+{
+	hnc::vector2D_fixed<double, n, n> const p = hnc::math::multiply(a, inv);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			if (std::abs(p(i, j) - ((i == j) ? 1. : 0.)) > 1e-9) { return false; }
+		}
+	}
+	return true;
+}
+
+// Matrix with values from a formula (invertible for these sizes)
+template <std::size_t n>
+hnc::vector2D_fixed<double, n, n> matrix()
+{
+	hnc::vector2D_fixed<double, n, n> a;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j) { a(i, j) = double((i * 7 + j * 3) % 5) + ((i == j) ? double(n) : 0.); }
+	}
+	return a;
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	// Multiply and transpose like hnc::vector2D
+	{
+		hnc::vector2D_fixed<double, 2, 3> const a(hnc::row_major_values, 1., 2., 3., 4., 5., 6.);
+		hnc::vector2D_fixed<double, 3, 2> const b(hnc::row_major_values, 7., 8., 9., 10., 11., 12.);
+		hnc::vector2D_fixed<double, 2, 2> const c = hnc::math::multiply(a, b);
+		std::cout << "a * b =\n" << c << "\n" << std::endl;
+		hnc::vector2D<double> const dynamic_c = hnc::math::multiply(hnc::vector2D<double>(a.view()), hnc::vector2D<double>(b.view()));
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::vector2D<double>(c.view()) == dynamic_c && c(0, 0) == 58. && c(1, 1) == 154., "hnc::math::multiply of hnc::vector2D_fixed fails\n");
+		hnc::vector2D_fixed<double, 3, 2> const t = hnc::math::transpose(a);
+		++nb_test;
+		nb_test -= hnc::test::warning(t == hnc::vector2D_fixed<double, 3, 2>(a.transposed_view()) && t(2, 1) == 6., "hnc::math::transpose of hnc::vector2D_fixed fails\n");
+	}
+
+	// Determinant
+	{
+		static_assert(hnc::math::determinant(hnc::vector2D_fixed<int, 2, 2>(hnc::row_major_values, 1, 2, 3, 4)) == -2, "hnc::math::determinant 2 x 2 constexpr fails");
+		static_assert(hnc::math::determinant(hnc::vector2D_fixed<int, 3, 3>(hnc::row_major_values, 2, 0, 1, 1, 3, 2, 1, 1, 2)) == 6, "hnc::math::determinant 3 x 3 constexpr fails");
+		hnc::vector2D_fixed<double, 4, 4> const a(hnc::row_major_values, 1., 0., 2., -1., 3., 0., 0., 5., 2., 1., 4., -3., 1., 0., 5., 0.);
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(hnc::math::determinant(a) - 30.) < 1e-12, "hnc::math::determinant 4 x 4 fails\n");
+		hnc::vector2D_fixed<double, 5, 5> b;
+		for (std::size_t i = 0; i < 5; ++i) { b(i, i) = double(i + 1); }
+		b(0, 4) = 7.;
+		b(3, 1) = -2.;
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(hnc::math::determinant(b) - 120.) < 1e-9, "hnc::math::determinant 5 x 5 (triangular) fails\n");
+		hnc::vector2D_fixed<double, 5, 5> rows_swapped = b;
+		for (std::size_t j = 0; j < 5; ++j) { std::swap(rows_swapped(0, j), rows_swapped(2, j)); }
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(hnc::math::determinant(rows_swapped) + 120.) < 1e-9, "hnc::math::determinant 5 x 5 with pivoting fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(hnc::math::determinant(matrix<4>()) - hnc::math::determinant<double, 4>(matrix<4>())) < 1e-9, "hnc::math::determinant 4 x 4 closed form and LU differ\n");
+	}
+
+	// Inverse
+	{
+		++nb_test;
+		nb_test -= hnc::test::warning(is_inverse(matrix<1>(), hnc::math::inverse(matrix<1>())), "hnc::math::inverse 1 x 1 fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(is_inverse(matrix<2>(), hnc::math::inverse(matrix<2>())), "hnc::math::inverse 2 x 2 fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(is_inverse(matrix<3>(), hnc::math::inverse(matrix<3>())), "hnc::math::inverse 3 x 3 fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(is_inverse(matrix<4>(), hnc::math::inverse(matrix<4>())), "hnc::math::inverse 4 x 4 fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(is_inverse(matrix<6>(), hnc::math::inverse(matrix<6>())), "hnc::math::inverse 6 x 6 fails\n");
+		std::cout << "inverse of\n" << matrix<3>() << "\n=\n" << hnc::math::inverse(matrix<3>()) << "\n" << std::endl;
+
+		bool exception_3 = false;
+		try { hnc::math::inverse(hnc::vector2D_fixed<double, 3, 3>(hnc::row_major_values, 1., 2., 3., 2., 4., 6., 0., 1., 1.)); }
+		catch (std::domain_error const &) { exception_3 = true; }
+		bool exception_5 = false;
+		try { hnc::math::inverse(hnc::vector2D_fixed<double, 5, 5>()); }
+		catch (std::domain_error const &) { exception_5 = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception_3 && exception_5, "hnc::math::inverse of a singular matrix does not throw\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::math::vector2D_fixed: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
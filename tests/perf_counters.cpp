@@ -0,0 +1,104 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// This file is part of hnc.
+
+// hnc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// hnc is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with hnc. If not, see <http://www.gnu.org/licenses/>
+
+
+#include <iostream>
+#include <vector>
+
+#include <hnc/perf_counters.hpp>
+#include <hnc/benchmark.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	std::vector<double> v(1000000, 1.);
+	auto computation = [&]() -> double
+	{
+		double sum = 0;
+		for (double const x : v) { sum += x; }
+		return sum;
+	};
+
+	// hnc::perf_counters
+	{
+		hnc::perf_counters counters;
+
+		std::cout << "hnc::perf_counters:" << std::endl;
+		std::cout << "- available: " << counters.available() << std::endl;
+		for (auto const event : hnc::perf_counters::events())
+		{
+			std::cout << "- " << hnc::perf_counters::name(event) << " available: " << counters.available(event) << std::endl;
+		}
+
+		counters.start();
+		double const sum = computation();
+		hnc::perf_counters::values_t const values = counters.stop();
+
+		std::cout << "Sum = " << sum << std::endl;
+		for (auto const event : hnc::perf_counters::events())
+		{
+			std::cout << "- " << hnc::perf_counters::name(event) << " = " << values[std::size_t(event)] << std::endl;
+		}
+
+		// Counters not available are 0
+		++nb_test;
+		{
+			bool ok = true;
+			for (auto const event : hnc::perf_counters::events())
+			{
+				if (counters.available(event) == false && values[std::size_t(event)] != 0) { ok = false; }
+			}
+			nb_test -= hnc::test::warning(ok, "hnc::perf_counters: a counter not available is not 0\n");
+		}
+		// 1000000 additions
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			counters.available(hnc::perf_counters::event_t::instructions) == false || values[std::size_t(hnc::perf_counters::event_t::instructions)] >= 1000000,
+			"hnc::perf_counters: less than 1000000 instructions for 1000000 additions\n"
+		);
+		std::cout << std::endl;
+	}
+
+	// hnc::benchmark with hardware performance counters
+	{
+		hnc::benchmark b;
+		b["Sum"].set_perf_counters();
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			b["Sum"].start();
+			computation();
+			b["Sum"].stop();
+		}
+
+		++nb_test;
+		nb_test -= hnc::test::warning(b["Sum"].all.size() == 3, "hnc::benchmark with hardware performance counters: must have 3 times\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b["Sum"].has_perf_counters() == false || b["Sum"].all_perf_counters.size() == 3, "hnc::benchmark with hardware performance counters: must have 3 values of hardware performance counters\n");
+
+		std::cout << b << std::endl;
+		std::cout << std::endl;
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::perf_counters: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,90 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <sstream>
+
+#include <hnc/serialization.hpp>
+#include <hnc/sparse.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+#ifndef hnc_no_boost_serialization
+
+/// @brief Save and load a value with Boost.Serialization text archives
+/// @param[in] value A value
+/// @return the loaded value
+template <class T>
+T round_trip(T const & value)
+{
+	std::stringstream s;
+	{
+		boost::archive::text_oarchive oarchive(s);
+		oarchive << value;
+	}
+	T r;
+	{
+		boost::archive::text_iarchive iarchive(s);
+		iarchive >> r;
+	}
+	return r;
+}
+
+#endif
+
+int main()
+{
+	int nb_test = 0;
+
+	#ifndef hnc_no_boost_serialization
+
+		hnc::vector2D<double> dense(6, 5, 0.);
+		dense(0, 0) = 1.;
+		dense(2, 4) = -2.5;
+		dense(5, 1) = 3.;
+		dense(5, 2) = 4.;
+
+		hnc::sparse::coo<double> const m_coo(dense);
+		hnc::sparse::csr<double> const m_csr(dense);
+		hnc::sparse::csc<double> const m_csc(dense);
+
+		hnc::sparse::coo<double> const m_coo_load = round_trip(m_coo);
+		++nb_test;
+		nb_test -= hnc::test::warning(m_coo_load.nb_non_zero() == 4 && m_coo_load.to_vector2D() == dense, "hnc::sparse::coo serialization fails\n");
+
+		hnc::sparse::csr<double> const m_csr_load = round_trip(m_csr);
+		++nb_test;
+		nb_test -= hnc::test::warning(m_csr_load == m_csr && m_csr_load(5, 2) == 4., "hnc::sparse::csr serialization fails\n");
+
+		hnc::sparse::csc<double> const m_csc_load = round_trip(m_csc);
+		++nb_test;
+		nb_test -= hnc::test::warning(m_csc_load == m_csc && m_csc_load(2, 4) == -2.5, "hnc::sparse::csc serialization fails\n");
+
+		hnc::sparse::csr<double> const empty_load = round_trip(hnc::sparse::csr<double>(3, 2));
+		++nb_test;
+		nb_test -= hnc::test::warning(empty_load == hnc::sparse::csr<double>(3, 2), "hnc::sparse::csr serialization of a matrix without value fails\n");
+
+	#else
+
+		std::cout << "Boost.Serialization is not available, no test" << std::endl;
+
+	#endif
+
+	hnc::test::warning(nb_test == 0, "hnc::sparse serialization: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,80 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <stdexcept>
+
+#include <hnc/sparse/coo.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Build
+	hnc::sparse::coo<double> m(3, 4);
+	m.reserve(4);
+	m.add(2, 3, 1.5);
+	m.add(0, 1, 2.);
+	m.add(2, 3, 0.5);
+	m.add(1, 0, -1.);
+	++nb_test;
+	nb_test -= hnc::test::warning(m.nb_row() == 3 && m.nb_col() == 4 && m.nb_non_zero() == 4 && m.rows()[0] == 2 && m.cols()[1] == 1 && m.values()[3] == -1., "hnc::sparse::coo::add fails\n");
+
+	// To vector2D (the duplicates are summed)
+	hnc::vector2D<double> const dense = m.to_vector2D();
+	std::cout << "hnc::sparse::coo to hnc::vector2D:\n" << dense << "\n" << std::endl;
+	{
+		hnc::vector2D<double> ref(3, 4, 0.);
+		ref(0, 1) = 2.;
+		ref(1, 0) = -1.;
+		ref(2, 3) = 2.;
+		++nb_test;
+		nb_test -= hnc::test::warning(dense == ref, "hnc::sparse::coo::to_vector2D fails\n");
+	}
+
+	// From vector2D
+	{
+		hnc::sparse::coo<double> const from_dense(dense);
+		++nb_test;
+		nb_test -= hnc::test::warning(from_dense.nb_non_zero() == 3 && from_dense.rows()[2] == 2 && from_dense.cols()[2] == 3 && from_dense.to_vector2D() == dense, "hnc::sparse::coo from a hnc::vector2D fails\n");
+	}
+
+	// Clear
+	{
+		hnc::sparse::coo<double> c = m;
+		c.clear();
+		++nb_test;
+		nb_test -= hnc::test::warning(c.nb_non_zero() == 0 && c.nb_row() == 3 && c.to_vector2D() == hnc::vector2D<double>(3, 4, 0.), "hnc::sparse::coo::clear fails\n");
+	}
+
+	// Out of range
+	#ifndef NDEBUG
+	{
+		bool exception = false;
+		try { m.add(3, 0, 1.); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::sparse::coo::add out of range does not throw\n");
+	}
+	#endif
+
+	hnc::test::warning(nb_test == 0, "hnc::sparse::coo: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,137 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+
+#include <hnc/sparse/csc.hpp>
+#include <hnc/sparse/coo.hpp>
+#include <hnc/sparse/csr.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_storage.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Random sparse matrix 50 x 37 (about 10% of values), with duplicates
+	std::size_t const nb_row = 50;
+	std::size_t const nb_col = 37;
+	hnc::sparse::coo<double> m_coo(nb_row, nb_col);
+	hnc::vector2D<double> dense(nb_row, nb_col, 0.);
+	{
+		unsigned int seed = 42;
+		auto const random = [&seed]() -> std::size_t { seed = seed * 1103515245u + 12345u; return std::size_t((seed / 65536u) % 32768u); };
+		for (std::size_t k = 0; k < 200; ++k)
+		{
+			std::size_t const i = random() % nb_row;
+			std::size_t const j = random() % nb_col;
+			double const value = double(random() % 7) - 3.;
+			m_coo.add(i, j, value);
+			dense(i, j) += value;
+		}
+	}
+
+	hnc::sparse::csc<double> const m(m_coo);
+	std::cout << "hnc::sparse::csc: " << m.nb_row() << "x" << m.nb_col() << ", " << m.nb_non_zero() << " values, density = " << m.density() << "\n" << std::endl;
+
+	// Structure
+	{
+		bool sorted = m.col_ptr().size() == m.nb_col() + 1 && m.col_ptr().back() == m.nb_non_zero() && m.row_index().size() == m.nb_non_zero();
+		for (std::size_t a = 0; a < m.nb_col(); ++a)
+		{
+			for (std::size_t k = m.col_ptr()[a] + 1; k < m.col_ptr()[a + 1]; ++k) { sorted = sorted && m.row_index()[k - 1] < m.row_index()[k]; }
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(sorted && m.nb_non_zero() <= 200, "hnc::sparse::csc, the indexes are not sorted or the duplicates are not merged\n");
+	}
+
+	// Conversions
+	{
+		++nb_test;
+		nb_test -= hnc::test::warning(m.to_vector2D() == dense, "hnc::sparse::csc::to_vector2D fails\n");
+		bool access = true;
+		for (std::size_t i = 0; i < nb_row; ++i) { for (std::size_t j = 0; j < nb_col; ++j) { access = access && m(i, j) == dense(i, j); } }
+		++nb_test;
+		nb_test -= hnc::test::warning(access, "hnc::sparse::csc::operator() fails\n");
+		hnc::sparse::csc<double> const from_dense(dense);
+		++nb_test;
+		nb_test -= hnc::test::warning(from_dense.to_vector2D() == dense && from_dense.nb_non_zero() <= m.nb_non_zero(), "hnc::sparse::csc from a hnc::vector2D fails\n");
+		hnc::sparse::csc<double> const from_coo(m.to_coo());
+		++nb_test;
+		nb_test -= hnc::test::warning(from_coo == m && (from_coo != m) == false, "hnc::sparse::csc::to_coo fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(m.to_vector2D<hnc::vector2D_storage::aligned_padded<double>>() == hnc::vector2D<double, hnc::vector2D_storage::aligned_padded<double>>(dense.view()), "hnc::sparse::csc::to_vector2D with aligned_padded storage fails\n");
+	}
+
+	// Conversion with CSR
+	{
+		hnc::sparse::csr<double> const m_csr(m_coo);
+		hnc::sparse::csc<double> const from_csr(m_csr);
+		++nb_test;
+		nb_test -= hnc::test::warning(from_csr == m && m.to_csr() == m_csr, "hnc::sparse::csc conversion with hnc::sparse::csr fails\n");
+	}
+	// Sparse matrix-vector product
+	{
+		std::vector<double> x(nb_col);
+		for (std::size_t j = 0; j < nb_col; ++j) { x[j] = double(j % 5) - 1.; }
+		std::vector<double> y_ref(nb_row, 0.);
+		for (std::size_t i = 0; i < nb_row; ++i) { for (std::size_t j = 0; j < nb_col; ++j) { y_ref[i] += dense(i, j) * x[j]; } }
+		++nb_test;
+		nb_test -= hnc::test::warning(m.multiply(x) == y_ref, "hnc::sparse::csc::multiply (sparse matrix-vector) fails\n");
+	}
+
+	// Sparse matrix-dense matrix product
+	{
+		hnc::vector2D<double> b(nb_col, 21);
+		for (std::size_t i = 0; i < b.nb_row(); ++i) { for (std::size_t j = 0; j < b.nb_col(); ++j) { b(i, j) = double((i + 2 * j) % 9) - 4.; } }
+		hnc::vector2D<double> c_ref(nb_row, b.nb_col(), 0.);
+		for (std::size_t i = 0; i < nb_row; ++i)
+		{
+			for (std::size_t k = 0; k < nb_col; ++k) { for (std::size_t j = 0; j < b.nb_col(); ++j) { c_ref(i, j) += dense(i, k) * b(k, j); } }
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(m.multiply(b) == c_ref, "hnc::sparse::csc::multiply (sparse matrix-dense matrix) fails\n");
+		hnc::vector2D<double, hnc::vector2D_storage::aligned_padded<double>> const b_padded(b.view());
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::vector2D<double>(m.multiply(b_padded).view()) == c_ref, "hnc::sparse::csc::multiply with aligned_padded storage fails\n");
+	}
+
+	// Empty matrix
+	{
+		hnc::sparse::csc<double> const empty(4, 3);
+		++nb_test;
+		nb_test -= hnc::test::warning(empty.nb_non_zero() == 0 && empty.density() == 0. && empty(3, 2) == 0. && empty.multiply(std::vector<double>(3, 1.)) == std::vector<double>(4, 0.), "hnc::sparse::csc without value fails\n");
+	}
+
+	// Wrong size
+	#ifndef NDEBUG
+	{
+		bool exception = false;
+		try { m.multiply(std::vector<double>(nb_col + 1, 1.)); }
+		catch (std::invalid_argument const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::sparse::csc::multiply with a wrong size does not throw\n");
+	}
+	#endif
+
+	hnc::test::warning(nb_test == 0, "hnc::sparse::csc: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,90 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <string>
+
+#include <hnc/trace.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+void compute()
+{
+	hnc_trace_scope("compute");
+	long double volatile x = 0;
+	for (std::size_t i = 0; i < 1000; ++i) { x = x + 1; }
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	hnc::trace::set_buffer_size(64);
+
+	// Disabled
+	compute();
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::trace::enabled() == false && hnc::trace::events().empty(), "hnc::trace: no event must be recorded when the tracing is disabled\n");
+
+	// Enabled
+	hnc::trace::enable();
+	{
+		hnc_trace_scope("main");
+		#pragma omp parallel for
+		for (int i = 0; i < 8; ++i) { compute(); }
+	}
+	hnc::trace::disable();
+	compute();
+
+	auto const events = hnc::trace::events();
+	std::size_t nb_event = 0;
+	for (auto const & thread_events : events) { nb_event += thread_events.size(); }
+	std::cout << "Number of threads = " << events.size() << std::endl;
+	std::cout << "Number of events  = " << nb_event << " (must be 9)" << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(nb_event == 9, "hnc::trace: 9 events must be recorded\n");
+	++nb_test;
+	nb_test -= hnc::test::warning
+	(
+		events.empty() == false && events[0].empty() == false && std::string(events[0].back().name) == "main",
+		"hnc::trace: the last event of the main thread must be \"main\"\n"
+	);
+
+	// Chrome JSON
+	std::string const json = hnc::trace::to_chrome_json();
+	std::cout << json << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(json.find("\"name\": \"compute\", \"ph\": \"X\"") != std::string::npos, "hnc::trace::to_chrome_json: must have complete events\n");
+	hnc::trace::save("hnc_trace.json");
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::filesystem::read_file("hnc_trace.json") == json, "hnc::trace::save: file is wrong\n");
+	hnc::filesystem::remove("hnc_trace.json");
+
+	// Ring buffer
+	hnc::trace::clear();
+	hnc::trace::enable();
+	for (std::size_t i = 0; i < 100; ++i) { compute(); }
+	hnc::trace::disable();
+	std::cout << "Lost events = " << hnc::trace::nb_lost_event() << " (must be 36)" << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(hnc::trace::events()[0].size() == 64 && hnc::trace::nb_lost_event() == 36, "hnc::trace: ring buffer must keep the 64 last events\n");
+	std::cout << std::endl;
+
+	hnc::test::warning(nb_test == 0, "hnc::trace: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -14,7 +14,9 @@
 
 
 #include <iostream>
+#include <type_traits>
 #include <vector>
+#include <string>
 
 #include <hnc/vector2D.hpp>
 #include <hnc/test.hpp>
@@ -1023,9 +1025,9 @@ int main()
 		{
 			unsigned int i = 10;
 			std::cout << "Write" << std::endl;
-			for (int row = int(v.nb_row() - 1); row > 0; --row)
+			for (int row = int(v.nb_row() - 1); row >= 0; --row)
 			{
-				for (int col = int(v.nb_col() - 1); col > 0; --col)
+				for (int col = int(v.nb_col() - 1); col >= 0; --col)
 				{
 					v(std::size_t(row), std::size_t(col)) = (unsigned int)(++i);
 					std::cout << v(std::size_t(row), std::size_t(col)) << " ";
@@ -1068,9 +1070,9 @@ int main()
 		{
 			unsigned int i = 10;
 			std::cout << "Read" << std::endl;
-			for (int row = int(v.nb_row() - 1); row > 0; --row)
+			for (int row = int(v.nb_row() - 1); row >= 0; --row)
 			{
-				for (int col = int(v.nb_col() - 1); col > 0; --col)
+				for (int col = int(v.nb_col() - 1); col >= 0; --col)
 				{
 					std::cout << v(std::size_t(row), std::size_t(col)) << " ";
 					++nb_test;
@@ -1082,6 +1084,128 @@ int main()
 		std::cout << std::endl;
 	}
 
+	// Reverse iterators visit the first row and the first column
+	{
+		hnc::vector2D<int> const v = { { 1, 2, 3 }, { 4, 5, 6 } };
+		hnc::vector2D<int> const empty;
+		std::vector<int> values;
+		for (auto it_l = v.crbegin(); it_l != v.crend(); ++it_l) { values.insert(values.end(), it_l->rbegin(), it_l->rend()); }
+		++nb_test;
+		nb_test -= hnc::test::warning(values == std::vector<int>({ 6, 5, 4, 3, 2, 1 }) && v.rend() - v.rbegin() == 2 && v[0].rend() - v[0].rbegin() == 3, "vector2D reverse iterators must visit the first row and the first column\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(empty.rbegin() == empty.rend() && (v.rend() - 1)->front() == 1 && *(v[1].rend() - 1) == 4, "vector2D reverse iterators fail\n");
+	}
+
+	// Move without copy, assignment returns a reference, lines created on demand
+	{
+		hnc::vector2D<double> v(300, 200, 4.2);
+		double const * const data = v.data();
+		hnc::vector2D<double> moved(std::move(v));
+		std::cout << "Move constructor keeps the data = " << (moved.data() == data) << " (must be 1)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(moved.data() == data && moved.nb_row() == 300 && moved.nb_col() == 200 && moved(299, 199) == 4.2, "vector2D move constructor must not copy the data\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(v.nb_row() == 0 && v.nb_col() == 0 && v.begin() == v.end(), "vector2D moved vector2D must be empty\n");
+
+		hnc::vector2D<double> assigned;
+		hnc::vector2D<double> & r = (assigned = std::move(moved));
+		++nb_test;
+		nb_test -= hnc::test::warning(&r == &assigned && assigned.data() == data && assigned[150][100] == 4.2, "vector2D move assignment must not copy the data and must return a reference\n");
+
+		hnc::vector2D<double> copy;
+		++nb_test;
+		nb_test -= hnc::test::warning(&(copy = assigned) == &copy && copy == assigned && copy.data() != assigned.data(), "vector2D copy assignment must return a reference\n");
+
+		++nb_test;
+		nb_test -= hnc::test::warning(sizeof(hnc::vector2D<double>) == sizeof(std::vector<double>) + 2 * sizeof(std::size_t), "vector2D must only have the data and the sizes\n");
+
+		// Iterator of a temporary line
+		auto it = copy[1].begin();
+		*it = 1.;
+		auto const end = copy[1].end();
+		++nb_test;
+		nb_test -= hnc::test::warning(copy(1, 0) == 1. && std::size_t(end - it) == copy.nb_col(), "vector2D iterator of a line must be valid after the line\n");
+
+		// A line returned by value is a view
+		static_assert(std::is_reference<decltype(copy[1])>::value == false, "vector2D::operator[] must return the line by value");
+		auto line = copy[2];
+		line[3] = 7.;
+		auto const back = copy.back();
+		++nb_test;
+		nb_test -= hnc::test::warning(copy(2, 3) == 7. && &back[0] == &copy(copy.nb_row() - 1, 0), "vector2D line returned by value must be a view on the data\n");
+
+		// Lines of a const vector2D
+		hnc::vector2D<double> const & c = copy;
+		double sum = 0;
+		for (auto const & line : c) { for (double const x : line) { sum += x; } }
+		std::cout << "Sum = " << sum << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(c.end() - c.begin() == 300 && sum > 0, "vector2D const iteration fails\n");
+		std::cout << std::endl;
+	}
+
+	// Capacity, push_back_row and in-place column insertion/removal
+	{
+		hnc::vector2D<int> v;
+		v.push_back_row(std::vector<int>({ 1, 2, 3 }));
+		v.reserve_rows(100);
+		int const * const data = v.data();
+		for (int row = 1; row < 100; ++row) { v.push_back_row(std::vector<int>({ 10 * row + 1, 10 * row + 2, 10 * row + 3 })); }
+		std::cout << "push_back_row: " << v.nb_row() << " x " << v.nb_col() << ", capacity_rows = " << v.capacity_rows() << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(v.nb_row() == 100 && v.nb_col() == 3 && v(99, 2) == 993 && v.data() == data, "vector2D push_back_row must not reallocate after reserve_rows\n");
+
+		v.push_back_row(7);
+		hnc::vector2D<double> d(1, 2, 1.);
+		d.push_back_row(0);
+		d.push_back_row(std::vector<double>({ 2., 3. }));
+		++nb_test;
+		nb_test -= hnc::test::warning(d.nb_row() == 3 && d(1, 1) == 0. && d(2, 1) == 3., "vector2D push_back_row with a value convertible to T fails\n");
+
+		// Push back a row of the vector2D itself, with a reallocation
+		hnc::vector2D<std::string> words = { { "a long string without small string optimization 0", "b" }, { "c", "d" } };
+		words.shrink_to_fit();
+		words.push_back_row(words[0]);
+		words.push_back_row(words.back());
+		++nb_test;
+		nb_test -= hnc::test::warning(words.nb_row() == 4 && words(2, 0) == words(0, 0) && words(3, 0) == words(0, 0) && words(3, 1) == "b" && words(0, 0).empty() == false, "vector2D push_back_row with a row of itself fails\n");
+		v.remove_line(100);
+		v.remove_line(0);
+		++nb_test;
+		nb_test -= hnc::test::warning(v.nb_row() == 99 && v(0, 0) == 11 && v(98, 2) == 993, "vector2D remove_line fails\n");
+
+		v.reserve_cols(5);
+		int const * const data_cols = v.data();
+		v.add_col_before(0, -1);
+		v.add_col_after(3, -4);
+		std::cout << "add_col: first row = " << v[0][0] << " " << v[0][1] << " " << v[0][2] << " " << v[0][3] << " " << v[0][4] << " (must be -1 11 12 13 -4)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			v.nb_col() == 5 && v.data() == data_cols &&
+			v(0, 0) == -1 && v(0, 1) == 11 && v(0, 3) == 13 && v(0, 4) == -4 &&
+			v(98, 0) == -1 && v(98, 1) == 991 && v(98, 3) == 993 && v(98, 4) == -4,
+			"vector2D add_col must shift the values in place\n"
+		);
+
+		v.remove_column(4);
+		v.remove_column(0);
+		v.remove_column(1);
+		++nb_test;
+		nb_test -= hnc::test::warning(v.nb_col() == 2 && v(0, 0) == 11 && v(0, 1) == 13 && v(98, 0) == 991 && v(98, 1) == 993, "vector2D remove_column fails\n");
+
+		// The default value is a value of the vector2D
+		v.add_col_before(1, v(0, 0));
+		++nb_test;
+		nb_test -= hnc::test::warning(v(0, 1) == 11 && v(98, 1) == 11 && v(98, 2) == 993, "vector2D add_col_before with a value of the vector2D fails\n");
+
+		v.shrink_to_fit();
+		std::cout << "shrink_to_fit: capacity_rows = " << v.capacity_rows() << " (must be 99)" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(v.capacity_rows() == 99, "vector2D shrink_to_fit fails\n");
+		std::cout << std::endl;
+	}
+
 	hnc::test::warning(nb_test == 0, "hnc::vector2D: " + hnc::to_string(nb_test) + " test fail!\n");
 
 	return nb_test;
@@ -0,0 +1,166 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_expression.hpp>
+#include <hnc/vector2D_storage.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+template <class storage_t>
+int test_expression(std::string const & name)
+{
+	int nb_test = 0;
+
+	using matrix_t = hnc::vector2D<double, storage_t>;
+
+	// a(i, j) = i + j, b(i, j) = i * j
+	std::size_t const nb_row = 7;
+	std::size_t const nb_col = 13;
+	matrix_t a(nb_row, nb_col);
+	matrix_t b(nb_row, nb_col);
+	for (std::size_t i = 0; i < nb_row; ++i)
+	{
+		for (std::size_t j = 0; j < nb_col; ++j)
+		{
+			a(i, j) = double(i + j);
+			b(i, j) = double(i * j);
+		}
+	}
+
+	// Expressions
+	{
+		matrix_t const c = a + b;
+		matrix_t const d = 2. * a - b / 4. + hnc::element_wise_product(a, b);
+		matrix_t e(1, 1);
+		e = -(a - b) * 3.;
+		bool ok = (c.nb_row() == nb_row && c.nb_col() == nb_col && e.nb_row() == nb_row && e.nb_col() == nb_col);
+		for (std::size_t i = 0; i < nb_row; ++i)
+		{
+			for (std::size_t j = 0; j < nb_col; ++j)
+			{
+				ok = ok && c(i, j) == a(i, j) + b(i, j);
+				ok = ok && d(i, j) == 2. * a(i, j) - b(i, j) / 4. + a(i, j) * b(i, j);
+				ok = ok && e(i, j) == -(a(i, j) - b(i, j)) * 3.;
+			}
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(ok, name + ", expressions fail\n");
+	}
+
+	// Compound assignments
+	{
+		matrix_t c = a;
+		c += b;
+		++nb_test;
+		nb_test -= hnc::test::warning(c == matrix_t(a + b), name + ", operator += fails\n");
+		c -= b;
+		++nb_test;
+		nb_test -= hnc::test::warning(c == a, name + ", operator -= fails\n");
+		c *= 4.;
+		c /= 2.;
+		++nb_test;
+		nb_test -= hnc::test::warning(c == matrix_t(a + a), name + ", operators *= and /= fail\n");
+		c += c;
+		++nb_test;
+		nb_test -= hnc::test::warning(c == matrix_t(4. * a), name + ", operator += with itself fails\n");
+	}
+
+	// Fill, axpy
+	{
+		matrix_t c(nb_row, nb_col);
+		c.fill(1.5);
+		++nb_test;
+		nb_test -= hnc::test::warning(c == matrix_t(nb_row, nb_col, 1.5), name + "::fill fails\n");
+		c.axpy(2., a);
+		++nb_test;
+		nb_test -= hnc::test::warning(c == matrix_t(2. * a + matrix_t(nb_row, nb_col, 1.5)), name + "::axpy fails\n");
+		c[3].fill(0.);
+		c[2].axpy(-1., b[2]);
+		++nb_test;
+		nb_test -= hnc::test::warning(c(3, 0) == 0. && c(3, nb_col - 1) == 0. && c(4, 0) == 9.5 && c(2, 5) == 2. * 7. + 1.5 - 10., name + ", fill and axpy on a row fail\n");
+	}
+
+	// Reductions
+	{
+		double sum = 0;
+		double sum_product = 0;
+		for (std::size_t i = 0; i < nb_row; ++i)
+		{
+			for (std::size_t j = 0; j < nb_col; ++j)
+			{
+				sum += a(i, j);
+				sum_product += a(i, j) * b(i, j);
+			}
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(a.sum() == sum && a.min() == 0. && a.max() == double(nb_row - 1 + nb_col - 1), name + "::sum, min, max fail\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(a.dot(b) == sum_product, name + "::dot fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(a[2].sum() == double(2 * nb_col + (nb_col - 1) * nb_col / 2) && a[2].min() == 2. && a[2].max() == double(2 + nb_col - 1), name + ", sum, min and max of a row fail\n");
+		std::vector<double> const ones(nb_col, 1.);
+		++nb_test;
+		nb_test -= hnc::test::warning(a[2].dot(ones) == a[2].sum() && a[1].dot(b[1]) == b[1].dot(a[1]), name + ", dot of a row fails\n");
+		matrix_t const & a_const = a;
+		++nb_test;
+		nb_test -= hnc::test::warning(a_const[6].sum() == a[6].sum() && a_const[6].max() == 18. && a_const[6].dot(ones) == a[6].sum(), name + ", reductions of a const row fail\n");
+	}
+
+	// Different sizes
+	#ifndef NDEBUG
+	{
+		bool exception = false;
+		try { matrix_t const c = a + matrix_t(nb_row, nb_col + 1); }
+		catch (std::invalid_argument const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, name + ", expression with different sizes does not throw\n");
+	}
+	#endif
+
+	return nb_test;
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	nb_test += test_expression<hnc::vector2D_storage::packed<double>>("hnc::vector2D");
+	nb_test += test_expression<hnc::vector2D_storage::aligned<double>>("hnc::vector2D<double, aligned>");
+	nb_test += test_expression<hnc::vector2D_storage::aligned_padded<double>>("hnc::vector2D<double, aligned_padded>");
+
+	// Mixed storages
+	{
+		hnc::vector2D<float> a(5, 9, 2.f);
+		hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>> b(5, 9, 3.f);
+		hnc::vector2D<float> const c = a + b * 2.f;
+		hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>> d(c - a);
+		++nb_test;
+		nb_test -= hnc::test::warning(c == hnc::vector2D<float>(5, 9, 8.f) && d(4, 8) == 6.f && a.dot(b) == 2.f * 3.f * 45.f, "hnc::vector2D, expression with different storages fails\n");
+		b.axpy(1.f, a);
+		++nb_test;
+		nb_test -= hnc::test::warning(b.sum() == 5.f * 45.f && b.min() == 5.f, "hnc::vector2D::axpy with different storages fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector2D_expression: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
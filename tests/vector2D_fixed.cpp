@@ -0,0 +1,128 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <hnc/vector2D_fixed.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+// Generic code with the API of hnc::vector2D
+template <class matrix_t>
+typename matrix_t::value_type sum_of_diagonal_and_rows(matrix_t & m)
+{
+	typename matrix_t::value_type r = 0;
+	for (std::size_t i = 0; i < std::min(m.nb_row(), m.nb_col()); ++i) { r += m(i, i); }
+	for (auto row : m) { r += row.sum(); }
+	m[0][0] = 0;
+	return r;
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	// Compile time
+	{
+		constexpr hnc::vector2D_fixed<int, 2, 3> m(hnc::row_major_values, 1, 2, 3, 4, 5, 6);
+		static_assert(m(1, 2) == 6 && m.at(0, 1) == 2, "hnc::vector2D_fixed constexpr access fails");
+		static_assert(hnc::vector2D_fixed<int, 2, 3>::nb_row() == 2 && hnc::vector2D_fixed<int, 2, 3>::nb_col() == 3, "hnc::vector2D_fixed constexpr sizes fail");
+		static_assert(hnc::vector2D_fixed<int, 2, 3>::index(1, 1) == 4, "hnc::vector2D_fixed constexpr index fails");
+		static_assert(sizeof(hnc::vector2D_fixed<double, 4, 4>) == 16 * sizeof(double), "hnc::vector2D_fixed has a overhead");
+		static_assert(std::is_trivially_copyable<hnc::vector2D_fixed<double, 3, 3>>::value, "hnc::vector2D_fixed<double, 3, 3> is not trivially copyable");
+		constexpr hnc::vector2D_fixed<double, 2, 2> zero;
+		static_assert(zero(1, 1) == 0., "hnc::vector2D_fixed default constructor fails");
+		std::cout << "constexpr matrix:\n" << m << "\n" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(m.sum() == 21 && m.min() == 1 && m.max() == 6, "hnc::vector2D_fixed sum, min, max fail\n");
+	}
+
+	// Constructors
+	{
+		hnc::vector2D_fixed<double, 3, 3> const a(3, 3, 2.);
+		hnc::vector2D_fixed<double, 3, 3> const b = { { 1, 2, 3 }, { 4, 5 } };
+		++nb_test;
+		nb_test -= hnc::test::warning(a(2, 2) == 2. && a(0, 1) == 2., "hnc::vector2D_fixed constructor with default value fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(b(0, 2) == 3. && b(1, 1) == 5. && b(1, 2) == 0. && b(2, 0) == 0., "hnc::vector2D_fixed constructor with initializer list fails\n");
+		// Sizes are not values when the number of values is 2 or 3
+		hnc::vector2D_fixed<double, 2, 1> const sizes(2, 1);
+		hnc::vector2D_fixed<int, 1, 3> const sizes_default(1, 3, 7);
+		hnc::vector2D_fixed<int, 1, 3> const values(hnc::row_major_values, 1, 3, 7);
+		hnc::vector2D_fixed<int, 1, 1> const value(hnc::row_major_values, 42);
+		++nb_test;
+		nb_test -= hnc::test::warning(sizes(0, 0) == 0. && sizes(1, 0) == 0. && sizes_default(0, 0) == 7 && sizes_default(0, 2) == 7, "hnc::vector2D_fixed constructor with the sizes fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(values(0, 0) == 1 && values(0, 1) == 3 && values(0, 2) == 7 && value(0, 0) == 42, "hnc::vector2D_fixed constructor with the values fails\n");
+		hnc::vector2D<double> const big = { { 0, 1, 2, 3 }, { 4, 5, 6, 7 }, { 8, 9, 10, 11 } };
+		hnc::vector2D_fixed<double, 2, 2> const block(big.sub_view(1, 2, 2, 2));
+		++nb_test;
+		nb_test -= hnc::test::warning(block == hnc::vector2D_fixed<double, 2, 2>(hnc::row_major_values, 6., 7., 10., 11.), "hnc::vector2D_fixed constructor with a view fails\n");
+	}
+
+	// Same API as hnc::vector2D
+	{
+		hnc::vector2D<int> dynamic = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+		hnc::vector2D_fixed<int, 3, 3> fixed = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+		int const r_dynamic = sum_of_diagonal_and_rows(dynamic);
+		int const r_fixed = sum_of_diagonal_and_rows(fixed);
+		++nb_test;
+		nb_test -= hnc::test::warning(r_dynamic == 60 && r_fixed == 60 && dynamic(0, 0) == 0 && fixed(0, 0) == 0, "hnc::vector2D_fixed generic code with hnc::vector2D fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(fixed[1][2] == 6 && fixed.back().front() == 7 && fixed.col(1)[2] == 8 && fixed.transposed_view()(2, 1) == 6, "hnc::vector2D_fixed lines and views fail\n");
+		std::size_t nb_row = 0;
+		for (auto it = fixed.rbegin(); it != fixed.rend(); ++it) { ++nb_row; }
+		++nb_test;
+		nb_test -= hnc::test::warning(nb_row == 3 && fixed.end() - fixed.begin() == 3 && fixed.rend() - fixed.rbegin() == 3 && (fixed.rend() - 1)->front() == 0 && (dynamic.rend() - 1)->front() == 0, "hnc::vector2D_fixed iterators fail\n");
+	}
+
+	// Element-wise expressions
+	{
+		hnc::vector2D_fixed<double, 2, 2> const a(hnc::row_major_values, 1., 2., 3., 4.);
+		hnc::vector2D_fixed<double, 2, 2> const b(hnc::row_major_values, 10., 20., 30., 40.);
+		hnc::vector2D_fixed<double, 2, 2> c = 2. * a + b;
+		++nb_test;
+		nb_test -= hnc::test::warning(c == hnc::vector2D_fixed<double, 2, 2>(hnc::row_major_values, 12., 24., 36., 48.), "hnc::vector2D_fixed expression fails\n");
+		c -= b;
+		c /= 2.;
+		++nb_test;
+		nb_test -= hnc::test::warning(c == a && c.dot(b) == 300., "hnc::vector2D_fixed -=, /= or dot fails\n");
+		c.axpy(-1., a);
+		c = hnc::element_wise_product(a, b);
+		++nb_test;
+		nb_test -= hnc::test::warning(c(1, 1) == 160., "hnc::vector2D_fixed element_wise_product fails\n");
+		hnc::vector2D<double> const dynamic = a - b;
+		++nb_test;
+		nb_test -= hnc::test::warning(dynamic.nb_row() == 2 && dynamic(1, 0) == -27., "hnc::vector2D from an expression on hnc::vector2D_fixed fails\n");
+	}
+
+	// Out of range
+	{
+		hnc::vector2D_fixed<int, 2, 2> m;
+		bool exception = false;
+		try { m.at(2, 0) = 1; }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_fixed::at out of range does not throw\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector2D_fixed: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
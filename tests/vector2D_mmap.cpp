@@ -0,0 +1,192 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+
+#include <hnc/vector2D_mmap.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/filesystem.hpp>
+#include <hnc/except.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	#ifdef hnc_unix
+
+	std::string const filename = hnc::filesystem::tmp_filename();
+
+	// Matrix 4 x 5 with 10, 11, ..., 29
+	hnc::vector2D<double> ref(4, 5);
+	{
+		double value = 10;
+		for (auto line : ref) { for (double & v : line) { v = value++; } }
+	}
+
+	// Create
+	{
+		hnc::vector2D_mmap<double> m(filename, 4, 5, 0., hnc::vector2D_mmap<double>::advice_t::sequential);
+		++nb_test;
+		nb_test -= hnc::test::warning(m.nb_row() == 4 && m.nb_col() == 5 && m.size() == 20 && m.sum() == 0. && m.filename() == filename, "hnc::vector2D_mmap, creation fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(m.data()) % 64 == 0, "hnc::vector2D_mmap, the values are not aligned on 64 bytes\n");
+
+		double value = 10;
+		for (auto line : m) { for (double & v : line) { v = value++; } }
+		std::cout << "hnc::vector2D_mmap:\n" << hnc::vector2D<double>(m.view()) << "\n" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(m(1, 2) == 17. && m[3][4] == 29. && m.at(2, 0) == 20. && m.front().front() == 10. && m.back().back() == 29. && m.rbegin()->front() == 25., "hnc::vector2D_mmap access fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(m.rend() - m.rbegin() == 4 && (m.rend() - 1)->front() == 10. && std::distance(m.rbegin(), m.rend()) == 4, "hnc::vector2D_mmap reverse iterators must visit the first row\n");
+
+		bool exception = false;
+		try { m.at(4, 0); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_mmap::at does not throw\n");
+
+		m.flush();
+	}
+
+	// File size
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		++nb_test;
+		nb_test -= hnc::test::warning(std::size_t(file.tellg()) == 64 + 20 * sizeof(double), "hnc::vector2D_mmap, the file size is " + hnc::to_string(file.tellg()) + "\n");
+	}
+
+	// Reopen
+	{
+		hnc::vector2D_mmap<double> const m(filename, hnc::vector2D_mmap<double>::mode_t::read_only, hnc::vector2D_mmap<double>::advice_t::random);
+		++nb_test;
+		nb_test -= hnc::test::warning(m.nb_row() == 4 && m.nb_col() == 5 && hnc::vector2D<double>(m.view()) == ref, "hnc::vector2D_mmap, reopen fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(m.min() == 10. && m.max() == 29. && m.sum() == ref.sum() && m.dot(ref) == ref.dot(ref) && m.sub_view(1, 1, 2, 2)(1, 1) == 22., "hnc::vector2D_mmap, reductions and views fail\n");
+	}
+
+	// Modify, expressions
+	{
+		hnc::vector2D_mmap<double> m(filename);
+		m = 2. * m + ref;
+		m.axpy(-1., ref);
+		m[0].fill(0.);
+		m.flush(false);
+		hnc::vector2D_mmap<double> moved(std::move(m));
+		++nb_test;
+		nb_test -= hnc::test::warning(m.data() == nullptr && moved(0, 4) == 0. && moved(1, 0) == 30. && moved(3, 4) == 58., "hnc::vector2D_mmap, expressions and move fail\n");
+	}
+	{
+		hnc::vector2D_mmap<double> const m(filename, hnc::vector2D_mmap<double>::mode_t::read_only);
+		++nb_test;
+		nb_test -= hnc::test::warning(m(0, 0) == 0. && m(2, 3) == 2. * ref(2, 3), "hnc::vector2D_mmap, the modifications are not saved\n");
+	}
+
+	// Non-const read only object: the writes throw instead of writing in a PROT_READ mapping
+	{
+		hnc::vector2D_mmap<double> m(filename, hnc::vector2D_mmap<double>::mode_t::read_only);
+		std::size_t nb_exception = 0;
+		try { m.fill(1.); }
+		catch (std::logic_error const &) { ++nb_exception; }
+		try { m.axpy(1., ref); }
+		catch (std::logic_error const &) { ++nb_exception; }
+		try { m = 2. * ref; }
+		catch (std::logic_error const &) { ++nb_exception; }
+		#ifndef NDEBUG
+			try { m(0, 0) = 1.; }
+			catch (std::logic_error const &) { ++nb_exception; }
+			try { m[1][1] = 1.; }
+			catch (std::logic_error const &) { ++nb_exception; }
+			try { m.view()(0, 0) = 1.; }
+			catch (std::logic_error const &) { ++nb_exception; }
+			std::size_t const nb_exception_expected = 6;
+		#else
+			std::size_t const nb_exception_expected = 3;
+		#endif
+		hnc::vector2D_mmap<double> const & m_const = m;
+		++nb_test;
+		nb_test -= hnc::test::warning(nb_exception == nb_exception_expected && m.mode() == hnc::vector2D_mmap<double>::mode_t::read_only && m_const(0, 0) == 0. && m_const(2, 3) == 2. * ref(2, 3), "hnc::vector2D_mmap, the writes in read only mode must throw\n");
+	}
+
+	// Create from a vector2D, default value
+	{
+		{
+			hnc::vector2D_mmap<double> const m(filename, ref.view());
+			hnc::vector2D_mmap<double> const m_transposed(filename + "_transposed", ref.transposed_view());
+			hnc::vector2D_mmap<double> const m_default(filename + "_default", 3, 7, 4.5);
+			++nb_test;
+			nb_test -= hnc::test::warning(m_transposed.nb_row() == 5 && m_transposed(4, 3) == 29. && m_transposed(1, 0) == 11. && m_default.sum() == 3. * 7. * 4.5, "hnc::vector2D_mmap, creation from a view or with a default value fails\n");
+		}
+		hnc::vector2D_mmap<double> const m(filename);
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::vector2D<double>(m.view()) == ref, "hnc::vector2D_mmap, creation from a vector2D fails\n");
+		std::remove((filename + "_transposed").c_str());
+		std::remove((filename + "_default").c_str());
+	}
+
+	// Empty matrix
+	{
+		{ hnc::vector2D_mmap<int> const m(filename + "_empty", 0, 0); }
+		hnc::vector2D_mmap<int> const m(filename + "_empty");
+		++nb_test;
+		nb_test -= hnc::test::warning(m.empty() && m.begin() == m.end(), "hnc::vector2D_mmap, empty matrix fails\n");
+		std::remove((filename + "_empty").c_str());
+	}
+
+	// Errors
+	{
+		bool exception = false;
+		try { hnc::vector2D_mmap<float> const m(filename); }
+		catch (std::runtime_error const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_mmap, open a file of double as a file of float does not throw\n");
+
+		exception = false;
+		try { hnc::vector2D_mmap<std::int64_t> const m(filename); }
+		catch (std::runtime_error const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_mmap, open a file of double as a file of int64_t does not throw\n");
+
+		exception = false;
+		try { hnc::vector2D_mmap<double> const m(filename + "_does_not_exist"); }
+		catch (hnc::except::file_not_found const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_mmap, open a file which does not exist does not throw\n");
+
+		{ std::ofstream file(filename + "_not_a_matrix"); file << "This is not a matrix, this is a text file with more than 64 bytes, which is enough for a header."; }
+		exception = false;
+		try { hnc::vector2D_mmap<double> const m(filename + "_not_a_matrix"); }
+		catch (std::runtime_error const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_mmap, open a text file does not throw\n");
+		std::remove((filename + "_not_a_matrix").c_str());
+	}
+
+	std::remove(filename.c_str());
+
+	#endif
+
+	hnc::test::warning(nb_test == 0, "hnc::vector2D_mmap: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
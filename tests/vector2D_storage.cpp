@@ -0,0 +1,161 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_storage.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+template <class T, class storage_t>
+bool is_aligned(hnc::vector2D<T, storage_t> const & m, std::size_t const alignment)
+{
+	for (std::size_t row = 0; row < m.nb_row(); ++row)
+	{
+		if (reinterpret_cast<std::uintptr_t>(m[row].data()) % alignment != 0) { return false; }
+	}
+	return true;
+}
+
+template <class storage_t>
+int test_storage(std::string const & name)
+{
+	int nb_test = 0;
+
+	using matrix_t = hnc::vector2D<int, storage_t>;
+
+	// Matrix 3 x 5 with 10, 11, ..., 24
+	matrix_t m(3, 5);
+	{
+		int value = 10;
+		for (auto line : m) { for (int & v : line) { v = value++; } }
+	}
+	std::cout << name << ":\n" << m << "\n" << std::endl;
+
+	++nb_test;
+	nb_test -= hnc::test::warning(m.row_stride() == storage_t::row_stride(5) && m.row_stride() >= 5 && m(1, 0) == 15 && m[2][4] == 24 && m.at(2, 4) == 24, name + ", access fails\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(m.data()) % storage_t::alignment == 0, name + ", data is not aligned\n");
+
+	// Views
+	{
+		++nb_test;
+		nb_test -= hnc::test::warning(m.view()(2, 3) == 23 && m.view().row_stride() == m.row_stride() && m.col(1)[2] == 21 && m.transposed_view()(4, 1) == 19, name + ", views fail\n");
+		hnc::vector2D<int> const copy(m.view());
+		++nb_test;
+		nb_test -= hnc::test::warning(copy.nb_row() == 3 && copy.nb_col() == 5 && copy(2, 4) == 24 && copy(1, 2) == 17, name + ", copy from a view fails\n");
+		matrix_t const m_copy(copy.view());
+		++nb_test;
+		nb_test -= hnc::test::warning(m_copy == m, name + ", construction from a view fails\n");
+	}
+
+	// Equality ignores the padding
+	{
+		matrix_t a(3, 5, 1);
+		matrix_t b(3, 5, 1);
+		a.add_col_after(4, 2);
+		b.add_col_after(4, 2);
+		a.remove_column(5);
+		b.remove_column(5);
+		++nb_test;
+		nb_test -= hnc::test::warning(a == b && a == matrix_t(3, 5, 1) && (a != b) == false, name + ", equality fails\n");
+	}
+
+	// Add rows and columns
+	{
+		matrix_t a = m;
+		a.add_row_before(1, -1);
+		a.add_col_before(2, -2);
+		a.push_back_row(std::vector<int>({ 1, 2, 3, 4, 5, 6 }));
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			a.nb_row() == 5 && a.nb_col() == 6 &&
+			a(0, 0) == 10 && a(0, 1) == 11 && a(0, 2) == -2 && a(0, 3) == 12 && a(0, 5) == 14 &&
+			a(1, 0) == -1 && a(1, 2) == -2 && a(1, 5) == -1 &&
+			a(3, 0) == 20 && a(3, 2) == -2 && a(3, 5) == 24 &&
+			a(4, 0) == 1 && a(4, 5) == 6,
+			name + ", add rows and columns fails\n"
+		);
+		++nb_test;
+		nb_test -= hnc::test::warning(is_aligned(a, (storage_t::row_stride(1) == 1) ? alignof(int) : storage_t::alignment), name + ", add rows and columns breaks the alignment\n");
+
+		a.remove_column(2);
+		a.remove_line(1);
+		a.remove_line(3);
+		++nb_test;
+		nb_test -= hnc::test::warning(a == m, name + ", remove rows and columns fails\n");
+
+		// Many columns (the row stride changes)
+		for (int j = 0; j < 20; ++j) { a.add_col_after(a.nb_col() - 1, j); }
+		++nb_test;
+		nb_test -= hnc::test::warning(a.nb_col() == 25 && a(0, 4) == 14 && a(2, 5) == 0 && a(1, 24) == 19 && a(2, 0) == 20, name + ", add columns fails\n");
+		while (a.nb_col() > 5) { a.remove_column(a.nb_col() - 1); }
+		++nb_test;
+		nb_test -= hnc::test::warning(a == m, name + ", remove columns fails\n");
+	}
+
+	// Capacity
+	{
+		matrix_t a = m;
+		a.reserve_rows(100);
+		int const * const p = a.data();
+		for (int i = 0; i < 97; ++i) { a.push_back_row(std::vector<int>(5, i)); }
+		++nb_test;
+		nb_test -= hnc::test::warning(a.data() == p && a.capacity_rows() >= 100 && a(99, 4) == 96, name + ", reserve_rows fails\n");
+	}
+
+	return nb_test;
+}
+
+int main()
+{
+	int nb_test = 0;
+
+	nb_test += test_storage<hnc::vector2D_storage::packed<int>>("hnc::vector2D_storage::packed");
+	nb_test += test_storage<hnc::vector2D_storage::aligned<int>>("hnc::vector2D_storage::aligned");
+	nb_test += test_storage<hnc::vector2D_storage::aligned_padded<int>>("hnc::vector2D_storage::aligned_padded");
+	nb_test += test_storage<hnc::vector2D_storage::aligned_padded<int, 32>>("hnc::vector2D_storage::aligned_padded<int, 32>");
+
+	// Row stride
+	{
+		++nb_test;
+		nb_test -= hnc::test::warning
+		(
+			hnc::vector2D_storage::aligned_padded<double>::row_stride(0) == 0 &&
+			hnc::vector2D_storage::aligned_padded<double>::row_stride(1) == 8 &&
+			hnc::vector2D_storage::aligned_padded<double>::row_stride(8) == 8 &&
+			hnc::vector2D_storage::aligned_padded<double>::row_stride(9) == 16 &&
+			hnc::vector2D_storage::aligned_padded<float>::row_stride(100) == 112,
+			"hnc::vector2D_storage::aligned_padded::row_stride fails\n"
+		);
+	}
+
+	// Aligned rows
+	{
+		hnc::vector2D<float, hnc::vector2D_storage::aligned_padded<float>> const m(17, 33, 1.f);
+		++nb_test;
+		nb_test -= hnc::test::warning(m.row_stride() == 48 && is_aligned(m, 64), "hnc::vector2D_storage::aligned_padded, the rows are not aligned on 64 bytes\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector2D_storage: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
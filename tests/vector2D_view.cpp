@@ -0,0 +1,203 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <array>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <hnc/vector2D.hpp>
+#include <hnc/vector2D_view.hpp>
+#include <hnc/algo/sum.hpp>
+#include <hnc/math/mean.hpp>
+#include <hnc/math/median.hpp>
+#include <hnc/math/standard_deviation.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Matrix 4 x 5 with 10, 11, ..., 29
+	hnc::vector2D<int> m(4, 5);
+	{
+		int value = 10;
+		for (std::size_t row = 0; row < m.nb_row(); ++row)
+		{
+			for (std::size_t col = 0; col < m.nb_col(); ++col) { m(row, col) = value++; }
+		}
+	}
+	std::cout << "Matrix:\n" << m << "\n" << std::endl;
+
+	// View on the matrix
+	{
+		hnc::vector2D_view<int> const v = m.view();
+		++nb_test;
+		nb_test -= hnc::test::warning(v.nb_row() == 4 && v.nb_col() == 5 && v.size() == 20 && v.data() == m.data(), "hnc::vector2D_view, view of the matrix fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(v.is_contiguous(), "hnc::vector2D_view::is_contiguous of the matrix fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(std::equal(v.begin(), v.end(), m.data()), "hnc::vector2D_view iteration on the matrix fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(v[2][3] == 23 && v(3, 4) == 29 && v.row(1).is_contiguous() && v.row(1).front() == 15, "hnc::vector2D_view access fails\n");
+	}
+
+	// Block
+	{
+		auto const block = m.sub_view(1, 2, 2, 3);
+		std::cout << "Block (1, 2) 2 x 3:\n" << block << "\n" << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(block.data() == &m(1, 2), "hnc::vector2D::sub_view copies the values\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(block(0, 0) == 17 && block(1, 2) == 24 && block.is_contiguous() == false, "hnc::vector2D::sub_view fails\n");
+		std::vector<int> const values(block.begin(), block.end());
+		++nb_test;
+		nb_test -= hnc::test::warning(values == std::vector<int>({ 17, 18, 19, 22, 23, 24 }), "hnc::vector2D_view iteration on a block fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(block.end() - block.begin() == 6 && *(block.begin() + 4) == 23 && *(block.end() - 1) == 24, "hnc::vector2D_view random access iterator fails\n");
+
+		// Sub-view of a sub-view
+		auto const sub_block = block.sub_view(1, 1, 1, 2);
+		++nb_test;
+		nb_test -= hnc::test::warning(sub_block.data() == &m(2, 3) && sub_block(0, 1) == 24 && sub_block.is_contiguous(), "hnc::vector2D_view::sub_view of a sub-view fails\n");
+
+		// The iterator stays valid after the view is destroyed
+		auto const it = m.sub_view(2, 1, 2, 2).begin();
+		++nb_test;
+		nb_test -= hnc::test::warning(*it == 21 && it[2] == 26, "hnc::vector2D_view iterator on a temporary view fails\n");
+	}
+
+	// Transposed view
+	{
+		auto const t = m.transposed_view();
+		std::cout << "Transposed:\n" << t << "\n" << std::endl;
+		bool same = (t.nb_row() == 5 && t.nb_col() == 4);
+		for (std::size_t i = 0; same && i < t.nb_row(); ++i)
+		{
+			for (std::size_t j = 0; j < t.nb_col(); ++j) { if (t(i, j) != m(j, i)) { same = false; } }
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(same, "hnc::vector2D::transposed_view fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(t.transposed()(2, 3) == m(2, 3) && t.transposed().is_contiguous(), "hnc::vector2D_view::transposed of the transposed view fails\n");
+		std::vector<int> const first_values(t.begin(), t.begin() + 5);
+		++nb_test;
+		nb_test -= hnc::test::warning(first_values == std::vector<int>({ 10, 15, 20, 25, 11 }), "hnc::vector2D_view iteration on a transposed view fails\n");
+
+		// Copy of a view
+		hnc::vector2D<int> const copy(t);
+		++nb_test;
+		nb_test -= hnc::test::warning(copy.nb_row() == 5 && copy.nb_col() == 4 && copy(4, 3) == 29 && copy(1, 2) == 21, "hnc::vector2D constructor with a view fails\n");
+	}
+
+	// Rows, columns, diagonal
+	{
+		hnc::vector2D<int> const & c = m;
+		auto const col = c.col(2);
+		std::cout << "Column 2: " << col << std::endl;
+		std::cout << "Diagonal: " << c.view().diagonal() << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(col.size() == 4 && col.stride() == 5 && col[3] == 27 && col.back() == 27 && col.is_contiguous() == false, "hnc::vector2D::col fails\n");
+		std::vector<int> const diagonal(c.view().diagonal().begin(), c.view().diagonal().end());
+		++nb_test;
+		nb_test -= hnc::test::warning(diagonal == std::vector<int>({ 10, 16, 22, 28 }), "hnc::vector2D_view::diagonal fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(c.view().transposed().row(2)[3] == 27 && c.view().transposed().col(1).sub_view(1, 3)[0] == 16, "hnc::vector2D_view row and col of a transposed view fail\n");
+		std::cout << std::endl;
+	}
+
+	// Write through the views
+	{
+		hnc::vector2D<int> w = m;
+		w.sub_view(0, 0, 2, 2).fill(0);
+		w.col(4).fill(-1);
+		++nb_test;
+		nb_test -= hnc::test::warning(w(0, 0) == 0 && w(1, 1) == 0 && w(2, 2) == 22 && w(0, 4) == -1 && w(3, 4) == -1 && w(0, 3) == 13, "hnc::vector2D_view::fill fails\n");
+
+		// Copy a block in the transposed block
+		w.sub_view(2, 0, 2, 2).assign(m.sub_view(2, 0, 2, 2).transposed());
+		++nb_test;
+		nb_test -= hnc::test::warning(w(2, 0) == 20 && w(2, 1) == 25 && w(3, 0) == 21 && w(3, 1) == 26, "hnc::vector2D_view::assign fails\n");
+
+		// Sort a column with the iterators
+		auto const col = w.col(1);
+		std::sort(col.begin(), col.end(), std::greater<int>());
+		++nb_test;
+		nb_test -= hnc::test::warning(w(0, 1) == 26 && w(1, 1) == 25 && w(3, 1) == 0, "std::sort on a hnc::vector2D_line_view fails\n");
+		std::cout << "Matrix after fill, assign and sort:\n" << w << "\n" << std::endl;
+	}
+
+	// Read-only views
+	{
+		hnc::vector2D_view<int const> const v = m.view();
+		hnc::vector2D_line_view<int const> const row = m.view().row(0);
+		++nb_test;
+		nb_test -= hnc::test::warning(v(1, 0) == 15 && row[4] == 14, "hnc::vector2D_view<T const> conversion fails\n");
+	}
+
+	// Algorithms of hnc::algo and hnc::math
+	{
+		hnc::vector2D<double> d(4, 4);
+		for (std::size_t row = 0; row < d.nb_row(); ++row)
+		{
+			for (std::size_t col = 0; col < d.nb_col(); ++col) { d(row, col) = double(row * 4 + col); }
+		}
+		std::cout << "hnc::algo::sum(block) = " << hnc::algo::sum(d.sub_view(1, 1, 2, 2)) << " (must be 30)" << std::endl;
+		std::cout << "hnc::math::mean(column 3) = " << hnc::math::mean(d.col(3)) << " (must be 9)" << std::endl;
+		std::cout << "hnc::math::median(transposed) = " << hnc::math::median(d.transposed_view()) << " (must be 7.5)" << std::endl;
+		std::cout << "hnc::math::standard_deviation(row 0) = " << hnc::math::standard_deviation(d.view().row(0)) << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::algo::sum(d.sub_view(1, 1, 2, 2)) == 30, "hnc::algo::sum of a hnc::vector2D_view fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::math::mean(d.col(3)) == 9, "hnc::math::mean of a hnc::vector2D_line_view fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::math::median(d.transposed_view()) == 7.5, "hnc::math::median of a hnc::vector2D_view fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::math::standard_deviation(d.view().row(0)) == hnc::math::standard_deviation(std::vector<double>({ 0, 1, 2, 3 })), "hnc::math::standard_deviation of a hnc::vector2D_line_view fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(hnc::algo::sum(std::set<int>({ 1, 2, 4 })) == 7 && hnc::math::median(std::array<double, 3>{ { 3., 1., 2. } }) == 2., "hnc::algo::sum and hnc::math::median of a range fail\n");
+		std::cout << std::endl;
+	}
+
+	// Empty view (N x 0)
+	{
+		hnc::vector2D<double> e(3, 0);
+		hnc::vector2D_view<double> const v = e.view();
+		auto it = v.begin();
+		std::advance(it, 0);
+		it += 0;
+		++nb_test;
+		nb_test -= hnc::test::warning(it == v.end() && std::distance(v.begin(), v.end()) == 0 && hnc::algo::sum(v) == 0., "hnc::vector2D_view iterators of a N x 0 view fail\n");
+	}
+
+	// Out of range
+	{
+		bool exception = false;
+		try { m.view().at(4, 0); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2D_view::at does not throw\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector2D_view: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
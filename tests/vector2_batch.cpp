@@ -0,0 +1,74 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+#include <hnc/vector2_batch.hpp>
+#include <hnc/vector2D_fixed.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Conversions
+	{
+		std::vector<hnc::vector2<double>> const points = { hnc::vector2<double>(3, 4), hnc::vector2<double>(1, 2), hnc::vector2<double>(0, 0) };
+		hnc::vector2_batch<double> const batch(points);
+		std::cout << batch << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(batch.size() == 3 && batch.x()[1] == 1. && batch.y()[0] == 4., "hnc::vector2_batch constructor from std::vector fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(batch.to_vector() == points && batch.at(1) == points[1], "hnc::vector2_batch::to_vector fails\n");
+		bool exception = false;
+		try { batch.at(3); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector2_batch::at out of range does not throw\n");
+	}
+
+	// Batch operations
+	{
+		hnc::vector2_batch<double> const a = { hnc::vector2<double>(3, 4), hnc::vector2<double>(1, 2), hnc::vector2<double>(0, 0) };
+		hnc::vector2_batch<double> const b = { hnc::vector2<double>(1, 0), hnc::vector2<double>(2, 1), hnc::vector2<double>(5, 5) };
+		hnc::vector2_batch<double> c = a + 2. * b;
+		c -= a;
+		c += hnc::vector2<double>(1, -1);
+		++nb_test;
+		nb_test -= hnc::test::warning(c[0] == hnc::vector2<double>(3, -1) && c[1] == hnc::vector2<double>(5, 1) && c[2] == hnc::vector2<double>(11, 9), "hnc::vector2_batch add or scale fails\n");
+		auto const dot = a.dot(b);
+		auto const cross = a.cross(b);
+		auto const norm = a.norm();
+		++nb_test;
+		nb_test -= hnc::test::warning(dot[0] == 3. && dot[1] == 4. && cross[0] == -4. && cross[1] == -3. && norm[0] == 5. && norm[2] == 0., "hnc::vector2_batch dot, cross or norm fails\n");
+		hnc::vector2_batch<double> n = a;
+		n.normalize();
+		++nb_test;
+		nb_test -= hnc::test::warning(std::abs(n[0].x - 0.6) < 1e-12 && std::abs(n[0].y - 0.8) < 1e-12 && n[2] == hnc::vector2<double>(), "hnc::vector2_batch::normalize fails\n");
+		n = a;
+		n.transform(hnc::vector2D_fixed<double, 2, 2>(hnc::row_major_values, 0., -1., 1., 0.), hnc::vector2<double>(10, 0));
+		++nb_test;
+		nb_test -= hnc::test::warning(n[0] == hnc::vector2<double>(6, 3) && n[1] == hnc::vector2<double>(8, 1), "hnc::vector2_batch::transform fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector2_batch: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -0,0 +1,128 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <string>
+
+#include <hnc/vector3D.hpp>
+#include <hnc/vector2D.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// Default constructor
+	{
+		hnc::vector3D<int> const v;
+		++nb_test;
+		nb_test -= hnc::test::warning(v.size_x() == 0 && v.size_y() == 0 && v.size_z() == 0 && v.empty(), "hnc::vector3D default constructor fails\n");
+	}
+
+	// Constructor, strides and alignment
+	for (hnc::vector3D_layout const layout : { hnc::vector3D_layout::z_contiguous, hnc::vector3D_layout::x_contiguous })
+	{
+		std::string const layout_name = (layout == hnc::vector3D_layout::z_contiguous) ? "z_contiguous" : "x_contiguous";
+		hnc::vector3D<double> v(3, 4, 5, 21., layout);
+		++nb_test;
+		nb_test -= hnc::test::warning(v.size_x() == 3 && v.size_y() == 4 && v.size_z() == 5 && v.size() == 60 && v.layout() == layout, "hnc::vector3D constructor with " + layout_name + " fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0, "hnc::vector3D data with " + layout_name + " is not aligned on 64 bytes\n");
+		bool test_default = true;
+		for (std::size_t x = 0; x < 3; ++x) { for (std::size_t y = 0; y < 4; ++y) { for (std::size_t z = 0; z < 5; ++z) { test_default = test_default && v(x, y, z) == 21.; } } }
+		++nb_test;
+		nb_test -= hnc::test::warning(test_default, "hnc::vector3D default value with " + layout_name + " fails\n");
+		bool const strides = (layout == hnc::vector3D_layout::z_contiguous) ?
+			(v.stride_z() == 1 && v.stride_y() == 5 && v.stride_x() == 20) :
+			(v.stride_x() == 1 && v.stride_y() == 3 && v.stride_z() == 12);
+		++nb_test;
+		nb_test -= hnc::test::warning(strides, "hnc::vector3D strides with " + layout_name + " fail\n");
+		v(2, 3, 4) = 42.;
+		++nb_test;
+		nb_test -= hnc::test::warning(v.data()[2 * v.stride_x() + 3 * v.stride_y() + 4 * v.stride_z()] == 42. && v.at(2, 3, 4) == 42., "hnc::vector3D access with " + layout_name + " fails\n");
+	}
+
+	// Padded lines
+	{
+		hnc::vector3D<float, hnc::vector2D_storage::aligned_padded<float>> v(3, 4, 5, 1.f);
+		++nb_test;
+		nb_test -= hnc::test::warning(v.line_stride() == 16 && v.stride_y() == 16 && v.stride_x() == 64, "hnc::vector3D with hnc::vector2D_storage::aligned_padded strides fail\n");
+		bool aligned = true;
+		for (std::size_t x = 0; x < 3; ++x) { for (std::size_t y = 0; y < 4; ++y) { aligned = aligned && reinterpret_cast<std::uintptr_t>(&v(x, y, 0)) % 64 == 0; } }
+		++nb_test;
+		nb_test -= hnc::test::warning(aligned, "hnc::vector3D with hnc::vector2D_storage::aligned_padded lines are not aligned\n");
+		hnc::vector3D<float> const packed(3, 4, 5, 1.f);
+		++nb_test;
+		nb_test -= hnc::test::warning(v == packed, "hnc::vector3D equality between storage policies fails\n");
+	}
+
+	// Values 0, 1, 2, ...
+	hnc::vector3D<int> v(3, 4, 5);
+	{
+		int value = 0;
+		for (std::size_t x = 0; x < 3; ++x) { for (std::size_t y = 0; y < 4; ++y) { for (std::size_t z = 0; z < 5; ++z) { v(x, y, z) = value++; } } }
+	}
+	std::cout << "vector3D:\n" << v << "\n" << std::endl;
+
+	// Slices
+	{
+		hnc::vector2D<int> const slice_x(v.slice_x(1));
+		hnc::vector2D<int> const slice_y(v.slice_y(2));
+		hnc::vector2D<int> const slice_z(v.slice_z(3));
+		++nb_test;
+		nb_test -= hnc::test::warning(slice_x.nb_row() == 4 && slice_x.nb_col() == 5 && slice_x(2, 3) == v(1, 2, 3), "hnc::vector3D::slice_x fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(slice_y.nb_row() == 3 && slice_y.nb_col() == 5 && slice_y(2, 4) == v(2, 2, 4), "hnc::vector3D::slice_y fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(slice_z.nb_row() == 3 && slice_z.nb_col() == 4 && slice_z(1, 2) == v(1, 2, 3), "hnc::vector3D::slice_z fails\n");
+		v.slice_y(0).fill(-1);
+		++nb_test;
+		nb_test -= hnc::test::warning(v(0, 0, 0) == -1 && v(2, 0, 4) == -1 && v(2, 1, 4) == 49, "hnc::vector3D::slice_y fill fails\n");
+	}
+
+	// Copy in another layout, move
+	{
+		hnc::vector3D<int> const copy(v.view(), hnc::vector3D_layout::x_contiguous);
+		++nb_test;
+		nb_test -= hnc::test::warning(copy == v && copy.layout() == hnc::vector3D_layout::x_contiguous && copy.stride_x() == 1, "hnc::vector3D copy of a view in another layout fails\n");
+		hnc::vector3D<int> moved(copy);
+		hnc::vector3D<int> const other = std::move(moved);
+		++nb_test;
+		nb_test -= hnc::test::warning(other == v && moved.empty() && moved.size_x() == 0, "hnc::vector3D move constructor fails\n");
+		hnc::vector3D<int> block(v.sub_view(1, 1, 1, 2, 2, 3));
+		++nb_test;
+		nb_test -= hnc::test::warning(block.size_x() == 2 && block.size_z() == 3 && block(1, 1, 2) == v(2, 2, 3), "hnc::vector3D copy of a block fails\n");
+		block = hnc::vector3D<int>(2, 2, 2, 7);
+		++nb_test;
+		nb_test -= hnc::test::warning(block.size() == 8 && block(1, 1, 1) == 7 && block != v, "hnc::vector3D move assignment fails\n");
+	}
+
+	// Out of range
+	{
+		bool exception = false;
+		try { v.at(3, 0, 0); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector3D::at out of range does not throw\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector3D: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
@@ -14,11 +14,34 @@
 
 
 #include <iostream>
+#include <stdexcept>
 
 #include <hnc/vector3D_C_style_minimal.hpp>
 #include <hnc/test.hpp>
 #include <hnc/to_string.hpp>
 
+/// @brief Type which counts its instances and throws when it is assigned from a "throwing" value
+struct counted_t
+{
+	static int nb_instance;
+
+	bool throwing;
+
+	counted_t(bool const throwing_value = false) : throwing(throwing_value) { ++nb_instance; }
+
+	counted_t(counted_t const & c) : throwing(c.throwing) { ++nb_instance; }
+
+	~counted_t() { --nb_instance; }
+
+	counted_t & operator=(counted_t const & c)
+	{
+		if (c.throwing) { throw std::runtime_error("counted_t::operator= throws"); }
+		return *this;
+	}
+};
+
+int counted_t::nb_instance = 0;
+
 int main()
 {
 	int nb_test = 0;
@@ -208,6 +231,33 @@ int main()
 	}
 	std::cout << std::endl;
 
+	// Contiguous values
+	++nb_test;
+	{
+		hnc::vector3D_C_style_minimal<int> v(3, 4, 5);
+		int value = 0;
+		for (std::size_t x = 0; x < v.size_x(); ++x)
+		{
+			for (std::size_t y = 0; y < v.size_y(); ++y)
+			{
+				for (std::size_t z = 0; z < v.size_z(); ++z) { v[x][y][z] = value++; }
+			}
+		}
+		bool test = true;
+		for (std::size_t i = 0; i < 3 * 4 * 5; ++i) { if (v.data()[i] != int(i)) { test = false; } }
+		hnc::vector3D_C_style_minimal<int> const copy(v);
+		test = test && copy.data() != v.data() && copy[2][3][4] == 59 && copy[1][0][2] == 22;
+		nb_test -= hnc::test::warning(test, "hnc::vector3D_C_style_minimal contiguous values fail\n");
+	}
+
+	// Constructor which throws (no leak)
+	++nb_test;
+	{
+		try { hnc::vector3D_C_style_minimal<counted_t> v(3, 4, 5, counted_t(true)); }
+		catch (std::runtime_error const &) { }
+		nb_test -= hnc::test::warning(counted_t::nb_instance == 0, "hnc::vector3D_C_style_minimal constructor leaks when T::operator= throws\n");
+	}
+
 	hnc::test::warning(nb_test == 0, "hnc::vector3D_C_style_minimal: " + hnc::to_string(nb_test) + " test fail!\n");
 
 	return nb_test;
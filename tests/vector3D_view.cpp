@@ -0,0 +1,90 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <stdexcept>
+
+#include <hnc/vector3D_view.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+int main()
+{
+	int nb_test = 0;
+
+	// C array 2 x 3 x 4 with 0, 1, ..., 23
+	int a[2][3][4];
+	{
+		int value = 0;
+		for (std::size_t x = 0; x < 2; ++x) { for (std::size_t y = 0; y < 3; ++y) { for (std::size_t z = 0; z < 4; ++z) { a[x][y][z] = value++; } } }
+	}
+
+	// View on the C array
+	hnc::vector3D_view<int> const v(&a[0][0][0], 2, 3, 4);
+	std::cout << "View:\n" << v << "\n" << std::endl;
+	++nb_test;
+	nb_test -= hnc::test::warning(v.size() == 24 && v.stride_x() == 12 && v.stride_y() == 4 && v.stride_z() == 1, "hnc::vector3D_view on a C array fails\n");
+	++nb_test;
+	nb_test -= hnc::test::warning(v(1, 2, 3) == 23 && v(1, 0, 2) == 14 && v.at(0, 1, 1) == 5, "hnc::vector3D_view access fails\n");
+
+	// Read-only view
+	{
+		hnc::vector3D_view<int const> const c = v;
+		++nb_test;
+		nb_test -= hnc::test::warning(c.data() == v.data() && c(1, 1, 1) == 17, "hnc::vector3D_view<T const> from hnc::vector3D_view<T> fails\n");
+	}
+
+	// Slices
+	{
+		hnc::vector2D_view<int> const s_x = v.slice_x(1);
+		hnc::vector2D_view<int> const s_y = v.slice_y(2);
+		hnc::vector2D_view<int> const s_z = v.slice_z(3);
+		++nb_test;
+		nb_test -= hnc::test::warning(s_x.nb_row() == 3 && s_x.nb_col() == 4 && s_x(2, 1) == 21 && s_x.is_contiguous(), "hnc::vector3D_view::slice_x fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(s_y.nb_row() == 2 && s_y.nb_col() == 4 && s_y(1, 0) == 20, "hnc::vector3D_view::slice_y fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(s_z.nb_row() == 2 && s_z.nb_col() == 3 && s_z(0, 2) == 11 && s_z.col_stride() == 4, "hnc::vector3D_view::slice_z fails\n");
+	}
+
+	// Block, fill and assign
+	{
+		hnc::vector3D_view<int> const block = v.sub_view(1, 1, 1, 1, 2, 3);
+		++nb_test;
+		nb_test -= hnc::test::warning(block.size_x() == 1 && block.size_y() == 2 && block.size_z() == 3 && block(0, 0, 0) == 17 && block(0, 1, 2) == 23, "hnc::vector3D_view::sub_view fails\n");
+		int b[1][2][3];
+		hnc::vector3D_view<int> const copy(&b[0][0][0], 1, 2, 3);
+		copy.assign(block);
+		++nb_test;
+		nb_test -= hnc::test::warning(b[0][0][0] == 17 && b[0][1][2] == 23, "hnc::vector3D_view::assign fails\n");
+		block.fill(-1);
+		++nb_test;
+		nb_test -= hnc::test::warning(a[1][1][1] == -1 && a[1][2][3] == -1 && a[1][1][0] == 16 && a[0][1][1] == 5, "hnc::vector3D_view::fill fails\n");
+	}
+
+	// Out of range
+	{
+		bool exception = false;
+		try { v.at(0, 3, 0); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector3D_view::at out of range does not throw\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector3D_view: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}
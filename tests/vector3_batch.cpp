@@ -0,0 +1,125 @@
+// Copyright © 2014 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include <hnc/vector3_batch.hpp>
+#include <hnc/vector2D_fixed.hpp>
+#include <hnc/test.hpp>
+#include <hnc/to_string.hpp>
+
+
+// Return true if the values are near
+bool near(double const a, double const b) { return std::abs(a - b) < 1e-12; }
+
+int main()
+{
+	int nb_test = 0;
+
+	// Conversions
+	{
+		std::vector<hnc::vector3<double>> const points = { hnc::vector3<double>(1, 2, 3), hnc::vector3<double>(4, 5, 6), hnc::vector3<double>(-1, 0, 2) };
+		hnc::vector3_batch<double> const batch(points);
+		std::cout << batch << std::endl;
+		++nb_test;
+		nb_test -= hnc::test::warning(batch.size() == 3 && batch.x()[1] == 4. && batch.y()[2] == 0. && batch.z()[0] == 3., "hnc::vector3_batch constructor from std::vector fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(batch.to_vector() == points && batch[2] == points[2], "hnc::vector3_batch::to_vector fails\n");
+		++nb_test;
+		nb_test -= hnc::test::warning(reinterpret_cast<std::uintptr_t>(batch.x()) % 64 == 0 && reinterpret_cast<std::uintptr_t>(batch.z()) % 64 == 0, "hnc::vector3_batch arrays are not aligned\n");
+		hnc::vector3_batch<double> b = { hnc::vector3<double>(1, 2, 3) };
+		b.push_back(hnc::vector3<double>(4, 5, 6));
+		b.set(0, hnc::vector3<double>(0, 0, 0));
+		b.resize(3, hnc::vector3<double>(-1, 0, 2));
+		++nb_test;
+		nb_test -= hnc::test::warning(b != batch && b[1] == batch[1] && b[2] == batch[2] && b.at(0) == hnc::vector3<double>(), "hnc::vector3_batch push_back, set or resize fails\n");
+		bool exception = false;
+		try { b.at(3); }
+		catch (std::out_of_range const &) { exception = true; }
+		++nb_test;
+		nb_test -= hnc::test::warning(exception, "hnc::vector3_batch::at out of range does not throw\n");
+	}
+
+	// Add and scale
+	{
+		hnc::vector3_batch<int> const a = { hnc::vector3<int>(1, 2, 3), hnc::vector3<int>(4, 5, 6) };
+		hnc::vector3_batch<int> const b = { hnc::vector3<int>(10, 20, 30), hnc::vector3<int>(40, 50, 60) };
+		hnc::vector3_batch<int> c = 2 * a + b;
+		++nb_test;
+		nb_test -= hnc::test::warning(c[0] == hnc::vector3<int>(12, 24, 36) && c[1] == hnc::vector3<int>(48, 60, 72), "hnc::vector3_batch operator + or * fails\n");
+		c -= b;
+		c += hnc::vector3<int>(1, 1, 1);
+		++nb_test;
+		nb_test -= hnc::test::warning(c == a * 2 + hnc::vector3_batch<int>(2, hnc::vector3<int>(1, 1, 1)), "hnc::vector3_batch operator -= or += fails\n");
+	}
+
+	// Dot, cross, norm, normalize
+	{
+		hnc::vector3_batch<double> const a = { hnc::vector3<double>(1, 0, 0), hnc::vector3<double>(1, 2, 3), hnc::vector3<double>(0, 0, 0) };
+		hnc::vector3_batch<double> const b = { hnc::vector3<double>(0, 1, 0), hnc::vector3<double>(4, 5, 6), hnc::vector3<double>(1, 1, 1) };
+		auto const dot = a.dot(b);
+		++nb_test;
+		nb_test -= hnc::test::warning(dot.size() == 3 && dot[0] == 0. && dot[1] == 32. && dot[2] == 0., "hnc::vector3_batch::dot fails\n");
+		hnc::vector3_batch<double> const cross = a.cross(b);
+		++nb_test;
+		nb_test -= hnc::test::warning(cross[0] == hnc::vector3<double>(0, 0, 1) && cross[1] == hnc::vector3<double>(-3, 6, -3) && cross[2] == hnc::vector3<double>(), "hnc::vector3_batch::cross fails\n");
+		auto const norm = a.norm();
+		++nb_test;
+		nb_test -= hnc::test::warning(norm[0] == 1. && near(norm[1], std::sqrt(14.)) && norm[2] == 0., "hnc::vector3_batch::norm fails\n");
+		hnc::vector3_batch<double> n = a;
+		n.normalize();
+		auto const norm_n = n.norm();
+		++nb_test;
+		nb_test -= hnc::test::warning(near(norm_n[0], 1.) && near(norm_n[1], 1.) && n[2] == hnc::vector3<double>() && near(n[1].z, 3. / std::sqrt(14.)), "hnc::vector3_batch::normalize fails\n");
+	}
+
+	// Matrix transform
+	{
+		hnc::vector3_batch<double> batch = { hnc::vector3<double>(1, 0, 0), hnc::vector3<double>(1, 2, 3) };
+		hnc::vector2D_fixed<double, 3, 3> const rotation_z = { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } };
+		batch.transform(rotation_z);
+		++nb_test;
+		nb_test -= hnc::test::warning(batch[0] == hnc::vector3<double>(0, 1, 0) && batch[1] == hnc::vector3<double>(-2, 1, 3), "hnc::vector3_batch::transform fails\n");
+		batch.transform(hnc::vector2D_fixed<double, 3, 3>(hnc::row_major_values, 2., 0., 0., 0., 2., 0., 0., 0., 2.), hnc::vector3<double>(1, 1, 1));
+		++nb_test;
+		nb_test -= hnc::test::warning(batch[0] == hnc::vector3<double>(1, 3, 1) && batch[1] == hnc::vector3<double>(-3, 3, 7), "hnc::vector3_batch::transform with translation fails\n");
+	}
+
+	// Large batch (vectorized loops with remainder)
+	{
+		std::vector<hnc::vector3<float>> points;
+		for (std::size_t i = 0; i < 1003; ++i) { points.emplace_back(float(i), float(i % 7), -float(i % 3)); }
+		hnc::vector3_batch<float> batch(points);
+		batch *= 0.5f;
+		auto const dot = batch.dot(batch);
+		bool ok = true;
+		for (std::size_t i = 0; i < points.size(); ++i)
+		{
+			hnc::vector3<float> const & p = points[i];
+			float const expected = 0.25f * (p.x * p.x + p.y * p.y + p.z * p.z);
+			if (std::abs(dot[i] - expected) > 1e-3f * (1.f + expected) || batch[i] != hnc::vector3<float>(0.5f * p.x, 0.5f * p.y, 0.5f * p.z)) { ok = false; }
+		}
+		++nb_test;
+		nb_test -= hnc::test::warning(ok, "hnc::vector3_batch large batch fails\n");
+	}
+
+	hnc::test::warning(nb_test == 0, "hnc::vector3_batch: " + hnc::to_string(nb_test) + " test fail!\n");
+
+	return nb_test;
+}